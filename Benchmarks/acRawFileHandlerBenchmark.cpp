@@ -0,0 +1,127 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acRawFileHandlerBenchmark.cpp
+///
+//==================================================================================
+
+//------------------------------ acRawFileHandlerBenchmark.cpp ------------------------------
+
+// Qt:
+#include <QElapsedTimer>
+#include <QImage>
+
+// C++:
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+// Local:
+#include <Benchmarks/acTimelineBenchmark.h>
+#include <AMDTApplicationComponents/Include/acRawFileHandler.h>
+
+/// The size of the converted pages.
+#define AC_BENCHMARK_TEXELS_PAGE_WIDTH 2048
+#define AC_BENCHMARK_TEXELS_PAGE_HEIGHT 2048
+
+/// The number of distinct values of the float and double components (values around the [0, 1] range, as a rendered image holds).
+#define AC_BENCHMARK_TEXELS_DISTINCT_VALUES 4001
+
+/// Creates a raw file handler of a single page of generated RGBA texels.
+/// \param componentDataType the data type of the components.
+/// \param seed the seed of the texel generator.
+/// \return the handler (owned by the caller), or nullptr if it could not be created.
+static acRawFileHandler* acBenchmarkCreateTexelsHandler(oaDataType componentDataType, quint64 seed)
+{
+    int dataTypeSize = oaSizeOfDataType(componentDataType);
+    gtSizeType componentsCount = (gtSizeType)AC_BENCHMARK_TEXELS_PAGE_WIDTH * AC_BENCHMARK_TEXELS_PAGE_HEIGHT * 4;
+    gtSizeType rawDataSize = componentsCount * dataTypeSize;
+
+    // the raw file handler frees the raw data
+    gtUByte* pRawData = (gtUByte*)malloc(rawDataSize);
+
+    if (pRawData == nullptr)
+    {
+        return nullptr;
+    }
+
+    quint64 randomState = seed;
+
+    for (gtSizeType i = 0; i < componentsCount; ++i)
+    {
+        randomState = randomState * Q_UINT64_C(6364136223846793005) + Q_UINT64_C(1442695040888963407);
+        quint32 bits = (quint32)(randomState >> 32);
+        gtUByte* pComponent = pRawData + i * dataTypeSize;
+
+        if (componentDataType == OA_FLOAT)
+        {
+            float value = (float)(bits % AC_BENCHMARK_TEXELS_DISTINCT_VALUES) / 2000.0f - 0.5f;
+            memcpy(pComponent, &value, sizeof(value));
+        }
+        else if (componentDataType == OA_DOUBLE)
+        {
+            double value = (double)(bits % AC_BENCHMARK_TEXELS_DISTINCT_VALUES) / 2000.0 - 0.5;
+            memcpy(pComponent, &value, sizeof(value));
+        }
+        else
+        {
+            memcpy(pComponent, &bits, qMin((int)sizeof(bits), dataTypeSize));
+        }
+    }
+
+    acRawFileHandler* pRetVal = new(std::nothrow) acRawFileHandler(pRawData, rawDataSize, AC_BENCHMARK_TEXELS_PAGE_WIDTH, AC_BENCHMARK_TEXELS_PAGE_HEIGHT,
+                                                                   OA_TEXEL_FORMAT_RGBA, componentDataType, 1);
+
+    if (pRetVal == nullptr)
+    {
+        free(pRawData);
+    }
+    else if (!pRetVal->isOk() || !pRetVal->setActivePage(0))
+    {
+        delete pRetVal;
+        pRetVal = nullptr;
+    }
+    else
+    {
+        // every conversion is measured, rather than the lookup of the converted page
+        pRetVal->setPageCacheBudget(0);
+    }
+
+    return pRetVal;
+}
+
+void acBenchmarkTexelKernels(const acTimelineBenchmarkOptions& options)
+{
+    const oaDataType componentDataTypes[] = { OA_FLOAT, OA_DOUBLE, OA_UNSIGNED_INT, OA_UNSIGNED_BYTE };
+    const char* componentDataTypeNames[] = { "float", "double", "uint32", "uint8" };
+
+    for (size_t typeIndex = 0; typeIndex < sizeof(componentDataTypes) / sizeof(componentDataTypes[0]); ++typeIndex)
+    {
+        acRawFileHandler* pHandler = acBenchmarkCreateTexelsHandler(componentDataTypes[typeIndex], options.m_nSeed);
+
+        if (pHandler == nullptr)
+        {
+            acBenchmarkMessage(QString("texels: could not create the %1 page").arg(componentDataTypeNames[typeIndex]));
+            continue;
+        }
+
+        // the float, double and 32 bits components are converted through the pixel value parameter, the 8 bits ones are swizzled
+        QVector<qint64> nsSamples;
+
+        for (int i = 0; i < options.m_nIterations; ++i)
+        {
+            QElapsedTimer conversionTimer;
+            conversionTimer.start();
+
+            QImage* pImage = pHandler->convertToQImage();
+
+            nsSamples.append(conversionTimer.nsecsElapsed());
+            delete pImage;
+        }
+
+        acBenchmarkReport(QString("texels: RGBA %1").arg(componentDataTypeNames[typeIndex]), nsSamples, options);
+
+        delete pHandler;
+    }
+}
@@ -0,0 +1,119 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineBenchmark.h
+///
+//==================================================================================
+
+//------------------------------ acTimelineBenchmark.h ------------------------------
+
+#ifndef __ACTIMELINEBENCHMARK
+#define __ACTIMELINEBENCHMARK
+
+// Qt:
+#include <QImage>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class acTimeline;
+
+/// The distribution of the durations of the generated timeline items.
+enum acTimelineBenchmarkDurations
+{
+    AC_BENCHMARK_DURATIONS_UNIFORM,         ///< Durations spread evenly up to twice the mean duration.
+    AC_BENCHMARK_DURATIONS_EXPONENTIAL,     ///< Mostly short items, with a few long ones.
+    AC_BENCHMARK_DURATIONS_PARETO           ///< Heavy tailed: many tiny items and a few items spanning a large part of the trace.
+};
+
+/// The parameters of a benchmark run.
+struct acTimelineBenchmarkOptions
+{
+    int                          m_nBranchCount;     ///< The number of top level branches.
+    int                          m_nDepth;           ///< The number of sub branch levels below each top level branch.
+    int                          m_nFanout;          ///< The number of sub branches of each branch which is not a leaf.
+    int                          m_nItemCount;       ///< The number of items, spread evenly over all the branches.
+    double                       m_dOverlap;         ///< The fraction of the items which start before the previous item of their branch ends.
+    acTimelineBenchmarkDurations m_durations;        ///< The distribution of the item durations.
+    quint64                      m_nMeanDuration;    ///< The mean item duration, in time units.
+    bool                         m_bCompactItems;    ///< Flag indicating whether the items are added as compact items rather than as acTimelineItem objects.
+    int                          m_nIterations;      ///< The number of times each operation is repeated.
+    int                          m_nWidth;           ///< The width of the timeline widget.
+    int                          m_nHeight;          ///< The height of the timeline widget.
+    quint64                      m_nSeed;            ///< The seed of the trace and operation generators.
+    QStringList                  m_scenarios;        ///< The scenarios to run (empty for the default ones).
+    QList<int>                   m_memoryItemCounts; ///< The item counts at which the item store memory is measured.
+    int                          m_nMaskItemCount;   ///< The number of items of the branch painted by the mask scenario.
+    double                       m_dMaxP99Ms;        ///< The 99th percentile latency above which the run fails, in milliseconds (0 for no limit).
+
+    /// Construct/Initialize a new instance of the acTimelineBenchmarkOptions struct, with the default parameters.
+    acTimelineBenchmarkOptions();
+
+    /// Gets a flag indicating whether or not a scenario should run.
+    /// \param scenario the name of the scenario.
+    /// \param isDefault flag indicating whether or not the scenario runs when no scenario was selected.
+    /// \return true if the scenario was selected, or if it is a default scenario and no scenario was selected.
+    bool isScenarioSelected(const QString& scenario, bool isDefault = true) const { return m_scenarios.isEmpty() ? isDefault : m_scenarios.contains(scenario); }
+};
+
+/// Fills a timeline with a synthetic trace.
+/// \param timeline the timeline to fill.
+/// \param options the shape of the trace.
+/// \param branchNames filled with the texts of all the branches, parents first.
+/// \return the number of items added.
+int acBenchmarkBuildTrace(acTimeline& timeline, const acTimelineBenchmarkOptions& options, QStringList& branchNames);
+
+/// Paints the timeline widget (and its grid and scroll bars) into an image, as its paint event would paint it on screen.
+/// \param timeline the timeline to paint.
+/// \param frame the image painted into.  It should be as large as the timeline.
+/// \return the time it took to paint the timeline, in nanoseconds.
+qint64 acBenchmarkRenderFrame(acTimeline& timeline, QImage& frame);
+
+/// Prints the latency percentiles of an operation, and records whether the operation exceeded the latency limit.
+/// \param operation the name of the operation.
+/// \param nsSamples the duration of each run of the operation, in nanoseconds.  The samples are sorted.
+/// \param options the run options, holding the latency limit.
+void acBenchmarkReport(const QString& operation, QVector<qint64>& nsSamples, const acTimelineBenchmarkOptions& options);
+
+/// Prints a message line.
+/// \param message the message.
+void acBenchmarkMessage(const QString& message);
+
+/// Gets the resident set size of the process.
+/// \return the resident set size in kilobytes, or -1 if it is not available on this platform.
+qint64 acBenchmarkCurrentRSS();
+
+/// Gets the peak resident set size of the process.
+/// \return the peak resident set size in kilobytes, or -1 if it is not available on this platform.
+qint64 acBenchmarkPeakRSS();
+
+/// The benchmark scenarios.  Each scenario reports the latencies of its operations with acBenchmarkReport:
+
+/// Loads a synthetic trace, and replays zoom, pan, hover, fold/unfold and branch search operations on it.  Then paints it with
+/// and without batched painting.
+/// \param options the run options.
+void acBenchmarkTimelineScenarios(const acTimelineBenchmarkOptions& options);
+
+/// Compares the resident memory of a branch holding its items as acTimelineItem objects and as compact items (acTimelineItemStore),
+/// at each item count of the options.  Every measurement runs in a separate process.
+/// \param options the run options.
+void acBenchmarkItemStoreMemory(const acTimelineBenchmarkOptions& options);
+
+/// Adds items to a branch and prints the resident memory they take.  This is the measuring process of acBenchmarkItemStoreMemory.
+/// \param store the item store: "objects" or "compact".
+/// \param itemCount the number of items.
+/// \return the process exit code.
+int acBenchmarkItemStoreMemoryProcess(const QString& store, int itemCount);
+
+/// Paints a single dense branch at several zoom levels, and replays the masking of its items on each paint pass with the flat
+/// mask rows (acTimelineMaskBuffer) and with the QMap based mask buffer they replaced.
+/// \param options the run options.
+void acBenchmarkMask(const acTimelineBenchmarkOptions& options);
+
+/// Converts a page of RGBA texels of each component data type into an image (the raw file handler texel kernels).
+/// \param options the run options.
+void acBenchmarkTexelKernels(const acTimelineBenchmarkOptions& options);
+
+#endif  // __ACTIMELINEBENCHMARK
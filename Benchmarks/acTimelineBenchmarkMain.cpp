@@ -0,0 +1,343 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineBenchmarkMain.cpp
+///
+//==================================================================================
+
+//------------------------------ acTimelineBenchmarkMain.cpp ------------------------------
+
+// The timeline benchmark.  Runs headless, on the offscreen Qt platform plugin (the timeline is painted into images by the
+// raster paint engine, no display or GPU is needed):
+//   CXLApplicationComponentsBenchmark [options]
+//     --branches N          the number of top level branches (8)
+//     --depth N             the number of sub branch levels below each top level branch (2)
+//     --fanout N            the number of sub branches of each branch which is not a leaf (2)
+//     --items N             the number of items, spread evenly over all the branches (1000000)
+//     --overlap F           the fraction of the items overlapping the previous item of their branch (0.2)
+//     --durations D         the item duration distribution: uniform, exponential or pareto (exponential)
+//     --mean-duration N     the mean item duration, in time units (1000)
+//     --compact             add the items as compact items rather than as acTimelineItem objects
+//     --iterations N        the number of times each operation is repeated (50)
+//     --size WxH            the size of the timeline widget (1600x900)
+//     --seed N              the seed of the trace and operation generators (1)
+//     --scenarios A,B,...   the scenarios to run: paint, zoom, pan, hover, fold, search, batched, mask, texels (the
+//                           default ones) and memory
+//     --memory-items N,...  the item counts at which the memory scenario measures the item stores (1000000,10000000)
+//     --mask-items N        the number of items of the branch painted by the mask scenario (1000000)
+//     --max-p99 MS          fail when the 99th percentile latency of an operation exceeds MS milliseconds
+// Prints the latency percentiles of every operation, and the peak resident set size.
+// Returns 0 when no operation exceeded the latency limit.
+
+// Qt:
+#include <QApplication>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+
+// C++:
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Local:
+#include <Benchmarks/acTimelineBenchmark.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
+
+static bool s_isLatencyLimitExceeded = false;
+
+acTimelineBenchmarkOptions::acTimelineBenchmarkOptions() :
+    m_nBranchCount(8),
+    m_nDepth(2),
+    m_nFanout(2),
+    m_nItemCount(1000000),
+    m_dOverlap(0.2),
+    m_durations(AC_BENCHMARK_DURATIONS_EXPONENTIAL),
+    m_nMeanDuration(1000),
+    m_bCompactItems(false),
+    m_nIterations(50),
+    m_nWidth(1600),
+    m_nHeight(900),
+    m_nSeed(1),
+    m_nMaskItemCount(1000000),
+    m_dMaxP99Ms(0)
+{
+    m_memoryItemCounts << 1000000 << 10000000;
+}
+
+qint64 acBenchmarkRenderFrame(acTimeline& timeline, QImage& frame)
+{
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+
+    timeline.render(&frame);
+
+    return frameTimer.nsecsElapsed();
+}
+
+void acBenchmarkReport(const QString& operation, QVector<qint64>& nsSamples, const acTimelineBenchmarkOptions& options)
+{
+    if (nsSamples.isEmpty())
+    {
+        return;
+    }
+
+    std::sort(nsSamples.begin(), nsSamples.end());
+
+    // nearest rank percentiles
+    int sampleCount = nsSamples.count();
+    auto percentileMs = [&nsSamples, sampleCount](double percentile)
+    {
+        int rank = (int)ceil(percentile * sampleCount / 100.0);
+        return nsSamples[qBound(0, rank - 1, sampleCount - 1)] / 1.0e6;
+    };
+
+    double p99Ms = percentileMs(99);
+    bool isLimitExceeded = options.m_dMaxP99Ms > 0 && p99Ms > options.m_dMaxP99Ms;
+
+    printf("%-36s %7d %10.3f %10.3f %10.3f %10.3f%s\n", operation.toUtf8().constData(), sampleCount,
+           percentileMs(50), percentileMs(90), p99Ms, nsSamples.last() / 1.0e6, isLimitExceeded ? "  (over the limit)" : "");
+    fflush(stdout);
+
+    s_isLatencyLimitExceeded = s_isLatencyLimitExceeded || isLimitExceeded;
+}
+
+void acBenchmarkMessage(const QString& message)
+{
+    printf("%s\n", message.toUtf8().constData());
+    fflush(stdout);
+}
+
+/// Reads a memory size field of the process status.
+/// \param fieldName the name of the field, including the colon.
+/// \return the field value in kilobytes, or -1 if it is not available.
+static qint64 acBenchmarkProcessStatusField(const char* fieldName)
+{
+    qint64 retVal = -1;
+
+#if defined(__linux__)
+    QFile statusFile("/proc/self/status");
+
+    if (statusFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QList<QByteArray> lines = statusFile.readAll().split('\n');
+
+        for (QList<QByteArray>::const_iterator i = lines.begin(); i != lines.end(); ++i)
+        {
+            if ((*i).startsWith(fieldName))
+            {
+                // for example "VmHWM:     123456 kB"
+                retVal = (*i).mid((int)strlen(fieldName)).trimmed().split(' ').first().toLongLong();
+                break;
+            }
+        }
+    }
+
+#else
+    (void)fieldName;
+#endif
+
+    return retVal;
+}
+
+qint64 acBenchmarkCurrentRSS()
+{
+    return acBenchmarkProcessStatusField("VmRSS:");
+}
+
+qint64 acBenchmarkPeakRSS()
+{
+    return acBenchmarkProcessStatusField("VmHWM:");
+}
+
+/// Parses the command line options.
+/// \param arguments the command line arguments, without the program name.
+/// \param options filled with the parsed options.
+/// \return true if the options are valid.
+static bool acBenchmarkParseOptions(const QStringList& arguments, acTimelineBenchmarkOptions& options)
+{
+    bool retVal = true;
+
+    for (int i = 0; retVal && i < arguments.count(); ++i)
+    {
+        const QString& option = arguments[i];
+
+        if (option == "--compact")
+        {
+            options.m_bCompactItems = true;
+            continue;
+        }
+
+        // all the other options have a value
+        if (i + 1 >= arguments.count())
+        {
+            retVal = false;
+            break;
+        }
+
+        const QString& value = arguments[++i];
+        bool isValid = true;
+
+        if (option == "--branches")
+        {
+            options.m_nBranchCount = value.toInt(&isValid);
+            isValid = isValid && options.m_nBranchCount > 0;
+        }
+        else if (option == "--depth")
+        {
+            options.m_nDepth = value.toInt(&isValid);
+            isValid = isValid && options.m_nDepth >= 0;
+        }
+        else if (option == "--fanout")
+        {
+            options.m_nFanout = value.toInt(&isValid);
+            isValid = isValid && options.m_nFanout > 0;
+        }
+        else if (option == "--items")
+        {
+            options.m_nItemCount = value.toInt(&isValid);
+            isValid = isValid && options.m_nItemCount >= 0;
+        }
+        else if (option == "--overlap")
+        {
+            options.m_dOverlap = value.toDouble(&isValid);
+            isValid = isValid && options.m_dOverlap >= 0 && options.m_dOverlap <= 1;
+        }
+        else if (option == "--durations")
+        {
+            if (value == "uniform")
+            {
+                options.m_durations = AC_BENCHMARK_DURATIONS_UNIFORM;
+            }
+            else if (value == "exponential")
+            {
+                options.m_durations = AC_BENCHMARK_DURATIONS_EXPONENTIAL;
+            }
+            else if (value == "pareto")
+            {
+                options.m_durations = AC_BENCHMARK_DURATIONS_PARETO;
+            }
+            else
+            {
+                isValid = false;
+            }
+        }
+        else if (option == "--mean-duration")
+        {
+            options.m_nMeanDuration = value.toULongLong(&isValid);
+            isValid = isValid && options.m_nMeanDuration > 0;
+        }
+        else if (option == "--iterations")
+        {
+            options.m_nIterations = value.toInt(&isValid);
+            isValid = isValid && options.m_nIterations > 0;
+        }
+        else if (option == "--size")
+        {
+            QStringList sizeParts = value.split('x');
+            bool isHeightValid = false;
+            isValid = sizeParts.count() == 2;
+
+            if (isValid)
+            {
+                options.m_nWidth = sizeParts[0].toInt(&isValid);
+                options.m_nHeight = sizeParts[1].toInt(&isHeightValid);
+                isValid = isValid && isHeightValid && options.m_nWidth > 0 && options.m_nHeight > 0;
+            }
+        }
+        else if (option == "--seed")
+        {
+            options.m_nSeed = value.toULongLong(&isValid);
+        }
+        else if (option == "--scenarios")
+        {
+            options.m_scenarios = value.split(',', QString::SkipEmptyParts);
+        }
+        else if (option == "--memory-items")
+        {
+            QStringList itemCounts = value.split(',', QString::SkipEmptyParts);
+            options.m_memoryItemCounts.clear();
+
+            for (QStringList::const_iterator itemCount = itemCounts.begin(); isValid && itemCount != itemCounts.end(); ++itemCount)
+            {
+                options.m_memoryItemCounts.append((*itemCount).toInt(&isValid));
+                isValid = isValid && options.m_memoryItemCounts.last() > 0;
+            }
+        }
+        else if (option == "--mask-items")
+        {
+            options.m_nMaskItemCount = value.toInt(&isValid);
+            isValid = isValid && options.m_nMaskItemCount > 0;
+        }
+        else if (option == "--max-p99")
+        {
+            options.m_dMaxP99Ms = value.toDouble(&isValid);
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        retVal = isValid;
+    }
+
+    return retVal;
+}
+
+int main(int argc, char* argv[])
+{
+    // The timeline is painted into images, no display is needed:
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication application(argc, argv);
+
+    QStringList arguments = application.arguments();
+    arguments.removeFirst();
+
+    // the memory scenario measures every item store in a process of its own
+    if (arguments.count() == 3 && arguments[0] == "--store-memory")
+    {
+        return acBenchmarkItemStoreMemoryProcess(arguments[1], arguments[2].toInt());
+    }
+
+    acTimelineBenchmarkOptions options;
+
+    if (!acBenchmarkParseOptions(arguments, options))
+    {
+        fprintf(stderr, "Usage: %s [--branches N] [--depth N] [--fanout N] [--items N] [--overlap F] [--durations uniform|exponential|pareto]\n"
+                "         [--mean-duration N] [--compact] [--iterations N] [--size WxH] [--seed N] [--scenarios A,B,...] [--memory-items N,...]\n"
+                "         [--mask-items N] [--max-p99 MS]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%-36s %7s %10s %10s %10s %10s\n", "operation (ms)", "count", "p50", "p90", "p99", "max");
+
+    acBenchmarkTimelineScenarios(options);
+
+    if (options.isScenarioSelected("mask"))
+    {
+        acBenchmarkMask(options);
+    }
+
+    if (options.isScenarioSelected("texels"))
+    {
+        acBenchmarkTexelKernels(options);
+    }
+
+    // the object store takes several gigabytes at 10M items, so the memory scenario only runs when it is selected
+    if (options.isScenarioSelected("memory", false))
+    {
+        acBenchmarkItemStoreMemory(options);
+    }
+
+    qint64 peakRSS = acBenchmarkPeakRSS();
+
+    if (peakRSS >= 0)
+    {
+        printf("peak RSS: %.1f MB\n", peakRSS / 1024.0);
+    }
+
+    return s_isLatencyLimitExceeded ? 1 : 0;
+}
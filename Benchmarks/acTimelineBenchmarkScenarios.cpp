@@ -0,0 +1,348 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineBenchmarkScenarios.cpp
+///
+//==================================================================================
+
+//------------------------------ acTimelineBenchmarkScenarios.cpp ------------------------------
+
+// Qt:
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QMouseEvent>
+
+// C++:
+#include <new>
+#include <random>
+
+// Local:
+#include <Benchmarks/acTimelineBenchmark.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+
+/// The zoom factor multiplier of each zoom step, as a few mouse wheel ticks would zoom.
+#define AC_BENCHMARK_ZOOM_STEP 4.0
+
+/// The zoom factor of the pan and hover scenarios.
+#define AC_BENCHMARK_DETAIL_ZOOM 256.0
+
+/// The zoom factor multiplier between the zoom levels of the batched painting scenario.
+#define AC_BENCHMARK_BATCHED_ZOOM_STEP 64.0
+
+/// Gets the zoom factor at which only a few items of each branch are visible.
+/// \param timeline the timeline.
+/// \param options the run options.
+/// \return the zoom factor.
+static double acBenchmarkMaxZoom(acTimeline& timeline, const acTimelineBenchmarkOptions& options)
+{
+    double retVal = timeline.fullRange() / (options.m_nMeanDuration * 8.0);
+    return qBound(AC_BENCHMARK_ZOOM_STEP, retVal, timeline.maxZoom());
+}
+
+/// Collects the branches which have sub branches.
+/// \param pBranch the branch to start from.
+/// \param parentBranches filled with the branch and its descendants which have sub branches.
+static void acBenchmarkCollectParentBranches(acTimelineBranch* pBranch, QList<acTimelineBranch*>& parentBranches)
+{
+    int subBranchCount = pBranch->subBranchCount();
+
+    if (subBranchCount > 0)
+    {
+        parentBranches.append(pBranch);
+    }
+
+    for (int i = 0; i < subBranchCount; ++i)
+    {
+        acTimelineBranch* pSubBranch = pBranch->getSubBranch(i);
+
+        if (pSubBranch != nullptr)
+        {
+            acBenchmarkCollectParentBranches(pSubBranch, parentBranches);
+        }
+    }
+}
+
+void acBenchmarkTimelineScenarios(const acTimelineBenchmarkOptions& options)
+{
+    // the trace is only loaded when one of its scenarios runs
+    QStringList traceScenarios = QStringList() << "paint" << "zoom" << "pan" << "hover" << "fold" << "search" << "batched";
+    bool isTraceNeeded = false;
+
+    for (QStringList::const_iterator i = traceScenarios.begin(); i != traceScenarios.end(); ++i)
+    {
+        isTraceNeeded = isTraceNeeded || options.isScenarioSelected(*i);
+    }
+
+    if (!isTraceNeeded)
+    {
+        return;
+    }
+
+    acTimeline* pTimeline = new(std::nothrow) acTimeline(nullptr);
+    Q_ASSERT(pTimeline != nullptr);
+
+    if (pTimeline == nullptr)
+    {
+        return;
+    }
+
+    // the timeline only lays itself out when it is visible.  On the offscreen platform, showing it does not need a display
+    pTimeline->resize(options.m_nWidth, options.m_nHeight);
+    pTimeline->show();
+    QApplication::processEvents();
+
+    QStringList branchNames;
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+
+    int itemCount = acBenchmarkBuildTrace(*pTimeline, options, branchNames);
+
+    QVector<qint64> loadSamples(1, loadTimer.nsecsElapsed());
+    acBenchmarkReport("load", loadSamples, options);
+    acBenchmarkMessage(QString("trace: %1 branches, %2 %3 items, RSS after load: %4 MB").arg(branchNames.count()).arg(itemCount)
+                       .arg(options.m_bCompactItems ? "compact" : "object").arg(acBenchmarkCurrentRSS() / 1024.0, 0, 'f', 1));
+
+    QApplication::processEvents();
+
+    QImage frame(pTimeline->size(), QImage::Format_ARGB32_Premultiplied);
+    std::mt19937_64 randomGenerator(options.m_nSeed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double maxZoom = acBenchmarkMaxZoom(*pTimeline, options);
+
+    // the first paint builds the item indices and the summary pyramids of the branches
+    QVector<qint64> firstPaintSamples(1, acBenchmarkRenderFrame(*pTimeline, frame));
+    acBenchmarkReport("first paint", firstPaintSamples, options);
+
+    if (options.isScenarioSelected("paint"))
+    {
+        QVector<qint64> paintSamples;
+
+        for (int i = 0; i < options.m_nIterations; ++i)
+        {
+            paintSamples.append(acBenchmarkRenderFrame(*pTimeline, frame));
+        }
+
+        acBenchmarkReport("paint (full range)", paintSamples, options);
+    }
+
+    if (options.isScenarioSelected("zoom"))
+    {
+        QVector<qint64> zoomInSamples;
+        QVector<qint64> zoomOutSamples;
+        QElapsedTimer operationTimer;
+
+        for (int i = 0; i < options.m_nIterations; ++i)
+        {
+            pTimeline->setPivot(unit(randomGenerator));
+
+            for (double zoomFactor = AC_BENCHMARK_ZOOM_STEP; zoomFactor <= maxZoom; zoomFactor *= AC_BENCHMARK_ZOOM_STEP)
+            {
+                operationTimer.start();
+                pTimeline->setZoomFactor(zoomFactor);
+                zoomInSamples.append(operationTimer.nsecsElapsed() + acBenchmarkRenderFrame(*pTimeline, frame));
+            }
+
+            for (double zoomFactor = pTimeline->zoomFactor() / AC_BENCHMARK_ZOOM_STEP; zoomFactor >= 1.0; zoomFactor /= AC_BENCHMARK_ZOOM_STEP)
+            {
+                operationTimer.start();
+                pTimeline->setZoomFactor(zoomFactor);
+                zoomOutSamples.append(operationTimer.nsecsElapsed() + acBenchmarkRenderFrame(*pTimeline, frame));
+            }
+
+            pTimeline->setZoomFactor(1.0);
+            QApplication::processEvents();
+        }
+
+        acBenchmarkReport("zoom in", zoomInSamples, options);
+        acBenchmarkReport("zoom out", zoomOutSamples, options);
+    }
+
+    if (options.isScenarioSelected("pan"))
+    {
+        QVector<qint64> panSamples;
+        QElapsedTimer operationTimer;
+
+        pTimeline->setPivot(0.0);
+        pTimeline->setZoomFactor(qMin(AC_BENCHMARK_DETAIL_ZOOM, maxZoom));
+        acBenchmarkRenderFrame(*pTimeline, frame);
+
+        qint64 panStep = qMax(pTimeline->rowWidth() / 4, 1);
+
+        while (panSamples.count() < options.m_nIterations)
+        {
+            qint64 newOffset = pTimeline->offset() + panStep;
+
+            if (newOffset + pTimeline->rowWidth() > (qint64)pTimeline->renderWidth())
+            {
+                // start over at the beginning of the trace
+                pTimeline->setOffset(0);
+                acBenchmarkRenderFrame(*pTimeline, frame);
+                continue;
+            }
+
+            operationTimer.start();
+            pTimeline->setOffset(newOffset);
+            panSamples.append(operationTimer.nsecsElapsed() + acBenchmarkRenderFrame(*pTimeline, frame));
+            QApplication::processEvents();
+        }
+
+        acBenchmarkReport("pan", panSamples, options);
+    }
+
+    if (options.isScenarioSelected("hover"))
+    {
+        QVector<qint64> hitTestSamples;
+        QVector<qint64> hoverSamples;
+        QElapsedTimer operationTimer;
+
+        pTimeline->setZoomFactor(1.0);
+        pTimeline->setPivot(unit(randomGenerator));
+        pTimeline->setZoomFactor(qMin(AC_BENCHMARK_DETAIL_ZOOM, maxZoom));
+        acBenchmarkRenderFrame(*pTimeline, frame);
+
+        int rowsTop = pTimeline->timelineSectionTopSpace();
+        int rowsHeight = qMin(pTimeline->cumulativeBranchHeight(), pTimeline->height() - rowsTop);
+
+        for (int i = 0; i < options.m_nIterations; ++i)
+        {
+            QPoint mousePos(pTimeline->titleWidth() + (int)(unit(randomGenerator) * pTimeline->rowWidth()), rowsTop + (int)(unit(randomGenerator) * rowsHeight));
+
+            operationTimer.start();
+            pTimeline->getTimelineItem(mousePos.x(), mousePos.y());
+            hitTestSamples.append(operationTimer.nsecsElapsed());
+
+            // the mouse move drops the pending tooltip, and the paint outlines the hovered item
+            QMouseEvent mouseMoveEvent(QEvent::MouseMove, mousePos, Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+            operationTimer.start();
+            QApplication::sendEvent(pTimeline, &mouseMoveEvent);
+            hoverSamples.append(operationTimer.nsecsElapsed() + acBenchmarkRenderFrame(*pTimeline, frame));
+            QApplication::processEvents();
+        }
+
+        acBenchmarkReport("hit test", hitTestSamples, options);
+        acBenchmarkReport("hover", hoverSamples, options);
+    }
+
+    if (options.isScenarioSelected("fold"))
+    {
+        QVector<qint64> foldSamples;
+        QElapsedTimer operationTimer;
+        QList<acTimelineBranch*> parentBranches;
+
+        for (QList<acTimelineBranch*>::const_iterator i = pTimeline->GetBranches().begin(); i != pTimeline->GetBranches().end(); ++i)
+        {
+            acBenchmarkCollectParentBranches(*i, parentBranches);
+        }
+
+        pTimeline->setZoomFactor(1.0);
+
+        for (int i = 0; i < options.m_nIterations && !parentBranches.isEmpty(); ++i)
+        {
+            acTimelineBranch* pBranch = parentBranches[(int)(randomGenerator() % parentBranches.count())];
+
+            operationTimer.start();
+            pBranch->setFolded(!pBranch->isFolded());
+            foldSamples.append(operationTimer.nsecsElapsed() + acBenchmarkRenderFrame(*pTimeline, frame));
+            QApplication::processEvents();
+        }
+
+        for (QList<acTimelineBranch*>::const_iterator i = parentBranches.begin(); i != parentBranches.end(); ++i)
+        {
+            (*i)->setFolded(false);
+        }
+
+        acBenchmarkReport("fold/unfold", foldSamples, options);
+    }
+
+    if (options.isScenarioSelected("search") && !branchNames.isEmpty())
+    {
+        QVector<qint64> exactSamples;
+        QVector<qint64> partialSamples;
+        QVector<qint64> missSamples;
+        QElapsedTimer operationTimer;
+        int missingBranchCount = 0;
+
+        for (int i = 0; i < options.m_nIterations; ++i)
+        {
+            const QString& branchName = branchNames[(int)(randomGenerator() % branchNames.count())];
+
+            operationTimer.start();
+            const acTimelineBranch* pBranch = pTimeline->getBranchFromText(branchName, false);
+            exactSamples.append(operationTimer.nsecsElapsed());
+
+            if (pBranch == nullptr)
+            {
+                missingBranchCount++;
+            }
+
+            // the branch index part of the text (for example "3.1" of "Thread 3.1"), which several branches contain
+            QString partialText = branchName.mid(branchName.indexOf(' ') + 1);
+            operationTimer.start();
+            pTimeline->getBranchFromText(partialText, true);
+            partialSamples.append(operationTimer.nsecsElapsed());
+
+            // a text no branch has, which visits all the branches
+            operationTimer.start();
+            pTimeline->getBranchFromText(branchName + "#", false);
+            missSamples.append(operationTimer.nsecsElapsed());
+        }
+
+        acBenchmarkReport("search branch (exact)", exactSamples, options);
+        acBenchmarkReport("search branch (partial)", partialSamples, options);
+        acBenchmarkReport("search branch (not found)", missSamples, options);
+
+        if (missingBranchCount > 0)
+        {
+            acBenchmarkMessage(QString("error: %1 searched branches were not found").arg(missingBranchCount));
+        }
+    }
+
+    if (options.isScenarioSelected("batched"))
+    {
+        pTimeline->setFrameStatsEnabled(true);
+        pTimeline->setZoomFactor(1.0);
+        pTimeline->setPivot(0.5);
+
+        // the solid mode is where a bucket of items is painted by a single drawRects call.  Gradient and rounded backgrounds
+        // are still filled one by one, only without the painter state changes
+        for (int styleIndex = 0; styleIndex < 2; ++styleIndex)
+        {
+            bool isGradient = (styleIndex == 0);
+            pTimeline->setGradientPainting(isGradient);
+            pTimeline->setRoundedRectangles(isGradient);
+
+            for (double zoomFactor = 1.0; zoomFactor <= maxZoom; zoomFactor *= AC_BENCHMARK_BATCHED_ZOOM_STEP)
+            {
+                pTimeline->setZoomFactor(zoomFactor);
+
+                for (int batchedIndex = 0; batchedIndex < 2; ++batchedIndex)
+                {
+                    bool isBatched = (batchedIndex == 1);
+                    QVector<qint64> paintSamples;
+
+                    pTimeline->setBatchedPainting(isBatched);
+                    acBenchmarkRenderFrame(*pTimeline, frame);
+
+                    for (int i = 0; i < options.m_nIterations; ++i)
+                    {
+                        paintSamples.append(acBenchmarkRenderFrame(*pTimeline, frame));
+                    }
+
+                    acBenchmarkReport(QString("paint %1, %2 (zoom %3)").arg(isBatched ? "batched" : "unbatched").arg(isGradient ? "gradient" : "solid")
+                                      .arg(zoomFactor), paintSamples, options);
+                }
+
+                acBenchmarkMessage(QString("  %1 items drawn per frame").arg(pTimeline->lastFrameStats().m_nItemsDrawn));
+            }
+        }
+
+        pTimeline->setBatchedPainting(false);
+        pTimeline->setGradientPainting(true);
+        pTimeline->setRoundedRectangles(true);
+        pTimeline->setFrameStatsEnabled(false);
+    }
+
+    delete pTimeline;
+}
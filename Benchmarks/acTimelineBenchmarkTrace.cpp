@@ -0,0 +1,220 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineBenchmarkTrace.cpp
+///
+//==================================================================================
+
+//------------------------------ acTimelineBenchmarkTrace.cpp ------------------------------
+
+// Qt:
+#include <QColor>
+#include <QList>
+
+// C++:
+#include <math.h>
+#include <new>
+#include <random>
+
+// Local:
+#include <Benchmarks/acTimelineBenchmark.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+
+/// The number of distinct item texts (and colors) of the synthetic traces, as in a trace of a few dozen API calls or kernels.
+#define AC_BENCHMARK_ITEM_TEXT_COUNT 32
+
+/// The shape parameter of the Pareto durations.  Below 2, the variance is unbounded.
+#define AC_BENCHMARK_PARETO_SHAPE 1.5
+
+/// The longest Pareto duration, in mean durations, so that a single item does not span the whole trace.
+#define AC_BENCHMARK_PARETO_MAX_DURATIONS 10000.0
+
+/// The state of the synthetic trace generation.
+struct acBenchmarkTraceState
+{
+    const acTimelineBenchmarkOptions&       m_options;          ///< The shape of the trace.
+    std::mt19937_64                         m_random;           ///< The generator of the item times.
+    std::uniform_real_distribution<double>  m_unit;             ///< Uniform values in [0, 1).
+    QStringList                             m_itemTexts;        ///< The item texts.
+    QList<QColor>                           m_itemColors;       ///< The item colors, one per item text.
+    int                                     m_nItemsPerBranch;  ///< The number of items of every branch.
+    int                                     m_nExtraItems;      ///< The number of branches (the first ones created) which get another item.
+    int                                     m_nItemCount;       ///< The number of items added so far.
+
+    acBenchmarkTraceState(const acTimelineBenchmarkOptions& options) :
+        m_options(options), m_random(options.m_nSeed), m_unit(0.0, 1.0), m_nItemsPerBranch(0), m_nExtraItems(0), m_nItemCount(0) {}
+
+    /// Draws an item duration from the distribution of the options.
+    /// \return the duration, at least 1.
+    quint64 nextDuration();
+};
+
+quint64 acBenchmarkTraceState::nextDuration()
+{
+    double meanDuration = (double)m_options.m_nMeanDuration;
+    double unitValue = m_unit(m_random);
+    double duration = meanDuration;
+
+    switch (m_options.m_durations)
+    {
+        case AC_BENCHMARK_DURATIONS_UNIFORM:
+            duration = 2.0 * meanDuration * unitValue;
+            break;
+
+        case AC_BENCHMARK_DURATIONS_EXPONENTIAL:
+            duration = -meanDuration * log(1.0 - unitValue);
+            break;
+
+        case AC_BENCHMARK_DURATIONS_PARETO:
+        {
+            // the scale which gives the requested mean
+            double scale = meanDuration * (AC_BENCHMARK_PARETO_SHAPE - 1.0) / AC_BENCHMARK_PARETO_SHAPE;
+            duration = qMin(scale / pow(1.0 - unitValue, 1.0 / AC_BENCHMARK_PARETO_SHAPE), meanDuration * AC_BENCHMARK_PARETO_MAX_DURATIONS);
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return (quint64)duration + 1;
+}
+
+/// Adds the items of a branch.  The items are generated in start time order, as a trace loader adds them.
+/// \param pBranch the branch.
+/// \param itemCount the number of items to add.
+/// \param state the trace generation state.
+static void acBenchmarkAddBranchItems(acTimelineBranch* pBranch, int itemCount, acBenchmarkTraceState& state)
+{
+    const acTimelineBenchmarkOptions& options = state.m_options;
+    QList<acTimelineItem*> items;
+
+    if (!options.m_bCompactItems)
+    {
+        items.reserve(itemCount);
+    }
+
+    quint64 startTime = 0;
+    quint64 endTime = 0;
+
+    for (int i = 0; i < itemCount; ++i)
+    {
+        if (i > 0 && state.m_unit(state.m_random) < options.m_dOverlap)
+        {
+            // starts before the previous item ends
+            startTime += (quint64)(state.m_unit(state.m_random) * (endTime - startTime));
+        }
+        else
+        {
+            // starts after a gap of up to the mean duration
+            startTime = endTime + (quint64)(state.m_unit(state.m_random) * options.m_nMeanDuration);
+        }
+
+        endTime = startTime + state.nextDuration();
+
+        int textIndex = (int)(state.m_random() % AC_BENCHMARK_ITEM_TEXT_COUNT);
+
+        if (options.m_bCompactItems)
+        {
+            pBranch->addCompactItem(startTime, endTime, state.m_itemColors[textIndex], state.m_itemTexts[textIndex]);
+        }
+        else
+        {
+            acTimelineItem* pItem = new(std::nothrow) acTimelineItem(startTime, endTime);
+            Q_ASSERT(pItem != nullptr);
+
+            if (pItem != nullptr)
+            {
+                pItem->setBackgroundColor(state.m_itemColors[textIndex]);
+                pItem->setText(state.m_itemTexts[textIndex]);
+                items.append(pItem);
+            }
+        }
+    }
+
+    if (!items.isEmpty())
+    {
+        pBranch->addTimelineItems(items);
+    }
+
+    state.m_nItemCount += itemCount;
+}
+
+/// Creates a branch with its items, and its sub branches down to the depth of the options.
+/// \param text the text of the branch.
+/// \param level the nesting level of the branch (0 for a top level branch).
+/// \param state the trace generation state.
+/// \param branchNames the texts of the branches created so far.
+/// \return the branch, or NULL if it could not be allocated.
+static acTimelineBranch* acBenchmarkCreateBranch(const QString& text, int level, acBenchmarkTraceState& state, QStringList& branchNames)
+{
+    acTimelineBranch* pBranch = new(std::nothrow) acTimelineBranch;
+    Q_ASSERT(pBranch != nullptr);
+
+    if (pBranch != nullptr)
+    {
+        pBranch->setText(text);
+
+        int itemCount = state.m_nItemsPerBranch;
+
+        if (branchNames.count() < state.m_nExtraItems)
+        {
+            itemCount++;
+        }
+
+        branchNames.append(text);
+        acBenchmarkAddBranchItems(pBranch, itemCount, state);
+
+        if (level < state.m_options.m_nDepth)
+        {
+            for (int i = 0; i < state.m_options.m_nFanout; ++i)
+            {
+                acTimelineBranch* pSubBranch = acBenchmarkCreateBranch(QString("%1.%2").arg(text).arg(i), level + 1, state, branchNames);
+
+                if (pSubBranch != nullptr)
+                {
+                    pBranch->addSubBranch(pSubBranch);
+                }
+            }
+        }
+    }
+
+    return pBranch;
+}
+
+int acBenchmarkBuildTrace(acTimeline& timeline, const acTimelineBenchmarkOptions& options, QStringList& branchNames)
+{
+    acBenchmarkTraceState state(options);
+
+    for (int i = 0; i < AC_BENCHMARK_ITEM_TEXT_COUNT; ++i)
+    {
+        state.m_itemTexts.append(QString("kernel_%1").arg(i));
+        state.m_itemColors.append(QColor::fromHsv(i * 360 / AC_BENCHMARK_ITEM_TEXT_COUNT, 160, 220));
+    }
+
+    // every top level branch has fanout^level branches at each level below it
+    int branchCount = 0;
+
+    for (int level = 0, levelBranchCount = options.m_nBranchCount; level <= options.m_nDepth; ++level, levelBranchCount *= options.m_nFanout)
+    {
+        branchCount += levelBranchCount;
+    }
+
+    state.m_nItemsPerBranch = options.m_nItemCount / branchCount;
+    state.m_nExtraItems = options.m_nItemCount % branchCount;
+
+    for (int i = 0; i < options.m_nBranchCount; ++i)
+    {
+        acTimelineBranch* pBranch = acBenchmarkCreateBranch(QString("Thread %1").arg(i), 0, state, branchNames);
+
+        if (pBranch != nullptr)
+        {
+            timeline.addBranch(pBranch);
+        }
+    }
+
+    return state.m_nItemCount;
+}
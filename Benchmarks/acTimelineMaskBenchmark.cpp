@@ -0,0 +1,368 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineMaskBenchmark.cpp
+///
+//==================================================================================
+
+//------------------------------ acTimelineMaskBenchmark.cpp ------------------------------
+
+// Qt:
+#include <QApplication>
+#include <QColor>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QRect>
+
+// C++:
+#include <math.h>
+#include <new>
+#include <random>
+#include <string.h>
+
+// Local:
+#include <Benchmarks/acTimelineBenchmark.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+
+/// The zoom factor multiplier between the measured zoom levels.
+#define AC_BENCHMARK_MASK_ZOOM_STEP 16.0
+
+/// The mean duration of the items of the painted branch, in time units.
+#define AC_BENCHMARK_MASK_MEAN_DURATION 1000.0
+
+/// The fraction of the items of the painted branch which start before the previous item ends.
+#define AC_BENCHMARK_MASK_OVERLAP 0.2
+
+/// The number of distinct item texts and colors of the painted branch.
+#define AC_BENCHMARK_MASK_TEXT_COUNT 32
+
+/// The mask buffer as it was before the flat mask rows: a map from the item height to a map from the item top to the pixels of
+/// the lane, which are allocated again on every reset.  Kept to compare the flat mask rows against.
+class acBenchmarkQMapMaskBuffer
+{
+public:
+    acBenchmarkQMapMaskBuffer() : m_nBufferWidth(0) {}
+    ~acBenchmarkQMapMaskBuffer() { freeRows(); }
+
+    /// Sets the mask for a timeline item (see acTimelineMaskBuffer::setMask).
+    bool setMask(int index, QRect rect)
+    {
+        if (index < 0 || index > m_nBufferWidth)
+        {
+            return false;
+        }
+
+        int mask = rect.width() << 1;
+        mask |= 0x1;
+        int rectHeight = rect.height();
+        int rectTop = rect.top();
+
+        if (!m_maskBuffer.contains(rectHeight) || !m_maskBuffer[rectHeight].contains(rectTop))
+        {
+            QMap<int, int*> offsetMap;
+            offsetMap[rectTop] = new(std::nothrow) int[m_nBufferWidth];
+            Q_ASSERT(offsetMap[rectTop] != nullptr);
+
+            if (offsetMap[rectTop] == nullptr)
+            {
+                return false;
+            }
+
+            memset(offsetMap[rectTop], 0, m_nBufferWidth * sizeof(int));
+
+            m_maskBuffer[rectHeight] = offsetMap;
+        }
+
+        m_maskBuffer[rectHeight][rectTop][index] = mask;
+        return true;
+    }
+
+    /// Checks the mask for a timeline item (see acTimelineMaskBuffer::checkMask).
+    bool checkMask(int index, QRect rect)
+    {
+        if (index < 0 || index > m_nBufferWidth)
+        {
+            return false;
+        }
+
+        int rectHeight = rect.height();
+        int rectTop = rect.top();
+
+        if (!m_maskBuffer.contains(rectHeight) || !m_maskBuffer[rectHeight].contains(rectTop) || m_maskBuffer[rectHeight][rectTop] == nullptr)
+        {
+            return false;
+        }
+
+        int mask = m_maskBuffer[rectHeight][rectTop][index];
+        bool isSet = (mask & 0x1) == 1;
+
+        if (isSet)
+        {
+            int setLen = mask >> 1;
+
+            if (setLen < rect.width())
+            {
+                isSet = false;
+            }
+        }
+
+        return isSet;
+    }
+
+    /// Frees the mask rows.  They are allocated again by the next setMask of each lane.
+    void resetMask(int rowWidth)
+    {
+        if (m_nBufferWidth < rowWidth)
+        {
+            m_nBufferWidth = rowWidth;
+        }
+
+        freeRows();
+        m_maskBuffer.clear();
+    }
+
+private:
+    /// Frees the pixels of all the lanes.
+    void freeRows()
+    {
+        for (QMap<int, QMap<int, int*> >::iterator i = m_maskBuffer.begin(); i != m_maskBuffer.end(); ++i)
+        {
+            for (QMap<int, int*>::iterator j = i.value().begin(); j != i.value().end(); ++j)
+            {
+                delete[] j.value();
+                j.value() = nullptr;
+            }
+
+            i.value().clear();
+        }
+    }
+
+    int m_nBufferWidth;                         ///< the width of the buffer.
+    QMap<int, QMap<int, int*> > m_maskBuffer;   ///< the mask buffer -- maps from a height to a map that maps from an offset to a list of pixels.
+};
+
+/// Adds the items of the painted branch, in start time order: exponential durations, and a fraction of the items overlapping
+/// the previous one, so that the small items under a long one are masked.
+/// \param pBranch the branch.
+/// \param options the run options, holding the item count, the item store and the seed.
+/// \param itemTimes filled with the start and end times of the items.
+static void acBenchmarkAddMaskBranchItems(acTimelineBranch* pBranch, const acTimelineBenchmarkOptions& options, QVector<QPair<quint64, quint64> >& itemTimes)
+{
+    std::mt19937_64 random(options.m_nSeed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    QList<QColor> colors;
+    QList<acTimelineItem*> items;
+    quint64 startTime = 0;
+    quint64 endTime = 0;
+
+    for (int i = 0; i < AC_BENCHMARK_MASK_TEXT_COUNT; ++i)
+    {
+        colors.append(QColor::fromHsv(i * 360 / AC_BENCHMARK_MASK_TEXT_COUNT, 160, 220));
+    }
+
+    itemTimes.clear();
+    itemTimes.reserve(options.m_nMaskItemCount);
+
+    for (int i = 0; i < options.m_nMaskItemCount; ++i)
+    {
+        if (i > 0 && unit(random) < AC_BENCHMARK_MASK_OVERLAP)
+        {
+            startTime += (quint64)(unit(random) * (endTime - startTime));
+        }
+        else
+        {
+            startTime = endTime + (quint64)(unit(random) * AC_BENCHMARK_MASK_MEAN_DURATION);
+        }
+
+        endTime = startTime + (quint64)(-AC_BENCHMARK_MASK_MEAN_DURATION * log(1.0 - unit(random))) + 1;
+        itemTimes.append(qMakePair(startTime, endTime));
+
+        int textIndex = i % AC_BENCHMARK_MASK_TEXT_COUNT;
+
+        if (options.m_bCompactItems)
+        {
+            pBranch->addCompactItem(startTime, endTime, colors[textIndex], QString("kernel_%1").arg(textIndex));
+        }
+        else
+        {
+            acTimelineItem* pItem = new(std::nothrow) acTimelineItem(startTime, endTime);
+            Q_ASSERT(pItem != nullptr);
+
+            if (pItem != nullptr)
+            {
+                pItem->setBackgroundColor(colors[textIndex]);
+                pItem->setText(QString("kernel_%1").arg(textIndex));
+                items.append(pItem);
+            }
+        }
+    }
+
+    if (!items.isEmpty())
+    {
+        pBranch->addTimelineItems(items);
+    }
+}
+
+/// The mask operation of a visible item.
+struct acBenchmarkMaskOperation
+{
+    int   m_nIndex;        ///< The mask index of the item.
+    QRect m_rect;          ///< The untrimmed rectangle of the item.
+    bool  m_bCanBeMasked;  ///< Flag indicating whether or not the item may be masked (false for the items crossing a tile edge, which only set the mask).
+};
+
+/// The mask operations of a paint pass, in painting order.
+typedef QVector<acBenchmarkMaskOperation> acBenchmarkMaskOperations;
+
+/// Computes the mask operations of a branch, as acTimelineItem::CalculateItemRect and CheckParentBranchMask compute them when the
+/// items are painted one by one.
+/// \param timeline the timeline, at the zoom level to compute the operations for.
+/// \param itemTimes the start and end times of the items of the branch, in start time order.
+/// \param branchRowTop the top of the branch row.
+/// \param branchHeight the height of the branch row.
+/// \param operations filled with the mask operations.
+static void acBenchmarkComputeMaskOperations(acTimeline& timeline, const QVector<QPair<quint64, quint64> >& itemTimes, int branchRowTop, int branchHeight,
+                                             acBenchmarkMaskOperations& operations)
+{
+    const acTimelineTimeTransform& timeTransform = timeline.timeTransform();
+    quint64 visibleStartTime = timeline.visibleStartTime();
+    quint64 visibleEndTime = visibleStartTime + timeline.visibleRange();
+    int titleWidth = timeline.titleWidth();
+    acTimelineRowView view = timeline.rowView();
+
+    operations.clear();
+
+    for (QVector<QPair<quint64, quint64> >::const_iterator i = itemTimes.begin(); i != itemTimes.end(); ++i)
+    {
+        if ((*i).second < visibleStartTime || (*i).first > visibleEndTime)
+        {
+            continue;
+        }
+
+        double dblWidth = timeTransform.durationToWidth((*i).second - (*i).first);
+        int itemWidth = (dblWidth > 1) ? (int)qMin(dblWidth, (double)AC_TIMELINE_MAX_PIXEL_COORD) : 1;
+        int itemX = titleWidth + timeTransform.timeToColumn((*i).first);
+
+        // the items are masked by their untrimmed geometry, and the items starting out of the mask are neither masked nor masking
+        int maskIndex = itemX - view.m_nMaskLeft;
+
+        if (itemX + itemWidth <= titleWidth || itemX >= titleWidth + view.m_nWidth || maskIndex < 0 || maskIndex >= view.maskWidth())
+        {
+            continue;
+        }
+
+        acBenchmarkMaskOperation operation;
+        operation.m_nIndex = maskIndex;
+        operation.m_rect = QRect(itemX, branchRowTop + 1, itemWidth, branchHeight - 2);
+        operation.m_bCanBeMasked = (maskIndex % AC_TIMELINE_TILE_WIDTH) + itemWidth <= AC_TIMELINE_TILE_WIDTH;
+        operations.append(operation);
+    }
+}
+
+/// Replays the mask operations of a paint pass on a mask buffer.
+/// \param mask the mask buffer.
+/// \param maskWidth the width of the mask (see acTimelineRowView::maskWidth).
+/// \param operations the mask operations.
+/// \param maskRejects set to the number of items the mask rejected.
+/// \return the time it took, in nanoseconds.
+template <class MaskBuffer>
+static qint64 acBenchmarkReplayMaskOperations(MaskBuffer& mask, int maskWidth, const acBenchmarkMaskOperations& operations, int& maskRejects)
+{
+    QElapsedTimer maskTimer;
+    maskTimer.start();
+
+    maskRejects = 0;
+    mask.resetMask(maskWidth);
+
+    for (acBenchmarkMaskOperations::const_iterator i = operations.begin(); i != operations.end(); ++i)
+    {
+        if ((*i).m_bCanBeMasked && mask.checkMask((*i).m_nIndex, (*i).m_rect))
+        {
+            maskRejects++;
+        }
+        else
+        {
+            mask.setMask((*i).m_nIndex, (*i).m_rect);
+        }
+    }
+
+    return maskTimer.nsecsElapsed();
+}
+
+void acBenchmarkMask(const acTimelineBenchmarkOptions& options)
+{
+    acTimeline* pTimeline = new(std::nothrow) acTimeline(nullptr);
+    Q_ASSERT(pTimeline != nullptr);
+
+    if (pTimeline == nullptr)
+    {
+        return;
+    }
+
+    pTimeline->resize(options.m_nWidth, options.m_nHeight);
+    pTimeline->show();
+    QApplication::processEvents();
+
+    // a single branch holding all the items
+    acTimelineBranch* pBranch = new(std::nothrow) acTimelineBranch;
+    Q_ASSERT(pBranch != nullptr);
+
+    if (pBranch != nullptr)
+    {
+        QVector<QPair<quint64, quint64> > itemTimes;
+        pBranch->setText("Mask");
+        acBenchmarkAddMaskBranchItems(pBranch, options, itemTimes);
+        pTimeline->addBranch(pBranch);
+
+        acBenchmarkMessage(QString("mask: one branch of %1 items").arg(itemTimes.count()));
+
+        QImage frame(pTimeline->size(), QImage::Format_ARGB32_Premultiplied);
+        acBenchmarkQMapMaskBuffer qmapMask;
+        acTimelineMaskBuffer flatMask;
+        acBenchmarkMaskOperations operations;
+        double maxZoom = qMax(pTimeline->fullRange() / (AC_BENCHMARK_MASK_MEAN_DURATION * 8.0), 1.0);
+
+        pTimeline->setPivot(0.5);
+
+        for (double zoomFactor = 1.0; zoomFactor <= maxZoom; zoomFactor *= AC_BENCHMARK_MASK_ZOOM_STEP)
+        {
+            pTimeline->setZoomFactor(zoomFactor);
+            QVector<qint64> paintSamples;
+
+            for (int i = 0; i < options.m_nIterations; ++i)
+            {
+                paintSamples.append(acBenchmarkRenderFrame(*pTimeline, frame));
+            }
+
+            // the masked items of a paint pass, as the items painted one by one mask them.  At low zoom levels the paint
+            // draws aggregated bars for most of the items instead, so the replay is the cost of the per item paint path
+            acBenchmarkComputeMaskOperations(*pTimeline, itemTimes, pBranch->top(), pBranch->height(), operations);
+
+            QVector<qint64> qmapSamples;
+            QVector<qint64> flatSamples;
+            int qmapRejects = 0;
+            int flatRejects = 0;
+
+            int maskWidth = pTimeline->rowView().maskWidth();
+
+            for (int i = 0; i < options.m_nIterations; ++i)
+            {
+                qmapSamples.append(acBenchmarkReplayMaskOperations(qmapMask, maskWidth, operations, qmapRejects));
+                flatSamples.append(acBenchmarkReplayMaskOperations(flatMask, maskWidth, operations, flatRejects));
+            }
+
+            acBenchmarkMessage(QString("mask at zoom %1: %2 visible items, %3 rejected by the QMap mask, %4 rejected by the flat mask")
+                               .arg(zoomFactor).arg(operations.count()).arg(qmapRejects).arg(flatRejects));
+            acBenchmarkReport(QString("paint, mask on (zoom %1)").arg(zoomFactor), paintSamples, options);
+            acBenchmarkReport(QString("mask per frame, QMap (zoom %1)").arg(zoomFactor), qmapSamples, options);
+            acBenchmarkReport(QString("mask per frame, flat (zoom %1)").arg(zoomFactor), flatSamples, options);
+        }
+    }
+
+    delete pTimeline;
+}
@@ -0,0 +1,195 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineMemoryBenchmark.cpp
+///
+//==================================================================================
+
+//------------------------------ acTimelineMemoryBenchmark.cpp ------------------------------
+
+// Qt:
+#include <QApplication>
+#include <QByteArray>
+#include <QColor>
+#include <QElapsedTimer>
+#include <QList>
+#include <QProcess>
+
+// C++:
+#include <new>
+#include <stdio.h>
+#include <string.h>
+
+// Local:
+#include <Benchmarks/acTimelineBenchmark.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+
+/// The number of distinct item texts and colors of the measured items.
+#define AC_BENCHMARK_MEMORY_TEXT_COUNT 32
+
+/// The prefix of the result line printed by the measuring process.
+#define AC_BENCHMARK_MEMORY_RESULT_PREFIX "item store memory:"
+
+/// The longest time a measuring process may run, in milliseconds.
+#define AC_BENCHMARK_MEMORY_PROCESS_TIMEOUT (30 * 60 * 1000)
+
+int acBenchmarkItemStoreMemoryProcess(const QString& store, int itemCount)
+{
+    bool isCompactStore = (store == "compact");
+
+    if (!isCompactStore && store != "objects")
+    {
+        return 2;
+    }
+
+    acTimelineBranch* pBranch = new(std::nothrow) acTimelineBranch;
+    Q_ASSERT(pBranch != nullptr);
+
+    if (pBranch == nullptr)
+    {
+        return 1;
+    }
+
+    QList<QColor> colors;
+
+    for (int i = 0; i < AC_BENCHMARK_MEMORY_TEXT_COUNT; ++i)
+    {
+        colors.append(QColor::fromHsv(i * 360 / AC_BENCHMARK_MEMORY_TEXT_COUNT, 160, 220));
+    }
+
+    qint64 rssBefore = acBenchmarkCurrentRSS();
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+
+    // the item texts are built for every item, as a trace loader builds them from the trace records
+    if (isCompactStore)
+    {
+        for (int i = 0; i < itemCount; ++i)
+        {
+            quint64 startTime = (quint64)i * 10;
+            int textIndex = i % AC_BENCHMARK_MEMORY_TEXT_COUNT;
+            pBranch->addCompactItem(startTime, startTime + 8, colors[textIndex], QString("kernel_%1").arg(textIndex));
+        }
+    }
+    else
+    {
+        QList<acTimelineItem*> items;
+        items.reserve(itemCount);
+
+        for (int i = 0; i < itemCount; ++i)
+        {
+            quint64 startTime = (quint64)i * 10;
+            int textIndex = i % AC_BENCHMARK_MEMORY_TEXT_COUNT;
+            acTimelineItem* pItem = new(std::nothrow) acTimelineItem(startTime, startTime + 8);
+            Q_ASSERT(pItem != nullptr);
+
+            if (pItem == nullptr)
+            {
+                break;
+            }
+
+            pItem->setBackgroundColor(colors[textIndex]);
+            pItem->setText(QString("kernel_%1").arg(textIndex));
+            items.append(pItem);
+        }
+
+        pBranch->addTimelineItems(items);
+    }
+
+    qint64 loadNs = loadTimer.nsecsElapsed();
+    qint64 rssAfter = acBenchmarkCurrentRSS();
+
+    printf(AC_BENCHMARK_MEMORY_RESULT_PREFIX " %lld %lld %lld\n", (long long)(rssAfter - rssBefore), (long long)loadNs, (long long)acBenchmarkPeakRSS());
+    fflush(stdout);
+
+    // the process exits right away, so the items are not freed one by one
+    return 0;
+}
+
+/// Measures the memory of a branch holding the specified items, in a separate process, so that the memory freed by the previous
+/// measurement (which the allocator keeps) is not reused.
+/// \param store the item store: "objects" or "compact".
+/// \param itemCount the number of items.
+/// \param rssKB set to the resident memory added by the items, in kilobytes.
+/// \param loadNs set to the time it took to add the items, in nanoseconds.
+/// \param peakRssKB set to the peak resident set size of the measuring process, in kilobytes.
+/// \return true if the measurement succeeded.
+static bool acBenchmarkMeasureItemStore(const QString& store, int itemCount, qint64& rssKB, qint64& loadNs, qint64& peakRssKB)
+{
+    bool retVal = false;
+
+    QProcess measuringProcess;
+    measuringProcess.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    measuringProcess.start(QApplication::applicationFilePath(), QStringList() << "--store-memory" << store << QString::number(itemCount));
+
+    if (measuringProcess.waitForFinished(AC_BENCHMARK_MEMORY_PROCESS_TIMEOUT) && measuringProcess.exitStatus() == QProcess::NormalExit &&
+        measuringProcess.exitCode() == 0)
+    {
+        QList<QByteArray> lines = measuringProcess.readAllStandardOutput().split('\n');
+
+        for (QList<QByteArray>::const_iterator i = lines.begin(); i != lines.end(); ++i)
+        {
+            if ((*i).startsWith(AC_BENCHMARK_MEMORY_RESULT_PREFIX))
+            {
+                QList<QByteArray> values = (*i).mid((int)strlen(AC_BENCHMARK_MEMORY_RESULT_PREFIX)).trimmed().split(' ');
+
+                if (values.count() == 3)
+                {
+                    rssKB = values[0].toLongLong();
+                    loadNs = values[1].toLongLong();
+                    peakRssKB = values[2].toLongLong();
+                    retVal = rssKB >= 0;
+                }
+            }
+        }
+    }
+    else
+    {
+        // for example, killed when running out of memory
+        measuringProcess.kill();
+        measuringProcess.waitForFinished();
+    }
+
+    return retVal;
+}
+
+void acBenchmarkItemStoreMemory(const acTimelineBenchmarkOptions& options)
+{
+    if (acBenchmarkCurrentRSS() < 0)
+    {
+        acBenchmarkMessage("item store memory: the resident set size is not available on this platform");
+        return;
+    }
+
+    for (QList<int>::const_iterator i = options.m_memoryItemCounts.begin(); i != options.m_memoryItemCounts.end(); ++i)
+    {
+        int itemCount = *i;
+        qint64 storeRssKB[2] = { 0, 0 };
+        const char* stores[2] = { "objects", "compact" };
+
+        for (int storeIndex = 0; storeIndex < 2; ++storeIndex)
+        {
+            qint64 rssKB = 0, loadNs = 0, peakRssKB = 0;
+
+            if (acBenchmarkMeasureItemStore(stores[storeIndex], itemCount, rssKB, loadNs, peakRssKB))
+            {
+                storeRssKB[storeIndex] = rssKB;
+                acBenchmarkMessage(QString("item store memory (%1, %2 items): %3 MB (%4 bytes per item), load %5 ms, peak RSS %6 MB")
+                                   .arg(stores[storeIndex]).arg(itemCount).arg(rssKB / 1024.0, 0, 'f', 1).arg(rssKB * 1024.0 / qMax(itemCount, 1), 0, 'f', 1)
+                                   .arg(loadNs / 1.0e6, 0, 'f', 1).arg(peakRssKB / 1024.0, 0, 'f', 1));
+            }
+            else
+            {
+                acBenchmarkMessage(QString("item store memory (%1, %2 items): the measurement failed").arg(stores[storeIndex]).arg(itemCount));
+            }
+        }
+
+        if (storeRssKB[0] > 0 && storeRssKB[1] > 0)
+        {
+            acBenchmarkMessage(QString("item store memory (%1 items): the compact store takes %2 times less memory")
+                               .arg(itemCount).arg(storeRssKB[0] / (double)storeRssKB[1], 0, 'f', 1));
+        }
+    }
+}
@@ -11,14 +11,31 @@
 
 // Qt:
 #include <QScrollBar>
+#include <QTimer>
 
 // Local:
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineGrid.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineFrameStats.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemBatch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineLabelCache.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineRangeStats.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineRowLayout.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTileCache.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTileRenderer.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTimeTransform.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineToolTipBuilder.h>
 
 /// Constant for the horizontal space used to draw the tree marks (plus/minus box used to expand collapse a row).
 static const int ACTIMELINE_TreeMarkSpace = 12;
+
+/// In streaming mode, when the whole timeline is displayed, the full range grows by this fraction (one quarter) more than needed,
+/// so that the time scale changes once per such growth rather than with every added item.
+static const int ACTIMELINE_StreamingRangeHeadroomDivisor = 4;
+
+/// The maximum number of items found by a text search of the timeline (see acTimeline::search).
+static const int ACTIMELINE_MaxSearchResults = 1 << 17;
 class QLabel;
 
 /// Timeline widget.
@@ -79,10 +96,21 @@ public:
     /// \return the start of the timeline.
     quint64 startTime() const { return m_nStartTime; }
 
-    /// Sets the full range of the timeline.
+    /// Sets the full range of the timeline.  In streaming mode, growing the full range of a zoomed in timeline keeps the visible range
+    /// (and follows the end of the timeline if it was visible) instead of zooming out.
     /// \param newFullRange the full range of the timeline.
     void setFullRange(const quint64 newFullRange);
 
+    /// Sets a flag indicating whether or not items are streamed into the timeline while it is displayed (for example, during a live session).
+    /// In streaming mode, added items only drop the tiles and summaries covering them, and the growth of the full range does not reset the
+    /// view, so that the cost of repainting is bounded by the newly added items rather than by the size of the session.
+    /// \param newStreamingMode a flag indicating whether or not items are streamed into the timeline.
+    void setStreamingMode(const bool newStreamingMode) { m_bStreamingMode = newStreamingMode; }
+
+    /// Gets a flag indicating whether or not items are streamed into the timeline while it is displayed.
+    /// \return a flag indicating whether or not items are streamed into the timeline while it is displayed.
+    bool isStreamingMode() const { return m_bStreamingMode; }
+
     /// Gets the full range of the timeline.
     /// \return the full range of the timeline.
     quint64 fullRange() const { return m_nFullRange; }
@@ -159,9 +187,36 @@ public:
     /// \return the height in pixels of all branches.
     int cumulativeBranchHeight();
 
+    /// Gets the vertical layout of the branch rows, laying out the rows first if branches were added since it was last laid out.
+    /// \return the vertical layout of the branch rows.
+    const acTimelineRowLayout& rowLayout() const { updateRowLayout(); return m_rowLayout; }
+
+    /// Lays out the branch rows (and assigns the row index of every branch) if branches were added in a way the layout could not be updated for.
+    void updateRowLayout() const;
+
+    /// Updates the row of the specified branch after its height, folded state or visibility changed.
+    /// \param branch the branch whose row should be updated.
+    void updateBranchRow(const acTimelineBranch* branch);
+
+    /// Assigns an id to a branch added to the timeline (directly or as a sub branch).  Called by acTimelineBranch::setParentTimeline.
+    /// \param branch the branch.
+    /// \return the id of the branch.
+    int registerBranch(acTimelineBranch* branch);
+
+    /// Gets the branch with the specified id.
+    /// \param id the id of the branch (see acTimelineBranch::id).
+    /// \return the branch with the id, or NULL if there is none.
+    acTimelineBranch* branchById(int id) const { return (id >= 0 && id < m_branchesById.count()) ? m_branchesById[id] : nullptr; }
+
+    /// Shows or hides branches.  Only the branches whose visibility changes are updated: their rows, the title width of their
+    /// parents and the tiles their items are painted on, so toggling a few of many branches does not lay out the whole timeline.
+    /// \param visibility the new visibility flag of the branches, by branch id.
+    /// \return the number of branches whose visibility changed.
+    int setBranchesVisibility(const QHash<int, bool>& visibility);
+
     /// Sets a flag indicating whether or not the timeline is painted with gradient colors.
     /// \param newGradientPainting a flag indicating whether or not the timeline is painted with gradient colors.
-    void setGradientPainting(const bool newGradientPainting) { m_bGradientPainting = newGradientPainting; }
+    void setGradientPainting(const bool newGradientPainting) { m_bGradientPainting = newGradientPainting; clearTileCache(); }
 
     /// Gets a flag indicating whether or not the timeline is painted with gradient colors.
     /// \return a flag indicating whether or not the timeline is painted with gradient colors.
@@ -169,12 +224,116 @@ public:
 
     /// Sets a flag indicating whether or not the timeline is painted with rounded rectangles.
     /// \param newRoundedRectangles a flag indicating whether or not the timeline is painted with rounded rectangles.
-    void setRoundedRectangles(const bool newRoundedRectangles) { m_bRoundedRectangles = newRoundedRectangles; }
+    void setRoundedRectangles(const bool newRoundedRectangles) { m_bRoundedRectangles = newRoundedRectangles; clearTileCache(); }
 
     /// Gets a flag indicating whether or not the timeline is painted with rounded rectangles.
     /// \return a flag indicating whether or not the timeline is painted with rounded rectangles.
     bool roundedRectangles() const { return m_bRoundedRectangles; }
 
+    /// Sets a flag indicating whether or not the items of a branch are painted in batches of the same color, rather than one by one.
+    /// Batching saves most of the painter state changes, but items of different colors which overlap may be painted in a different order.
+    /// \param newBatchedPainting a flag indicating whether or not the items of a branch are painted in batches of the same color.
+    void setBatchedPainting(const bool newBatchedPainting) { m_bBatchedPainting = newBatchedPainting; clearTileCache(); update(); }
+
+    /// Gets a flag indicating whether or not the items of a branch are painted in batches of the same color.
+    /// \return a flag indicating whether or not the items of a branch are painted in batches of the same color.
+    bool isBatchedPainting() const { return m_bBatchedPainting; }
+
+    /// Gets the batch the branches add their items to while painting.
+    /// \return the item batch, or NULL if the items are painted one by one.
+    acTimelineItemBatch* itemBatch() { return m_bBatchedPainting ? &m_itemBatch : nullptr; }
+
+    /// Gets the cache of the laid out item labels, which follows the font of the timeline.
+    /// \return the label cache.
+    acTimelineLabelCache& labelCache() { return m_labelCache; }
+
+    /// Sets a flag indicating whether or not the branch items are painted from a cache of pre-rendered tiles.
+    /// Tiles are rendered once per zoom level, so scrolling, hovering and selecting only blit cached tiles, render newly exposed tiles,
+    /// and repaint the selected and hovered items on top of them.  Item labels crossing a tile edge are centered within each tile.
+    /// \param newTileCacheEnabled a flag indicating whether or not the branch items are painted from a cache of pre-rendered tiles.
+    void setTileCacheEnabled(const bool newTileCacheEnabled);
+
+    /// Gets a flag indicating whether or not the branch items are painted from a cache of pre-rendered tiles.
+    /// \return a flag indicating whether or not the branch items are painted from a cache of pre-rendered tiles.
+    bool isTileCacheEnabled() const { return m_bTileCacheEnabled; }
+
+    /// Sets the memory budget of the tile cache.
+    /// \param budget the maximum number of bytes used by cached tiles.
+    void setTileCacheBudget(qint64 budget) { m_tileCache.setBudget(budget); }
+
+    /// Sets a flag indicating whether or not the tiles are rasterized on worker threads (only used when the tile cache is enabled).
+    /// Until the tiles of a new zoom level are rasterized, the tiles of the previous zoom level are drawn stretched as a preview.
+    /// \param newAsyncTileRendering a flag indicating whether or not the tiles are rasterized on worker threads.
+    void setAsyncTileRendering(const bool newAsyncTileRendering);
+
+    /// Gets a flag indicating whether or not the tiles are rasterized on worker threads.
+    /// \return a flag indicating whether or not the tiles are rasterized on worker threads.
+    bool isAsyncTileRendering() const { return m_bAsyncTileRendering; }
+
+    /// Gets the number of tiles being rasterized on the worker threads.
+    /// \return the number of tiles submitted to the worker threads which were not added to the tile cache (or cancelled) yet.
+    int pendingTileCount() const { return m_tileRenderer.pendingCount(); }
+
+    /// Drops all pre-rendered tiles.  Should be called when items change in a way the timeline is not notified about.
+    void clearTileCache() { m_tileCache.clear(); m_tileRenderer.cancel(); }
+
+    /// Drops the pre-rendered tiles of the specified branch.
+    /// \param branch the branch whose tiles should be dropped.
+    void invalidateTiles(const acTimelineBranch* branch) { m_tileCache.invalidateBranch(branch); m_tileRenderer.cancelBranch(branch); }
+
+    /// Drops the pre-rendered tiles of the specified branch which cover the specified time range.
+    /// \param branch the branch whose tiles should be dropped.
+    /// \param startTime the start of the time range.
+    /// \param endTime the end of the time range.
+    void invalidateTiles(const acTimelineBranch* branch, quint64 startTime, quint64 endTime);
+
+    /// Sets a flag indicating whether or not statistics are collected for each paint of the timeline.  Enabling the statistics clears the previously collected ones.
+    /// \param newFrameStatsEnabled a flag indicating whether or not statistics are collected for each paint of the timeline.
+    void setFrameStatsEnabled(const bool newFrameStatsEnabled);
+
+    /// Gets a flag indicating whether or not statistics are collected for each paint of the timeline.
+    /// \return a flag indicating whether or not statistics are collected for each paint of the timeline.
+    bool isFrameStatsEnabled() const { return m_bFrameStatsEnabled; }
+
+    /// Sets a flag indicating whether or not the statistics of the last paint are displayed over the timeline.  Only used when the statistics are enabled.
+    /// \param newFrameStatsHUDVisible a flag indicating whether or not the statistics of the last paint are displayed over the timeline.
+    void setFrameStatsHUDVisible(const bool newFrameStatsHUDVisible) { m_bFrameStatsHUDVisible = newFrameStatsHUDVisible; update(); }
+
+    /// Gets a flag indicating whether or not the statistics of the last paint are displayed over the timeline.
+    /// \return a flag indicating whether or not the statistics of the last paint are displayed over the timeline.
+    bool isFrameStatsHUDVisible() const { return m_bFrameStatsHUDVisible; }
+
+    /// Gets the statistics of the last paints, oldest first.  At most AC_TIMELINE_FRAME_STATS_HISTORY_SIZE paints are kept.
+    /// \return the statistics of the last paints.
+    const QList<acTimelineFrameStats>& frameStatsHistory() const { return m_frameStatsHistory; }
+
+    /// Gets the statistics of the last paint.
+    /// \return the statistics of the last paint, or empty statistics if no paint was recorded.
+    acTimelineFrameStats lastFrameStats() const { return m_frameStatsHistory.isEmpty() ? acTimelineFrameStats() : m_frameStatsHistory.last(); }
+
+    /// Clears the statistics of the last paints.
+    void clearFrameStats() { m_frameStatsHistory.clear(); m_nFrameCount = 0; m_currentFrameStats.reset(); }
+
+    /// Writes the statistics of the last paints to a CSV file.
+    /// \param filePath the path of the file to write.
+    /// \return true if the file was written successfully.
+    bool saveFrameStatsCsv(const QString& filePath) const { return acWriteTimelineFrameStatsCsv(m_frameStatsHistory, filePath); }
+
+    /// Gets the statistics of the paint in progress, for the branches and items to update.
+    /// \return the statistics of the paint in progress, or nullptr if the statistics are not enabled.
+    acTimelineFrameStats* frameStats() { return m_bFrameStatsEnabled ? &m_currentFrameStats : nullptr; }
+
+    /// Gets a flag indicating whether or not the timeline is currently being painted.
+    /// \return a flag indicating whether or not the timeline is currently being painted.
+    bool isPainting() const { return m_bPainting; }
+
+    /// Paints the items of the specified branch from the tile cache, rendering the tiles which are not cached yet, then the item labels over them.
+    /// \param painter the painter object to use when painting the tiles.
+    /// \param branch the branch whose items should be painted.
+    /// \param branchTop the Y coordinate of the top of the branch row.
+    /// \param branchHeight the height of the branch row.
+    void drawBranchTiles(QPainter& painter, acTimelineBranch* branch, int branchTop, int branchHeight);
+
     /// Sets a flag indicating whether or not the pivot position follows the mouse cursor.
     /// \param newPivotMouseTracking a flag indicating whether or not the pivot position follows the mouse cursor.
     void setPivotMouseTracking(const bool newPivotMouseTracking) { m_bPivotMouseTracking = newPivotMouseTracking; };
@@ -195,6 +354,55 @@ public:
     /// \return the first branch found with the specified text.  Returns NULL if branch can not be found
     acTimelineBranch* getBranchFromText(const QString& branchText, bool partialMatch, bool shouldRecurse = true) const;
 
+    /// Gets all the branches (including sub branches) whose text matches a query.  The titles are looked up in a trigram index,
+    /// rebuilt when a branch was added or a title was changed since the previous call.
+    /// \param text the query.
+    /// \param matchType how the branch texts should match the query.
+    /// \param caseSensitivity the case sensitivity of the comparison.
+    /// \return the matching branches, parents before their sub branches.
+    QList<acTimelineBranch*> findBranches(const QString& text, acTimelineTextIndex::MatchType matchType, Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive) const;
+
+    /// Finds the items of all branches whose text matches a query, replacing the results of the previous search.  The texts of the
+    /// items are looked up in a trigram index of their distinct texts, which is brought up to date with the items added since the
+    /// previous search.  At most ACTIMELINE_MaxSearchResults items are found, the earliest ones of each branch first.
+    /// \param text the query.
+    /// \param matchType how the item texts should match the query.
+    /// \param caseSensitivity the case sensitivity of the comparison.
+    /// \return the number of items found.
+    int search(const QString& text, acTimelineTextIndex::MatchType matchType = acTimelineTextIndex::MATCH_SUBSTRING, Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive);
+
+    /// Gets the items found by the most recent search, sorted by start time.
+    /// \return the items found by the most recent search.
+    const QVector<acTimelineSearchResult>& searchResults() const { return m_searchResults; }
+
+    /// Gets the timeline item of a search result, creating it if the result is a compact or trace item.
+    /// \param result the search result.
+    /// \return the timeline item of the search result, or NULL if it could not be found.
+    acTimelineItem* searchResultItem(const acTimelineSearchResult& result) const;
+
+    /// Selects and shows the next (or previous) item found by the most recent search.  The first call after a search shows the first
+    /// result starting at or after the selected item (or the visible time window if no item is selected).  The results wrap around.
+    /// \param forward true to show the next result, false to show the previous one.
+    /// \param shouldZoom true to zoom into the item (see ZoomToItem), false to only center it (see DisplayItemAtHorizontalCenter).
+    /// \return the item shown, or NULL if there are no search results.
+    acTimelineItem* showNextSearchResult(bool forward = true, bool shouldZoom = false);
+
+    /// Computes the statistics of the items of each visible branch within a time range: item count, total, minimum, maximum and mean
+    /// duration, and the item texts with the longest total duration.  The branches are processed in parallel on worker threads, and
+    /// rangeStatsComputed is emitted when they are all done.  A new computation cancels the one in progress.
+    /// \param rangeStart the start of the time range.
+    /// \param rangeEnd the end of the time range.
+    /// \param topTextCount the number of item texts listed for each branch.
+    void computeRangeStats(quint64 rangeStart, quint64 rangeEnd, int topTextCount = AC_TIMELINE_RANGE_STATS_DEFAULT_TOP_TEXTS);
+
+    /// Sets a flag indicating whether or not the statistics of the selected time range are computed when the user ctrl-drags to select a region.
+    /// \param newSelectionStatsEnabled a flag indicating whether or not the statistics of the selected time range are computed.
+    void setSelectionStatsEnabled(const bool newSelectionStatsEnabled) { m_bSelectionStatsEnabled = newSelectionStatsEnabled; }
+
+    /// Gets a flag indicating whether or not the statistics of the selected time range are computed when the user ctrl-drags to select a region.
+    /// \return a flag indicating whether or not the statistics of the selected time range are computed.
+    bool isSelectionStatsEnabled() const { return m_bSelectionStatsEnabled; }
+
     /// Gets the timeline item located at the specified X and Y coordinate.
     /// \param x the x coordinate.
     /// \param y the y coordinate.
@@ -228,6 +436,29 @@ public:
     /// \return the X coordinate of the specified timestamp.
     int getXCoordOfTime(quint64 time) const;
 
+    /// Gets the timestamp at the specified X coordinate.  This is the inverse of getXCoordOfTime.
+    /// \param x the X coordinate, relative to the left side of the row area (i.e. excluding the title section).
+    /// \return the timestamp at the specified X coordinate.
+    quint64 getTimeOfXCoord(int x) const;
+
+    /// Gets the transform between times and X coordinates (relative to the left side of the row area) for the current view.
+    /// The transform is recomputed when the start time, full range, render width or offset changed since it was last used, so it
+    /// can be fetched once before converting the times of many items.
+    /// \return the transform between times and X coordinates.
+    const acTimelineTimeTransform& timeTransform() const
+    {
+        if (!m_timeTransform.isSetFor(m_nStartTime, m_nFullRange, m_nRenderWidth, m_nOffset))
+        {
+            m_timeTransform.set(m_nStartTime, m_nFullRange, m_nRenderWidth, m_nOffset);
+        }
+
+        return m_timeTransform;
+    }
+
+    /// Gets the visible part of the timeline rows, which the branches paint their items on when they are not painted from tiles.
+    /// \return the time transform, visible time range and row area of the current view.
+    acTimelineRowView rowView() const;
+
     /// Converts a fraction value from a visible fraction to a full timeline fraction.
     /// \param fractionOfVisiblePortion a fraction value representing a fraction of the visible portion of the timeline.
     /// \return a fraction value representing a fraction of the full timeline.
@@ -267,6 +498,12 @@ public:
     /// \return true if the branch was added, false otherwise.
     bool addBranch(acTimelineBranch* branch);
 
+    /// Adds a branch for each branch of a memory mapped trace file, with the same names and hierarchy, showing the trace items.
+    /// The trace file must stay open for as long as the branches exist.
+    /// \param traceFile the open trace file.
+    /// \return true if the branches were added, false otherwise.
+    bool addTraceBranches(const acTimelineTraceFile& traceFile);
+
     /// Sets the selected branch for this timeline to the specified branch.
     /// \param branch the branch to select.
     void setSelectedBranch(acTimelineBranch* branch);
@@ -356,6 +593,10 @@ protected:
     /// \param event the event parameters.
     void resizeEvent(QResizeEvent* event);
 
+    /// Overridden QWidget method called when the enabled state, font or palette of this widget changes.
+    /// \param event the event parameters.
+    void changeEvent(QEvent* event);
+
     /// Recalculates the title width based on the current set of branches.
     void recalcTitleWidth();
 
@@ -382,6 +623,12 @@ signals:
     /// Signal emitted when the timeline's offset changes.
     void offsetChanged();
 
+    /// Signal emitted when the statistics requested by computeRangeStats are computed.
+    /// \param rangeStart the start of the time range.
+    /// \param rangeEnd the end of the time range.
+    /// \param stats the statistics of each visible branch, parents before their sub branches.
+    void rangeStatsComputed(quint64 rangeStart, quint64 rangeEnd, const QVector<acTimelineBranchRangeStats>& stats);
+
 
 signals:
     /// Called when the visibility filter changes.
@@ -396,6 +643,25 @@ private slots:
     /// \param subBranch the branch which was added.
     void branchAdded(acTimelineBranch* subBranch);
 
+    /// Called once when a batch of timeline items is added to a branch.
+    /// \param count the number of timeline items added.
+    void branchItemsAdded(int count);
+
+    /// Called when tiles were rasterized on the worker threads.  Adds them to the tile cache.
+    void tilesRendered();
+
+    /// Called after a rendered tile did not fit in the tile cache.  Disables the tile cache, so that the items are painted directly.
+    void disableTileCache();
+
+    /// Called when the statistics of a time range were computed on the worker threads.  Emits rangeStatsComputed.
+    void rangeStatsFinished();
+
+    /// Called when the mouse rested over an item long enough for its tooltip to be built.  Queues the building of the tooltip text.
+    void toolTipTimerFired();
+
+    /// Called when the text of a tooltip was built on the worker thread.  Shows it if the mouse is still over the item.
+    void toolTipBuilt();
+
     /// Called when the text of a branch changes.
     void branchTextChanged();
 
@@ -445,9 +711,19 @@ private:
         QColor m_color;        ///< The color of the marker.
     };
 
-    /// Resets the row index for all branches.
+    /// Marks the row layout (and the row index of all branches) for rebuilding.
     void resetRowIndex();
 
+    /// Drops the pending tooltip request (when the mouse leaves the item it was requested for).
+    void dropToolTipRequest();
+
+    /// Adds the rows of the specified branch to the row layout, or marks the row layout for rebuilding if the rows cannot be appended.
+    /// \param branch the branch which was added.
+    void addBranchRows(acTimelineBranch* branch);
+
+    /// Rebuilds the index of the branch titles if a branch was added or a branch title was changed.
+    void ensureBranchTextIndex() const;
+
     /// Computes the pivot from the zoom pivot.
     void updateZoomPivotFromPivot();
 
@@ -484,9 +760,57 @@ private:
     /// \param numTicks the number of ticks to zoom.  A positive number indicates zoom in. A negative number indicates zoom out.
     void userZoom(int numTicks);
 
-    /// Clears all branches.
+    /// Clears all branches.  Waits for the range statistics jobs reading the items of the branches, so that the trace files
+    /// shown by the branches can be closed afterwards.
     void clearBranches();
 
+    /// Renders a tile of the items of the specified branch.
+    /// \param branch the branch whose items should be rendered.
+    /// \param tileIndex the index of the tile within the full render width.
+    /// \param branchHeight the height of the branch row.
+    /// \return the rendered tile.
+    QImage renderTile(acTimelineBranch* branch, qint64 tileIndex, int branchHeight);
+
+    /// Called when a rendered tile could not be added to the tile cache.  Disables the tile cache once the current paint is done.
+    void tileCacheOverflowed();
+
+    /// Grows the full range of a zoomed in timeline in streaming mode, keeping the time per pixel, and following the end of the timeline if it was visible.
+    /// \param newFullRange the new full range of the timeline.
+    /// \return false if the full range should be set the usual way (the range does not grow, or the timeline is not zoomed in).
+    bool growStreamingFullRange(const quint64 newFullRange);
+
+    /// Records the paint commands of a tile of the items of the specified branch, to be rasterized on a worker thread.
+    /// \param branch the branch whose items should be recorded.
+    /// \param tileIndex the index of the tile within the full render width.
+    /// \param branchHeight the height of the branch row.
+    /// \return the recorded paint commands.
+    QPicture recordTile(acTimelineBranch* branch, qint64 tileIndex, int branchHeight);
+
+    /// Paints a tile of the items of the specified branch, without their labels.
+    /// \param tilePainter the painter object of the tile.
+    /// \param branch the branch whose items should be painted.
+    /// \param tileIndex the index of the tile within the full render width.
+    /// \param branchHeight the height of the branch row.
+    void paintTile(QPainter& tilePainter, acTimelineBranch* branch, qint64 tileIndex, int branchHeight);
+
+    /// Gets the part of the timeline rows covered by a tile, with X coordinates relative to the left side of the tile.
+    /// \param tileIndex the index of the tile within the full render width.
+    /// \return the time transform, time range and area of the tile.
+    acTimelineRowView tileRowView(qint64 tileIndex) const;
+
+    /// Repaints the selected item and the item under the mouse on top of the tiles, in the visible portion of the timeline.
+    /// \param painter the painter object to use when painting the items.
+    void drawItemOverlays(QPainter& painter);
+
+    /// Repaints the specified item on top of the tiles, on the row where it is displayed.
+    /// \param painter the painter object to use when painting the item.
+    /// \param item the item to paint.
+    void drawItemOverlay(QPainter& painter, acTimelineItem* item);
+
+    /// Draws the statistics of the last paint over the top-right corner of the branch rows.
+    /// \param painter the painter object to use when painting the statistics.
+    void drawFrameStatsHUD(QPainter& painter);
+
 
     /// Shows a timeline item, optionally zooming in to the item
     /// \param item the timeline item to show
@@ -544,6 +868,41 @@ private:
 
     QSize             m_lastSizeWhenCacheWasCleared; ///< Contain the size of the timeline when the cache was recently cleared. Will be used to decide if the cache should be cleared again, or not.
 
+    acTimelineTileCache m_tileCache;                ///< The cache of pre-rendered branch item tiles.
+    bool             m_bTileCacheEnabled;           ///< Flag indicating whether or not the branch items are painted from m_tileCache.
+    bool             m_bPainting;                   ///< Flag indicating that the timeline is being painted.
+    acTimelineTileRenderer m_tileRenderer;          ///< The worker threads rasterizing the tiles.
+    bool             m_bAsyncTileRendering;         ///< Flag indicating whether or not the tiles are rasterized by m_tileRenderer.
+    bool             m_bStreamingMode;              ///< Flag indicating whether or not items are streamed into the timeline while it is displayed.
+    bool             m_bFrameStatsEnabled;          ///< Flag indicating whether or not statistics are collected for each paint.
+    bool             m_bFrameStatsHUDVisible;       ///< Flag indicating whether or not the statistics of the last paint are displayed over the timeline.
+    acTimelineFrameStats m_currentFrameStats;       ///< The statistics of the paint in progress (and of the tooltips built since the last paint).
+    QList<acTimelineFrameStats> m_frameStatsHistory; ///< The statistics of the last paints, oldest first.
+    quint64          m_nFrameCount;                 ///< The number of paints recorded since the statistics were enabled.
+    mutable acTimelineRowLayout m_rowLayout;        ///< The vertical layout of the branch rows.
+    mutable bool     m_bRowLayoutInvalid;           ///< Flag indicating that m_rowLayout should be rebuilt before it is used.
+    bool             m_bBatchedPainting;            ///< Flag indicating whether or not the items of a branch are painted in batches of the same color.
+    acTimelineItemBatch m_itemBatch;                ///< The batch the branches add their items to while painting (when m_bBatchedPainting is set).
+    acTimelineLabelCache m_labelCache;              ///< The cache of the laid out item labels.
+    acTimelineTextIndex m_textIndex;                ///< The trigram index of the distinct texts of the items.
+    QHash<const acTimelineBranch*, QVector<int> > m_compactTextIds; ///< The m_textIndex id of each compact item string of each branch.
+    QHash<quint64, QVector<int> > m_traceTextIds; ///< The m_textIndex id of each string of each trace file shown by the branches, by load generation of the trace file.
+    QHash<const acTimelineBranch*, QVector<int> > m_itemTextIds; ///< The m_textIndex id of each distinct item object text of each branch.
+    mutable acTimelineTextIndex m_branchTextIndex;  ///< The trigram index of the branch titles.
+    mutable QList<acTimelineBranch*> m_indexedBranches; ///< The branches whose titles are in m_branchTextIndex, parents before their sub branches.
+    mutable QVector<QVector<int> > m_branchesByTextId; ///< The positions in m_indexedBranches of the branches with each title of m_branchTextIndex, in increasing order.
+    mutable bool     m_bBranchTextIndexInvalid;     ///< Flag indicating that m_branchTextIndex should be rebuilt (a branch was added or a branch title was changed).
+    QVector<acTimelineSearchResult> m_searchResults; ///< The items found by the most recent search, sorted by start time.
+    int              m_nCurrentSearchResult;        ///< The index of the search result shown last (-1 if none was shown since the search).
+    acTimelineRangeStatsCalculator m_rangeStatsCalculator; ///< The worker threads computing the statistics of a time range.
+    bool             m_bSelectionStatsEnabled;      ///< Flag indicating whether or not the statistics of the selected time range are computed.
+    mutable acTimelineTimeTransform m_timeTransform; ///< The transform between times and X coordinates, set from the view when it is used (see timeTransform).
+    QVector<acTimelineBranch*> m_branchesById;      ///< The branches of the timeline, indexed by branch id.
+    acTimelineToolTipBuilder m_toolTipBuilder;      ///< The worker thread building the tooltip texts, and the cache of the texts built last.
+    QTimer           m_toolTipTimer;                ///< Delays the building of a tooltip text until the mouse rests over the item.
+    acTimelineItem*  m_pToolTipItem;                ///< The item whose tooltip is requested (nullptr if none).  Only compared to the item under the mouse.
+    QPoint           m_toolTipPos;                  ///< The global position the requested tooltip is shown at.
+
 protected:
 
     QList<acTimelineBranch*> m_subBranches;         ///< The list of top-level branches in the timeline.
@@ -14,16 +14,24 @@
 #include <QObject>
 #include <QPainter>
 #include <QMap>
+#include <QVector>
 
 // Infra:
 #include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
 
 class acTimeline;
 class acTimelineItem;
+class acTimelineItemBatch;
 class acTimelineMaskBuffer;
+class acTimelineRowView;
+struct acTimelineRangeItems;
 
 // Local:
 #include <AMDTApplicationComponents/Include/acApplicationComponentsDLLBuild.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemIndex.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemStore.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTextIndex.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTraceFile.h>
 
 /// Timeline branch class -- takes ownership (memory-wise) of contained timeline items
 class AC_API acTimelineBranch : public QObject
@@ -61,6 +69,10 @@ public:
     /// \return the required width of the title section of this branch.
     int titleWidth() const { return m_nTitleWidth; }
 
+    /// Recalculates the title width of this branch, taking into account the (already calculated) title width of sub branches.
+    /// Called by the timeline when the visibility of sub branches changed.
+    void recalcTitleWidth();
+
     /// Sets the start time for the branch.  Note that the branch's start time can also be adjusted by addTimelineItem, addSubBranch, and subBranchRangeChanged.
     /// \param newStartTime the start time for the branch.
     void setStartTime(const quint64 newStartTime);
@@ -105,6 +117,10 @@ public:
     /// \return the mask buffer used by this branch when painting items.
     acTimelineMaskBuffer* getMaskBuffer() const { return m_pMask; }
 
+    /// Gets a flag indicating whether or not the item rectangles were refreshed during the most recent paint pass.
+    /// \return true if the items were painted as aggregated bars or from tiles, false if they were painted one by one.
+    bool areItemRectsStale() const { return m_bItemRectsStale; }
+
     /// Gets a flag indicating whether or not all this branch's parents are unfolded.
     /// \return true if all parents are unfolded, false otherwise.
     bool allParentsUnfolded() const;
@@ -119,7 +135,11 @@ public:
 
     /// Gets the row index of this branch.  The row index is the position of the branch within the timeline if you started at the top with zero and counted as you moved down through the timeline.
     /// \return the row index of this branch.
-    unsigned int rowIndex() const {return m_nRowIndex; }
+    unsigned int rowIndex() const;
+
+    /// Gets the id of this branch, which identifies it within its timeline (see acTimeline::branchById).
+    /// \return the id of this branch, or -1 if the branch was not added to a timeline yet.
+    int id() const { return m_nId; }
 
     /// Resets the row index of this branch and all sub branches.
     /// \param rowIndex reference to the row index to assign to this branch.  It is incremented in the body so that subsequent calls to resetRowIndex for other branch's will get the correct index.
@@ -145,7 +165,8 @@ public:
     /// \return an untyped pointer containing extra data attached to this branch.
     void* tag() const { return m_pTag; }
 
-    /// Gets the cumulative height of this branch and all visible sub branches.
+    /// Gets the cumulative height of this branch and all visible sub branches.  Uses the row layout of the parent timeline when the branch is in it,
+    /// in which case a hidden branch (or a branch with a hidden parent) has no height.
     /// \return the cumulative height of this branch and all visible sub branches.
     int cumulativeHeight() const;
 
@@ -157,6 +178,59 @@ public:
     /// \return true if the item was added, false otherwise.
     bool addTimelineItem(acTimelineItem* item);
 
+    /// Adds the specified timeline items to this branch in a single batch.  Storage is reserved once, the item index is sorted once
+    /// (by start time, if the items are not already in order) and the branch range is updated once.  The items keep the order they
+    /// are passed in.  Instead of emitting branchItemAdded
+    /// for every item, a single branchItemsAdded signal is emitted for the whole batch.  This is the preferred way to load large traces.
+    /// \param items the timeline items to be added.  NULL items are ignored.
+    /// \return true if any item was added, false otherwise.
+    bool addTimelineItems(const QList<acTimelineItem*>& items);
+
+    /// Adds a compact item to this branch.  Compact items are kept in a struct-of-arrays store instead of as separate acTimelineItem
+    /// objects, which makes large traces much cheaper to hold and load.  An acTimelineItem is only created for a compact item when it
+    /// is looked up (see getCompactTimelineItem), for example when the mouse hovers over it.
+    /// Note: as with addTimelineItem, painting performance is best when items are added in order according to their start time.
+    /// \param startTime the start time of the item.
+    /// \param endTime the end time of the item.
+    /// \param backgroundColor the background color of the item.
+    /// \param text the text of the item.
+    /// \param flags the flags of the item (see AC_TIMELINE_COMPACT_ITEM_SHAPE_MASK).
+    /// \return the index of the item within the compact item store of this branch.
+    int addCompactItem(quint64 startTime, quint64 endTime, const QColor& backgroundColor, const QString& text, quint8 flags = 0);
+
+    /// Gets the compact item store of this branch.
+    /// \return the compact item store of this branch.
+    const acTimelineItemStore& compactItems() const { return m_compactItems; }
+
+    /// Gets the timeline item representing the compact item at the specified index, creating it if needed.
+    /// The returned item is owned by the branch and stays valid for the lifetime of the branch.
+    /// \param index the index of the compact item within the compact item store.
+    /// \return the timeline item representing the compact item, or NULL if index is out of range.
+    acTimelineItem* getCompactTimelineItem(const int index) const;
+
+    /// Sets the items of this branch which are read from a memory mapped trace file.  Trace items are painted straight from the
+    /// mapping, one per pixel column at most, so that only the pages covering the visible time window are read.
+    /// The trace file must stay open for as long as the branch exists (or until other trace items are set).
+    /// \param traceItems a view of the items of a branch of the trace file.
+    void setTraceItems(const acTimelineTraceItems& traceItems);
+
+    /// Gets the items of this branch which are read from a memory mapped trace file.
+    /// \return a view of the trace items (empty if the branch has no trace items).
+    const acTimelineTraceItems& traceItems() const { return m_traceItems; }
+
+    /// Gets the timeline item representing the trace item at the specified position, creating it if needed.
+    /// The returned item is owned by the branch and stays valid until other trace items are set.
+    /// \param pos the position of the trace item.
+    /// \return the timeline item representing the trace item, or NULL if pos is out of range.
+    acTimelineItem* getTraceTimelineItem(qint64 pos) const;
+
+    /// Takes a snapshot of the items of this branch (not including sub branches) overlapping a time range, which can be read from
+    /// another thread while items are added to the branch (see acTimelineRangeStatsCalculator).
+    /// \param rangeStart the start of the time range.
+    /// \param rangeEnd the end of the time range.
+    /// \param[out] items the snapshot of the items.
+    void getItemsInRange(quint64 rangeStart, quint64 rangeEnd, acTimelineRangeItems& items) const;
+
     /// Adds the specified branch as a sub branch of this branch.
     /// \param subBranch the branch to be added.
     /// \return true if the sub branch was added, false otherwise.
@@ -182,6 +256,29 @@ public:
     /// \return the first sub branch found with the specified text.  Returns NULL if branch can not be found
     acTimelineBranch* getSubBranchFromText(const QString& branchText, bool partialMatch) const;
 
+    /// Adds the texts of the compact items added since the previous call to a text index.
+    /// \param textIndex the text index.
+    /// \param[in,out] textIds the text index id of each string of the compact item store, extended with the ids of the new strings.
+    void indexCompactTexts(acTimelineTextIndex& textIndex, QVector<int>& textIds) const;
+
+    /// Adds the distinct texts of the acTimelineItem objects added since the previous call to a text index.
+    /// \param textIndex the text index.
+    /// \param[in,out] textIds the text index id of each distinct item object text of this branch, extended with the ids of the new texts.
+    void indexItemTexts(acTimelineTextIndex& textIndex, QVector<int>& textIds) const;
+
+    /// Finds the items of this branch (not including sub branches) whose text is one of the matching texts of a text index query.
+    /// The items are found through lists of their indices or positions by string id, so only the matching items are read.  The
+    /// lists of the item objects and compact items are extended as the items are added, the lists of the trace items are built by
+    /// the first search of the trace.
+    /// \param textMatches the matching texts of the text index (see acTimelineTextIndex::findTexts).
+    /// \param itemTextIds the text index id of each distinct item object text (see indexItemTexts).
+    /// \param compactTextIds the text index id of each string of the compact item store (see indexCompactTexts).
+    /// \param pTraceTextIds the text index id of each string of the trace file of the trace items, or NULL if the branch has no trace items.
+    /// \param maxResults the maximum number of results added for each kind of items (the earliest items are added first).
+    /// \param[out] results the list the found items are appended to.
+    void findTextMatches(const QVector<bool>& textMatches, const QVector<int>& itemTextIds, const QVector<int>& compactTextIds,
+                         const QVector<int>* pTraceTextIds, int maxResults, QVector<acTimelineSearchResult>& results) const;
+
     /// Gets the sub branch at the specified Y coordinate.
     /// \param y the Y coordinate of the sub branch which is needed.
     /// \return the sub branch at the specified Y coordinate, or NULL if no sub branch is located at the specified Y coordinate.
@@ -207,6 +304,18 @@ public:
     /// \return the index of the specified item within the m_timelineItems list
     int indexOfItem(acTimelineItem* item) const;
 
+    /// Invalidates the interval index used to look up items by time.  Called by contained items when their start or end time changes.
+    void invalidateItemIndex() { m_bItemIndexInvalid = true; m_bSummaryPyramidInvalid = true; invalidateTiles(); }
+
+    /// Marks the item summary pyramid as out of date (an item's color was changed).  The pyramid is rebuilt when next needed.
+    void invalidateSummaryPyramid() { m_bSummaryPyramidInvalid = true; invalidateTiles(); }
+
+    /// Marks the lists of the item objects by text as out of date (an item's text was changed).  They are rebuilt by the next search.
+    void invalidateItemTextIndex() { m_bItemTextIndexInvalid = true; }
+
+    /// Drops the pre-rendered tiles of this branch (and of the parent branches, which may paint the items of this branch) from the parent timeline's tile cache.
+    void invalidateTiles();
+
     /// Gets the rectangle of the tree mark of this branch. The tree mark is the plus/minus glyph used for expanding/collapsing branches.
     /// \return the rectangle of the tree mark of this branch.
     QRect treeMarkRect() { return m_treeMarkRect; }
@@ -216,12 +325,21 @@ public:
     /// \param yOffset the Y coordinate at which to draw this branch.
     void draw(QPainter& painter, int& yOffset);
 
+    /// Draws the items of this branch (and of its sub branches, when folded) without the row background and title, and then their labels.
+    /// Used for painting the branch directly, and by the parent timeline for rendering tiles and painting the labels over them.
+    /// \param painter the painter object to use when painting the items.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
+    /// \param branchRowTop the Y coordinate of the top of the row to paint on.
+    /// \param branchHeight the height of the row to paint on.
+    void drawItems(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight);
+
     /// Draws all subbranch items on this branch when this branch is folded (collapsed).
     /// \param painter the painter object to use when painting the items.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
     /// \param yOffset the Y coordinate of the branch on which to draw the items.
     /// \param branchHeight the height of the branch on which to draw the items.
     /// \param shouldUpdateChildGeometry when the branch items are drawn, should it's geometry be updated?
-    void DrawSubBranchItems(QPainter& painter, const int yOffset, const int branchHeight, bool shouldUpdateChildGeometry);
+    void DrawSubBranchItems(QPainter& painter, const acTimelineRowView& view, const int yOffset, const int branchHeight, bool shouldUpdateChildGeometry);
 
     /// Clears the draw cache which contains the list of items to draw.
     /// \param clearSubBranchCache flag indicating if the draw cache for all sub branches should be cleared as well.
@@ -251,6 +369,10 @@ signals:
     /// \param item the timeline item added.
     void branchItemAdded(acTimelineItem* item);
 
+    /// Signal emitted once when a batch of timeline items is added by addTimelineItems.
+    /// \param count the number of timeline items added.
+    void branchItemsAdded(int count);
+
     /// Signal emitted when a timeline item's text is changed.
     void branchTextChanged();
 
@@ -286,8 +408,136 @@ private:
     /// \return the item at the specified location, or NULL if no item is located at the specified location.
     acTimelineItem* getTimelineItem(const acTimelineBranch* branch, const int x, const int y) const;
 
-    /// Recalculates the title width of this branch, taking into account the title width of sub branches.
-    void recalcTitleWidth();
+    /// Extends the title width of this branch to the title width of the specified sub branch, after a branch was added to it.
+    /// \param subBranch the sub branch whose title width changed.
+    void growTitleWidth(const acTimelineBranch* subBranch);
+
+    /// Extends the range of this branch to include the specified time range, emitting branchRangeChanged if needed.
+    /// \param startTime the start of the time range.
+    /// \param endTime the end of the time range.
+    void extendRange(quint64 startTime, quint64 endTime);
+
+    /// Makes sure the item interval index is built and up to date with the items of this branch.
+    void ensureItemIndex() const;
+
+    /// Gets the range of sorted positions (within the item interval index) of the items overlapping the specified time window.
+    /// \param rangeStart the start of the time window.
+    /// \param rangeEnd the end of the time window.
+    /// \param[out] firstPos the first sorted position within the range.
+    /// \param[out] lastPos one past the last sorted position within the range.
+    /// \return true if the range is not empty, false otherwise.
+    bool findItemsInRange(quint64 rangeStart, quint64 rangeEnd, int& firstPos, int& lastPos) const;
+
+    /// Gets the range of sorted positions (within the item interval index) of the items overlapping the painted portion of the parent timeline.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
+    /// \param[out] firstPos the first sorted position within the range.
+    /// \param[out] lastPos one past the last sorted position within the range.
+    /// \return true if the range is not empty, false otherwise.
+    bool findVisibleItems(const acTimelineRowView& view, int& firstPos, int& lastPos) const;
+
+    /// Gets the range of sorted positions (within the compact item interval index) of the compact items overlapping the painted portion of the parent timeline.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
+    /// \param[out] firstPos the first sorted position within the range.
+    /// \param[out] lastPos one past the last sorted position within the range.
+    /// \return true if the range is not empty, false otherwise.
+    bool findVisibleCompactItems(const acTimelineRowView& view, int& firstPos, int& lastPos) const;
+
+    /// Paints the compact items at the specified range of sorted positions.  Compact items which were never looked up are painted
+    /// through a single shared proxy item.
+    /// \param painter the painter object to use when painting the items.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
+    /// \param branchRowTop the Y coordinate of the top of the row to paint on.
+    /// \param branchHeight the height of the row to paint on.
+    /// \param firstPos the first sorted position of the items to paint.
+    /// \param lastPos one past the last sorted position of the items to paint.
+    /// \param drawFaded should the items be painted faded (when painted on a folded parent branch)?
+    /// \param shouldUpdateGeometry should the item geometry be updated?
+    void drawCompactItems(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, int firstPos, int lastPos, bool drawFaded, bool shouldUpdateGeometry);
+
+    /// Paints the trace items overlapping the painted portion of the parent timeline, at most one per pixel column.  After an item is
+    /// painted, the items starting within the pixel columns it covers are skipped (as they would be by the paint mask).
+    /// \param painter the painter object to use when painting the items.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
+    /// \param branchRowTop the Y coordinate of the top of the row to paint on.
+    /// \param branchHeight the height of the row to paint on.
+    /// \param drawFaded should the items be painted faded (when painted on a folded parent branch)?
+    /// \param shouldUpdateGeometry should the item geometry be updated?
+    void drawTraceItems(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawFaded, bool shouldUpdateGeometry);
+
+    /// Gets the shared item used to paint the compact and trace items which have no timeline item of their own, creating it if needed.
+    /// \return the shared proxy item, or NULL if it could not be created.
+    acTimelineItem* compactItemProxy();
+
+    /// Paints an item, or adds it to the specified batch if the item can be batched.
+    /// \param painter the painter object to use when the item is painted directly.
+    /// \param pBatch the batch to add the item to, or NULL to paint the item directly.
+    /// \param item the item.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
+    /// \param branchRowTop the Y coordinate of the top of the row to paint on.
+    /// \param branchHeight the height of the row to paint on.
+    /// \param drawFaded should the item be painted faded (without a gradient), as sub branch items are painted in their parent branch?
+    /// \param shouldUpdateGeometry should the item geometry be updated?
+    void drawItem(QPainter& painter, acTimelineItemBatch* pBatch, acTimelineItem* item, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawFaded, bool shouldUpdateGeometry);
+
+    /// Makes sure the item summary pyramid is built and up to date with the items of this branch.
+    void ensureSummaryPyramid() const;
+
+    /// Makes sure the index of the trace item positions by string id is built for the current trace items.
+    /// \return true if the index is built, false if the trace items are too many to be indexed (more than 2^32).
+    bool ensureTraceTextIndex() const;
+
+    /// Adds an item object to the lists of the item objects by text (m_itemsByTextId).
+    /// \param index the index of the item in m_timelineItems.
+    void indexItemText(int index) const;
+
+    /// Rebuilds the lists of the item objects by text if an item's text was changed.
+    void ensureItemTextIndex() const;
+
+    /// Gets a flag indicating whether or not the parent timeline is in streaming mode.
+    /// \return true if the parent timeline is in streaming mode.
+    bool isStreaming() const;
+
+    /// Adds an item to the item summary pyramid in streaming mode, or marks the pyramid as out of date.
+    /// \param startTime the start time of the added item.
+    /// \param endTime the end time of the added item.
+    /// \param color the color of the added item.
+    void summarizeAddedItem(quint64 startTime, quint64 endTime, QRgb color);
+
+    /// Drops the tiles and draw cache made out of date by added items.  In streaming mode, only the tiles covering the added items are dropped.
+    /// \param startTime the start time of the added items.
+    /// \param endTime the end time of the added items.
+    void invalidateAddedRange(quint64 startTime, quint64 endTime);
+
+    /// Paints the items within the painted time window as one aggregated bar per pixel column, if the items are dense enough.
+    /// Items are aggregated when the branch has more items than pixel columns over its time range and the items are on average shorter
+    /// than a pixel.  This only depends on the zoom level, so the row is painted the same whether it is painted at once or tile by tile.
+    /// \param painter the painter object to use when painting the bars.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
+    /// \param branchRowTop the Y coordinate of the top of the row to paint on.
+    /// \param branchHeight the height of the row to paint on.
+    /// \param firstPos the first sorted position of the visible items.
+    /// \param lastPos one past the last sorted position of the visible items.
+    /// \param compactFirstPos the first sorted position of the visible compact items.
+    /// \param compactLastPos one past the last sorted position of the visible compact items.
+    /// \param alpha the alpha value used for the bar colors (255 to use the item colors as is).
+    /// \return true if the items were painted as aggregated bars, false if the items should be painted one by one.
+    bool drawAggregatedItems(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, int firstPos, int lastPos, int compactFirstPos, int compactLastPos, int alpha);
+
+    /// Marks the item rectangles as stale, so that items are hit tested by time within the specified row area.
+    /// \param itemsRowRect the area where the items were painted.
+    /// \param includeSubBranches flag indicating whether the items of the sub branches were painted on the same row (folded branch).
+    void markItemRectsStale(const QRect& itemsRowRect, bool includeSubBranches);
+
+    /// Gets the item at the specified sorted position of the item interval index.
+    /// \param pos the sorted position.
+    /// \return the item at the specified sorted position.
+    acTimelineItem* itemAtSortedPos(int pos) const { return m_timelineItems[m_itemIndex.itemIndex(pos)]; }
+
+    /// Gets the timeline item of this branch (not including sub branches) at the specified location.
+    /// \param x the X coordinate of the item which is needed.
+    /// \param y the Y coordinate of the item which is needed.
+    /// \return the item at the specified location, or NULL if no item is located at the specified location.
+    acTimelineItem* getOwnTimelineItem(const int x, const int y) const;
 
     QString                 m_strText;          ///< The title text of this branch.
 
@@ -299,12 +549,12 @@ private:
 
     bool                    m_bFolded;          ///< Flag indicating whether or not this branch is folded.
     bool                    m_bSelected;        ///< Flag indicating whether or not this branch is selected.
-    bool                    m_bSorted;          ///< Flag indicating whether or not this branch is sorted.
 
     int                     m_nTitleWidth;      ///< The width of the title section of this branch.
 
     unsigned int            m_nDepth;           ///< The depth of this branch.
     unsigned int            m_nRowIndex;        ///< The row index of this branch.
+    int                     m_nId;              ///< The id of this branch in its timeline (-1 until the branch is added to a timeline).
 
     int                     m_nTop;             ///< The top (y coordinate) of this branch.
     bool                    m_bHeightSet;       ///< Flag indicating whether or not the height has been set.  False indicates that the parent timeline's defaultBranchHeight is being used.
@@ -322,6 +572,29 @@ private:
     QList<acTimelineItem*>   m_timelineItems;   ///< The list of timeline items contained in this branch.
     QList<acTimelineItem*>   m_drawCache;       ///< A list of items actually painted.  Used as an optimization when repainting this branch.
 
+    mutable acTimelineItemIntervalIndex m_itemIndex;   ///< Interval index of m_timelineItems, used to find the items overlapping a time window.
+    mutable bool             m_bItemIndexInvalid; ///< Flag indicating that m_itemIndex should be rebuilt from m_timelineItems (an item's time range was changed).
+    mutable QVector<QString> m_itemTexts;         ///< The distinct texts of m_timelineItems, by string id.  Texts are only ever added.
+    mutable QHash<QString, int> m_itemTextIds;    ///< The string id of each text of m_itemTexts.
+    mutable QVector<QVector<int> > m_itemsByTextId; ///< The indices in m_timelineItems of the items with each string id, in increasing order.
+    mutable bool             m_bItemTextIndexInvalid; ///< Flag indicating that m_itemsByTextId should be rebuilt from m_timelineItems (an item's text was changed).
+
+    mutable acTimelineItemSummaryPyramid m_summaryPyramid; ///< Multi-resolution summary of m_timelineItems and m_compactItems, used to paint the items when zoomed out.
+    mutable bool             m_bSummaryPyramidInvalid;     ///< Flag indicating that m_summaryPyramid should be rebuilt.
+    bool                     m_bItemRectsStale;            ///< Flag indicating that the item rectangles were not refreshed during the most recent paint pass (items were painted as aggregated bars or from tiles).
+    QRect                    m_itemsRowRect;               ///< The area where the items of this branch were painted during the most recent paint pass.
+
+    acTimelineItemStore      m_compactItems;               ///< The compact items contained in this branch.
+    mutable acTimelineItemIntervalIndex m_compactItemIndex; ///< Interval index of m_compactItems.  Compact item times never change, so it is only ever appended to.
+    QVector<QVector<int> >   m_compactItemsByTextId;       ///< The indices of the compact items with each string id of m_compactItems, in increasing order.
+    mutable QMap<int, acTimelineItem*> m_compactTimelineItems; ///< The timeline items created for compact items that were looked up, by compact item index.
+    acTimelineItem*          m_pCompactItemProxy;          ///< Shared item used to paint the compact and trace items which have no timeline item of their own.
+    acTimelineTraceItems     m_traceItems;                 ///< The items of this branch read from a memory mapped trace file.
+    mutable QMap<qint64, acTimelineItem*> m_traceTimelineItems; ///< The timeline items created for trace items that were looked up, by position.
+    mutable QVector<quint32> m_traceItemsByTextId;         ///< The positions of the trace items, grouped by string id, in increasing order within each group.
+    mutable QVector<quint32> m_traceTextIdOffsets;         ///< The index in m_traceItemsByTextId of the first position of each string id (string count + 1 of them).
+    mutable quint64          m_nTraceTextIndexGeneration;  ///< The load generation of the trace file m_traceItemsByTextId was built for (0 if it is not built).
+
     bool                     m_shouldDrawChildren; /// Should the branch children be drawn on parent?
 
     QColor                   m_bgColor;         /// The branch background color
@@ -330,12 +603,13 @@ private:
 /// Mask buffer class used to prevent painting items that would not actually appear on the
 /// screen because another timeline item has already been drawn there (i.e. multiple items
 /// with the same height that occupy the same area on the timeline).  Maintains a separate
-/// mask for each height (since branches can contain items of differing heights)
-class acTimelineMaskBuffer
+/// mask row for each lane (top and height), since branches can contain items of differing heights.
+/// Mask rows are flat arrays allocated once per row width and reused across paint passes.
+class AC_API acTimelineMaskBuffer
 {
 public:
     /// Construct/Initialize a new instance of the MaskBuffer class.
-    acTimelineMaskBuffer() : m_nBufferWidth(0) {}
+    acTimelineMaskBuffer() : m_nBufferWidth(0), m_nLastRow(-1) {}
 
     /// Destroys instance of the the MaskBuffer class.
     virtual ~acTimelineMaskBuffer();
@@ -363,8 +637,25 @@ private:
     /// Disable assignment operator.
     acTimelineMaskBuffer& operator= (const acTimelineMaskBuffer& obj);
 
+    /// Mask of a single lane (items with the same top and height).
+    struct MaskRow
+    {
+        int          m_nTop;        ///< The top of the items in this lane.
+        int          m_nHeight;     ///< The height of the items in this lane.
+        QVector<int> m_widths;      ///< The width of the item masked at each pixel (zero if none).
+        int          m_nDirtyStart; ///< The first pixel set since the last reset.
+        int          m_nDirtyEnd;   ///< One past the last pixel set since the last reset.
+    };
+
+    /// Gets the mask row of the specified lane.
+    /// \param rect the rectangle of the timeline item.
+    /// \param create flag indicating whether or not to add the lane if it does not exist yet.
+    /// \return the mask row, or NULL if the lane does not exist and create is false.
+    MaskRow* findRow(const QRect& rect, bool create);
+
     int m_nBufferWidth;           ///< the width of the buffer.
-    QMap<int, QMap<int, int*> > m_maskBuffer; ///< the mask buffer -- maps from a height to a map that maps from an offset to a list of pixels.
+    QVector<MaskRow> m_maskRows;  ///< the mask rows, one per lane.  Branches typically have only a few lanes, so they are searched linearly.
+    int m_nLastRow;               ///< the index of the most recently used mask row (-1 if none).
 
 };
 
@@ -34,6 +34,10 @@ public:
     int GetVisibleCPUThreadCount()const { return m_visibleCPUThreadCount; }
     QMap<QString, bool>& getThreadVisibilityMap() { return m_threadNameVisibilityMap; }
 
+    /// Gets the branches whose visibility was changed when the dialog was accepted (already applied to the timeline)
+    /// \return the new visibility flag of the changed branches, by branch id
+    const QHash<int, bool>& getVisibilityChanges() const { return m_visibilityChanges; }
+
 private slots:
     /// function called on Ok button clicked
     void OnClickOk();
@@ -78,6 +82,9 @@ private:
     int m_visibleCPUThreadCount;
 
     QMap<QString, bool> m_threadNameVisibilityMap;
+
+    /// the branches whose check state differs from their visibility, by branch id
+    QHash<int, bool> m_visibilityChanges;
 };
 
 #endif //__ACTIMELINEFILTERSDIALOG_H
@@ -0,0 +1,66 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineFrameStats.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINEFRAMESTATS_H_
+#define _ACTIMELINEFRAMESTATS_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Local:
+#include <AMDTApplicationComponents/Include/acApplicationComponentsDLLBuild.h>
+
+/// The number of frames kept by acTimeline when collecting frame statistics.
+#define AC_TIMELINE_FRAME_STATS_HISTORY_SIZE 256
+
+/// Statistics of a single paint of an acTimeline (see acTimeline::setFrameStatsEnabled).
+struct AC_API acTimelineFrameStats
+{
+    quint64 m_nFrameIndex;          ///< The index of the paint, counted from when the statistics were enabled.
+    int     m_nBranchesVisited;     ///< The number of branch rows painted.
+    int     m_nItemsConsidered;     ///< The number of items whose geometry was computed.
+    int     m_nItemsDrawn;          ///< The number of items painted.
+    int     m_nMaskRejects;         ///< The number of items skipped because their pixels were already covered (see acTimelineMaskBuffer).
+    int     m_nTextDraws;           ///< The number of item labels painted.
+    int     m_nAggregatedBars;      ///< The number of aggregated bars painted instead of dense items.
+    int     m_nTilesRendered;       ///< The number of tiles rendered or recorded (tiles blitted from the tile cache are not counted).
+    qint64  m_nTooltipLayoutNs;     ///< The time spent building item tooltips since the previous paint, in nanoseconds.
+    qint64  m_nPaintNs;             ///< The total time of the paint, in nanoseconds.
+
+    /// Construct/Initialize a new instance of the acTimelineFrameStats struct.
+    acTimelineFrameStats() { reset(); }
+
+    /// Resets all the statistics to zero.
+    void reset();
+
+    /// Gets the header line of the CSV format of the statistics.
+    /// \return the comma separated names of the statistics.
+    static QString csvHeader();
+
+    /// Gets the statistics in CSV format.
+    /// \return the comma separated values of the statistics.
+    QString toCsv() const;
+
+    /// Gets the statistics as human readable lines, for the HUD overlay.
+    /// \return one line per statistic.
+    QStringList toLines() const;
+};
+
+/// Writes frame statistics to a CSV file.
+/// \param frames the statistics to write, one line per frame.
+/// \param filePath the path of the file to write.
+/// \return true if the file was written successfully.
+AC_API bool acWriteTimelineFrameStatsCsv(const QList<acTimelineFrameStats>& frames, const QString& filePath);
+
+#endif // _ACTIMELINEFRAMESTATS_H_
@@ -20,11 +20,22 @@
 // forward declarations
 class acTimeline;
 class acTimelineBranch;
+class acTimelineItemBatch;
+class acTimelineRowView;
 class acTimelineItemToolTip;
+class acTimelineItemView;
+class acTimelineTraceItems;
 
 // Local:
 #include <AMDTApplicationComponents/Include/acApplicationComponentsDLLBuild.h>
 
+// The alpha of the background of items painted faded (the items of sub branches, painted in their parent branch):
+#define AC_TIMELINE_FADED_ITEM_ALPHA 50
+
+// The margin by which the painted frame of an item extends out of the painted area, so that the rounded corners of the item ends
+// which are out of the area are never painted into it (larger than the corner radius):
+#define AC_TIMELINE_ITEM_FRAME_MARGIN 8
+
 /// Timeline item class
 class AC_API acTimelineItem : public QObject
 {
@@ -103,7 +114,7 @@ public:
 
     /// Sets the text for this timeline item.
     /// \param newText the text for this timeline item.
-    void setText(const QString newText) { m_strText = newText; }
+    void setText(const QString newText);
 
     /// Gets the text shown in the tooltip when the mouse hovers over this timeline item.
     /// \return the text shown in the tooltip when the mouse hovers over this timeline item.
@@ -129,6 +140,19 @@ public:
     /// \return the index of this item within the owning branch.
     int index();
 
+    /// Gets the index of the compact item represented by this item within the compact item store of the owning branch.
+    /// \return the index of the compact item, or -1 if this item is not a compact item.
+    int compactIndex() const { return m_nCompactIndex; }
+
+    /// Sets the times, background color, text and shape of this item from a compact item. Should only be called by the branch.
+    /// \param compactItem the compact item represented by this item.
+    void setFromCompactItem(const acTimelineItemView& compactItem);
+
+    /// Sets the times, background color, text and shape of this item from a trace item. Should only be called by the branch.
+    /// \param traceItems the trace items of the owning branch.
+    /// \param pos the position of the trace item represented by this item.
+    void setFromTraceItem(const acTimelineTraceItems& traceItems, qint64 pos);
+
     /// Gets the fractional offset of this timeline item. This Should be a value between 0 and 1.
     /// This represents the vertical offset of the top of a timeline item within its parent branch.
     /// The fraction is multiplied by the branch height and then added to the branch top to get the top of the timeline item.
@@ -155,19 +179,52 @@ public:
     /// \param newFractionalHeight the fractional height of this timeline item.
     void setFractionalHeight(const double newFractionalHeight);
 
-    /// Draws this timeline item.
+    /// Draws this timeline item.  The label of the item is not painted, but queued in the label cache of the timeline, and painted
+    /// by the branch over all its items (see acTimelineLabelCache::addRowLabel).
     /// \param painter the painter object to use when painting this item.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
     /// \param branchRowTop the Y coordinate of the top of the owning branch.
     /// \param branchHeight the height of the owning branch.
     /// \param drawGradientBG should the background be painted with gradient
     /// \param shouldUpdateGeometry should the item geometry be updated? Sometimes the item is drawn twice (once in it's own branch, and once in it's parent branch),
     ///        when the item is painted in the parent branch the geomtery should not be updated
-    virtual void draw(QPainter& painter, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry);
+    /// \param drawFaded should the background be painted faded? The items of sub branches are painted faded in their parent branch
+    virtual void draw(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry, bool drawFaded);
+
+    /// Computes the geometry of this timeline item like draw does, but adds its background and selection frame to a batch instead of painting them.
+    /// Items which are not batchable (see isBatchable) return false, so that their own draw is called.
+    /// \param batch the batch the shapes of this item are added to.
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile).
+    /// \param branchRowTop the Y coordinate of the top of the owning branch.
+    /// \param branchHeight the height of the owning branch.
+    /// \param drawGradientBG should the background be painted with gradient
+    /// \param shouldUpdateGeometry should the item geometry be updated? (see draw)
+    /// \param drawFaded should the background be painted faded? (see draw)
+    /// \return true if the item was added to the batch (or is not visible), false if it should be painted with draw.
+    virtual bool drawBatched(acTimelineItemBatch& batch, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry, bool drawFaded);
+
+    /// Gets a flag indicating whether or not this item paints like acTimelineItem::draw, so that drawBatched can add it to a batch.
+    /// A derived class which overrides draw should override this to return false.
+    /// \return true if the item can be batched.
+    virtual bool isBatchable() const { return true; }
+
+    /// Draws this timeline item on top of the pre-rendered tiles of the parent timeline, with its selection or highlight frame.
+    /// Unlike draw, the branch mask is not checked.
+    /// \param painter the painter object to use when painting this item.
+    /// \param branchRowTop the Y coordinate of the top of the row on which this item is displayed.
+    /// \param branchHeight the height of the row on which this item is displayed.
+    virtual void drawOverlay(QPainter& painter, const int branchRowTop, const int branchHeight);
 
     /// Gets the tooltip items for this timeline item.
     /// \param [out] tooltip reference that gets populated with the tooltip contents for this timeline item.
     virtual void tooltipItems(acTimelineItemToolTip& tooltip) const;
 
+    /// Gets a flag indicating whether or not the tooltip of this item is the one of acTimelineItem::tooltipItems, so that it can be
+    /// built by a worker thread from a copy of the item times and text (see acTimelineToolTipBuilder::ItemSnapshot).
+    /// A derived class which overrides tooltipItems should override this to return false.
+    /// \return true if the tooltip of the item can be built from a snapshot of the item.
+    virtual bool hasDefaultToolTip() const { return true; }
+
     /// Set the item shape (rectangle[default], line or dot):
     /// \param shape the requested shape
     void SetItemShape(ItemGraphicShape shape) { m_itemShape = shape; };
@@ -187,29 +244,75 @@ public:
 
 protected:
 
+    /// The painted geometry of an item.  The background of an item only depends on its untrimmed geometry, so an item is painted
+    /// the same whether the painted area is the whole row or a tile of it
+    struct ItemFrame
+    {
+        QRect m_frameRect;          ///< The item rectangle, trimmed to the painted area widened by AC_TIMELINE_ITEM_FRAME_MARGIN
+        int   m_nLeft;              ///< The X coordinate of the untrimmed item
+        int   m_nWidth;             ///< The width of the untrimmed item
+        bool  m_bRoundLeftCorners;  ///< Should the left corners be round? (false when the left end of the item is trimmed)
+        bool  m_bRoundRightCorners; ///< Should the right corners be round? (false when the right end of the item is trimmed)
+    };
+
     /// Draw the item background
     /// \param painter the painter object to use when painting this item
-    /// \param roundLeftCorners should the left corner be round?
-    /// \param roundRightCorners should the left corner be round?
+    /// \param frame the painted geometry of the item
     /// \param drawGradientBG should the background be painted with gradient
-    void DrawItemBackground(QPainter& painter, bool roundLeftCorners, bool roundRightCorners, bool drawGradientBG);
-
-    /// Mark the item as highlighted in case it is selected
+    /// \param drawFaded should the background be painted faded?
+    void DrawItemBackground(QPainter& painter, const ItemFrame& frame, bool drawGradientBG, bool drawFaded);
+
+    /// Builds the frame path of the item (m_itemFramePath)
+    /// \param pTimeline the parent timeline
+    /// \param frame the painted geometry of the item
+    void BuildItemFramePath(acTimeline* pTimeline, const ItemFrame& frame);
+
+    /// Gets the rectangle the background gradient of the item spans: the untrimmed item
+    /// \param frame the painted geometry of the item
+    /// \return the gradient rectangle
+    static QRectF GetItemGradientRect(const ItemFrame& frame);
+
+    /// Gets the background colors of the item, taking into account whether or not the item is faded and the timeline is enabled
+    /// \param pTimeline the parent timeline
+    /// \param drawFaded should the background be painted faded?
+    /// \param [out] blockColor the background color
+    /// \param [out] lightenedColor the lightened background color, used for gradients
+    void GetItemBackgroundColors(acTimeline* pTimeline, bool drawFaded, QColor& blockColor, QColor& lightenedColor);
+
+    /// Checks whether the text of the item fits in its rectangle
+    /// \param pTimeline the parent timeline
+    /// \return true if the text should be painted
+    bool IsItemTextVisible(acTimeline* pTimeline) const;
+
+    /// Mark the item as highlighted in case it is selected.  Not called while painting tiles, which are shared by all the selection states
     /// \param painter the painter object to use when painting this item
     void DrawSelection(QPainter& painter);
 
     /// Draw the text
     void DrawItemText(acTimeline* pTimeline, QPainter& painter);
 
-    // Checks the parent mask, and update m_rect accordingly
-    void CheckParentBranchMask();
+    // Checks the parent mask, and update m_rect accordingly.  The mask is indexed by the untrimmed start of the item, and is split
+    // in tile columns (starting at view.m_nMaskLeft): the items crossing a tile edge set the mask but are never masked, so that
+    // the same items are masked whether the row is painted at once or tile by tile
+    void CheckParentBranchMask(const acTimelineRowView& view, const ItemFrame& frame);
 
-    /// Calculate the item rectangle before drawing it (the function sets m_rect and m_bVisible)
+    /// Calculate the item rectangle before drawing it (the function sets m_rect, trimmed to the painted area, and m_bVisible)
+    /// \param view the part of the timeline rows the item is painted on
     /// \param branchHeight the parent branch height
     /// \param branchRowTop the parent branch top coordinate
-    /// \param roundLeftCorners[out] should the left corner be round?
-    /// \param roundRightCorners[out] should the right corner be round?
-    void CalculateItemRect(const int branchHeight, const int branchRowTop, bool& roundLeftCorners, bool& roundRightCorners);
+    /// \param frame[out] the painted geometry of the item
+    void CalculateItemRect(const acTimelineRowView& view, const int branchHeight, const int branchRowTop, ItemFrame& frame);
+
+    /// Adds the background and selection frame of the item to a batch, and queues its label, like acTimelineItem::draw would paint them (see drawBatched)
+    /// \param batch the batch the shapes of this item are added to
+    /// \param view the part of the timeline rows the item is painted on
+    /// \param branchRowTop the Y coordinate of the top of the owning branch
+    /// \param branchHeight the height of the owning branch
+    /// \param drawGradientBG should the background be painted with gradient
+    /// \param shouldUpdateGeometry should the item geometry be updated? (see draw)
+    /// \param drawFaded should the background be painted faded? (see draw)
+    /// \return true
+    bool AddItemToBatch(acTimelineItemBatch& batch, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry, bool drawFaded);
 
 protected:
 
@@ -228,6 +331,7 @@ protected:
     QString                 m_strText;                      ///< The text for this timeline item.
 
     int                     m_nIndex;                       ///< The index of this item within the owning branch.
+    int                     m_nCompactIndex;                ///< The index of the compact item represented by this item (-1 if this item is not a compact item).
     quint64                 m_nStartTime;                   ///< The start time for this timeline item.
     quint64                 m_nEndTime;                     ///< The end time for this timeline item.
 
@@ -272,6 +376,8 @@ private:
 
     bool m_isSelected; /// <Is the item selected
 
+    /// The batch paints the selection frames of the items it collected
+    friend class acTimelineItemBatch;
 
 };
 
@@ -301,6 +407,10 @@ public:
     /// \param [out] tooltip reference that gets populated with the tooltip contents for this timeline item.
     virtual void tooltipItems(acTimelineItemToolTip& tooltip) const;
 
+    /// The tooltip of API items has a call index row, so it is collected with tooltipItems.
+    /// \return false.
+    virtual bool hasDefaultToolTip() const { return false; }
+
 protected:
     int m_nApiIndex; ///< The index of the API represented by this timeline item.
 };
@@ -309,6 +419,14 @@ protected:
 class AC_API acTimelineItemToolTip : public QObject
 {
 public:
+    /// The formats of the values.  Time values are kept as numbers, and only formatted when the tooltip text is built.
+    enum ValueFormat
+    {
+        VALUE_TEXT,             ///< The value is a string.
+        VALUE_MILLISECONDS,     ///< The value is a time in nanoseconds, displayed in milliseconds.
+        VALUE_DURATION          ///< The value is a duration in nanoseconds, displayed in milliseconds.
+    };
+
     /// Construct/initialize a new instance of the acTimelineItemToolTip class.
     acTimelineItemToolTip();
 
@@ -337,6 +455,18 @@ public:
     /// \return true if the name/value pair could be added, false otehrwise.
     bool add(QString name, QString value);
 
+    /// Adds a name/time pair.  The time is formatted when the value is read.
+    /// \param name the name of for the tooltip item.
+    /// \param time the time, in nanoseconds.
+    /// \return true if the name/time pair could be added, false otherwise.
+    bool addTime(QString name, double time);
+
+    /// Adds a name/duration pair.  The duration is formatted when the value is read.
+    /// \param name the name of for the tooltip item.
+    /// \param duration the duration, in nanoseconds.
+    /// \return true if the name/duration pair could be added, false otherwise.
+    bool addDuration(QString name, quint64 duration);
+
     /// Removes the name/value pair at the given index.
     /// \param index the index of the name/value pair to remove.
     /// \return true if the item could be removed, false otherwise (index is out of bounds).
@@ -352,6 +482,22 @@ public:
     /// \return the value at the given index, NULL if the index is out of bounds.
     QString getValue(int index) const;
 
+    /// Gets the format of the value at the given index.
+    /// \param index the index of the value.
+    /// \return the format of the value, VALUE_TEXT if the index is out of bounds.
+    ValueFormat getFormat(int index) const;
+
+    /// Gets the number (time or duration) of the value at the given index, before it is formatted.
+    /// \param index the index of the value.
+    /// \return the number of the value, 0 if the value is a string or the index is out of bounds.
+    double getNumber(int index) const;
+
+    /// Formats a time or duration value.  Can be called from any thread.
+    /// \param format the format of the value.
+    /// \param number the time or duration, in nanoseconds.
+    /// \return the formatted value.
+    static QString formatNumber(ValueFormat format, double number);
+
     /// Clears all name/value pairs and sets the additional text to an empty string.
     void clear();
 
@@ -362,10 +508,18 @@ private:
         /// Construct/initialize a new instance of the ToolTipItem struct.
         // \param name the name of the tooltip item.
         // \param value the value of the tooltip item.
-        ToolTipItem(QString name, QString value) : m_strName(name), m_strValue(value) {};
+        ToolTipItem(QString name, QString value) : m_strName(name), m_strValue(value), m_format(VALUE_TEXT), m_dNumber(0) {};
+
+        /// Construct/initialize a new instance of the ToolTipItem struct with a time or duration value.
+        // \param name the name of the tooltip item.
+        // \param format the format of the value.
+        // \param number the time or duration.
+        ToolTipItem(QString name, ValueFormat format, double number) : m_strName(name), m_format(format), m_dNumber(number) {};
 
         QString          m_strName;           ///< The name of the tooltip item.
-        QString          m_strValue;          ///< The value of the tooltip item.
+        QString          m_strValue;          ///< The value of the tooltip item (when m_format is VALUE_TEXT).
+        ValueFormat      m_format;            ///< The format of the value.
+        double           m_dNumber;           ///< The time or duration of the tooltip item (when m_format is not VALUE_TEXT).
     };
 
     QList<ToolTipItem*> m_tooltipItems;      ///< The list of name/value pairs.
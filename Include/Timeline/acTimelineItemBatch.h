@@ -0,0 +1,105 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineItemBatch.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINEITEMBATCH_H_
+#define _ACTIMELINEITEMBATCH_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QColor>
+#include <QHash>
+#include <QLine>
+#include <QList>
+#include <QPainterPath>
+#include <QPair>
+#include <QRect>
+#include <QVector>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+class QPainter;
+class acTimelineItem;
+
+/// Collects the shapes of the timeline items painted by a branch, grouped by color, so that they are painted with a few
+/// painter calls instead of changing the painter state for every item (see acTimeline::setBatchedPainting).
+/// Solid rectangles of the same color are painted with a single drawRects call, and lines with a single drawLines call.
+/// Gradient and rounded backgrounds depend on the geometry of each item, so they are filled one by one, but without saving
+/// and restoring the painter state.  The backgrounds are painted first, then the selection frames.  The item texts are drawn
+/// over the whole row by the label cache of the timeline, as when the items are painted one by one.
+class acTimelineItemBatch
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineItemBatch class.
+    acTimelineItemBatch();
+
+    /// Adds a line (the background of an item which is one pixel wide or high).
+    /// \param line the line.
+    /// \param color the color of the line.
+    void addLine(const QLine& line, const QColor& color);
+
+    /// Adds a rectangular item background.
+    /// \param rect the rectangle.
+    /// \param gradientRect the rectangle of the whole item, which the gradient spans.
+    /// \param color the color of the rectangle (the start color, for a gradient).
+    /// \param gradientColor the end color of the gradient, or the same color as color for a solid rectangle.
+    void addRect(const QRect& rect, const QRectF& gradientRect, const QColor& color, const QColor& gradientColor);
+
+    /// Adds an item background with a non rectangular frame (rounded corners).
+    /// \param gradientRect the rectangle of the whole item, which the gradient spans.
+    /// \param path the frame of the item.
+    /// \param color the color of the background (the start color, for a gradient).
+    /// \param gradientColor the end color of the gradient, or the same color as color for a solid background.
+    void addPath(const QRectF& gradientRect, const QPainterPath& path, const QColor& color, const QColor& gradientColor);
+
+    /// Adds an item whose selection (or highlight) frame is painted over the backgrounds.
+    /// \param pItem the item.
+    void addSelection(acTimelineItem* pItem);
+
+    /// Gets a flag indicating whether or not anything was added since the last flush.
+    /// \return true if nothing was added since the last flush.
+    bool isEmpty() const { return m_nUsedBuckets == 0 && m_selections.isEmpty(); }
+
+    /// Paints everything that was added, and empties the batch (keeping the allocated storage).
+    /// \param painter the painter object to use.
+    void flush(QPainter& painter);
+
+private:
+    /// The shapes of a color.
+    struct Bucket
+    {
+        QColor                m_color;         ///< The color of the shapes (the start color of the gradients).
+        QColor                m_gradientColor; ///< The end color of the gradients (the same as m_color for solid shapes).
+        QVector<QLine>        m_lines;         ///< The lines.
+        QVector<QRect>        m_rects;         ///< The rectangles.
+        QVector<QRectF>       m_rectGradients; ///< The gradient rectangles of the items of m_rects (empty for solid shapes).
+        QVector<QRectF>       m_pathGradients; ///< The gradient rectangles of the items of m_paths.
+        QVector<QPainterPath> m_paths;         ///< The non rectangular frames.
+    };
+
+    /// Gets the bucket of the specified colors, adding it if needed.
+    /// \param color the color of the shapes.
+    /// \param gradientColor the end color of the gradients.
+    /// \return the bucket.
+    Bucket& bucket(const QColor& color, const QColor& gradientColor);
+
+    /// Fills a background with a solid color or with a gradient from the top left to the bottom right of the item.
+    /// \param painter the painter object to use.
+    /// \param currentBucket the bucket of the background.
+    /// \param gradientRect the rectangle of the whole item.
+    /// \param pRect the rectangle to fill, or NULL to fill the frame.
+    /// \param pPath the frame of the item, when pRect is NULL.
+    void fillBackground(QPainter& painter, const Bucket& currentBucket, const QRectF& gradientRect, const QRect* pRect, const QPainterPath* pPath);
+
+    QVector<Bucket>              m_buckets;      ///< The buckets, in the order their first shape was added.
+    int                          m_nUsedBuckets; ///< The number of buckets in use.  Unused buckets are kept to reuse their storage.
+    QHash<QPair<QRgb, QRgb>, int> m_bucketIndex; ///< The index of the bucket of each pair of colors.
+    QList<acTimelineItem*>       m_selections;   ///< The items whose selection frame should be painted.
+};
+
+#endif // _ACTIMELINEITEMBATCH_H_
@@ -10,8 +10,8 @@
 #define _ACTIMELINEITEMCURVE_H_
 
 
-#include <QMap>
 #include <QList>
+#include <QVector>
 #include <QWidget>
 #include <QPainter>
 
@@ -19,8 +19,11 @@
 // Local:
 #include <AMDTApplicationComponents/Include/acApplicationComponentsDLLBuild.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTimeTransform.h>
 
 /// class that draw a line graph along the timeline using a set of points
+/// The samples are kept sorted by time in contiguous arrays, with a pyramid of the minimum and maximum values of aligned
+/// blocks of samples, so that painting only visits the visible samples and emits at most four points per pixel column.
 class AC_API acTimelineItemCurve : public acTimelineItem
 {
     Q_OBJECT
@@ -28,14 +31,59 @@ class AC_API acTimelineItemCurve : public acTimelineItem
 public:
     acTimelineItemCurve();
 
-    virtual void draw(QPainter& painter, const int branchRowTop, const int branchHeight);
+    /// Draws the curve for the visible time range.  Several samples falling within the same pixel column are drawn as a
+    /// vertical span from the first sample to the minimum, the maximum and the last sample of the column.
+    /// \param painter the painter object to use when painting this item
+    /// \param view the part of the timeline rows to paint on (the visible part of the rows, or a tile)
+    /// \param branchRowTop the Y coordinate of the top of the owning branch
+    /// \param branchHeight the height of the owning branch
+    /// \param drawGradientBG not used by curves
+    /// \param shouldUpdateGeometry should the item rectangle be updated to the part of the row covered by the curve?
+    /// \param drawFaded should the curve be painted faded?
+    virtual void draw(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry, bool drawFaded);
 
+    /// Curves are not painted like regular items, so they are never batched.
+    /// \return false, so that the curve is painted with draw.
+    virtual bool isBatchable() const { return false; }
+
+    /// Curves have no selection or highlight frame, so nothing is painted on top of the tiles.
+    virtual void drawOverlay(QPainter& painter, const int branchRowTop, const int branchHeight);
+
+    /// Adds a sample to the curve (replacing the value of an existing sample with the same time stamp).
+    /// Samples added in order of time stamp only update the tail of the min/max pyramid.
+    /// The start and end times of the item follow the time range of the samples, so that the owning branch finds the curve
+    /// when it looks up the items overlapping the visible time range.
+    /// \param timeStamp the time of the sample
+    /// \param value the value of the sample
     void addTimestampValuePair(quint64 timeStamp, float value);
 
     void setSolid(const bool newValue) { m_bSolid = newValue; }
 
 private:
 
+    /// Recomputes the blocks of the min/max pyramid containing the specified sample and all the samples after it.
+    /// \param firstSample the index of the first changed sample
+    void updatePyramidTail(int firstSample);
+
+    /// Gets the minimum and maximum values of a range of samples, using the largest pyramid blocks within the range.
+    /// \param firstSample the index of the first sample of the range
+    /// \param endSample one past the index of the last sample of the range
+    /// \param [out] minValue the minimum value
+    /// \param [out] maxValue the maximum value
+    void rangeMinMax(int firstSample, int endSample, float& minValue, float& maxValue) const;
+
+    /// Gets the end of the run of samples drawn in the same pixel column as the specified sample.
+    /// \param timeTransform the time transform of the parent timeline
+    /// \param firstSample the index of the first sample of the column
+    /// \param endSample one past the index of the last sample to consider
+    /// \param x the pixel column of the first sample
+    /// \return one past the index of the last sample of the column
+    int columnEnd(const acTimelineTimeTransform& timeTransform, int firstSample, int endSample, int x) const;
+
+    /// Appends a point to m_pointBuffer, unless it is the same as the last point.
+    /// \param point the point
+    void appendPoint(const QPoint& point);
+
     float m_fMaxValue;
     double m_dInvMaxValue;
     quint64 m_nMinTime;
@@ -51,7 +99,10 @@ private:
 #pragma warning(disable : 4512)
 #endif
     QVector<QPoint> m_pointBuffer;
-    QMap<quint64, float> m_samplePairs; ///< map of the samples to plot along the curve
+    QVector<quint64> m_sampleTimes;           ///< the time stamps of the samples, in increasing order
+    QVector<float> m_sampleValues;            ///< the values of the samples, in the order of m_sampleTimes
+    QVector<QVector<float> > m_minLevels;     ///< the minimum values of aligned blocks of samples.  The blocks of level k contain 2^(k+1) samples
+    QVector<QVector<float> > m_maxLevels;     ///< the maximum values of aligned blocks of samples, with the same layout as m_minLevels
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
@@ -0,0 +1,200 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineItemIndex.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINEITEMINDEX_H_
+#define _ACTIMELINEITEMINDEX_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QVector>
+#include <QColor>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+/// Interval index over the items of a timeline branch.
+/// Items are kept sorted by start time together with a running maximum of their end times.
+/// This allows finding the items that overlap a time window with two binary searches, regardless of
+/// the order in which the items were added, and including long items that start before the window.
+class acTimelineItemIntervalIndex
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineItemIntervalIndex class.
+    acTimelineItemIntervalIndex() : m_bBuilt(true), m_bSorted(true) {}
+
+    /// Removes all intervals from the index.
+    void clear();
+
+    /// Reserves storage for the specified number of intervals.
+    /// \param count the number of intervals to reserve storage for.
+    void reserve(int count);
+
+    /// Appends an interval to the index. The interval gets the next item index (i.e. the current count).
+    /// Appending an interval which does not start before the last one keeps the index built.
+    /// \param startTime the start time of the interval.
+    /// \param endTime the end time of the interval.
+    void append(quint64 startTime, quint64 endTime);
+
+    /// Sorts the intervals by start time (if needed) and computes the running maximum of the end times.
+    void build();
+
+    /// Gets a flag indicating whether or not the index is ready to be queried.
+    /// \return true if the index is built, false if build() should be called before querying.
+    bool isBuilt() const { return m_bBuilt; }
+
+    /// Gets the number of intervals in the index.
+    /// \return the number of intervals in the index.
+    int count() const { return m_startTimes.count(); }
+
+    /// Finds the range of sorted positions which may contain intervals overlapping the specified time window.
+    /// Every interval overlapping the window is within the range. Intervals within the range may still end
+    /// before the window starts, so callers should check endTime(pos) when an exact answer is needed.
+    /// \param rangeStart the start of the time window.
+    /// \param rangeEnd the end of the time window.
+    /// \param[out] firstPos the first sorted position within the range.
+    /// \param[out] lastPos one past the last sorted position within the range.
+    /// \return true if the range is not empty, false otherwise.
+    bool findOverlapping(quint64 rangeStart, quint64 rangeEnd, int& firstPos, int& lastPos) const;
+
+    /// Gets the item index of the interval at the specified sorted position.
+    /// \param pos the sorted position.
+    /// \return the index of the item (in insertion order) at the specified sorted position.
+    int itemIndex(int pos) const { return m_itemIndices.isEmpty() ? pos : m_itemIndices[pos]; }
+
+    /// Gets the start time of the interval at the specified sorted position.
+    /// \param pos the sorted position.
+    /// \return the start time of the interval at the specified sorted position.
+    quint64 startTime(int pos) const { return m_startTimes[pos]; }
+
+    /// Gets the end time of the interval at the specified sorted position.
+    /// \param pos the sorted position.
+    /// \return the end time of the interval at the specified sorted position.
+    quint64 endTime(int pos) const { return m_endTimes[pos]; }
+
+private:
+    QVector<quint64> m_startTimes;      ///< Start times, in sorted order once built.
+    QVector<quint64> m_endTimes;        ///< End times, in the same order as m_startTimes.
+    QVector<quint64> m_maxEndTimes;     ///< Running maximum of m_endTimes.  Only valid when the index is built.
+    QVector<int>     m_itemIndices;     ///< Maps a sorted position to an item index.  Empty while the mapping is the identity.
+    bool             m_bBuilt;          ///< Flag indicating whether or not the index is sorted and m_maxEndTimes is up to date.
+    bool             m_bSorted;         ///< Flag indicating whether or not the intervals are currently sorted by start time.
+};
+
+/// Multi-resolution summary of the items of a timeline branch, used to paint dense branches when zoomed out.
+/// The base level divides the time range of the branch into buckets (a power of two of them), and each upper level
+/// merges pairs of buckets of the level below.  An item is counted in the bucket containing its start time.
+class acTimelineItemSummaryPyramid
+{
+public:
+    /// Summary of the items starting within a single time bucket.
+    struct Bucket
+    {
+        quint32 m_count;                    ///< The number of items starting within the bucket.
+        QRgb    m_dominantColor;            ///< The color covering the most time within the bucket.
+        quint64 m_dominantColorDuration;    ///< The total duration of the items with the dominant color.
+        quint64 m_minDuration;              ///< The duration of the shortest item.
+        quint64 m_maxDuration;              ///< The duration of the longest item.
+        quint64 m_maxEndTime;               ///< The latest end time of the items.
+    };
+
+    /// Construct/Initialize a new instance of the acTimelineItemSummaryPyramid class.
+    acTimelineItemSummaryPyramid() : m_nStartTime(0), m_nBucketDuration(1), m_nItemCount(0), m_nTotalDuration(0), m_nLastStartTime(0), m_nCurrentBucket(-1) {}
+
+    /// Removes all levels from the pyramid.
+    void clear();
+
+    /// Starts building the pyramid.  Should be followed by calls to addItem (in order of start time) and a call to finish.
+    /// \param startTime the start of the time range covered by the pyramid.
+    /// \param endTime the end of the time range covered by the pyramid.
+    /// \param itemCount the number of items which will be added.  Used to choose the resolution of the base level.
+    void begin(quint64 startTime, quint64 endTime, int itemCount);
+
+    /// Adds an item to the base level.  Items must be added in order of their start time.
+    /// \param startTime the start time of the item.
+    /// \param endTime the end time of the item.
+    /// \param color the color of the item.
+    void addItem(quint64 startTime, quint64 endTime, QRgb color);
+
+    /// Builds the upper levels of the pyramid from the base level.
+    void finish();
+
+    /// Adds an item to a finished pyramid, updating only the buckets containing it.
+    /// \param startTime the start time of the item.
+    /// \param endTime the end time of the item.
+    /// \param color the color of the item.
+    /// \return false if the item starts before the last summarized item or after the time range covered by the pyramid, in which case the pyramid should be rebuilt.
+    bool appendItem(quint64 startTime, quint64 endTime, QRgb color);
+
+    /// Gets a flag indicating whether or not the pyramid contains any level.
+    /// \return true if the pyramid is empty, false otherwise.
+    bool isEmpty() const { return m_levels.isEmpty(); }
+
+    /// Gets the number of levels in the pyramid.
+    /// \return the number of levels in the pyramid.
+    int levelCount() const { return m_levels.count(); }
+
+    /// Gets the coarsest level whose buckets are not longer than the specified duration.
+    /// \param maxBucketDuration the maximum duration of a bucket (typically the duration of one pixel).
+    /// \return the level, or -1 if even the base level buckets are longer than the specified duration.
+    int levelForResolution(double maxBucketDuration) const;
+
+    /// Gets the start of the time range covered by the pyramid.
+    /// \return the start of the time range covered by the pyramid.
+    quint64 startTime() const { return m_nStartTime; }
+
+    /// Gets the duration of a bucket at the specified level.
+    /// \param level the level.
+    /// \return the duration of a bucket at the specified level.
+    quint64 bucketDuration(int level) const { return m_nBucketDuration << level; }
+
+    /// Gets the number of buckets at the specified level.
+    /// \param level the level.
+    /// \return the number of buckets at the specified level.
+    int bucketCount(int level) const { return m_levels[level].count(); }
+
+    /// Gets the index of the bucket containing the specified time at the specified level.
+    /// \param level the level.
+    /// \param time the time.
+    /// \return the index of the bucket, clamped to the valid range of bucket indices.
+    int bucketIndex(int level, quint64 time) const;
+
+    /// Gets the bucket at the specified level and index.
+    /// \param level the level.
+    /// \param index the index of the bucket.
+    /// \return the bucket at the specified level and index.
+    const Bucket& bucket(int level, int index) const { return m_levels[level][index]; }
+
+    /// Gets the mean duration of the summarized items.
+    /// \return the mean duration of the summarized items.
+    double meanDuration() const { return m_nItemCount > 0 ? m_nTotalDuration / (double)m_nItemCount : 0; }
+
+private:
+    /// Computes the dominant color of the bucket currently being filled.
+    void updateCurrentBucketColor();
+
+    /// Computes the dominant color of the bucket currently being filled, and stops filling it.
+    void flushCurrentBucket();
+
+    /// Merges two adjacent buckets into a bucket of the level above.
+    /// \param left the earlier bucket.
+    /// \param right the later bucket.
+    /// \param merged the merged bucket.
+    static void mergeBuckets(const Bucket& left, const Bucket& right, Bucket& merged);
+
+    quint64                     m_nStartTime;       ///< The start of the time range covered by the pyramid.
+    quint64                     m_nBucketDuration;  ///< The duration of a base level bucket.
+    quint64                     m_nItemCount;       ///< The number of summarized items.
+    quint64                     m_nTotalDuration;   ///< The total duration of the summarized items.
+    quint64                     m_nLastStartTime;   ///< The start time of the last summarized item.
+    QVector<QVector<Bucket> >   m_levels;           ///< The levels of the pyramid.  Level zero is the base (finest) level.
+
+    int                         m_nCurrentBucket;   ///< The index of the base level bucket currently being filled by addItem (-1 if none).
+    QVector<QPair<QRgb, quint64> > m_currentColors; ///< Total duration per color for the bucket currently being filled.
+};
+
+#endif // _ACTIMELINEITEMINDEX_H_
@@ -0,0 +1,169 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineItemStore.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINEITEMSTORE_H_
+#define _ACTIMELINEITEMSTORE_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QVector>
+#include <QHash>
+#include <QString>
+#include <QColor>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Local:
+#include <AMDTApplicationComponents/Include/acApplicationComponentsDLLBuild.h>
+
+/// The bits of the compact item flags which hold the item shape (an acTimelineItem::ItemGraphicShape value).
+#define AC_TIMELINE_COMPACT_ITEM_SHAPE_MASK 0x03
+
+class acTimelineItemStore;
+
+/// Lightweight (flyweight) view of a single item of an acTimelineItemStore.
+/// A view is only valid as long as the store it refers to exists.
+class AC_API acTimelineItemView
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineItemView class.
+    /// \param pStore the store containing the item.
+    /// \param index the index of the item within the store.
+    acTimelineItemView(const acTimelineItemStore* pStore, int index) : m_pStore(pStore), m_nIndex(index) {}
+
+    /// Gets a flag indicating whether or not this view refers to an existing item.
+    /// \return true if the view refers to an existing item, false otherwise.
+    bool isValid() const;
+
+    /// Gets the index of the item within the store.
+    /// \return the index of the item within the store.
+    int index() const { return m_nIndex; }
+
+    /// Gets the start time of the item.
+    /// \return the start time of the item.
+    quint64 startTime() const;
+
+    /// Gets the end time of the item.
+    /// \return the end time of the item.
+    quint64 endTime() const;
+
+    /// Gets the background color of the item.
+    /// \return the background color of the item.
+    QColor backgroundColor() const;
+
+    /// Gets the text of the item.
+    /// \return the text of the item.
+    const QString& text() const;
+
+    /// Gets the flags of the item.
+    /// \return the flags of the item.
+    quint8 flags() const;
+
+private:
+    const acTimelineItemStore* m_pStore; ///< The store containing the item.
+    int                        m_nIndex; ///< The index of the item within the store.
+};
+
+/// Compact struct-of-arrays storage for timeline items.
+/// Each item takes two times, a palette index, a string id and a flags byte, kept in contiguous vectors, instead of a
+/// separately allocated acTimelineItem object.  Colors and texts are interned, so repeated values are only stored once.
+class AC_API acTimelineItemStore
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineItemStore class.
+    acTimelineItemStore() {}
+
+    /// Removes all items, colors and texts from the store.
+    void clear();
+
+    /// Reserves storage for the specified number of items.
+    /// \param count the number of items to reserve storage for.
+    void reserve(int count);
+
+    /// Adds an item to the store.
+    /// \param startTime the start time of the item.
+    /// \param endTime the end time of the item.
+    /// \param backgroundColor the background color of the item.
+    /// \param text the text of the item.
+    /// \param flags the flags of the item (see AC_TIMELINE_COMPACT_ITEM_SHAPE_MASK).
+    /// \return the index of the new item.
+    int addItem(quint64 startTime, quint64 endTime, const QColor& backgroundColor, const QString& text, quint8 flags);
+
+    /// Gets the number of items in the store.
+    /// \return the number of items in the store.
+    int count() const { return m_startTimes.count(); }
+
+    /// Gets a view of the item at the specified index.
+    /// \param index the index of the item.
+    /// \return a view of the item at the specified index.
+    acTimelineItemView item(int index) const { return acTimelineItemView(this, index); }
+
+    /// Gets the start time of the item at the specified index.
+    /// \param index the index of the item.
+    /// \return the start time of the item.
+    quint64 startTime(int index) const { return m_startTimes[index]; }
+
+    /// Gets the end time of the item at the specified index.
+    /// \param index the index of the item.
+    /// \return the end time of the item.
+    quint64 endTime(int index) const { return m_endTimes[index]; }
+
+    /// Gets the background color of the item at the specified index.
+    /// \param index the index of the item.
+    /// \return the background color of the item.
+    QRgb backgroundColor(int index) const { return m_palette[m_paletteIndices[index]]; }
+
+    /// Gets the text of the item at the specified index.
+    /// \param index the index of the item.
+    /// \return the text of the item.
+    const QString& text(int index) const { return m_strings[m_textIds[index]]; }
+
+    /// Gets the string pool id of the text of the item at the specified index.
+    /// \param index the index of the item.
+    /// \return the string pool id of the text of the item.
+    quint32 textId(int index) const { return m_textIds[index]; }
+
+    /// Gets the number of distinct texts in the string pool.
+    /// \return the number of distinct texts (the string pool ids are 0 to stringCount() - 1).
+    int stringCount() const { return m_strings.count(); }
+
+    /// Gets a text of the string pool.
+    /// \param stringId the string pool id of the text.
+    /// \return the text.
+    const QString& string(quint32 stringId) const { return m_strings[stringId]; }
+
+    /// Gets the flags of the item at the specified index.
+    /// \param index the index of the item.
+    /// \return the flags of the item.
+    quint8 flags(int index) const { return m_flags[index]; }
+
+private:
+    /// Gets the palette index of the specified color, adding the color to the palette if needed.
+    /// \param color the color.
+    /// \return the palette index of the color.
+    quint16 internColor(QRgb color);
+
+    /// Gets the id of the specified text, adding the text to the string pool if needed.
+    /// \param text the text.
+    /// \return the id of the text.
+    quint32 internText(const QString& text);
+
+    QVector<quint64>         m_startTimes;      ///< The start times of the items.
+    QVector<quint64>         m_endTimes;        ///< The end times of the items.
+    QVector<quint16>         m_paletteIndices;  ///< The palette index of the background color of the items.
+    QVector<quint32>         m_textIds;         ///< The string pool id of the text of the items.
+    QVector<quint8>          m_flags;           ///< The flags of the items.
+
+    QVector<QRgb>            m_palette;         ///< The distinct colors used by the items.
+    QHash<QRgb, quint16>     m_paletteLookup;   ///< Maps a color to its palette index.
+    QVector<QString>         m_strings;         ///< The distinct texts used by the items.
+    QHash<QString, quint32>  m_stringLookup;    ///< Maps a text to its string pool id.
+};
+
+#endif // _ACTIMELINEITEMSTORE_H_
@@ -0,0 +1,124 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineLabelCache.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINELABELCACHE_H_
+#define _ACTIMELINELABELCACHE_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QPair>
+#include <QRect>
+#include <QStaticText>
+#include <QString>
+#include <QVector>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+class QPainter;
+
+/// The granularity in pixels of the available widths labels are elided to.
+#define AC_TIMELINE_LABEL_WIDTH_BUCKET 8
+
+/// The default maximum number of labels kept by the timeline label cache.
+#define AC_TIMELINE_LABEL_CACHE_DEFAULT_CAPACITY 16384
+
+/// Cache of the laid out item labels of a timeline, so that the text of an item is shaped once rather than on every paint.
+/// A label which fits in the item is kept as a single QStaticText per string.  A label which does not fit is elided to the
+/// available width, rounded down to a multiple of AC_TIMELINE_LABEL_WIDTH_BUCKET, and kept per string and width bucket.
+/// All labels are laid out with the font of the cache, and are dropped when the font changes.  When the cache holds more than
+/// its capacity, all labels are dropped (item names are usually repeated, so the cache refills with the labels in use).
+/// The labels of the items of a row are collected while the items are painted (addRowLabel), and drawn over all the items of the
+/// row once they are painted (drawRowLabels), whether the items are painted directly, batched or from tiles.
+class acTimelineLabelCache
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineLabelCache class.
+    acTimelineLabelCache();
+
+    /// Sets the font the labels are laid out with.  Removes all labels if the font changed.
+    /// \param font the font of the timeline.
+    void setFont(const QFont& font);
+
+    /// Removes all labels from the cache.
+    void clear();
+
+    /// Sets the maximum number of labels kept by the cache.
+    /// \param capacity the maximum number of labels.
+    void setCapacity(int capacity) { m_nCapacity = capacity; }
+
+    /// Gets a flag indicating whether or not an item label can be displayed in the specified rectangle (the rectangle is
+    /// wider than an average character and at least as high as a line).
+    /// \param rect the rectangle of the item.
+    /// \return true if a label can be displayed in the rectangle.
+    bool isTextVisible(const QRect& rect) const { return isTextVisibleInWidth(rect.width()) && rect.height() >= m_nLineSpacing; }
+
+    /// Gets a flag indicating whether or not an item label can be displayed in an item of the specified width (see isTextVisible).
+    /// \param width the width of the item.
+    /// \return true if the item is wide enough for a label.
+    bool isTextVisibleInWidth(int width) const { return width > m_nAverageCharWidth; }
+
+    /// Draws a label centered in the specified rectangle, elided if it does not fit, with the current pen of the painter.
+    /// \param painter the painter object to use.
+    /// \param rect the rectangle of the item.
+    /// \param text the text of the label.
+    /// \return false if nothing was drawn, because not even an elided label fits in the rectangle.
+    bool drawLabel(QPainter& painter, const QRect& rect, const QString& text);
+
+    /// Adds a label to the labels of the row being painted.
+    /// \param rect the rectangle of the item, within the painted part of the row.
+    /// \param color the color of the label.
+    /// \param text the text of the label.
+    void addRowLabel(const QRect& rect, const QColor& color, const QString& text);
+
+    /// Draws the labels added since the last call, centered in their rectangles, and removes them.
+    /// \param painter the painter object to use.  The labels are drawn with its pen, changing only the color.
+    /// \return the number of labels drawn.
+    int drawRowLabels(QPainter& painter);
+
+private:
+    /// A laid out label.
+    struct Label
+    {
+        QStaticText m_staticText; ///< The laid out text.
+        QSizeF      m_size;       ///< The size of the laid out text.
+        bool        m_bEmpty;     ///< Flag indicating that nothing fits in the available width.
+    };
+
+    /// A label of the row being painted.
+    struct RowLabel
+    {
+        QRect   m_rect;     ///< The rectangle the label is centered in.
+        QRgb    m_color;    ///< The color of the label.
+        QString m_text;     ///< The text of the label.
+    };
+
+    /// Lays out a label with the font of the cache.
+    /// \param text the text of the label.
+    /// \param [out] label the laid out label.
+    void layoutLabel(const QString& text, Label& label) const;
+
+    /// Gets the label of the specified text which fits in the specified width, laying it out if needed.
+    /// \param text the text of the label.
+    /// \param availableWidth the width available for the label.
+    /// \return the label, or NULL if nothing fits in the available width.
+    const Label* label(const QString& text, int availableWidth);
+
+    QFont                               m_font;              ///< The font the labels are laid out with.
+    int                                 m_nAverageCharWidth; ///< The average character width of m_font.
+    int                                 m_nLineSpacing;      ///< The line spacing of m_font.
+    int                                 m_nCapacity;         ///< The maximum number of labels kept by the cache.
+    QHash<QString, Label>               m_fullLabels;        ///< The labels which are not elided, by text.
+    QHash<QPair<QString, int>, Label>   m_elidedLabels;      ///< The elided labels, by text and width bucket.
+    QVector<RowLabel>                   m_rowLabels;         ///< The labels of the row being painted.
+};
+
+#endif // _ACTIMELINELABELCACHE_H_
@@ -0,0 +1,136 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineRangeStats.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINERANGESTATS_H_
+#define _ACTIMELINERANGESTATS_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QAtomicInt>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Local:
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemIndex.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemStore.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTraceFile.h>
+
+class QObject;
+class acTimelineBranch;
+
+/// The default number of item texts listed by the statistics of a branch (see acTimelineBranchRangeStats::m_topTexts).
+#define AC_TIMELINE_RANGE_STATS_DEFAULT_TOP_TEXTS 10
+
+/// Snapshot of the items of a branch overlapping a time range, taken on the GUI thread so that the statistics of the range can be
+/// computed on a worker thread while items are still being added to the branch.  The acTimelineItem objects overlapping the range
+/// are copied, the compact items are shared with the branch (their vectors are copied on write) and the trace items are read from
+/// the mapping.
+struct acTimelineRangeItems
+{
+    QVector<quint64>            m_startTimes;       ///< The start times of the acTimelineItem objects overlapping the range.
+    QVector<quint64>            m_endTimes;         ///< The end times of the acTimelineItem objects overlapping the range.
+    QVector<QString>            m_texts;            ///< The texts of the acTimelineItem objects overlapping the range.
+    acTimelineItemStore         m_compactItems;     ///< The compact items of the branch.
+    acTimelineItemIntervalIndex m_compactItemIndex; ///< The built interval index of m_compactItems.
+    acTimelineTraceItems        m_traceItems;       ///< The trace items of the branch.
+};
+
+/// The number of items and total duration of the items of a branch with the same text, within a time range.
+struct acTimelineRangeTextStats
+{
+    QString m_text;             ///< The text of the items.
+    quint64 m_nItemCount;       ///< The number of items with the text.
+    quint64 m_nTotalDuration;   ///< The total duration of the items with the text, within the range.
+};
+
+/// The statistics of the items of a branch (not including sub branches) overlapping a time range.  The durations are clipped to the
+/// range, so that they add up to the time the items take within the selection.
+struct acTimelineBranchRangeStats
+{
+    acTimelineBranch*                   m_pBranch;          ///< The branch.
+    quint64                             m_nItemCount;       ///< The number of items overlapping the range.
+    quint64                             m_nTotalDuration;   ///< The total duration of the items within the range.
+    quint64                             m_nMinDuration;     ///< The shortest duration of an item within the range (0 if there are no items).
+    quint64                             m_nMaxDuration;     ///< The longest duration of an item within the range.
+    QVector<acTimelineRangeTextStats>   m_topTexts;         ///< The item texts with the longest total duration, longest first.
+
+    /// Gets the mean duration of the items within the range.
+    /// \return the mean duration of the items within the range (0 if there are no items).
+    double meanDuration() const { return (m_nItemCount > 0) ? (double)m_nTotalDuration / m_nItemCount : 0.0; }
+};
+
+/// Computes the statistics of the branches of a timeline within a time range, one branch per job on a pool of worker threads.
+/// When the statistics of all the branches of a request are computed, the finished slot of the receiver is invoked (queued) on the
+/// GUI thread, and the statistics can be collected with takeResults.  Submitting a request cancels the previous one.
+class acTimelineRangeStatsCalculator
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineRangeStatsCalculator class.
+    /// \param pReceiver the object notified when the statistics are computed.
+    /// \param finishedSlot the name of the slot of the receiver invoked when the statistics are computed.
+    acTimelineRangeStatsCalculator(QObject* pReceiver, const char* finishedSlot);
+
+    /// Destructor.  Cancels the queued jobs and waits for the running ones.
+    ~acTimelineRangeStatsCalculator();
+
+    /// Queues the computation of the statistics of the specified branches within a time range.
+    /// \param rangeStart the start of the time range.
+    /// \param rangeEnd the end of the time range.
+    /// \param topTextCount the number of item texts listed for each branch.
+    /// \param branches the branches.
+    void submit(quint64 rangeStart, quint64 rangeEnd, int topTextCount, const QList<acTimelineBranch*>& branches);
+
+    /// Cancels the current request.  Queued jobs are removed from the pool, running jobs are discarded when they finish.
+    void cancel();
+
+    /// Cancels the current request, and waits for the running jobs to finish.  The jobs read the items of the branches (including
+    /// the trace items, from the mapping of their trace file), so this must be called before the branches or the trace file are released.
+    void cancelAndWait();
+
+    /// Collects the statistics of the current request, once they are all computed.
+    /// \param[out] rangeStart the start of the time range of the request.
+    /// \param[out] rangeEnd the end of the time range of the request.
+    /// \param[out] stats the statistics of each branch, in the order the branches were submitted.
+    /// \return true if the statistics were collected, false if the request was cancelled or is not finished.
+    bool takeResults(quint64& rangeStart, quint64& rangeEnd, QVector<acTimelineBranchRangeStats>& stats);
+
+    /// Computes the statistics of the items of a branch within a time range.  Called from the worker threads.
+    /// \param items the snapshot of the items of the branch.
+    /// \param rangeStart the start of the time range.
+    /// \param rangeEnd the end of the time range.
+    /// \param topTextCount the number of item texts to list.
+    /// \param[out] stats the statistics of the branch (m_pBranch is not set).
+    static void computeStats(const acTimelineRangeItems& items, quint64 rangeStart, quint64 rangeEnd, int topTextCount, acTimelineBranchRangeStats& stats);
+
+private:
+    class Job;
+
+    /// Stores the statistics of a branch, and notifies the receiver when the request is complete.  Called from the worker threads.
+    /// \param branchIndex the index of the branch within the request.
+    /// \param stats the statistics of the branch.
+    /// \param generation the generation the job was submitted in.
+    void addResult(int branchIndex, const acTimelineBranchRangeStats& stats, int generation);
+
+    QObject*                            m_pReceiver;        ///< The object notified when the statistics are computed.
+    const char*                         m_finishedSlot;     ///< The name of the slot of the receiver invoked when the statistics are computed.
+    QThreadPool                         m_threadPool;       ///< The worker threads.
+    QAtomicInt                          m_generation;       ///< Incremented by submit and cancel, so that the running jobs know their results are not needed anymore.
+    QMutex                              m_resultsMutex;     ///< Guards the members below.
+    quint64                             m_nRangeStart;      ///< The start of the time range of the current request.
+    quint64                             m_nRangeEnd;        ///< The end of the time range of the current request.
+    QVector<acTimelineBranchRangeStats> m_results;          ///< The statistics of the branches of the current request.
+    int                                 m_nPendingCount;    ///< The number of branches of the current request whose statistics are not computed yet (-1 if there is no request).
+};
+
+#endif // _ACTIMELINERANGESTATS_H_
@@ -0,0 +1,128 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineRowLayout.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINEROWLAYOUT_H_
+#define _ACTIMELINEROWLAYOUT_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+class acTimelineBranch;
+
+/// Vertical layout of the branch rows of a timeline.
+/// The rows are kept in display order (the branches in pre-order), in a segment tree of row heights, so that the
+/// height of the rows above a position and the row at a Y coordinate are found in O(log n).  The rows of folded and
+/// hidden branches stay in the tree, covered by a counter on the nodes spanning them, so that folding, unfolding,
+/// hiding or showing a branch only updates O(log n) nodes however many rows it contains.
+class acTimelineRowLayout
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineRowLayout class.
+    acTimelineRowLayout();
+
+    /// Lays out the rows of the specified branches and of all their sub branches, and assigns the row index of every branch.
+    /// \param branches the top level branches of the timeline.
+    void build(const QList<acTimelineBranch*>& branches);
+
+    /// Adds the rows of a branch which was added to the timeline (and of its sub branches) without laying out all the rows again.
+    /// This is only possible when the rows of the branch come after all the existing rows, and none of its parents are folded or hidden.
+    /// \param pBranch the added branch.
+    /// \return false if the rows could not be added, in which case the layout should be built again.
+    bool appendBranch(acTimelineBranch* pBranch);
+
+    /// Removes all the rows.
+    void clear();
+
+    /// Gets a flag indicating whether or not the specified branch has a row in the layout.
+    /// \param pBranch the branch.
+    /// \return true if the branch has a row in the layout.
+    bool contains(const acTimelineBranch* pBranch) const { return m_rowOfBranch.contains(pBranch); }
+
+    /// Updates the row of the specified branch after its height, folded state or visibility changed.
+    /// \param pBranch the branch whose row should be updated.
+    void updateRow(const acTimelineBranch* pBranch);
+
+    /// Gets the height of all the displayed rows.
+    /// \return the height of all the displayed rows.
+    int totalHeight() const { return m_sums.isEmpty() ? 0 : m_sums[1]; }
+
+    /// Gets the height of the displayed rows of the specified branch and of its sub branches.
+    /// \param pBranch the branch.
+    /// \return the height of the displayed rows of the branch, or 0 if the branch is not displayed (or has no row in the layout).
+    int subtreeHeight(const acTimelineBranch* pBranch) const;
+
+    /// Gets the branch displayed at the specified Y coordinate.
+    /// \param y the Y coordinate, relative to the top of the first row.
+    /// \return the branch displayed at the Y coordinate, or NULL if there is no row there.
+    acTimelineBranch* branchAt(int y) const;
+
+private:
+    /// A branch row.
+    struct Row
+    {
+        acTimelineBranch* m_pBranch;    ///< The branch of the row.
+        int               m_nParentRow; ///< The row of the parent branch (-1 for top level branches).
+        int               m_nEnd;       ///< One past the last row of the sub branches of the branch.
+        int               m_nHeight;    ///< The height of the row, as stored in the tree.
+        bool              m_bFolded;    ///< Flag indicating that the rows of the sub branches are covered, because the branch is folded.
+        bool              m_bHidden;    ///< Flag indicating that the rows of the branch are covered, because the branch is hidden.
+    };
+
+    /// Appends the rows of the specified branch and of its sub branches (in pre-order).
+    /// \param pBranch the branch.
+    /// \param parentRow the row of the parent branch (-1 for top level branches).
+    void addRows(acTimelineBranch* pBranch, int parentRow);
+
+    /// Allocates the tree for the current rows and fills it with their heights and covers.
+    void buildTree();
+
+    /// Applies the height, folded state and visibility of the branch of the specified row to the tree.
+    /// \param row the row.
+    void updateRowState(int row);
+
+    /// Sets the height of the specified row in the tree.
+    /// \param row the row.
+    /// \param height the height of the row.
+    void setRowHeight(int row, int height);
+
+    /// Adds to the cover counter of a range of rows.
+    /// \param node the tree node.
+    /// \param nodeFirst the first row spanned by the node.
+    /// \param nodeEnd one past the last row spanned by the node.
+    /// \param first the first row of the range.
+    /// \param end one past the last row of the range.
+    /// \param delta 1 to cover the range, -1 to uncover it.
+    void addCover(int node, int nodeFirst, int nodeEnd, int first, int end, int delta);
+
+    /// Recomputes the height of the displayed rows spanned by the specified node from its children.
+    /// \param node the tree node.
+    void updateSum(int node);
+
+    /// Gets the height of the displayed rows within a range of rows.
+    /// \param node the tree node.
+    /// \param nodeFirst the first row spanned by the node.
+    /// \param nodeEnd one past the last row spanned by the node.
+    /// \param first the first row of the range.
+    /// \param end one past the last row of the range.
+    /// \return the height of the displayed rows within the range.
+    int sum(int node, int nodeFirst, int nodeEnd, int first, int end) const;
+
+    QVector<Row>                        m_rows;         ///< The rows, in display order.
+    QHash<const acTimelineBranch*, int> m_rowOfBranch;  ///< The row of each branch.
+    int                                 m_nCapacity;    ///< The number of leaves of the tree (a power of two).
+    QVector<int>                        m_covers;       ///< The cover counter of each tree node.  Node 1 is the root, the leaves start at m_nCapacity.
+    QVector<int>                        m_sums;         ///< The height of the displayed rows spanned by each tree node.
+};
+
+#endif // _ACTIMELINEROWLAYOUT_H_
@@ -0,0 +1,102 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTextIndex.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINETEXTINDEX_H_
+#define _ACTIMELINETEXTINDEX_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+class acTimelineBranch;
+
+/// An item found by a text search of a timeline (see acTimeline::search).
+struct acTimelineSearchResult
+{
+    /// The storage of the found item within its branch.
+    enum ItemKind
+    {
+        SEARCH_RESULT_ITEM,         ///< An acTimelineItem.  m_nIndex is its index within the branch.
+        SEARCH_RESULT_COMPACT_ITEM, ///< A compact item.  m_nIndex is its index within the compact item store of the branch.
+        SEARCH_RESULT_TRACE_ITEM    ///< A trace item.  m_nIndex is its position within the trace items of the branch.
+    };
+
+    acTimelineBranch* m_pBranch;    ///< The branch containing the item.
+    ItemKind          m_kind;       ///< The storage of the item.
+    qint64            m_nIndex;     ///< The index or position of the item (see ItemKind).
+    quint64           m_nStartTime; ///< The start time of the item.
+};
+
+/// Trigram index of the distinct texts of a timeline (the texts of its items, or the titles of its branches), so that a substring or
+/// prefix query only compares the texts sharing the rarest trigram of the query rather than every text.  The trigrams are taken
+/// from the case folded texts, so the same index serves case sensitive and case insensitive queries.  Texts are only ever added.
+class acTimelineTextIndex
+{
+public:
+    /// The kinds of text matching.
+    enum MatchType
+    {
+        MATCH_SUBSTRING,    ///< The text contains the query.
+        MATCH_PREFIX,       ///< The text starts with the query.
+        MATCH_EXACT         ///< The text is the query.
+    };
+
+    /// Construct/Initialize a new instance of the acTimelineTextIndex class.
+    acTimelineTextIndex() {}
+
+    /// Removes all texts from the index.
+    void clear();
+
+    /// Adds a text to the index, unless it is already in it.
+    /// \param text the text.
+    /// \return the id of the text.
+    int addText(const QString& text);
+
+    /// Gets the number of texts in the index.
+    /// \return the number of texts in the index (the ids are 0 to count() - 1).
+    int count() const { return m_texts.count(); }
+
+    /// Finds the texts matching a query.
+    /// \param query the query.
+    /// \param matchType how the texts should match the query.
+    /// \param caseSensitivity the case sensitivity of the comparison.
+    /// \param[out] matches a flag per text id, set for the matching texts.
+    void findTexts(const QString& query, MatchType matchType, Qt::CaseSensitivity caseSensitivity, QVector<bool>& matches) const;
+
+    /// Finds the ids of the texts matching a query.
+    /// \param query the query.
+    /// \param matchType how the texts should match the query.
+    /// \param caseSensitivity the case sensitivity of the comparison.
+    /// \param[out] textIds the ids of the matching texts, in increasing order.
+    void findTextIds(const QString& query, MatchType matchType, Qt::CaseSensitivity caseSensitivity, QVector<int>& textIds) const;
+
+    /// Checks whether a text matches a query, without using the index.
+    /// \param text the text.
+    /// \param query the query.
+    /// \param matchType how the text should match the query.
+    /// \param caseSensitivity the case sensitivity of the comparison.
+    /// \return true if the text matches the query.
+    static bool matches(const QString& text, const QString& query, MatchType matchType, Qt::CaseSensitivity caseSensitivity);
+
+private:
+    /// Gets the key of the trigram starting at the specified character.
+    /// \param pChars the first character of the trigram.
+    /// \return the key of the trigram.
+    static quint64 trigramKey(const QChar* pChars) { return ((quint64)pChars[0].unicode() << 32) | ((quint64)pChars[1].unicode() << 16) | pChars[2].unicode(); }
+
+    QVector<QString>               m_texts;     ///< The texts, by id.
+    QHash<QString, int>            m_textIds;   ///< The id of each text.
+    QHash<quint64, QVector<int> >  m_postings;  ///< The ids of the texts containing each trigram of the case folded texts, in increasing order.
+};
+
+#endif // _ACTIMELINETEXTINDEX_H_
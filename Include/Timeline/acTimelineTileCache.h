@@ -0,0 +1,152 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTileCache.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINETILECACHE_H_
+#define _ACTIMELINETILECACHE_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QHash>
+#include <QImage>
+#include <QLinkedList>
+#include <QPoint>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+class QPainter;
+class acTimelineBranch;
+
+/// The width in pixels of a timeline tile.
+#define AC_TIMELINE_TILE_WIDTH 512
+
+/// The default memory budget of the timeline tile cache, in bytes.
+#define AC_TIMELINE_TILE_CACHE_DEFAULT_BUDGET (64 * 1024 * 1024)
+
+/// Cache of pre-rendered timeline tiles.  A tile holds the items of a single branch row within a fixed span of pixels of the
+/// full render width, so it only depends on the branch contents and the zoom level, not on the horizontal offset.
+/// Tiles are keyed by branch, tile index and row height.  All tiles belong to a single zoom level; switching to another zoom
+/// level drops them (or keeps them as preview tiles, see setKeepPreviewTiles).  When the cache exceeds its memory budget, the
+/// least recently used tiles are dropped.  The tiles are kept in a list ordered by use, so finding, using and dropping a tile are
+/// constant time operations.
+class acTimelineTileCache
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineTileCache class.
+    acTimelineTileCache();
+
+    /// Removes all tiles from the cache.
+    void clear();
+
+    /// Sets the zoom level of the cached tiles.  Removes all tiles if the zoom level changed.  The zoom level is considered unchanged if
+    /// the start time and the time per pixel are the same (within a pixel over the render width), so that the cached tiles stay
+    /// valid while the full range of a streaming timeline grows.
+    /// \param renderWidth the full render width of the timeline.
+    /// \param startTime the start time of the timeline.
+    /// \param fullRange the full range of the timeline.
+    /// \return true if the zoom level changed.
+    bool setZoomLevel(quint64 renderWidth, quint64 startTime, quint64 fullRange);
+
+    /// Sets a flag indicating whether or not the tiles of the previous zoom level are kept when the zoom level changes,
+    /// so that they can be drawn stretched (see drawPreview) until the tiles of the new zoom level are rendered.
+    /// The preview tiles are not counted in the memory budget, so they use at most as much memory as the cached tiles.
+    /// \param keepPreviewTiles a flag indicating whether or not the tiles of the previous zoom level are kept.
+    void setKeepPreviewTiles(bool keepPreviewTiles);
+
+    /// Draws the parts of the preview tiles which cover the specified tile, stretched to the current zoom level.
+    /// \param painter the painter object to use when drawing the preview.
+    /// \param pBranch the branch.
+    /// \param tileIndex the index of the tile at the current zoom level.
+    /// \param height the height of the branch row.
+    /// \param tilePos the position of the tile in the painter coordinates.
+    /// \return true if any preview tile was drawn.
+    bool drawPreview(QPainter& painter, const acTimelineBranch* pBranch, qint64 tileIndex, int height, const QPoint& tilePos) const;
+
+    /// Sets the memory budget of the cache.
+    /// \param budget the maximum number of bytes used by cached tiles.
+    void setBudget(qint64 budget);
+
+    /// Gets the memory budget of the cache.
+    /// \return the maximum number of bytes used by cached tiles.
+    qint64 budget() const { return m_nBudget; }
+
+    /// Gets the cached tile of the specified branch, and marks it as recently used.
+    /// \param pBranch the branch.
+    /// \param tileIndex the index of the tile (the tile covers pixels [tileIndex * AC_TIMELINE_TILE_WIDTH, (tileIndex + 1) * AC_TIMELINE_TILE_WIDTH) of the render width).
+    /// \param height the height of the branch row.
+    /// \return the cached tile, or NULL if the tile is not cached.
+    const QImage* tile(const acTimelineBranch* pBranch, qint64 tileIndex, int height);
+
+    /// Adds a tile to the cache, dropping the least recently used tiles if needed.
+    /// \param pBranch the branch.
+    /// \param tileIndex the index of the tile.
+    /// \param height the height of the branch row.
+    /// \param image the rendered tile.
+    /// \return true if the tile was cached, false if the tile alone exceeds the memory budget (the tile is not cached then).
+    bool insert(const acTimelineBranch* pBranch, qint64 tileIndex, int height, const QImage& image);
+
+    /// Removes all tiles of the specified branch.
+    /// \param pBranch the branch.
+    void invalidateBranch(const acTimelineBranch* pBranch);
+
+    /// Removes the tiles of the specified branch within a range of tile indices.
+    /// \param pBranch the branch.
+    /// \param firstTileIndex the index of the first tile to remove.
+    /// \param lastTileIndex the index of the last tile to remove.
+    void invalidateTiles(const acTimelineBranch* pBranch, qint64 firstTileIndex, qint64 lastTileIndex);
+
+private:
+    /// The key of a cached tile in the use list.
+    struct TileKey
+    {
+        const acTimelineBranch* m_pBranch;      ///< The branch.
+        qint64                  m_nTileIndex;   ///< The index of the tile.
+    };
+
+    typedef QLinkedList<TileKey> TileUseList;
+
+    /// A cached tile.
+    struct Tile
+    {
+        QImage                  m_image;        ///< The rendered tile.
+        int                     m_nHeight;      ///< The height of the branch row the tile was rendered for.
+        TileUseList::iterator   m_usePos;       ///< The position of the tile in the use list (only valid for the cached tiles, not for the preview tiles).
+    };
+
+    typedef QHash<qint64, Tile> BranchTiles;
+
+    /// Removes least recently used tiles until the cache is within its budget.
+    void evict();
+
+    /// Removes a tile from the cache and from the use list.
+    /// \param branchIt the tiles of the branch of the tile.
+    /// \param tileIt the tile.
+    /// \return the tile following the removed tile within the branch tiles.
+    BranchTiles::iterator removeTile(QHash<const acTimelineBranch*, BranchTiles>::iterator branchIt, BranchTiles::iterator tileIt);
+
+    /// A zoom level.
+    struct ZoomLevel
+    {
+        quint64 m_nRenderWidth;     ///< The full render width of the timeline.
+        quint64 m_nStartTime;       ///< The start time of the timeline.
+        quint64 m_nFullRange;       ///< The full range of the timeline.
+    };
+
+    QHash<const acTimelineBranch*, BranchTiles> m_tiles;   ///< The cached tiles, per branch and tile index.
+    QHash<const acTimelineBranch*, BranchTiles> m_previewTiles; ///< The tiles of the previous zoom level, per branch and tile index.
+    ZoomLevel                   m_previewZoomLevel;         ///< The zoom level of the preview tiles.
+    bool                        m_bKeepPreviewTiles;        ///< Flag indicating whether or not the tiles of the previous zoom level are kept.
+    quint64                     m_nRenderWidth;             ///< The render width of the zoom level of the cached tiles.
+    quint64                     m_nStartTime;               ///< The start time of the zoom level of the cached tiles.
+    quint64                     m_nFullRange;               ///< The full range of the zoom level of the cached tiles.
+    qint64                      m_nBudget;                  ///< The maximum number of bytes used by cached tiles.
+    qint64                      m_nUsedBytes;               ///< The number of bytes used by cached tiles.
+    TileUseList                 m_tileUseList;              ///< The cached tiles, from the most recently used to the least recently used.
+};
+
+#endif // _ACTIMELINETILECACHE_H_
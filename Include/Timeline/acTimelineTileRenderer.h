@@ -0,0 +1,128 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTileRenderer.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINETILERENDERER_H_
+#define _ACTIMELINETILERENDERER_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QAtomicInt>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QPicture>
+#include <QThreadPool>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+class QObject;
+class acTimelineBranch;
+
+/// Rasterizes timeline tiles on a pool of worker threads.
+/// The items of a tile are painted on the GUI thread into a QPicture, which only records the paint commands.  The recorded
+/// commands are then played into a QImage by a worker thread, which is where the time is spent for dense branches
+/// (antialiasing, gradients and text).  The pool has one thread per core.
+/// When rendered tiles are available, the finished slot of the receiver is invoked (queued) on the GUI thread, and the tiles
+/// can be collected with takeResults.
+class acTimelineTileRenderer
+{
+public:
+    /// A rendered tile.
+    struct Result
+    {
+        const acTimelineBranch* m_pBranch;      ///< The branch of the tile.
+        qint64                  m_nTileIndex;   ///< The index of the tile.
+        int                     m_nHeight;      ///< The height of the branch row the tile was rendered for.
+        QImage                  m_image;        ///< The rendered tile.
+        quint64                 m_nSerial;      ///< The serial number of the job which rendered the tile.
+    };
+
+    /// Construct/Initialize a new instance of the acTimelineTileRenderer class.
+    /// \param pReceiver the object notified when rendered tiles are available.
+    /// \param finishedSlot the name of the slot of the receiver invoked when rendered tiles are available.
+    acTimelineTileRenderer(QObject* pReceiver, const char* finishedSlot);
+
+    /// Destructor.  Cancels the queued jobs and waits for the running ones.
+    ~acTimelineTileRenderer();
+
+    /// Creates an empty (transparent) tile image.
+    /// \param height the height of the branch row, in logical pixels.
+    /// \param pixelRatio the device pixel ratio of the tile.
+    /// \param logicalDpi the logical DPI of the tile, used when rendering text.
+    /// \return the tile image.
+    static QImage createTileImage(int height, int pixelRatio, int logicalDpi);
+
+    /// Queues a tile for rendering.  Replaces a pending job of the same tile.
+    /// \param pBranch the branch of the tile.
+    /// \param tileIndex the index of the tile.
+    /// \param height the height of the branch row.
+    /// \param picture the recorded paint commands of the tile.
+    /// \param pixelRatio the device pixel ratio of the tile.
+    /// \param logicalDpi the logical DPI of the tile.
+    void submit(const acTimelineBranch* pBranch, qint64 tileIndex, int height, const QPicture& picture, int pixelRatio, int logicalDpi);
+
+    /// Gets a flag indicating whether or not the specified tile is being rendered.
+    /// \param pBranch the branch of the tile.
+    /// \param tileIndex the index of the tile.
+    /// \param height the height of the branch row.
+    /// \return true if the tile was submitted and not collected or cancelled yet.
+    bool isPending(const acTimelineBranch* pBranch, qint64 tileIndex, int height) const;
+
+    /// Gets the number of tiles being rendered.
+    /// \return the number of pending tiles.
+    int pendingCount() const { return m_pending.count(); }
+
+    /// Cancels all jobs.  Queued jobs are removed from the pool, running jobs are discarded when they finish.
+    void cancel();
+
+    /// Cancels the jobs of the specified branch.  Their tiles are discarded when they finish.
+    /// \param pBranch the branch.
+    void cancelBranch(const acTimelineBranch* pBranch);
+
+    /// Cancels the jobs of the specified branch within a range of tile indices.  Their tiles are discarded when they finish.
+    /// \param pBranch the branch.
+    /// \param firstTileIndex the index of the first tile to cancel.
+    /// \param lastTileIndex the index of the last tile to cancel.
+    void cancelTiles(const acTimelineBranch* pBranch, qint64 firstTileIndex, qint64 lastTileIndex);
+
+    /// Collects the rendered tiles.  Tiles of cancelled jobs are discarded.
+    /// \return the rendered tiles.
+    QList<Result> takeResults();
+
+private:
+    class Job;
+
+    typedef QPair<const acTimelineBranch*, qint64> TileKey;
+
+    /// A submitted tile.
+    struct PendingTile
+    {
+        int     m_nHeight;      ///< The height of the branch row.
+        quint64 m_nSerial;      ///< The serial number of the job rendering the tile.
+    };
+
+    /// Adds a rendered tile, and notifies the receiver if needed.  Called from the worker threads.
+    /// \param result the rendered tile.
+    /// \param generation the generation the job was submitted in.
+    void addResult(const Result& result, int generation);
+
+    QObject*                     m_pReceiver;          ///< The object notified when rendered tiles are available.
+    const char*                  m_finishedSlot;       ///< The name of the slot of the receiver invoked when rendered tiles are available.
+    QThreadPool                  m_threadPool;         ///< The worker threads.
+    QAtomicInt                   m_generation;         ///< Incremented by cancel, so that the running jobs know their tiles are not needed anymore.
+    QHash<TileKey, PendingTile>  m_pending;            ///< The submitted tiles which were not collected yet.  Only accessed by the GUI thread.
+    quint64                      m_nNextSerial;        ///< The serial number of the next job.
+    QMutex                       m_resultsMutex;       ///< Guards m_results and m_bNotifyPosted.
+    QList<Result>                m_results;            ///< The rendered tiles which were not collected yet.
+    bool                         m_bNotifyPosted;      ///< Flag indicating that the receiver was notified and did not collect the tiles yet.
+};
+
+#endif // _ACTIMELINETILERENDERER_H_
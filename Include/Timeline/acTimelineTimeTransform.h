@@ -0,0 +1,154 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTimeTransform.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINETIMETRANSFORM_H_
+#define _ACTIMELINETIMETRANSFORM_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtGlobal>
+
+// C++:
+#include <cmath>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+/// The largest X coordinate (in absolute value) returned by acTimelineTimeTransform::timeToPixel.  Times far outside of the
+/// visible window are clamped to it, so that the coordinates can still be offset by the title width without overflowing.
+#define AC_TIMELINE_MAX_PIXEL_COORD (1 << 30)
+
+/// The rounding error tolerated by acTimelineTimeTransform::timeToColumn, in pixels.  Far larger than the rounding errors of the
+/// transform, and far smaller than the distance of a time which is not on a pixel edge to the nearest edge.
+#define AC_TIMELINE_PIXEL_EPSILON 1e-6
+
+/// Affine transform between the times of a timeline and the X coordinates of its rows (relative to the left side of the row area).
+/// The transform is anchored on an integer origin time next to X = 0, so a time is converted from its exact integer distance to
+/// the origin with a single multiply-add, rather than from its distance to the start of the timeline.  Visible times therefore keep
+/// a sub-pixel precision when the timeline is zoomed in to nanoseconds within a session of many hours, where the render width and
+/// the offset are too large for the X coordinate to be computed as a difference of two doubles.
+class acTimelineTimeTransform
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineTimeTransform class.
+    acTimelineTimeTransform();
+
+    /// Sets the transform from the view of a timeline.  X = (time - startTime) * renderWidth / fullRange - offset.
+    /// \param startTime the start time of the timeline.
+    /// \param fullRange the full range of the timeline.
+    /// \param renderWidth the full render width of the timeline.
+    /// \param offset the horizontal offset of the timeline, in pixels.
+    void set(quint64 startTime, quint64 fullRange, quint64 renderWidth, qint64 offset);
+
+    /// Checks whether the transform was set from the specified view.
+    /// \param startTime the start time of the timeline.
+    /// \param fullRange the full range of the timeline.
+    /// \param renderWidth the full render width of the timeline.
+    /// \param offset the horizontal offset of the timeline, in pixels.
+    /// \return true if the transform is up to date with the view.
+    bool isSetFor(quint64 startTime, quint64 fullRange, quint64 renderWidth, qint64 offset) const
+    {
+        return m_nStartTime == startTime && m_nFullRange == fullRange && m_nRenderWidth == renderWidth && m_nOffset == offset;
+    }
+
+    /// Gets the X coordinate of a time.
+    /// \param time the time.
+    /// \return the X coordinate of the time, with its fractional part.
+    double timeToX(quint64 time) const { return (double)(qint64)(time - m_nOriginTime) * m_dPixelsPerTime + m_dOriginX; }
+
+    /// Gets the X coordinate of a time given as an offset from the start of the timeline (as used by the grid).
+    /// \param timeOffset the time, relative to the start of the timeline.
+    /// \return the X coordinate of the time, with its fractional part.
+    double timeOffsetToX(double timeOffset) const { return (timeOffset - (double)(m_nOriginTime - m_nStartTime)) * m_dPixelsPerTime + m_dOriginX; }
+
+    /// Gets the pixel column of a time (the X coordinate truncated towards zero, as in acTimeline::getXCoordOfTime).
+    /// \param time the time.
+    /// \return the pixel column of the time, clamped to +/- AC_TIMELINE_MAX_PIXEL_COORD.
+    int timeToPixel(quint64 time) const { return clampToPixel(timeToX(time)); }
+
+    /// Gets the pixel column of a time, rounded down rather than towards zero, and with a tolerance for the rounding errors of the
+    /// transform.  A time is in the same column whatever the offset the transform was set for, so the items are painted at the same
+    /// columns whether a row is painted at once or tile by tile.
+    /// \param time the time.
+    /// \return the pixel column of the time, clamped to +/- AC_TIMELINE_MAX_PIXEL_COORD.
+    int timeToColumn(quint64 time) const { return clampToPixel(std::floor(timeToX(time) + AC_TIMELINE_PIXEL_EPSILON)); }
+
+    /// Gets the width of a duration.
+    /// \param duration the duration.
+    /// \return the width of the duration, in pixels.
+    double durationToWidth(quint64 duration) const { return duration * m_dPixelsPerTime; }
+
+    /// Gets the time at an X coordinate.  This is the inverse of timeToPixel.
+    /// \param x the X coordinate.
+    /// \return the first time of the pixel column (never before the start time of the timeline).
+    quint64 xToTime(int x) const;
+
+    /// Gets the scale of the transform.
+    /// \return the number of pixels per time unit.
+    double pixelsPerTime() const { return m_dPixelsPerTime; }
+
+    /// Gets the inverse scale of the transform.
+    /// \return the number of time units per pixel.
+    double timePerPixel() const { return m_dTimePerPixel; }
+
+    /// Gets the origin of the transform.
+    /// \return the time the transform is anchored on (the latest time whose X coordinate is not positive).
+    quint64 originTime() const { return m_nOriginTime; }
+
+    /// Truncates an X coordinate to a pixel column.
+    /// \param x the X coordinate.
+    /// \return the pixel column, clamped to +/- AC_TIMELINE_MAX_PIXEL_COORD.
+    static int clampToPixel(double x)
+    {
+        return (x <= -AC_TIMELINE_MAX_PIXEL_COORD) ? -AC_TIMELINE_MAX_PIXEL_COORD : ((x >= AC_TIMELINE_MAX_PIXEL_COORD) ? AC_TIMELINE_MAX_PIXEL_COORD : (int)x);
+    }
+
+private:
+    quint64 m_nStartTime;       ///< The start time of the timeline the transform was set from.
+    quint64 m_nFullRange;       ///< The full range of the timeline the transform was set from.
+    quint64 m_nRenderWidth;     ///< The render width of the timeline the transform was set from.
+    qint64  m_nOffset;          ///< The offset of the timeline the transform was set from.
+
+    quint64 m_nOriginTime;      ///< The time the transform is anchored on.
+    double  m_dOriginX;         ///< The X coordinate of m_nOriginTime (within one time unit left of X = 0).
+    double  m_dPixelsPerTime;   ///< The number of pixels per time unit.
+    double  m_dTimePerPixel;    ///< The number of time units per pixel.
+};
+
+/// The part of the timeline rows the items of a branch are painted in: the visible part of the rows, or a tile of the full render
+/// width.  The branches and items take their geometry from it rather than from the view of the timeline, so that a tile is painted
+/// without changing the view of the timeline.
+/// The items are painted the same way whatever the painted area is, so that the tiles put together look like the items painted
+/// directly: the backgrounds are trimmed outside of the area, and the paint mask starts at a tile edge (m_nMaskLeft).
+class acTimelineRowView
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineRowView class, for an empty area.
+    acTimelineRowView() : m_nVisibleStartTime(0), m_nVisibleRange(0), m_nLeft(0), m_nWidth(0), m_nMaskLeft(0),
+        m_bIsTiled(false), m_bPaintBackgrounds(true), m_bPaintLabels(true) {}
+
+    /// Gets the end of the time range of the painted area.
+    /// \return the last time of the painted area.
+    quint64 visibleEndTime() const { return m_nVisibleStartTime + m_nVisibleRange; }
+
+    /// Gets the width of the paint mask, from the tile edge at m_nMaskLeft to the right side of the painted area.
+    /// \return the width of the paint mask.
+    int maskWidth() const { return m_nLeft + m_nWidth - m_nMaskLeft; }
+
+    acTimelineTimeTransform m_timeTransform;     ///< The transform between the times and the X coordinates relative to m_nLeft.
+    quint64                 m_nVisibleStartTime; ///< The first time of the painted area.
+    quint64                 m_nVisibleRange;     ///< The time range of the painted area.
+    int                     m_nLeft;             ///< The X coordinate of the left side of the painted area.
+    int                     m_nWidth;            ///< The width of the painted area.
+    int                     m_nMaskLeft;         ///< The X coordinate of the first column of the paint mask: the edge of the tile holding the left side of the area.  The items starting before it are not masked.
+    bool                    m_bIsTiled;          ///< Flag indicating that the items are painted through the tile cache (into a tile, or the labels over the tiles).  Tiles are cached and shared by all the selection states, so the selection frames, the draw cache and the item rectangle state are left alone.
+    bool                    m_bPaintBackgrounds; ///< Flag indicating whether or not the item backgrounds are painted.
+    bool                    m_bPaintLabels;      ///< Flag indicating whether or not the item labels are painted (over all the items of the row, see acTimelineLabelCache::addRowLabel).
+};
+
+#endif // _ACTIMELINETIMETRANSFORM_H_
@@ -0,0 +1,160 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineToolTipBuilder.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINETOOLTIPBUILDER_H_
+#define _ACTIMELINETOOLTIPBUILDER_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QAtomicInt>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Local:
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+
+class QObject;
+
+/// The time the mouse should rest over an item before its tooltip text is built, in milliseconds.
+#define AC_TIMELINE_TOOLTIP_DEBOUNCE_MS 50
+
+/// The number of items whose tooltip text is kept by acTimelineToolTipBuilder.
+#define AC_TIMELINE_TOOLTIP_CACHE_CAPACITY 64
+
+/// Builds the tooltip text of the timeline items on a worker thread, and caches the text of the items hovered last.
+/// The items are owned by the GUI thread, so the GUI thread only copies the times and text of the item into an ItemSnapshot, and
+/// the worker builds the tooltip rows, formats the times and assembles the text.  Items with their own tooltip (see
+/// acTimelineItem::hasDefaultToolTip) are read with acTimelineItem::tooltipItems on the GUI thread, and only their formatting is done
+/// by the worker.  When the text is built, the finished slot of the receiver is invoked (queued) on the GUI thread, and the text can
+/// be collected with takeResult.  Only the most recent request is kept: submitting a request or cancelling drops the previous one.
+class acTimelineToolTipBuilder
+{
+public:
+    /// A name/value pair of a tooltip, copied out of acTimelineItemToolTip so that it can be formatted by the worker thread.
+    struct Row
+    {
+        QString                             m_strName;      ///< The name of the row.
+        QString                             m_strValue;     ///< The value of the row (when m_format is VALUE_TEXT).
+        acTimelineItemToolTip::ValueFormat  m_format;       ///< The format of the value.
+        double                              m_dNumber;      ///< The time or duration of the row (when m_format is not VALUE_TEXT).
+    };
+
+    /// The content of a tooltip.
+    struct Content
+    {
+        QVector<Row>    m_rows;                 ///< The name/value pairs.
+        QString         m_strAdditionalText;    ///< The additional text.
+    };
+
+    /// A copy of the data the default tooltip of an item is built from (see acTimelineItem::tooltipItems), taken on the GUI thread.
+    struct ItemSnapshot
+    {
+        QString m_strText;              ///< The text of the item.
+        quint64 m_nStartTime;           ///< The start time of the item.
+        quint64 m_nEndTime;             ///< The end time of the item.
+        quint64 m_nTimelineStartTime;   ///< The start time of the timeline, which the tooltip times are relative to.
+    };
+
+    /// Construct/Initialize a new instance of the acTimelineToolTipBuilder class.
+    /// \param pReceiver the object notified when a tooltip text is built.
+    /// \param finishedSlot the name of the slot of the receiver invoked when a tooltip text is built.
+    acTimelineToolTipBuilder(QObject* pReceiver, const char* finishedSlot);
+
+    /// Destructor.  Cancels the queued request and waits for the running one.
+    ~acTimelineToolTipBuilder();
+
+    /// Copies the content of a tooltip.
+    /// \param tooltip the tooltip.
+    /// \param[out] content the content of the tooltip.
+    static void getContent(const acTimelineItemToolTip& tooltip, Content& content);
+
+    /// Builds the content of the default tooltip of an item, like acTimelineItem::tooltipItems.  Can be called from any thread.
+    /// \param snapshot the snapshot of the item.
+    /// \param[out] content the content of the tooltip.
+    static void getContent(const ItemSnapshot& snapshot, Content& content);
+
+    /// Builds the text of a tooltip (one "name: value" row per pair, followed by the additional text).  Can be called from any thread.
+    /// \param content the content of the tooltip.
+    /// \return the tooltip text.
+    static QString buildText(const Content& content);
+
+    /// Queues the building of the tooltip text of an item, dropping the previous request.
+    /// \param pItem the item.  Only used to identify the result, it is not accessed by the worker thread.
+    /// \param content the content of the tooltip of the item.
+    void submit(const acTimelineItem* pItem, const Content& content);
+
+    /// Queues the building of the default tooltip text of an item, dropping the previous request.
+    /// \param pItem the item.  Only used to identify the result, it is not accessed by the worker thread.
+    /// \param snapshot the snapshot of the item, which the content of the tooltip is built from by the worker thread.
+    void submit(const acTimelineItem* pItem, const ItemSnapshot& snapshot);
+
+    /// Drops the current request.
+    void cancel();
+
+    /// Collects the text built for the current request.
+    /// \param[out] pItem the item of the request.
+    /// \param[out] text the tooltip text of the item.
+    /// \return true if the text was collected, false if the request was dropped or is not finished.
+    bool takeResult(const acTimelineItem*& pItem, QString& text);
+
+    /// Looks up the cached tooltip text of an item.  Texts cached before the time range or text of the item changed are ignored.
+    /// \param pItem the item.
+    /// \param[out] text the cached tooltip text.
+    /// \return true if the text of the item is cached, false otherwise.
+    bool findCached(const acTimelineItem* pItem, QString& text);
+
+    /// Caches the tooltip text of an item, replacing the item used least recently if the cache is full.
+    /// \param pItem the item.
+    /// \param text the tooltip text of the item.
+    void cache(const acTimelineItem* pItem, const QString& text);
+
+    /// Removes all the cached texts (when the items are deleted).
+    void clearCache();
+
+private:
+    class Job;
+
+    /// A cached tooltip text, with the item state it was built from.
+    struct CacheEntry
+    {
+        QString m_strText;      ///< The tooltip text.
+        quint64 m_nStartTime;   ///< The start time of the item.
+        quint64 m_nEndTime;     ///< The end time of the item.
+        QString m_strItemText;  ///< The text of the item.
+    };
+
+    /// Stores the text built for a request, and notifies the receiver.  Called from the worker thread.
+    /// \param pItem the item of the request.
+    /// \param text the tooltip text.
+    /// \param generation the generation the request was submitted in.
+    void setResult(const acTimelineItem* pItem, const QString& text, int generation);
+
+    /// Queues a job, dropping the previous request.
+    /// \param pJob the job.  The thread pool deletes it when it is done.
+    void start(Job* pJob);
+
+    QObject*                                    m_pReceiver;        ///< The object notified when a tooltip text is built.
+    const char*                                 m_finishedSlot;     ///< The name of the slot of the receiver invoked when a tooltip text is built.
+    QThreadPool                                 m_threadPool;       ///< The worker thread.
+    QAtomicInt                                  m_generation;       ///< Incremented by submit and cancel, so that the running job knows its text is not needed anymore.
+    QMutex                                      m_resultMutex;      ///< Guards the result members below.
+    bool                                        m_bHasResult;       ///< Flag indicating that the text of the current request was built and not collected yet.
+    const acTimelineItem*                       m_pResultItem;      ///< The item of the built text.
+    QString                                     m_strResultText;    ///< The built text.
+    QHash<const acTimelineItem*, CacheEntry>    m_cache;            ///< The cached tooltip texts.  Only accessed by the GUI thread.
+    QList<const acTimelineItem*>                m_cacheOrder;       ///< The cached items, used least recently first.
+};
+
+#endif // _ACTIMELINETOOLTIPBUILDER_H_
@@ -0,0 +1,228 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTraceFile.h
+///
+//==================================================================================
+
+#ifndef _ACTIMELINETRACEFILE_H_
+#define _ACTIMELINETRACEFILE_H_
+
+// Qt:
+#include <qtIgnoreCompilerWarnings.h>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QRgb>
+#include <QString>
+#include <QVector>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Local:
+#include <AMDTApplicationComponents/Include/acApplicationComponentsDLLBuild.h>
+
+class acTimelineBranch;
+class acTimelineTraceFile;
+
+/// The maximum number of decoded item texts kept by a trace file.
+#define AC_TIMELINE_TRACE_TEXT_CACHE_CAPACITY 16384
+
+/// View of the items of a single branch of a memory mapped trace file.
+/// The items are sorted by start time and read directly from the mapping, so only the pages holding the items which are
+/// looked up are read from the disk.  A view is only valid as long as the trace file it refers to is open.
+class AC_API acTimelineTraceItems
+{
+public:
+    /// Construct/Initialize an empty view.
+    acTimelineTraceItems() : m_pFile(nullptr), m_nCount(0), m_pStartTimes(nullptr), m_pEndTimes(nullptr), m_pMaxEndTimes(nullptr), m_pPaletteIndices(nullptr), m_pTextIds(nullptr), m_pFlags(nullptr) {}
+
+    /// Gets the number of items.
+    /// \return the number of items.
+    qint64 count() const { return m_nCount; }
+
+    /// Gets the start time of the item at the specified position.
+    /// \param pos the position of the item (items are sorted by start time).
+    /// \return the start time of the item.
+    quint64 startTime(qint64 pos) const { return m_pStartTimes[pos]; }
+
+    /// Gets the end time of the item at the specified position.
+    /// \param pos the position of the item.
+    /// \return the end time of the item.
+    quint64 endTime(qint64 pos) const { return m_pEndTimes[pos]; }
+
+    /// Gets the latest end time of the items up to the specified position.
+    /// \param pos the position of the item.
+    /// \return the latest end time of the items at positions 0 to pos.
+    quint64 maxEndTime(qint64 pos) const { return m_pMaxEndTimes[pos]; }
+
+    /// Gets the background color of the item at the specified position.
+    /// \param pos the position of the item.
+    /// \return the background color of the item.
+    QRgb backgroundColor(qint64 pos) const;
+
+    /// Gets the text of the item at the specified position.
+    /// \param pos the position of the item.
+    /// \return the text of the item.
+    QString text(qint64 pos) const;
+
+    /// Gets the string table id of the text of the item at the specified position.
+    /// \param pos the position of the item.
+    /// \return the string table id of the text of the item.
+    quint32 textId(qint64 pos) const { return m_pTextIds[pos]; }
+
+    /// Gets the flags of the item at the specified position.
+    /// \param pos the position of the item.
+    /// \return the flags of the item (see AC_TIMELINE_COMPACT_ITEM_SHAPE_MASK).
+    quint8 flags(qint64 pos) const { return m_pFlags[pos]; }
+
+    /// Finds the range of positions which may contain items overlapping the specified time window (see acTimelineItemIntervalIndex::findOverlapping).
+    /// \param rangeStart the start of the time window.
+    /// \param rangeEnd the end of the time window.
+    /// \param[out] firstPos the first position within the range.  The item at this position overlaps the window.
+    /// \param[out] lastPos one past the last position within the range.
+    /// \return true if the range is not empty, false otherwise.
+    bool findOverlapping(quint64 rangeStart, quint64 rangeEnd, qint64& firstPos, qint64& lastPos) const;
+
+    /// Gets the position of the first item starting at or after the specified time, within a range of positions.
+    /// \param time the time.
+    /// \param firstPos the first position of the range.
+    /// \param lastPos one past the last position of the range.
+    /// \return the position of the first item of the range starting at or after the time, or lastPos if there is none.
+    qint64 lowerBound(quint64 time, qint64 firstPos, qint64 lastPos) const;
+
+    /// Gets the position of the first item whose running maximum of the end times reaches the specified time, within a range of positions.
+    /// The item at that position ends at or after the time, unless the position is lastPos.
+    /// \param time the time.
+    /// \param firstPos the first position of the range.
+    /// \param lastPos one past the last position of the range.
+    /// \return the position of the first item of the range whose running maximum end time is at or after the time, or lastPos if there is none.
+    qint64 lowerBoundMaxEndTime(quint64 time, qint64 firstPos, qint64 lastPos) const;
+
+    /// Gets the trace file containing the items.
+    /// \return the trace file, or NULL for an empty view.
+    const acTimelineTraceFile* file() const { return m_pFile; }
+
+private:
+    friend class acTimelineTraceFile;
+
+    const acTimelineTraceFile* m_pFile;           ///< The trace file containing the items.
+    qint64                     m_nCount;          ///< The number of items.
+    const quint64*             m_pStartTimes;     ///< The start times of the items, in increasing order.
+    const quint64*             m_pEndTimes;       ///< The end times of the items.
+    const quint64*             m_pMaxEndTimes;    ///< The running maximum of m_pEndTimes.
+    const quint16*             m_pPaletteIndices; ///< The palette index of the background color of the items.
+    const quint32*             m_pTextIds;        ///< The string table id of the text of the items.
+    const quint8*              m_pFlags;          ///< The flags of the items.
+};
+
+/// Compact columnar trace file, memory mapped so that acTimeline can display traces larger than the memory, without creating
+/// an object per item.  Opening a trace only reads its header, branch table and palette; item pages are read when they are painted.
+///
+/// File layout (little endian, all offsets are absolute and 8 byte aligned):
+/// - Header: the "ACTRACE1" magic, the format version, the branch, palette and string counts, and the offsets of the palette,
+///   the string table and the branch table.
+/// - Palette: a QRgb per color.
+/// - String table: stringCount + 1 quint64 offsets into the UTF-8 string data, followed by the string data.
+/// - Branch table: for each branch (in pre-order, parents before their sub branches), the string id of its name, the index of
+///   its parent branch (-1 for top level branches), its item count and the offsets of its item columns.
+/// - Item columns of each branch, sorted by start time: start times, end times, running maximum of the end times (quint64),
+///   palette indices (quint16), string ids (quint32) and flags (quint8).
+class AC_API acTimelineTraceFile
+{
+public:
+    /// Construct/Initialize a new instance of the acTimelineTraceFile class.
+    acTimelineTraceFile();
+
+    /// Destructor.  Unmaps the file.
+    ~acTimelineTraceFile();
+
+    /// Maps a trace file.  Closes the previously opened file, if any.
+    /// \param filePath the path of the trace file.
+    /// \return true if the file was mapped and its header and branch table are valid.
+    bool open(const QString& filePath);
+
+    /// Unmaps the trace file.  Views of its items and branches using them must not be used afterwards.
+    void close();
+
+    /// Gets a flag indicating whether or not a trace file is mapped.
+    /// \return true if a trace file is mapped.
+    bool isOpen() const { return m_pData != nullptr; }
+
+    /// Gets the load generation of the trace file.  Every call to open gives the trace file a new load generation, unique among all
+    /// trace files, so that the data derived from a trace (such as the indexed strings) is not mistaken for the data of a trace
+    /// opened later in the same object.
+    /// \return the load generation, or 0 if the trace file was never opened.
+    quint64 loadGeneration() const { return m_nLoadGeneration; }
+
+    /// Gets the number of branches in the trace.
+    /// \return the number of branches in the trace.
+    int branchCount() const { return m_branches.count(); }
+
+    /// Gets the name of the specified branch.
+    /// \param branchIndex the index of the branch.
+    /// \return the name of the branch.
+    QString branchName(int branchIndex) const;
+
+    /// Gets the parent of the specified branch.
+    /// \param branchIndex the index of the branch.
+    /// \return the index of the parent branch, or -1 for a top level branch.
+    int branchParent(int branchIndex) const;
+
+    /// Gets the items of the specified branch.
+    /// \param branchIndex the index of the branch.
+    /// \return a view of the items of the branch.
+    const acTimelineTraceItems& branchItems(int branchIndex) const { return m_branches[branchIndex]; }
+
+    /// Gets a color of the palette.
+    /// \param paletteIndex the index of the color.
+    /// \return the color, or transparent black if the index is out of range.
+    QRgb paletteColor(quint16 paletteIndex) const { return (paletteIndex < m_palette.count()) ? m_palette[paletteIndex] : 0; }
+
+    /// Gets a string of the string table, decoding it if it is not cached.
+    /// \param stringId the id of the string.
+    /// \return the string, or an empty string if the id is out of range.
+    QString string(quint32 stringId) const;
+
+    /// Decodes a string of the string table, without using or filling the decoded string cache, so that it can be called from any thread.
+    /// \param stringId the id of the string.
+    /// \return the string, or an empty string if the id is out of range.
+    QString decodeString(quint32 stringId) const;
+
+    /// Gets the number of strings in the string table.
+    /// \return the number of strings (the string ids are 0 to stringCount() - 1).
+    quint32 stringCount() const { return m_nStringCount; }
+
+    /// Writes the compact items of the specified branches and of all their sub branches to a trace file.
+    /// \param filePath the path of the trace file.
+    /// \param branches the top level branches to write.
+    /// \return true if the file was written successfully.
+    static bool write(const QString& filePath, const QList<acTimelineBranch*>& branches);
+
+private:
+    /// Gets a pointer to an array within the mapping, checking that the array is within the file.
+    /// \param offset the offset of the array.
+    /// \param count the number of elements of the array.
+    /// \param elementSize the size of an element.
+    /// \return the array, or NULL if it is not within the file.
+    const uchar* mappedArray(quint64 offset, quint64 count, quint64 elementSize) const;
+
+    QFile                           m_file;          ///< The trace file.
+    uchar*                          m_pData;         ///< The mapping of the whole file.
+    qint64                          m_nSize;         ///< The size of the file.
+    QVector<QRgb>                   m_palette;       ///< The colors of the items.
+    const quint64*                  m_pStringOffsets; ///< The offsets of the strings within m_pStringData (stringCount + 1 of them).
+    const char*                     m_pStringData;   ///< The UTF-8 string data.
+    quint32                         m_nStringCount;  ///< The number of strings.
+    QVector<quint32>                m_branchNames;   ///< The string id of the name of each branch.
+    QVector<int>                    m_branchParents; ///< The index of the parent of each branch.
+    QVector<acTimelineTraceItems>   m_branches;      ///< The items of each branch.
+    mutable QHash<quint32, QString> m_decodedStrings; ///< The strings decoded so far, by id.
+    quint64                         m_nLoadGeneration; ///< The load generation of the trace file (see loadGeneration).
+
+    static quint64                  m_nLastLoadGeneration; ///< The last load generation given to a trace file.
+};
+
+#endif // _ACTIMELINETRACEFILE_H_
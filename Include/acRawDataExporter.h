@@ -11,7 +11,12 @@
 #ifndef __ACRAWDATAEXPORTER
 #define __ACRAWDATAEXPORTER
 
+// Qt:
+#include <QByteArray>
+#include <QVector>
+
 // Infra:
+#include <AMDTBaseTools/Include/gtASCIIString.h>
 #include <AMDTAPIClasses/Include/apFileType.h>
 #include <AMDTOSWrappers/Include/osFilePath.h>
 #include <AMDTOSWrappers/Include/osFile.h>
@@ -46,7 +51,10 @@ public:
     // Sets the header for the CSV file
     void setCSVHeader(const gtString& CSVHeader) { _csvHeader = CSVHeader; };
 
-    // Export raw data to file
+    // Export raw data to file.
+    // The CSV cells hold the same text as apPixelValueParameter::valueAsString formats, with one deliberate difference:
+    // a value hidden by a filter raw file handler is written as an empty cell. The per cell export of older versions
+    // printed a stale value (usually the previous cell's value) in that cell instead.
     bool exportToFile(const osFilePath& filePath);
 
 public:
@@ -68,6 +76,30 @@ private:
     bool writeBufferCSVPageContent(osFile& csvFile);
     bool writeNonBufferCSVPageContent(osFile& csvFile);
 
+    // Job formatting a band of rows of a non buffer CSV page on a thread pool:
+    class CSVRowsJob;
+
+    // The ways the cells of a non buffer CSV page are formatted (see selectCSVCellFormat):
+    enum CSVCellFormatType
+    {
+        AC_CSV_CELL_PARAMETER,  // Each value is read and formatted through a pixel value parameter
+        AC_CSV_CELL_TABLE,      // The 8 and 16 bits values are read from the raw data, and their text is looked up in _csvValueTexts
+        AC_CSV_CELL_FLOAT       // The float values are read from the raw data, and formatted by appendFloatCSVValue
+    };
+
+    // Selects how the cells of the active page are formatted
+    void selectCSVCellFormat();
+
+    // Checks that appendFloatCSVValue formats the float values like the pixel value parameter does
+    bool isFloatCSVFormatMatching(apPixelValueParameter* pParameter);
+
+    // Formats a band of rows of a non buffer CSV page into text
+    void formatNonBufferCSVRows(int firstRow, int endRow, int width, const QVector<bool>& isChannelWritten, const QVector<gtASCIIString>& channelNames,
+                                apPixelValueParameter* pParameter, gtASCIIString& csvText);
+
+    // Writes the CSV text to the file once it reaches the chunk size
+    void flushCSVText(osFile& csvFile, gtString& csvText, bool forceFlush);
+    void flushCSVText(osFile& csvFile, gtASCIIString& csvText, bool forceFlush);
 
 private:
     // Raw data that should be written
@@ -79,6 +111,13 @@ private:
     // The header for the CSV file
     gtString _csvHeader;
 
+    // The way the cells of the current non buffer CSV page are formatted
+    CSVCellFormatType _csvCellFormatType;
+
+    // The text of every value of an 8 or 16 bits data type, and the data type they were formatted for
+    QVector<QByteArray> _csvValueTexts;
+    oaDataType _csvValueTextsDataType;
+
 
 };
 
@@ -12,7 +12,13 @@
 #define __ACRAWFILEHANDLER
 
 // Qt:
+#include <QAtomicInt>
+#include <QHash>
 #include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QThreadPool>
+#include <QVector>
 
 // Infra:
 #include <AMDTOSWrappers/Include/osFilePath.h>
@@ -26,6 +32,9 @@
 #include <AMDTApplicationComponents/Include/acApplicationComponentsDLLBuild.h>
 #include <AMDTApplicationComponents/Include/acDefinitions.h>
 
+class QBitArray;
+class QFile;
+
 
 // ----------------------------------------------------------------------------------
 // Class Name:           acRawFileHandler
@@ -54,8 +63,9 @@ public:
     // Checks if the raw file handler was loaded successfully or not
     bool isOk() const  { return _isLoadedSuccesfully; };
 
-    // Loads raw data from file
-    bool loadFromFile(const osFilePath& rawDataFile);
+    // Loads raw data from file. When mapFile is true, the raw data is read in place from a read-only mapping
+    // of the file, so only the pages which are viewed are read into memory
+    bool loadFromFile(const osFilePath& rawDataFile, bool mapFile = false);
 
     // Sets the current active page in the raw data, default is page 0
     bool setActivePage(int pageIndex);
@@ -66,6 +76,9 @@ public:
     // Set filter raw file handler:
     void setFilterRawFileHandler(acRawFileHandler* pFilterRawFileHandler, unsigned int index) {if (index < AC_MAX_RAW_FILE_FILTER_HANDLERS) {_pFilterRawFileHandler[index] = pFilterRawFileHandler;};};
 
+    // Checks if any filter raw file handler is set:
+    bool hasFilterRawFileHandlers() const;
+
     // Convert the currently active page in the raw data into a QImage object:
     QImage* convertToQImage();
 
@@ -75,6 +88,22 @@ public:
     // Return a VBO raw data component value:
     bool getBufferRawDataComponentValue(int x, int y, apPixelValueParameter*& pParameter);
 
+    // Reads a raw data component value from a certain (xPos, yPos) position of the currently active page into a parameter owned by
+    // the caller (see createPixelValueDataParameter). The filters are not checked and the handler is not modified, so the values
+    // can be read on several threads, each with its own parameter
+    bool readRawDataComponentValue(int x, int y, int componentIndex, apPixelValueParameter* pParameter);
+
+    // Create an appropriate apPixelValueParameter which will be used to reading form raw data (owned by the caller)
+    apPixelValueParameter* createPixelValueDataParameter();
+
+    // Returns the raw data of the currently active page, for reading the component values in place (NULL for buffers).
+    // A pixel takes rawDataPixelSize() bytes. When each component has its own data type value, component i is at
+    // i * dataTypeSize() bytes within the pixel
+    const gtUByte* activePageRawData() const;
+    int rawDataPixelSize() const { return _rawDataPixelSize; }
+    int dataTypeSize() const { return _dataTypeSize; }
+    bool hasComponentPerDataTypeValue() const { return (_amountOfComponentsInDataType == 1); }
+
     // Ask the raw data to calculate it's best fit normal
     bool normalizeValues(oaTexelDataFormat texelFormat, bool force = false);
 
@@ -133,22 +162,185 @@ public:
     // Get the size, in bytes, of our data:
     gtSizeType getDataSize() const {return _rawDataSize;}
 
+    // Checks if the raw data is read in place from a mapping of the raw data file (see loadFromFile)
+    bool isMapped() const { return (_pMappedFile != NULL); }
+
     // Get the Y-flip flag state
     bool shouldYFlipImage() const { return m_yFlipImage; }
 
+    // Sets the memory budget, in bytes, of the converted pages cache (0 disables the cache and the pages prefetching)
+    void setPageCacheBudget(gtSizeType pageCacheBudget);
+
+    // Enables / disables the prefetching of the pages next to the active page (disabled when all the pages are converted in order, for example when exported)
+    void setPagePrefetchEnabled(bool isEnabled);
+    bool isPagePrefetchEnabled() const { return _isPagePrefetchEnabled; }
+
 private:
     // Initializes the raw file handler after loading data
     void initHandler();
 
-    // Create an appropriate apPixelValueParameter which will be used to reading form raw data
-    apPixelValueParameter* createPixelValueDataParameter();
     void clearDataParameter();
 
-    // Fill pixel value according to the raw data type
-    void calculateQImagePixelValue(gtUByte* pSrcRawData, uchar* pPixel, bool shouldPixelBeDisplayed);
+    // Maps a raw data file, and reads its dimensions and format from the file header
+    bool mapRawDataFile(const osFilePath& rawDataFile);
+
+    // Checks that a raw data file header describes exactly the raw data that follows it
+    static bool verifyMappedFileHeader(const qint32* header, quint64 dataSize);
+
+    // Releases the raw data (frees the memory or unmaps the file)
+    void releaseRawData();
+
+    // The ways a range of mapped raw data is about to be accessed (see adviseMappedData):
+    enum MappedDataAdvice
+    {
+        AC_MAPPED_DATA_WILL_NEED,   // The range is about to be displayed, read it ahead
+        AC_MAPPED_DATA_SEQUENTIAL,  // The range is about to be scanned from start to end
+        AC_MAPPED_DATA_DONT_NEED    // The range is not displayed anymore, its memory can be reclaimed
+    };
+
+    // Passes an access hint for a range of the raw data to the OS (when the raw data is mapped)
+    void adviseMappedData(gtSizeType offset, gtSizeType size, MappedDataAdvice advice);
+
+    // The ways of converting texels into QImage pixels (see selectTexelKernel):
+    enum TexelKernelType
+    {
+        AC_TEXEL_KERNEL_GENERIC,    // Each component is read through the pixel value parameter
+        AC_TEXEL_KERNEL_LOOKUP,     // Each component is converted through a lookup table (8 and 16 bits data types)
+        AC_TEXEL_KERNEL_SWIZZLE,    // The texel bytes are copied into the pixel bytes (4 x 8 bits components kept as is)
+        AC_TEXEL_KERNEL_TYPED       // Each component is read with a typed load (float, double, 32 bits integer data types)
+    };
+
+    // A texel component, and the QImage pixel bits it writes:
+    struct TexelComponent
+    {
+        // Index of the component in the texel format
+        int _componentIndex;
+
+        // Offset of the component data type in the texel
+        int _srcOffset;
+
+        // The pixel bits written by the component
+        quint32 _pixelMask;
+
+        // Spreads a channel value into the written pixel bytes (bits = channel value * spread)
+        quint32 _pixelSpread;
+
+        // Is the component value converted into the normalized colors?
+        bool _isNormalizedValue;
+
+        // The pixel bits written for each value of the component data type (lookup kernel only)
+        QVector<quint32> _lookupTable;
+    };
+
+    // A texel conversion kernel, selected once per conversion:
+    struct TexelKernel
+    {
+        TexelKernelType _type;
+
+        // The pixel before the components are written
+        quint32 _defaultPixel;
+
+        // The components written into the pixel, in order
+        QVector<TexelComponent> _components;
+
+        // Swizzle kernel only - the texel byte copied into each of the components pixel bytes
+        int _swizzleSrcByte[4];
+        int _swizzleDstByte[4];
+
+        // The pixels displayed according to the filters (NULL if there are no filters), and the color of the others
+        const QBitArray* _pDisplayedPixels;
+        quint32 _notInScopePixel;
+
+        // Typed kernel only - the minimum and maximum values the normalized component is converted with
+        double _minValue;
+        double _maxValue;
+    };
+
+    // Jobs processing bands of rows of the active page on a thread pool:
+    class ConversionJob;
+    class MinMaxJob;
+
+    // Job converting a page next to the active page in the background:
+    class PrefetchJob;
+
+    // The state a page image was converted in:
+    struct PageImageKey
+    {
+        int _page;
+        oaTexelDataFormat _texelDataFormat;
+        oaDataType _componentDataType;
+        bool _valuesNormalized;
+        double _minValue;
+        double _maxValue;
+        double _valueMultiplier;
+    };
+
+    // A cached page image:
+    struct PageImage
+    {
+        PageImageKey _key;
+        QImage _image;
+    };
+
+    // The cached lowest and highest values of a page:
+    struct PageMinMaxValues
+    {
+        oaTexelDataFormat _texelDataFormat;
+        oaDataType _componentDataType;
+        bool _shouldNegativeValuesBeNormalized;
+        double _minValue;
+        double _maxValue;
+    };
+
+    // Selects the kernel converting the texels of the current data type and format into QImage pixels
+    void selectTexelKernel(TexelKernel& kernel);
+
+    // Builds the lookup table of a texel component, by reading each possible value through the pixel value parameter
+    bool buildTexelLookupTable(TexelComponent& component);
+
+    // Calculates the pixel bits written by a texel component whose value was read into a parameter
+    quint32 calculateTexelComponentBits(const TexelComponent& component, apPixelValueParameter* pParameter);
+
+    // Converts a band of rows of a page into QImage lines
+    void convertTexelRows(const TexelKernel& kernel, int firstRow, int endRow, gtSizeType pageRawDataOffset, apPixelValueParameter* pParameter, uchar* pImageBits, int imageLineSize);
 
-    // Fill normalized pixel value according to the raw data type
-    void calculateNormalizedPixelValue(gtUByte* pSrcRawData, uchar* pPixel, bool shouldPixelBeDisplayed);
+    // Checks if the page images can be cached and prefetched (the filter handlers state is not part of the cached images key)
+    bool canCachePageImages() const;
+
+    // Gets the key of a page image converted in the current state
+    void getPageImageKey(int page, PageImageKey& key) const;
+
+    // Looks up / adds a page image in the converted pages cache (called by the prefetch jobs too)
+    bool findCachedPageImage(const PageImageKey& key, QImage* pImage);
+    void cachePageImage(const PageImageKey& key, const QImage& image);
+
+    // Removes the least recently used page images until the cache fits its budget (the cache mutex must be locked)
+    void trimPageImagesCache(gtSizeType pageCacheBudget);
+
+    // Queues the conversion of the pages following the active page in the scrub direction
+    void prefetchNeighborPages();
+
+    // Drops the queued prefetch jobs, without waiting for the running one (when the images they convert are not needed anymore)
+    void dropPrefetch();
+
+    // Drops the queued prefetch jobs and waits for the running one (before changing the state they read)
+    void cancelPrefetch();
+
+    // Clears the converted pages and lowest and highest values caches
+    void clearPageCaches();
+
+    // Converts a row of texels into QImage pixels
+    void convertTexelRow(const TexelKernel& kernel, gtUByte* pSrcRow, quint32* pDstRow, int width, apPixelValueParameter* pParameter);
+
+    // Calculates the amount of row bands the active page is split into when it is processed in parallel
+    int calculateRowBandsCount() const;
+
+    // Calculates which pixels are displayed according to the filter raw file handlers (false if there are no filters)
+    bool calculatePixelFilterMask(QBitArray& displayedPixels);
+
+    // Fill the normalized color of a value (R, G, B)
+    void calculateNormalizedColor(double currentVal, GLubyte* pPixelValue);
+    static void calculateNormalizedColor(double currentVal, double minValue, double maxValue, GLubyte* pPixelValue);
 
     // Function checks if negative values are allowed by the input texel format:
     bool shouldNormalizeDataNegativeValues(oaTexelDataFormat texelFormat);
@@ -157,12 +349,18 @@ private:
     // Retrieves channel value given an offset in the raw data pointing to the current pixel
     bool getPixelChannelValue(gtUByte* pDataOffset, int componentIndex, apPixelValueParameter*& pParameter);
 
+    // Reads a channel value into the given parameter
+    bool readPixelChannelValue(apPixelValueParameter* pParameter, gtUByte* pDataOffset, int componentIndex);
+
     // Checks if a pixel should be filtered:
     bool checkPixelFilter(int row, int col, bool& shouldDisplayPixel);
 
     // Finds the lowest and highest values in a raw data
     bool findMinMaxValuesFromRawData(bool shouldNegativeValuesBeNormalized);
 
+    // Finds the lowest and highest values in a band of rows of the active page
+    void findRowsMinMaxValues(int firstRow, int endRow, apPixelValueParameter* pParameter, bool shouldNegativeValuesBeNormalized, double& minValue, double& maxValue);
+
     // Calculates the value multiplier according to the minimum and maximum values
     void calculateValueMultiplier(double minValue, double maxValue);
 
@@ -198,6 +396,9 @@ private:
     // Total size, in bytes, of data held by us:
     gtSizeType _rawDataSize;
 
+    // The raw data file, when the raw data points into its mapping (NULL when the raw data is held in memory)
+    QFile* _pMappedFile;
+
     // Amount of pages in the raw data
     int _amountOfPages;
     int m_pageStride;
@@ -205,7 +406,7 @@ private:
 
     // Current active page in raw data and the offset in the raw data buffer
     int _activePage;
-    unsigned long _activePageRawDataOffset;
+    gtSizeType _activePageRawDataOffset;
 
     // Buffer offset:
     int _offset;
@@ -219,6 +420,26 @@ private:
     // Pixel value read parameter
     apPixelValueParameter* _pPixelValueDataParameter;
 
+    // The converted pages cache, used least recently first. Guarded by _pageCacheMutex, since the prefetch jobs add images to it
+    QMutex _pageCacheMutex;
+    QHash<int, PageImage> _pageImages;
+    QList<int> _pageImagesOrder;
+    gtSizeType _pageCacheSize;
+    gtSizeType _pageCacheBudget;
+
+    // The lowest and highest values of the pages, by page index
+    QHash<int, PageMinMaxValues> _pageMinMaxValues;
+
+    // The direction the pages were last switched in (1 or -1), the prefetched pages follow it
+    int _scrubDirection;
+
+    // Are the pages next to the active page prefetched
+    bool _isPagePrefetchEnabled;
+
+    // The pages prefetching thread, and a counter incremented when the prefetched images are not needed anymore
+    QThreadPool _prefetchThreadPool;
+    QAtomicInt _prefetchGeneration;
+
     static apGLfloatParameter* _pStaticGLFloatParamter;
     static apGLbyteParameter* _pStaticGLByteParamter;
     static apGLubyteParameter* _pStaticGLuByteParamter;
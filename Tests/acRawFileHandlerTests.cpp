@@ -0,0 +1,517 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acRawFileHandlerTests.cpp
+///
+//==================================================================================
+
+//------------------------------ acRawFileHandlerTests.cpp ------------------------------
+
+// Qt:
+#include <QColor>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+// C++:
+#include <stdlib.h>
+#include <string.h>
+
+// Infra:
+#include <AMDTOSWrappers/Include/osFilePath.h>
+
+// Local:
+#include <AMDTApplicationComponents/Include/acColours.h>
+#include <AMDTApplicationComponents/Include/acFunctions.h>
+#include <AMDTApplicationComponents/Include/acRawFileHandler.h>
+#include <Tests/acTests.h>
+
+// ---------------------------------------------------------------------------
+// Name:        acCompareRawFileHandlerPages
+// Description: Compares the active page of two raw file handlers, converted
+//              as is and normalized
+// Arguments:   inMemoryHandler - The handler holding the raw data in memory
+//              mappedHandler - The handler reading the raw data from the mapping
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static void acCompareRawFileHandlerPages(acRawFileHandler& inMemoryHandler, acRawFileHandler& mappedHandler)
+{
+    QImage* pInMemoryImage = inMemoryHandler.convertToQImage();
+    QImage* pMappedImage = mappedHandler.convertToQImage();
+
+    if (AC_TEST_CHECK((pInMemoryImage != NULL) && (pMappedImage != NULL)))
+    {
+        AC_TEST_CHECK(*pInMemoryImage == *pMappedImage);
+    }
+
+    delete pInMemoryImage;
+    delete pMappedImage;
+
+    // The lowest and highest values are found by scanning the page:
+    oaTexelDataFormat texelDataFormat = inMemoryHandler.dataFormat();
+    bool isInMemoryNormalized = inMemoryHandler.normalizeValues(texelDataFormat, true);
+    bool isMappedNormalized = mappedHandler.normalizeValues(texelDataFormat, true);
+    AC_TEST_CHECK(isInMemoryNormalized == isMappedNormalized);
+
+    if (isInMemoryNormalized && isMappedNormalized)
+    {
+        double inMemoryMinValue = 0, inMemoryMaxValue = 0, mappedMinValue = 0, mappedMaxValue = 0;
+        inMemoryHandler.getMinMaxValues(inMemoryMinValue, inMemoryMaxValue);
+        mappedHandler.getMinMaxValues(mappedMinValue, mappedMaxValue);
+        AC_TEST_CHECK((inMemoryMinValue == mappedMinValue) && (inMemoryMaxValue == mappedMaxValue));
+
+        pInMemoryImage = inMemoryHandler.convertToQImage();
+        pMappedImage = mappedHandler.convertToQImage();
+
+        if (AC_TEST_CHECK((pInMemoryImage != NULL) && (pMappedImage != NULL)))
+        {
+            AC_TEST_CHECK(*pInMemoryImage == *pMappedImage);
+        }
+
+        delete pInMemoryImage;
+        delete pMappedImage;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acGenerateTestRawData
+// Description: Generates texels. The float and double components are finite
+//              values around the [0, 1] range, the other components are
+//              random bits.
+// Arguments:   componentDataType - The component data type
+//              rawDataSize - The size of the raw data, in bytes
+// Return Val:  gtUByte* - The raw data (allocated with malloc, owned by the
+//              caller), or NULL if it could not be allocated
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static gtUByte* acGenerateTestRawData(oaDataType componentDataType, gtSizeType rawDataSize)
+{
+    gtUByte* pRetVal = (gtUByte*)malloc(rawDataSize);
+
+    if (pRetVal != NULL)
+    {
+        // The same texels are generated for each format:
+        quint32 randomState = 0x12345678;
+
+        for (gtSizeType i = 0; i < rawDataSize; i++)
+        {
+            randomState = randomState * 1664525 + 1013904223;
+            pRetVal[i] = (gtUByte)(randomState >> 24);
+        }
+
+        if (componentDataType == OA_FLOAT)
+        {
+            for (gtSizeType i = 0; i + sizeof(float) <= rawDataSize; i += sizeof(float))
+            {
+                quint32 bits = 0;
+                memcpy(&bits, pRetVal + i, sizeof(bits));
+                float value = (float)(bits % 4001) / 1000.0f - 1.5f;
+                memcpy(pRetVal + i, &value, sizeof(value));
+            }
+        }
+        else if (componentDataType == OA_DOUBLE)
+        {
+            for (gtSizeType i = 0; i + sizeof(double) <= rawDataSize; i += sizeof(double))
+            {
+                quint64 bits = 0;
+                memcpy(&bits, pRetVal + i, sizeof(bits));
+                double value = (double)(bits % 400001) / 100000.0 - 1.5;
+                memcpy(pRetVal + i, &value, sizeof(value));
+            }
+        }
+    }
+
+    return pRetVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acSaveTestRawDataFile
+// Description: Saves a raw data file of generated texels, in the layout of
+//              oaRawFileSeralizer (a header of 32 bits fields: width, height,
+//              texel format, data type and amount of pages, followed by the
+//              pages)
+// Arguments:   filePath - The path of the saved file
+//              texelDataFormat, componentDataType - The raw data format
+//              width, height - The pages size
+//              amountOfPages - The amount of pages
+// Return Val:  bool - Success / Failure
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static bool acSaveTestRawDataFile(const QString& filePath, oaTexelDataFormat texelDataFormat, oaDataType componentDataType, int width, int height, int amountOfPages)
+{
+    bool retVal = false;
+
+    gtSizeType rawDataSize = (gtSizeType)oaCalculatePixelUnitByteSize(texelDataFormat, componentDataType) * width * height * amountOfPages;
+    gtUByte* pRawData = acGenerateTestRawData(componentDataType, rawDataSize);
+    QFile rawDataFile(filePath);
+
+    if ((pRawData != NULL) && rawDataFile.open(QIODevice::WriteOnly))
+    {
+        qint32 header[] = {width, height, (qint32)texelDataFormat, (qint32)componentDataType, amountOfPages};
+
+        retVal = (rawDataFile.write((const char*)header, sizeof(header)) == (qint64)sizeof(header)) &&
+                 (rawDataFile.write((const char*)pRawData, rawDataSize) == (qint64)rawDataSize);
+    }
+
+    free(pRawData);
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acTestRawFileHandlerLoadModes
+// Description: Loads raw data files both into memory (through
+//              oaRawFileSeralizer) and mapped, and checks that the mapped file
+//              header is read as the serializer reads it, and that each page
+//              is converted into the same image. Raw data files of a few
+//              formats are generated, and checked with the given ones.
+// Arguments:   rawDataFiles - The paths of more raw data files saved by
+//              oaRawFileSeralizer
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acTestRawFileHandlerLoadModes(const QStringList& rawDataFiles)
+{
+    static const oaTexelDataFormat texelDataFormats[] = {OA_TEXEL_FORMAT_RGBA, OA_TEXEL_FORMAT_RGBA, OA_TEXEL_FORMAT_LUMINANCE, OA_TEXEL_FORMAT_RGB};
+    static const oaDataType componentDataTypes[] = {OA_UNSIGNED_BYTE, OA_FLOAT, OA_FLOAT, OA_UNSIGNED_SHORT};
+    const int amountOfGeneratedFiles = sizeof(texelDataFormats) / sizeof(texelDataFormats[0]);
+
+    QTemporaryDir generatedFilesDir;
+    QStringList allRawDataFiles;
+
+    if (AC_TEST_CHECK(generatedFilesDir.isValid()))
+    {
+        for (int i = 0; i < amountOfGeneratedFiles; i++)
+        {
+            QString generatedFilePath = QDir(generatedFilesDir.path()).filePath(QString("acTestRawData%1.raw").arg(i));
+
+            if (AC_TEST_CHECK(acSaveTestRawDataFile(generatedFilePath, texelDataFormats[i], componentDataTypes[i], 67 + i, 45, 3)))
+            {
+                allRawDataFiles.append(generatedFilePath);
+            }
+        }
+    }
+
+    allRawDataFiles.append(rawDataFiles);
+
+    foreach (const QString& rawDataFile, allRawDataFiles)
+    {
+        acTestMessage(QString("acTestRawFileHandlerLoadModes: %1").arg(rawDataFile));
+
+        osFilePath rawDataFilePath(acQStringToGTString(rawDataFile));
+
+        // The converted pages are not cached, so that each page is converted from the raw data:
+        acRawFileHandler inMemoryHandler;
+        acRawFileHandler mappedHandler;
+        inMemoryHandler.setPageCacheBudget(0);
+        mappedHandler.setPageCacheBudget(0);
+
+        bool isInMemoryLoaded = inMemoryHandler.loadFromFile(rawDataFilePath, false);
+        bool isMappedLoaded = mappedHandler.loadFromFile(rawDataFilePath, true);
+
+        // The mapped handler falls back to reading the file through the serializer when its header does not describe the data that follows it:
+        if (AC_TEST_CHECK(isInMemoryLoaded && isMappedLoaded) && AC_TEST_CHECK(mappedHandler.isMapped() && !inMemoryHandler.isMapped()))
+        {
+            int inMemoryWidth = 0, inMemoryHeight = 0, mappedWidth = 0, mappedHeight = 0;
+            inMemoryHandler.getSize(inMemoryWidth, inMemoryHeight);
+            mappedHandler.getSize(mappedWidth, mappedHeight);
+            AC_TEST_CHECK((inMemoryWidth == mappedWidth) && (inMemoryHeight == mappedHeight));
+            AC_TEST_CHECK(inMemoryHandler.dataFormat() == mappedHandler.dataFormat());
+            AC_TEST_CHECK(inMemoryHandler.dataType() == mappedHandler.dataType());
+            AC_TEST_CHECK(inMemoryHandler.getDataSize() == mappedHandler.getDataSize());
+
+            if (AC_TEST_CHECK(inMemoryHandler.amountOfPages() == mappedHandler.amountOfPages()))
+            {
+                for (int page = 0; page < inMemoryHandler.amountOfPages(); page++)
+                {
+                    if (AC_TEST_CHECK(inMemoryHandler.setActivePage(page) && mappedHandler.setActivePage(page)))
+                    {
+                        acCompareRawFileHandlerPages(inMemoryHandler, mappedHandler);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// The pixel bytes order of the converted images (little endian ARGB32):
+#define AC_TEST_PIXEL_ALPHA_INDEX 3
+#define AC_TEST_PIXEL_RED_INDEX 2
+#define AC_TEST_PIXEL_GREEN_INDEX 1
+#define AC_TEST_PIXEL_BLUE_INDEX 0
+
+// ---------------------------------------------------------------------------
+// Name:        acConvertPageReference
+// Description: Converts the active page of a raw file handler one pixel and
+//              one component at a time, through the pixel value parameter, as
+//              the raw file handler did before the texel kernels (the
+//              reference the kernels output is compared with)
+// Arguments:   handler - The raw file handler (without filters)
+// Return Val:  QImage - The converted page
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static QImage acConvertPageReference(acRawFileHandler& handler)
+{
+    int width = 0, height = 0;
+    handler.getSize(width, height);
+    QImage retVal(width, height, QImage::Format_ARGB32);
+
+    oaTexelDataFormat texelDataFormat = handler.dataFormat();
+    int amountOfComponents = oaAmountOfTexelFormatComponents(texelDataFormat);
+
+    double minValue = 0, maxValue = 0;
+    handler.getMinMaxValues(minValue, maxValue);
+
+    apPixelValueParameter* pParameter = handler.createPixelValueDataParameter();
+
+    for (int y = 0; (y < height) && (pParameter != NULL); y++)
+    {
+        int lineIndex = handler.shouldYFlipImage() ? height - (y + 1) : y;
+        uchar* pLine = retVal.scanLine(lineIndex);
+
+        for (int x = 0; x < width; x++)
+        {
+            GLubyte pixelValue[4] = {0, 0, 0, 0xff};
+
+            if (handler.isNormalized())
+            {
+                // The first component is converted into the normalized colors:
+                if (handler.readRawDataComponentValue(x, y, 0, pParameter))
+                {
+                    double currentVal = pParameter->valueAsDouble();
+
+                    if (currentVal > maxValue)
+                    {
+                        pixelValue[AC_TEST_PIXEL_RED_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.red();
+                        pixelValue[AC_TEST_PIXEL_GREEN_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.green();
+                        pixelValue[AC_TEST_PIXEL_BLUE_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.blue();
+                    }
+                    else if (currentVal < minValue)
+                    {
+                        pixelValue[AC_TEST_PIXEL_RED_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.red();
+                        pixelValue[AC_TEST_PIXEL_GREEN_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.green();
+                        pixelValue[AC_TEST_PIXEL_BLUE_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.blue();
+                    }
+                    else
+                    {
+                        currentVal -= minValue;
+
+                        if ((maxValue - minValue) > 0)
+                        {
+                            currentVal /= maxValue - minValue;
+                        }
+
+                        pixelValue[AC_TEST_PIXEL_RED_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.red();
+                        pixelValue[AC_TEST_PIXEL_GREEN_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.green();
+                        pixelValue[AC_TEST_PIXEL_BLUE_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.blue();
+                    }
+                }
+
+                // The alpha of the LUMINANCE_ALPHA formats is kept:
+                if ((texelDataFormat == OA_TEXEL_FORMAT_LUMINANCEALPHA) || (texelDataFormat == OA_TEXEL_FORMAT_LUMINANCEALPHA_COMPRESSED))
+                {
+                    if (handler.readRawDataComponentValue(x, y, 1, pParameter))
+                    {
+                        pixelValue[AC_TEST_PIXEL_ALPHA_INDEX] = pParameter->asPixelValue();
+                    }
+                }
+            }
+            else
+            {
+                for (int i = 0; i < amountOfComponents; i++)
+                {
+                    if (handler.readRawDataComponentValue(x, y, i, pParameter))
+                    {
+                        GLubyte channelValue = pParameter->asPixelValue();
+
+                        switch (oaGetTexelFormatComponentType(texelDataFormat, i))
+                        {
+                            case OA_TEXEL_FORMAT_STENCIL:
+                            case OA_TEXEL_FORMAT_DEPTH:
+                            case OA_TEXEL_FORMAT_LUMINANCE:
+                            case OA_TEXEL_FORMAT_COLORINDEX:
+                            case OA_TEXEL_FORMAT_VARIABLE_VALUE:
+                                memset(pixelValue, channelValue, 3 * sizeof(GLubyte));
+                                break;
+
+                            case OA_TEXEL_FORMAT_RED:
+                                pixelValue[AC_TEST_PIXEL_RED_INDEX] = channelValue;
+                                break;
+
+                            case OA_TEXEL_FORMAT_GREEN:
+                                pixelValue[AC_TEST_PIXEL_GREEN_INDEX] = channelValue;
+                                break;
+
+                            case OA_TEXEL_FORMAT_BLUE:
+                                pixelValue[AC_TEST_PIXEL_BLUE_INDEX] = channelValue;
+                                break;
+
+                            case OA_TEXEL_FORMAT_ALPHA:
+                                pixelValue[AC_TEST_PIXEL_ALPHA_INDEX] = channelValue;
+                                break;
+
+                            default:
+                                break;
+                        }
+                    }
+                }
+            }
+
+            memcpy(pLine + x * 4, pixelValue, 4);
+        }
+    }
+
+    delete pParameter;
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acCreateTestRawFileHandler
+// Description: Creates a raw file handler of two pages of generated texels.
+//              The float and double components are finite values around the
+//              [0, 1] range, the other components are random bits.
+// Arguments:   texelDataFormat, componentDataType - The raw data format
+//              width, height - The pages size
+// Return Val:  acRawFileHandler* - The handler (owned by the caller), or NULL
+//              if the format and data type do not describe texels
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static acRawFileHandler* acCreateTestRawFileHandler(oaTexelDataFormat texelDataFormat, oaDataType componentDataType, int width, int height)
+{
+    acRawFileHandler* pRetVal = NULL;
+
+    int pixelSize = oaCalculatePixelUnitByteSize(texelDataFormat, componentDataType);
+    int amountOfComponents = oaAmountOfTexelFormatComponents(texelDataFormat);
+    int amountOfComponentsInDataType = oaAmountComponentsInDataType(componentDataType);
+    int dataTypeSize = oaSizeOfDataType(componentDataType);
+
+    bool isTexelFormat = (pixelSize > 0) && (amountOfComponents > 0) && (dataTypeSize > 0) && (amountOfComponentsInDataType > 0) &&
+                         ((amountOfComponentsInDataType == 1) || (amountOfComponentsInDataType == amountOfComponents));
+
+    if (isTexelFormat)
+    {
+        const int amountOfPages = 2;
+        gtSizeType rawDataSize = (gtSizeType)pixelSize * width * height * amountOfPages;
+
+        // The raw file handler frees the raw data:
+        gtUByte* pRawData = acGenerateTestRawData(componentDataType, rawDataSize);
+
+        pRetVal = new acRawFileHandler(pRawData, rawDataSize, width, height, texelDataFormat, componentDataType, amountOfPages);
+        pRetVal->setPageCacheBudget(0);
+
+        if (!pRetVal->isOk())
+        {
+            delete pRetVal;
+            pRetVal = NULL;
+        }
+    }
+
+    return pRetVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acTestRawFileHandlerTexelKernels
+// Description: Converts pages of every texel format and data type through the
+//              texel kernels, and checks that the images are bit identical to
+//              the ones converted one pixel at a time (acConvertPageReference),
+//              as is and normalized (both within and outside of the range)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acTestRawFileHandlerTexelKernels()
+{
+    static const oaDataType componentDataTypes[] =
+    {
+        OA_UNSIGNED_BYTE, OA_UNSIGNED_BYTE_3_3_2, OA_UNSIGNED_BYTE_2_3_3_REV, OA_BYTE,
+        OA_UNSIGNED_SHORT, OA_UNSIGNED_SHORT_5_6_5, OA_UNSIGNED_SHORT_5_6_5_REV, OA_UNSIGNED_SHORT_4_4_4_4, OA_UNSIGNED_SHORT_4_4_4_4_REV,
+        OA_UNSIGNED_SHORT_5_5_5_1, OA_UNSIGNED_SHORT_1_5_5_5_REV, OA_SHORT,
+        OA_UNSIGNED_INT, OA_UNSIGNED_INT_8_8_8_8, OA_UNSIGNED_INT_8_8_8_8_REV, OA_UNSIGNED_INT_10_10_10_2, OA_UNSIGNED_INT_2_10_10_10_REV, OA_INT,
+        OA_LONG, OA_UNSIGNED_LONG, OA_FLOAT, OA_DOUBLE
+    };
+
+    // A small page, converted on the calling thread, and a page converted in parallel row bands (and with lookup tables for 16 bits data types):
+    static const int pageSizes[][2] = {{7, 5}, {520, 260}};
+
+    int amountOfCombinations = 0;
+
+    for (int format = 0; format <= (int)OA_TEXEL_FORMAT_LAST_CL_BUFFER_FORMAT; format++)
+    {
+        oaTexelDataFormat texelDataFormat = (oaTexelDataFormat)format;
+
+        if ((texelDataFormat == OA_TEXEL_FORMAT_UNKNOWN) || oaIsBufferTexelFormat(texelDataFormat))
+        {
+            continue;
+        }
+
+        for (size_t typeIndex = 0; typeIndex < sizeof(componentDataTypes) / sizeof(componentDataTypes[0]); typeIndex++)
+        {
+            oaDataType componentDataType = componentDataTypes[typeIndex];
+
+            for (size_t sizeIndex = 0; sizeIndex < sizeof(pageSizes) / sizeof(pageSizes[0]); sizeIndex++)
+            {
+                // 0 - as is, 1 - normalized to the page values, 2 - normalized to a range the values are partly out of:
+                for (int mode = 0; mode < 3; mode++)
+                {
+                    acRawFileHandler* pHandler = acCreateTestRawFileHandler(texelDataFormat, componentDataType, pageSizes[sizeIndex][0], pageSizes[sizeIndex][1]);
+
+                    if (pHandler == NULL)
+                    {
+                        break;
+                    }
+
+                    bool isModeSet = true;
+
+                    if (mode == 1)
+                    {
+                        // Only single component formats are normalized to their values:
+                        isModeSet = (oaAmountOfTexelFormatComponents(texelDataFormat) == 1) && pHandler->normalizeValues(texelDataFormat, true);
+                    }
+                    else if (mode == 2)
+                    {
+                        bool isFloatingPoint = (componentDataType == OA_FLOAT) || (componentDataType == OA_DOUBLE);
+                        isModeSet = isFloatingPoint ? pHandler->setMinMaxValues(-0.5, 1.25) : pHandler->setMinMaxValues(3, 100);
+                    }
+
+                    if (isModeSet)
+                    {
+                        amountOfCombinations++;
+
+                        for (int page = 0; page < pHandler->amountOfPages(); page++)
+                        {
+                            if (AC_TEST_CHECK(pHandler->setActivePage(page)))
+                            {
+                                QImage* pImage = pHandler->convertToQImage();
+
+                                if (AC_TEST_CHECK(pImage != NULL))
+                                {
+                                    bool isIdentical = (*pImage == acConvertPageReference(*pHandler));
+
+                                    if (!AC_TEST_CHECK(isIdentical))
+                                    {
+                                        acTestMessage(QString("  texel format %1, data type %2, page size %3x%4, mode %5, page %6").arg(format).arg((int)componentDataType)
+                                                      .arg(pageSizes[sizeIndex][0]).arg(pageSizes[sizeIndex][1]).arg(mode).arg(page));
+                                    }
+                                }
+
+                                delete pImage;
+                            }
+                        }
+                    }
+
+                    delete pHandler;
+                }
+            }
+        }
+    }
+
+    acTestMessage(QString("acTestRawFileHandlerTexelKernels: %1 formats, data types and modes compared").arg(amountOfCombinations));
+    AC_TEST_CHECK(amountOfCombinations > 0);
+}
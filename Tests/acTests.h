@@ -0,0 +1,37 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTests.h
+///
+//==================================================================================
+
+//------------------------------ acTests.h ------------------------------
+
+#ifndef __ACTESTS
+#define __ACTESTS
+
+// Qt:
+#include <QStringList>
+
+// Checks a test condition. A failed condition is printed and counted, and the test goes on:
+#define AC_TEST_CHECK(condition) acTestCheck((condition), #condition, __FILE__, __LINE__)
+
+// Counts and prints a failed test condition. Returns the condition
+bool acTestCheck(bool condition, const char* conditionText, const char* fileName, int lineNumber);
+
+// Prints a test progress message
+void acTestMessage(const QString& message);
+
+// The test suites. Each suite checks its conditions with AC_TEST_CHECK:
+
+// Loads generated raw data files and the given ones (saved by oaRawFileSeralizer) both in memory and mapped, and compares their pages
+void acTestRawFileHandlerLoadModes(const QStringList& rawDataFiles);
+
+// Checks that the texel kernels convert every texel format and data type into the same pixels as the per pixel conversion
+void acTestRawFileHandlerTexelKernels();
+
+// Checks that the timeline painted from the tiles rasterized on the worker threads looks the same as the timeline painted directly
+void acTestTimelineTileRendering();
+
+#endif  // __ACTESTS
@@ -0,0 +1,64 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTestsMain.cpp
+///
+//==================================================================================
+
+//------------------------------ acTestsMain.cpp ------------------------------
+
+// The application components tests. Runs headless, on the offscreen Qt platform plugin:
+//   CXLApplicationComponentsTests [raw data files...]
+// The raw data files (saved by oaRawFileSeralizer) are checked by the raw file handler tests, with the files they generate.
+// Returns 0 when all the checks passed.
+
+// Qt:
+#include <QApplication>
+#include <QStringList>
+
+// C++:
+#include <stdio.h>
+
+// Local:
+#include <Tests/acTests.h>
+
+static int s_failedChecksCount = 0;
+static int s_checksCount = 0;
+
+bool acTestCheck(bool condition, const char* conditionText, const char* fileName, int lineNumber)
+{
+    s_checksCount++;
+
+    if (!condition)
+    {
+        s_failedChecksCount++;
+        fprintf(stderr, "%s(%d): check failed: %s\n", fileName, lineNumber, conditionText);
+    }
+
+    return condition;
+}
+
+void acTestMessage(const QString& message)
+{
+    printf("%s\n", message.toUtf8().constData());
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[])
+{
+    // The tests paint into images, no display is needed:
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication application(argc, argv);
+
+    QStringList arguments = application.arguments();
+    arguments.removeFirst();
+
+    acTestRawFileHandlerTexelKernels();
+    acTestRawFileHandlerLoadModes(arguments);
+    acTestTimelineTileRendering();
+
+    printf("%d checks, %d failed\n", s_checksCount, s_failedChecksCount);
+
+    return (s_failedChecksCount == 0) ? 0 : 1;
+}
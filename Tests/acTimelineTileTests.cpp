@@ -0,0 +1,274 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTileTests.cpp
+///
+//==================================================================================
+
+//------------------------------ acTimelineTileTests.cpp ------------------------------
+
+// Qt:
+#include <QApplication>
+#include <QColor>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QList>
+#include <QThread>
+
+// C++:
+#include <new>
+
+// Local:
+#include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+#include <Tests/acTests.h>
+
+// The longest time to wait for the worker threads to rasterize the tiles of a view, in milliseconds:
+#define AC_TEST_TILES_TIMEOUT 60000
+
+// The largest difference of a color channel between the directly painted and the tiled timeline.  The tiles are composited onto
+// the rows, and the gradients are computed relative to another origin, which may round a channel differently:
+#define AC_TEST_TILES_TOLERANCE 4
+
+// ---------------------------------------------------------------------------
+// Name:        acAddTestTimelineItems
+// Description: Adds items to a timeline branch, with texts and colors, some
+//              of them overlapping the previous item
+// Arguments:   pBranch - The branch
+//              itemCount - The amount of items to add
+//              isCompact - Add compact items rather than acTimelineItem
+//                          objects
+//              seed - The seed of the item times
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static void acAddTestTimelineItems(acTimelineBranch* pBranch, int itemCount, bool isCompact, quint32 seed)
+{
+    quint32 randomValue = seed;
+    quint64 startTime = 0;
+    quint64 endTime = 0;
+    QList<acTimelineItem*> items;
+
+    for (int i = 0; i < itemCount; i++)
+    {
+        randomValue = randomValue * 1664525 + 1013904223;
+        quint64 duration = 1 + ((randomValue >> 8) % 2000);
+
+        // Every fourth item starts before the previous one ends:
+        if ((i % 4) == 3)
+        {
+            startTime += (endTime - startTime) / 2;
+        }
+        else
+        {
+            startTime = endTime + ((randomValue >> 20) % 500);
+        }
+
+        endTime = startTime + duration;
+
+        QColor itemColor = QColor::fromHsv((i * 37) % 360, 170, 210);
+        QString itemText = QString("item %1").arg(i % 50);
+
+        if (isCompact)
+        {
+            pBranch->addCompactItem(startTime, endTime, itemColor, itemText);
+        }
+        else
+        {
+            acTimelineItem* pItem = new(std::nothrow) acTimelineItem(startTime, endTime);
+
+            if (pItem != NULL)
+            {
+                pItem->setBackgroundColor(itemColor);
+                pItem->setText(itemText);
+                items.append(pItem);
+            }
+        }
+    }
+
+    if (!items.isEmpty())
+    {
+        pBranch->addTimelineItems(items);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRenderTimelineDirect
+// Description: Paints a timeline without its tile cache, the items being
+//              painted directly onto the rows
+// Arguments:   timeline - The timeline
+// Return Val:  QImage - The painted timeline
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static QImage acRenderTimelineDirect(acTimeline& timeline)
+{
+    QImage retVal(timeline.size(), QImage::Format_ARGB32_Premultiplied);
+
+    timeline.setTileCacheEnabled(false);
+    timeline.render(&retVal);
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRenderTimelineTiles
+// Description: Paints a timeline from its tile cache, after the tiles of the
+//              view were rasterized on the worker threads
+// Arguments:   timeline - The timeline
+// Return Val:  QImage - The painted timeline
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static QImage acRenderTimelineTiles(acTimeline& timeline)
+{
+    QImage retVal(timeline.size(), QImage::Format_ARGB32_Premultiplied);
+
+    timeline.setTileCacheEnabled(true);
+    timeline.setAsyncTileRendering(true);
+    timeline.clearTileCache();
+
+    // Painting the view submits its tiles to the worker threads:
+    timeline.render(&retVal);
+
+    // The rasterized tiles are added to the cache by a queued call on the GUI thread:
+    QElapsedTimer waitTimer;
+    waitTimer.start();
+
+    while ((timeline.pendingTileCount() > 0) && (waitTimer.elapsed() < AC_TEST_TILES_TIMEOUT))
+    {
+        QApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+
+    AC_TEST_CHECK(timeline.pendingTileCount() == 0);
+
+    // Now the view is painted from the cached tiles:
+    timeline.render(&retVal);
+    AC_TEST_CHECK(timeline.pendingTileCount() == 0);
+
+    // The tile cache would be disabled if a tile did not fit in its budget:
+    AC_TEST_CHECK(timeline.isTileCacheEnabled());
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acCountDifferentPixels
+// Description: Counts the pixels of two images of the same size whose color
+//              channels differ by more than AC_TEST_TILES_TOLERANCE
+// Arguments:   image1 - The first image
+//              image2 - The second image
+// Return Val:  int - The number of different pixels (all of them if the
+//              sizes differ)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static int acCountDifferentPixels(const QImage& image1, const QImage& image2)
+{
+    int retVal = 0;
+
+    if (image1.size() != image2.size())
+    {
+        retVal = image1.width() * image1.height();
+    }
+    else
+    {
+        for (int y = 0; y < image1.height(); y++)
+        {
+            const QRgb* pLine1 = reinterpret_cast<const QRgb*>(image1.constScanLine(y));
+            const QRgb* pLine2 = reinterpret_cast<const QRgb*>(image2.constScanLine(y));
+
+            for (int x = 0; x < image1.width(); x++)
+            {
+                QRgb pixel1 = pLine1[x];
+                QRgb pixel2 = pLine2[x];
+
+                if ((qAbs(qRed(pixel1) - qRed(pixel2)) > AC_TEST_TILES_TOLERANCE) ||
+                    (qAbs(qGreen(pixel1) - qGreen(pixel2)) > AC_TEST_TILES_TOLERANCE) ||
+                    (qAbs(qBlue(pixel1) - qBlue(pixel2)) > AC_TEST_TILES_TOLERANCE) ||
+                    (qAbs(qAlpha(pixel1) - qAlpha(pixel2)) > AC_TEST_TILES_TOLERANCE))
+                {
+                    retVal++;
+                }
+            }
+        }
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acTestTimelineTileRendering
+// Description: Checks that a timeline painted from the tiles rasterized on
+//              the worker threads (the recorded tile paint commands played
+//              into images, with the labels painted over them) looks the
+//              same as the timeline painted directly, for several painting
+//              styles and zoom levels
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acTestTimelineTileRendering()
+{
+    acTestMessage("acTestTimelineTileRendering");
+
+    acTimeline* pTimeline = new(std::nothrow) acTimeline(NULL);
+
+    if (AC_TEST_CHECK(pTimeline != NULL))
+    {
+        // The timeline only lays itself out when it is visible. On the offscreen platform, showing it does not need a display:
+        pTimeline->resize(1200, 400);
+        pTimeline->show();
+        QApplication::processEvents();
+
+        // A branch of item objects with a sub branch of compact items, and a branch of compact items:
+        acTimelineBranch* pObjectsBranch = new(std::nothrow) acTimelineBranch;
+        acTimelineBranch* pSubBranch = new(std::nothrow) acTimelineBranch;
+        acTimelineBranch* pCompactBranch = new(std::nothrow) acTimelineBranch;
+
+        if (AC_TEST_CHECK((pObjectsBranch != NULL) && (pSubBranch != NULL) && (pCompactBranch != NULL)))
+        {
+            pObjectsBranch->setText("Objects");
+            pSubBranch->setText("Sub branch");
+            pCompactBranch->setText("Compact");
+            acAddTestTimelineItems(pObjectsBranch, 20000, false, 1);
+            acAddTestTimelineItems(pSubBranch, 5000, true, 2);
+            acAddTestTimelineItems(pCompactBranch, 20000, true, 3);
+            pObjectsBranch->addSubBranch(pSubBranch);
+            pTimeline->addBranch(pObjectsBranch);
+            pTimeline->addBranch(pCompactBranch);
+        }
+
+        const double zoomFactors[] = { 1.0, 8.0, 64.0, 512.0, 4096.0 };
+        const int zoomFactorsCount = sizeof(zoomFactors) / sizeof(zoomFactors[0]);
+
+        for (int style = 0; style < 3; style++)
+        {
+            // Gradient and rounded backgrounds, solid backgrounds, and batched solid backgrounds:
+            pTimeline->setGradientPainting(style == 0);
+            pTimeline->setRoundedRectangles(style == 0);
+            pTimeline->setBatchedPainting(style == 2);
+
+            for (int zoomIndex = 0; zoomIndex < zoomFactorsCount; zoomIndex++)
+            {
+                pTimeline->setZoomFactor(1.0);
+                pTimeline->setPivot(0.37);
+                pTimeline->setZoomFactor(zoomFactors[zoomIndex]);
+
+                QImage directImage = acRenderTimelineDirect(*pTimeline);
+                QImage tilesImage = acRenderTimelineTiles(*pTimeline);
+                int differentPixels = acCountDifferentPixels(directImage, tilesImage);
+
+                if (!AC_TEST_CHECK(differentPixels == 0))
+                {
+                    acTestMessage(QString("acTestTimelineTileRendering: %1 pixels of the tiles differ from the direct painting at style %2, zoom %3")
+                                  .arg(differentPixels).arg(style).arg(zoomFactors[zoomIndex]));
+                }
+            }
+        }
+
+        delete pTimeline;
+    }
+}
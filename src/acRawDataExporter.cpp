@@ -10,6 +10,12 @@
 
 // Qt
 #include <QtWidgets>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+// Standard C:
+#include <string.h>
 
 // Infra:
 #include <AMDTBaseTools/Include/gtAssert.h>
@@ -21,6 +27,160 @@
 #include <AMDTApplicationComponents/Include/acRawDataExporter.h>
 #include <AMDTApplicationComponents/Include/acImageDataProxy.h>
 
+// The CSV text is written to the file in chunks of (at least) this amount of characters:
+#define AC_CSV_EXPORT_CHUNK_LENGTH (1024 * 1024)
+
+// The amount of rows formatted by each job, and the amount of jobs queued for each thread at once
+// (the rows are formatted in batches, so that the formatted text which waits to be written is bounded):
+#define AC_CSV_EXPORT_ROWS_PER_BAND 8
+#define AC_CSV_EXPORT_BANDS_PER_THREAD 4
+
+// The amount of values of a page which appendFloatCSVValue is checked on, before it is used for the page:
+#define AC_CSV_EXPORT_CHECKED_FLOAT_VALUES 256
+
+// appendFloatCSVValue handles the floats below 2^(24 + AC_CSV_EXPORT_FLOAT_MAX_SHIFT), so that their value in millionths fits in 64 bits:
+#define AC_CSV_EXPORT_FLOAT_MAX_SHIFT 19
+
+// The values appendFloatCSVValue is checked on, in addition to the page values (including exact ties of the sixth decimal, 1/128 and 3/128):
+static const float s_csvCheckedFloatValues[] = { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 0.1f, -2.75f, 3.14159274f, 0.0078125f, 0.0234375f, -0.0234375f,
+                                                 1.0e-7f, -1.0e-7f, 4.0e-6f, 0.9999995f, 1234567.875f, 1.0e10f, 8.5e12f
+                                               };
+
+// ---------------------------------------------------------------------------
+// Name:        appendFloatCSVValue
+// Description: Appends a float value to the CSV text as the "%f" printf format
+//              prints it: 6 decimals, rounded half to even, and a minus sign
+//              for the negative values (including the ones rounded to zero).
+//              The value is converted with integer arithmetic, which is exact
+//              for the float values
+// Arguments:   value - The value
+//              csvText - The text the value is appended to
+// Return Val:  bool - false for the infinities, the NaNs and the values too
+//              large to convert (nothing is appended)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+static bool appendFloatCSVValue(float value, gtASCIIString& csvText)
+{
+    bool retVal = false;
+
+    quint32 valueBits = 0;
+    memcpy(&valueBits, &value, sizeof(valueBits));
+
+    int exponent = (int)((valueBits >> 23) & 0xff);
+    quint64 mantissa = valueBits & 0x7fffff;
+
+    // Skip the infinities and the NaNs:
+    if (exponent != 0xff)
+    {
+        // The value is mantissa * 2^shift:
+        if (exponent == 0)
+        {
+            exponent = 1;
+        }
+        else
+        {
+            mantissa |= 0x800000;
+        }
+
+        int shift = exponent - 150;
+
+        // Get the value in millionths (below 2^44 before the shift):
+        quint64 millionths = mantissa * 1000000;
+        bool isInRange = true;
+
+        if (shift >= 0)
+        {
+            isInRange = (shift <= AC_CSV_EXPORT_FLOAT_MAX_SHIFT);
+            millionths = isInRange ? (millionths << shift) : 0;
+        }
+        else if (shift > -64)
+        {
+            // Round half to even, as printf does:
+            quint64 remainder = millionths & ((1ULL << -shift) - 1);
+            quint64 half = 1ULL << (-shift - 1);
+            millionths >>= -shift;
+
+            if ((remainder > half) || ((remainder == half) && ((millionths & 1) != 0)))
+            {
+                millionths++;
+            }
+        }
+        else
+        {
+            millionths = 0;
+        }
+
+        if (isInRange)
+        {
+            // Write the digits from the last one:
+            char digits[32];
+            char* pDigit = digits + sizeof(digits);
+            *(--pDigit) = '\0';
+
+            quint32 fraction = (quint32)(millionths % 1000000);
+            quint64 integerPart = millionths / 1000000;
+
+            for (int i = 0; i < 6; i++)
+            {
+                *(--pDigit) = (char)('0' + (fraction % 10));
+                fraction /= 10;
+            }
+
+            *(--pDigit) = '.';
+
+            do
+            {
+                *(--pDigit) = (char)('0' + (integerPart % 10));
+                integerPart /= 10;
+            }
+            while (integerPart != 0);
+
+            if ((valueBits >> 31) != 0)
+            {
+                *(--pDigit) = '-';
+            }
+
+            csvText.append(pDigit);
+            retVal = true;
+        }
+    }
+
+    return retVal;
+}
+
+// Formats a band of rows of a non buffer CSV page
+class acRawDataExporter::CSVRowsJob : public QRunnable
+{
+public:
+    CSVRowsJob(acRawDataExporter* pExporter, int firstRow, int endRow, int width, const QVector<bool>& isChannelWritten, const QVector<gtASCIIString>& channelNames,
+               gtASCIIString& csvText)
+        : _pExporter(pExporter), _firstRow(firstRow), _endRow(endRow), _width(width), _isChannelWritten(isChannelWritten), _channelNames(channelNames), _csvText(csvText)
+    {
+    }
+
+    virtual void run()
+    {
+        // The values are read through a parameter of this job, since the parameters hold the value they read:
+        apPixelValueParameter* pParameter = _pExporter->_pRawDataHandler->createPixelValueDataParameter();
+        GT_IF_WITH_ASSERT(pParameter != NULL)
+        {
+            _pExporter->formatNonBufferCSVRows(_firstRow, _endRow, _width, _isChannelWritten, _channelNames, pParameter, _csvText);
+        }
+
+        delete pParameter;
+    }
+
+private:
+    acRawDataExporter* _pExporter;
+    int _firstRow;
+    int _endRow;
+    int _width;
+    const QVector<bool>& _isChannelWritten;
+    const QVector<gtASCIIString>& _channelNames;
+    gtASCIIString& _csvText;
+};
+
 // ---------------------------------------------------------------------------
 // Name:        acRawDataExporter::acRawDataExporter
 // Description: Constructor
@@ -29,7 +189,7 @@
 // Date:        27/1/2008
 // ---------------------------------------------------------------------------
 acRawDataExporter::acRawDataExporter(acRawFileHandler* pRawDataHandler)
-    : _pRawDataHandler(pRawDataHandler), _outputFileType(AP_PNG_FILE)
+    : _pRawDataHandler(pRawDataHandler), _outputFileType(AP_PNG_FILE), _csvCellFormatType(AC_CSV_CELL_PARAMETER), _csvValueTextsDataType(OA_BYTE)
 {
 
 }
@@ -322,6 +482,10 @@ bool acRawDataExporter::fillMultiPageBitmap(QImage* pQMultiBitmap)
     {
         retVal = true;
 
+        // All the pages are converted in order, so the pages next to the active one should not be prefetched:
+        bool wasPagePrefetchEnabled = _pRawDataHandler->isPagePrefetchEnabled();
+        _pRawDataHandler->setPagePrefetchEnabled(false);
+
         // Loop through all the pages in the raw data:
         int amountOfPages = _pRawDataHandler->amountOfPages();
 
@@ -360,6 +524,8 @@ bool acRawDataExporter::fillMultiPageBitmap(QImage* pQMultiBitmap)
             // We return true only if all iterations were successful
             retVal = retVal && isSuccess;
         }
+
+        _pRawDataHandler->setPagePrefetchEnabled(wasPagePrefetchEnabled);
     }
 
     return retVal;
@@ -482,37 +648,27 @@ bool acRawDataExporter::writeNonBufferCSVPageContent(osFile& csvFile)
         int height = 0;
         _pRawDataHandler->getSize(width, height);
 
-        // Generate the CSV file columns:
-        gtString csvColumns;
+        // Generate the CSV file columns (the CSV text is written to the file in chunks):
+        gtASCIIString csvText;
         // Add an empty cell at top left corner
-        csvColumns.append(L",");
+        csvText.append(",");
 
         // First generate the first line - table columns:
         for (int i = 0; i < width; i++)
         {
-            csvColumns.appendFormattedString(L"[%d],", i);
+            csvText.appendFormattedString("[%d],", i);
         }
 
-        // Write columns to file
-        csvFile << csvColumns;
-
         // Get amount of components in data format
         int amountOfComponents = oaAmountOfTexelFormatComponents(dataFormat);
         GT_IF_WITH_ASSERT(amountOfComponents != -1)
         {
-            // Calculate number of rows (which is the data height * amount of components)
-            int rowsNum = height * amountOfComponents;
+            // Get the channels names once, rather than for each row:
+            QVector<bool> isChannelWritten(amountOfComponents, false);
+            QVector<gtASCIIString> channelNames(amountOfComponents);
 
-            // Start pouring the data
-            for (int y = 0; y < rowsNum; y++)
+            for (int channelIndex = 0; channelIndex < amountOfComponents; channelIndex++)
             {
-                // Start a new line
-                csvFile << "\n";
-
-                // Write row label which is component name and y position in raw data
-                int yPosition = y / amountOfComponents;
-                int channelIndex = y % amountOfComponents;
-
                 // Get current channel type
                 oaTexelDataFormat channelType = oaGetTexelFormatComponentType(dataFormat, channelIndex);
                 GT_IF_WITH_ASSERT(channelType != OA_TEXEL_FORMAT_STENCIL)
@@ -520,45 +676,336 @@ bool acRawDataExporter::writeNonBufferCSVPageContent(osFile& csvFile)
                     // Get current channel name
                     gtString channelName;
                     bool rcGetChannelName = oaGetTexelDataFormatName(channelType, channelName);
-                    GT_IF_WITH_ASSERT(rcGetChannelName)
+                    GT_ASSERT(rcGetChannelName);
+
+                    channelNames[channelIndex].append(channelName.asASCIICharArray());
+                    isChannelWritten[channelIndex] = rcGetChannelName;
+                }
+            }
+
+            // Select how the values are formatted (on this thread, before the rows are formatted in parallel):
+            selectCSVCellFormat();
+
+            // Calculate number of rows (which is the data height * amount of components)
+            int rowsNum = height * amountOfComponents;
+
+            if (_pRawDataHandler->hasFilterRawFileHandlers())
+            {
+                // The filters are checked by the raw data handler, which is not thread safe:
+                for (int y = 0; y < rowsNum; y++)
+                {
+                    formatNonBufferCSVRows(y, y + 1, width, isChannelWritten, channelNames, NULL, csvText);
+                    flushCSVText(csvFile, csvText, false);
+                }
+            }
+            else
+            {
+                // Format the rows in parallel, a batch of bands at a time, and write the bands in order:
+                int amountOfBands = qMax(QThread::idealThreadCount(), 1) * AC_CSV_EXPORT_BANDS_PER_THREAD;
+                QVector<gtASCIIString> bandsText(amountOfBands);
+
+                for (int batchFirstRow = 0; batchFirstRow < rowsNum; batchFirstRow += amountOfBands * AC_CSV_EXPORT_ROWS_PER_BAND)
+                {
+                    QThreadPool threadPool;
+                    int amountOfBatchBands = 0;
+
+                    for (int i = 0; i < amountOfBands; i++)
                     {
-                        // Write channel name and y position as row label
-                        gtString csvRowLabel;
-                        csvRowLabel.appendFormattedString(L"%ls [%d]: ,", channelName.asCharArray(), yPosition);
-                        csvFile << csvRowLabel;
+                        int firstRow = batchFirstRow + i * AC_CSV_EXPORT_ROWS_PER_BAND;
 
-                        for (int x = 0; x < width; x++)
+                        if (firstRow >= rowsNum)
                         {
-                            // Get cell value
-                            apPixelValueParameter* pParameter;
-                            bool isValueAvailable = false;
-                            bool rc2 = _pRawDataHandler->getRawDataComponentValue(x, yPosition, channelIndex, pParameter, isValueAvailable);
-
-                            if (rc2)
-                            {
-                                if (pParameter)
-                                {
-                                    // Get cell value as string
-                                    gtString cellValue;
-                                    pParameter->valueAsString(cellValue);
-
-                                    // Write cell value
-                                    gtString csvCellValue;
-                                    csvCellValue.appendFormattedString(L"%ls,", cellValue.asCharArray());
-
-                                    // Write csv cell value to file
-                                    csvFile << csvCellValue;
-                                }
-                            }
+                            break;
                         }
+
+                        int endRow = qMin(firstRow + AC_CSV_EXPORT_ROWS_PER_BAND, rowsNum);
+                        threadPool.start(new CSVRowsJob(this, firstRow, endRow, width, isChannelWritten, channelNames, bandsText[i]));
+                        amountOfBatchBands++;
+                    }
+
+                    threadPool.waitForDone();
+
+                    for (int i = 0; i < amountOfBatchBands; i++)
+                    {
+                        csvText.append(bandsText[i]);
+                        bandsText[i].makeEmpty();
+
+                        flushCSVText(csvFile, csvText, false);
+                    }
+                }
+            }
+        }
+
+        // Write the rest of the text to file
+        flushCSVText(csvFile, csvText, true);
+    }
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawDataExporter::selectCSVCellFormat
+// Description: Selects how the cells of the active page are formatted: the 8
+//              and 16 bits values are looked up in a table holding the
+//              parameter text of every value, and the float values are
+//              formatted by appendFloatCSVValue once it was checked to format
+//              them like the parameter. The other values are formatted
+//              through the parameter.
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawDataExporter::selectCSVCellFormat()
+{
+    _csvCellFormatType = AC_CSV_CELL_PARAMETER;
+
+    oaDataType dataType = _pRawDataHandler->dataType();
+    int dataTypeSize = _pRawDataHandler->dataTypeSize();
+
+    // The packed data types hold several components in each value:
+    if ((_pRawDataHandler->activePageRawData() != NULL) && _pRawDataHandler->hasComponentPerDataTypeValue())
+    {
+        apPixelValueParameter* pParameter = _pRawDataHandler->createPixelValueDataParameter();
+        GT_IF_WITH_ASSERT(pParameter != NULL)
+        {
+            if ((dataTypeSize == 1) || (dataTypeSize == 2))
+            {
+                // Format every value once (the table is kept for the next pages):
+                if (_csvValueTexts.isEmpty() || (_csvValueTextsDataType != dataType))
+                {
+                    int amountOfValues = 1 << (dataTypeSize * 8);
+                    _csvValueTexts.resize(amountOfValues);
+                    _csvValueTextsDataType = dataType;
+
+                    for (int i = 0; i < amountOfValues; i++)
+                    {
+                        quint8 byteValue = (quint8)i;
+                        quint16 shortValue = (quint16)i;
+                        pParameter->readValueFromPointer((dataTypeSize == 1) ? (void*)&byteValue : (void*)&shortValue);
+
+                        gtString valueText;
+                        pParameter->valueAsString(valueText);
+                        _csvValueTexts[i] = valueText.asASCIICharArray();
                     }
                 }
+
+                _csvCellFormatType = AC_CSV_CELL_TABLE;
+            }
+            else if ((dataType == OA_FLOAT) && isFloatCSVFormatMatching(pParameter))
+            {
+                _csvCellFormatType = AC_CSV_CELL_FLOAT;
             }
         }
+
+        delete pParameter;
     }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawDataExporter::isFloatCSVFormatMatching
+// Description: Checks that appendFloatCSVValue formats the float values like
+//              the pixel value parameter does, on a set of values (signs, ties
+//              of the sixth decimal, tiny and large values) and on the first
+//              values of the active page
+// Arguments:   pParameter - A float pixel value parameter
+// Return Val:  bool - true if all the texts match
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawDataExporter::isFloatCSVFormatMatching(apPixelValueParameter* pParameter)
+{
+    bool retVal = true;
+
+    QVector<float> checkedValues;
+
+    for (size_t i = 0; i < sizeof(s_csvCheckedFloatValues) / sizeof(s_csvCheckedFloatValues[0]); i++)
+    {
+        checkedValues.append(s_csvCheckedFloatValues[i]);
+    }
+
+    int width = 0;
+    int height = 0;
+    _pRawDataHandler->getSize(width, height);
+
+    int amountOfPageValues = width * height * _pRawDataHandler->rawDataPixelSize() / (int)sizeof(float);
+    const gtUByte* pPageRawData = _pRawDataHandler->activePageRawData();
+
+    for (int i = 0; i < qMin(amountOfPageValues, AC_CSV_EXPORT_CHECKED_FLOAT_VALUES); i++)
+    {
+        float pageValue = 0.0f;
+        memcpy(&pageValue, pPageRawData + i * sizeof(float), sizeof(float));
+        checkedValues.append(pageValue);
+    }
+
+    for (int i = 0; retVal && (i < checkedValues.size()); i++)
+    {
+        gtASCIIString valueText;
+        gtString parameterText;
+        pParameter->readValueFromPointer((void*)&checkedValues[i]);
+        pParameter->valueAsString(parameterText);
+
+        // The values appendFloatCSVValue does not handle are formatted through the parameter anyway:
+        if (appendFloatCSVValue(checkedValues[i], valueText))
+        {
+            retVal = (strcmp(valueText.asCharArray(), parameterText.asASCIICharArray()) == 0);
+        }
+    }
+
     return retVal;
 }
 
+// ---------------------------------------------------------------------------
+// Name:        acRawDataExporter::formatNonBufferCSVRows
+// Description: Formats a band of rows of a non buffer CSV page into text. The
+//              values are read straight from the raw data, unless they are
+//              formatted through the parameter (see selectCSVCellFormat)
+// Arguments:   firstRow, endRow - The rows range [firstRow, endRow), each
+//              raw data line has a row per component
+//              width - The raw data width
+//              isChannelWritten - Flags, per component, if its rows are written
+//              channelNames - The components names
+//              pParameter - The parameter the values are read into, or NULL
+//              to read the values through the raw data handler, which checks
+//              the filters (on the main thread only)
+//              csvText - The text the rows are appended to
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawDataExporter::formatNonBufferCSVRows(int firstRow, int endRow, int width, const QVector<bool>& isChannelWritten, const QVector<gtASCIIString>& channelNames,
+                                               apPixelValueParameter* pParameter, gtASCIIString& csvText)
+{
+    int amountOfComponents = isChannelWritten.size();
+    const gtUByte* pPageRawData = _pRawDataHandler->activePageRawData();
+    int pixelSize = _pRawDataHandler->rawDataPixelSize();
+    int dataTypeSize = _pRawDataHandler->dataTypeSize();
+
+    // The filtered pages are read through the raw data handler:
+    CSVCellFormatType cellFormatType = (pParameter != NULL) ? _csvCellFormatType : AC_CSV_CELL_PARAMETER;
+
+    for (int y = firstRow; y < endRow; y++)
+    {
+        // Start a new line
+        csvText.append("\n");
+
+        // Write row label which is component name and y position in raw data
+        int yPosition = y / amountOfComponents;
+        int channelIndex = y % amountOfComponents;
+
+        if (isChannelWritten[channelIndex])
+        {
+            // Write channel name and y position as row label
+            csvText.appendFormattedString("%s [%d]: ,", channelNames[channelIndex].asCharArray(), yPosition);
+
+            // The first value of the row component:
+            const gtUByte* pValue = (pPageRawData != NULL) ? (pPageRawData + ((gtSizeType)yPosition * width * pixelSize) + (channelIndex * dataTypeSize)) : NULL;
+
+            for (int x = 0; x < width; x++, pValue += pixelSize)
+            {
+                bool isFormatted = false;
+
+                if (cellFormatType == AC_CSV_CELL_TABLE)
+                {
+                    int valueIndex = *pValue;
+
+                    if (dataTypeSize == 2)
+                    {
+                        quint16 shortValue = 0;
+                        memcpy(&shortValue, pValue, sizeof(shortValue));
+                        valueIndex = shortValue;
+                    }
+
+                    csvText.append(_csvValueTexts[valueIndex].constData());
+                    csvText.append(",");
+                    isFormatted = true;
+                }
+                else if (cellFormatType == AC_CSV_CELL_FLOAT)
+                {
+                    float floatValue = 0.0f;
+                    memcpy(&floatValue, pValue, sizeof(floatValue));
+
+                    // The infinities, NaNs and huge values are formatted through the parameter:
+                    isFormatted = appendFloatCSVValue(floatValue, csvText);
+
+                    if (isFormatted)
+                    {
+                        csvText.append(",");
+                    }
+                }
+
+                if (!isFormatted)
+                {
+                    // Get cell value
+                    apPixelValueParameter* pCellParameter = pParameter;
+                    bool isValueAvailable = true;
+                    bool rc2 = false;
+
+                    if (pParameter != NULL)
+                    {
+                        rc2 = _pRawDataHandler->readRawDataComponentValue(x, yPosition, channelIndex, pParameter);
+                    }
+                    else
+                    {
+                        pCellParameter = NULL;
+                        rc2 = _pRawDataHandler->getRawDataComponentValue(x, yPosition, channelIndex, pCellParameter, isValueAvailable);
+                    }
+
+                    if (rc2 && !isValueAvailable)
+                    {
+                        // Write an empty cell for a filtered value, so that the next cells stay in their columns:
+                        csvText.append(",");
+                    }
+                    else if (rc2 && (pCellParameter != NULL))
+                    {
+                        // Get cell value as string
+                        gtString cellValue;
+                        pCellParameter->valueAsString(cellValue);
+
+                        // Write cell value
+                        csvText.append(cellValue.asASCIICharArray());
+                        csvText.append(",");
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawDataExporter::flushCSVText
+// Description: Writes the CSV text to the file once it reaches the chunk size,
+//              and empties it
+// Arguments:   csvFile - Csv file to write the text into
+//              csvText - The text to write
+//              forceFlush - Write the text whatever its size is
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawDataExporter::flushCSVText(osFile& csvFile, gtString& csvText, bool forceFlush)
+{
+    if ((csvText.length() >= AC_CSV_EXPORT_CHUNK_LENGTH) || (forceFlush && !csvText.isEmpty()))
+    {
+        csvFile << csvText;
+        csvText.makeEmpty();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawDataExporter::flushCSVText
+// Description: Writes the CSV text to the file once it reaches the chunk size,
+//              and empties it
+// Arguments:   csvFile - Csv file to write the text into
+//              csvText - The text to write
+//              forceFlush - Write the text whatever its size is
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawDataExporter::flushCSVText(osFile& csvFile, gtASCIIString& csvText, bool forceFlush)
+{
+    if ((csvText.length() >= AC_CSV_EXPORT_CHUNK_LENGTH) || (forceFlush && !csvText.isEmpty()))
+    {
+        csvFile << csvText;
+        csvText.makeEmpty();
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Name:        acRawDataExporter::writeBufferCSVPageContent
 // Description: Writes a buffer CSV page
@@ -605,29 +1052,24 @@ bool acRawDataExporter::writeBufferCSVPageContent(osFile& csvFile)
         float amountOfRowsAsFloat = (float)width / (float)oneRowSize;
         int amountOfRows = (int)(ceill(amountOfRowsAsFloat));
 
-        // Generate the CSV file columns:
-        gtString csvColumns;
+        // Generate the CSV file columns (the CSV text is written to the file in chunks):
+        gtString csvText;
         // Add an empty cell at top left corner
-        csvColumns.append(L",");
+        csvText.append(L",");
 
         // First generate the first line - table columns:
         for (int i = 0; i < amountOfCells; i++)
         {
-            csvColumns.appendFormattedString(L"[%d],", i);
+            csvText.appendFormattedString(L"[%d],", i);
         }
 
-        // Write columns to file
-        csvFile << csvColumns;
-
-        // Start pouring the data:
+        // Start pouring the data (on this thread, the buffer values are read through the static parameters):
         for (int y = 0; y < amountOfRows; y++)
         {
             // Start a new line
-            csvFile << "\n";
+            csvText.append(L"\n");
 
-            gtString csvRowLabel;
-            csvRowLabel.appendFormattedString(L"[%d]: ,", y);
-            csvFile << csvRowLabel;
+            csvText.appendFormattedString(L"[%d]: ,", y);
 
             for (int x = 0; x < amountOfCells; x++)
             {
@@ -651,16 +1093,18 @@ bool acRawDataExporter::writeBufferCSVPageContent(osFile& csvFile)
                             pParameter->valueAsString(cellValue);
 
                             // Write cell value
-                            gtString csvCellValue;
-                            csvCellValue.appendFormattedString(L"%ls,", cellValue.asCharArray());
-
-                            // Write csv cell value to file
-                            csvFile << csvCellValue;
+                            csvText.append(cellValue);
+                            csvText.append(L",");
                         }
                     }
                 }
             }
+
+            flushCSVText(csvFile, csvText, false);
         }
+
+        // Write the rest of the text to file
+        flushCSVText(csvFile, csvText, true);
     }
 
     return retVal;
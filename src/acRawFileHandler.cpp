@@ -10,11 +10,21 @@
 
 // Qt
 #include <AMDTApplicationComponents/Include/acQtIncludes.h>
+#include <QBitArray>
+#include <QFile>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 // Standard C:
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
+#if AMDT_BUILD_TARGET == AMDT_LINUX_OS
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
 
 // Infra:
 #include <AMDTBaseTools/Include/gtAssert.h>
@@ -29,6 +39,7 @@
 // Local:
 #include <AMDTApplicationComponents/Include/acMessageBox.h>
 #include <AMDTApplicationComponents/Include/acColours.h>
+#include <AMDTApplicationComponents/Include/acFunctions.h>
 #include <AMDTApplicationComponents/Include/acRawFileHandler.h>
 #include <inc/acStringConstants.h>
 
@@ -55,6 +66,141 @@ apCLulongParameter* acRawFileHandler::_pStaticCLULongParamter = new apCLulongPar
 #define QT_BITMAP_GREEN_CHANNEL_INDEX 1
 #define QT_BITMAP_BLUE_CHANNEL_INDEX 0
 
+// The swizzle texel kernel uses SSE2 when the compiler targets it (always on x64):
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define AC_RAW_FILE_HANDLER_USE_SSE2 1
+#else
+    #define AC_RAW_FILE_HANDLER_USE_SSE2 0
+#endif
+
+// Pages of fewer pixels are processed on the calling thread:
+#define AC_RAW_DATA_MIN_PIXELS_PER_ROW_BAND 65536
+
+// The amount of row bands processed by each thread of the pool:
+#define AC_RAW_DATA_ROW_BANDS_PER_THREAD 4
+
+// A mapped raw data file starts with a header of 32 bit fields (width, height, texel format, data type and
+// amount of pages), followed by the pages, as oaRawFileSeralizer writes it. Files whose header does not
+// describe exactly the data that follows it are not mapped (see verifyMappedFileHeader):
+#define AC_RAW_DATA_FILE_HEADER_FIELDS 5
+
+// The default memory budget of the converted pages cache, in bytes:
+#define AC_RAW_DATA_PAGE_CACHE_DEFAULT_BUDGET (256 * 1024 * 1024)
+
+// The amount of pages converted ahead of the active page, in the scrub direction:
+#define AC_RAW_DATA_PREFETCHED_PAGES 2
+
+// Converts a band of rows of the active page into the QImage lines
+class acRawFileHandler::ConversionJob : public QRunnable
+{
+public:
+    ConversionJob(acRawFileHandler* pHandler, const TexelKernel& kernel, int firstRow, int endRow, gtSizeType pageRawDataOffset, uchar* pImageBits, int imageLineSize)
+        : _pHandler(pHandler), _kernel(kernel), _firstRow(firstRow), _endRow(endRow), _pageRawDataOffset(pageRawDataOffset), _pImageBits(pImageBits), _imageLineSize(imageLineSize)
+    {
+    }
+
+    virtual void run()
+    {
+        // The generic and typed kernels read the components through a parameter of their own, since the parameters hold the value they read:
+        apPixelValueParameter* pParameter = NULL;
+
+        if ((_kernel._type == AC_TEXEL_KERNEL_GENERIC) || (_kernel._type == AC_TEXEL_KERNEL_TYPED))
+        {
+            pParameter = _pHandler->createPixelValueDataParameter();
+        }
+
+        GT_IF_WITH_ASSERT((pParameter != NULL) || ((_kernel._type != AC_TEXEL_KERNEL_GENERIC) && (_kernel._type != AC_TEXEL_KERNEL_TYPED)))
+        {
+            _pHandler->convertTexelRows(_kernel, _firstRow, _endRow, _pageRawDataOffset, pParameter, _pImageBits, _imageLineSize);
+        }
+
+        delete pParameter;
+    }
+
+private:
+    acRawFileHandler* _pHandler;
+    const TexelKernel& _kernel;
+    int _firstRow;
+    int _endRow;
+    gtSizeType _pageRawDataOffset;
+    uchar* _pImageBits;
+    int _imageLineSize;
+};
+
+// Finds the lowest and highest values in a band of rows of the active page
+class acRawFileHandler::MinMaxJob : public QRunnable
+{
+public:
+    MinMaxJob(acRawFileHandler* pHandler, int firstRow, int endRow, bool shouldNegativeValuesBeNormalized, double& minValue, double& maxValue)
+        : _pHandler(pHandler), _firstRow(firstRow), _endRow(endRow), _shouldNegativeValuesBeNormalized(shouldNegativeValuesBeNormalized), _minValue(minValue), _maxValue(maxValue)
+    {
+    }
+
+    virtual void run()
+    {
+        apPixelValueParameter* pParameter = _pHandler->createPixelValueDataParameter();
+        GT_IF_WITH_ASSERT(pParameter != NULL)
+        {
+            _pHandler->findRowsMinMaxValues(_firstRow, _endRow, pParameter, _shouldNegativeValuesBeNormalized, _minValue, _maxValue);
+        }
+
+        delete pParameter;
+    }
+
+private:
+    acRawFileHandler* _pHandler;
+    int _firstRow;
+    int _endRow;
+    bool _shouldNegativeValuesBeNormalized;
+    double& _minValue;
+    double& _maxValue;
+};
+
+// Converts a page next to the active page, and adds it to the converted pages cache
+class acRawFileHandler::PrefetchJob : public QRunnable
+{
+public:
+    PrefetchJob(acRawFileHandler* pHandler, const TexelKernel& kernel, const PageImageKey& key, int generation)
+        : _pHandler(pHandler), _kernel(kernel), _key(key), _generation(generation)
+    {
+    }
+
+    virtual void run()
+    {
+        // Skip the pages which are not needed anymore, or were cached since the job was queued:
+        if ((_pHandler->_prefetchGeneration.loadAcquire() == _generation) && !_pHandler->findCachedPageImage(_key, NULL))
+        {
+            QImage image(_pHandler->_width, _pHandler->_height, QImage::Format_ARGB32);
+
+            GT_IF_WITH_ASSERT(!image.isNull())
+            {
+                apPixelValueParameter* pParameter = NULL;
+
+                if ((_kernel._type == AC_TEXEL_KERNEL_GENERIC) || (_kernel._type == AC_TEXEL_KERNEL_TYPED))
+                {
+                    pParameter = _pHandler->createPixelValueDataParameter();
+                }
+
+                GT_IF_WITH_ASSERT((pParameter != NULL) || ((_kernel._type != AC_TEXEL_KERNEL_GENERIC) && (_kernel._type != AC_TEXEL_KERNEL_TYPED)))
+                {
+                    gtSizeType pageRawDataOffset = (gtSizeType)_pHandler->_rawDataPixelSize * _pHandler->_width * _pHandler->_height * _key._page;
+                    _pHandler->convertTexelRows(_kernel, 0, _pHandler->_height, pageRawDataOffset, pParameter, image.bits(), image.bytesPerLine());
+                    _pHandler->cachePageImage(_key, image);
+                }
+
+                delete pParameter;
+            }
+        }
+    }
+
+private:
+    acRawFileHandler* _pHandler;
+    TexelKernel _kernel;
+    PageImageKey _key;
+    int _generation;
+};
+
 // ---------------------------------------------------------------------------
 // Name:        acRawFileHandler::acRawFileHandler
 // Description: Constructor - loads the raw data file
@@ -67,15 +213,19 @@ acRawFileHandler::acRawFileHandler(bool yFlipImage)
     : _isLoadedSuccesfully(false), _width(0), _height(0), m_yFlipImage(yFlipImage),
       _componentDataType(OA_UNSIGNED_BYTE), _texelDataFormat(OA_TEXEL_FORMAT_UNKNOWN),
       _rawDataPixelSize(0), _dataTypeSize(0), _amountOfPixelComponents(0),
-      _amountOfComponentsInDataType(0), _pRawData(NULL), _rawDataSize(0), _amountOfPages(-1),
+      _amountOfComponentsInDataType(0), _pRawData(NULL), _rawDataSize(0), _pMappedFile(NULL), _amountOfPages(-1),
       m_pageStride(1), m_pageOffset(0), _activePage(0), _activePageRawDataOffset(0), _offset(0),
-      _stride(0), _valuesNormazlied(false), _pPixelValueDataParameter(NULL), _minValueParameter(0),
-      _maxValueParameter(0), _valueMultiplier(-1)
+      _stride(0), _valuesNormazlied(false), _pPixelValueDataParameter(NULL), _pageCacheSize(0),
+      _pageCacheBudget(AC_RAW_DATA_PAGE_CACHE_DEFAULT_BUDGET), _scrubDirection(1), _isPagePrefetchEnabled(true),
+      _minValueParameter(0), _maxValueParameter(0), _valueMultiplier(-1)
 {
     for (int i = 0; i < AC_MAX_RAW_FILE_FILTER_HANDLERS; i++)
     {
         _pFilterRawFileHandler[i] = NULL;
     }
+
+    // The pages are prefetched one at a time, nearest first:
+    _prefetchThreadPool.setMaxThreadCount(1);
 }
 
 // ---------------------------------------------------------------------------
@@ -89,16 +239,19 @@ acRawFileHandler::acRawFileHandler(gtUByte* pRawData, gtSizeType rawDataSize, in
     : _isLoadedSuccesfully(false), _width(width), _height(height), m_yFlipImage(true),
       _componentDataType(dataType), _texelDataFormat(dataFormat),
       _rawDataPixelSize(0), _dataTypeSize(0), _amountOfPixelComponents(0),
-      _amountOfComponentsInDataType(0), _pRawData(pRawData), _rawDataSize(rawDataSize), _amountOfPages(amountOfPages),
+      _amountOfComponentsInDataType(0), _pRawData(pRawData), _rawDataSize(rawDataSize), _pMappedFile(NULL), _amountOfPages(amountOfPages),
       m_pageStride(1), m_pageOffset(0), _activePage(0), _activePageRawDataOffset(0), _valuesNormazlied(false),
-      _pPixelValueDataParameter(NULL), _minValueParameter(0), _maxValueParameter(0),
-      _valueMultiplier(-1)
+      _pPixelValueDataParameter(NULL), _pageCacheSize(0), _pageCacheBudget(AC_RAW_DATA_PAGE_CACHE_DEFAULT_BUDGET),
+      _scrubDirection(1), _isPagePrefetchEnabled(true), _minValueParameter(0), _maxValueParameter(0), _valueMultiplier(-1)
 {
     for (int i = 0; i < AC_MAX_RAW_FILE_FILTER_HANDLERS; i++)
     {
         _pFilterRawFileHandler[i] = NULL;
     }
 
+    // The pages are prefetched one at a time, nearest first:
+    _prefetchThreadPool.setMaxThreadCount(1);
+
     // Sanity check:
     GT_IF_WITH_ASSERT(pRawData != NULL)
     {
@@ -126,11 +279,7 @@ acRawFileHandler::acRawFileHandler(gtUByte* pRawData, gtSizeType rawDataSize, in
 acRawFileHandler::~acRawFileHandler()
 {
     // Release raw data memory
-    if (_pRawData)
-    {
-        free(_pRawData);
-        _pRawData = NULL;
-    }
+    releaseRawData();
 
     // Clear the GL parameter object:
     clearDataParameter();
@@ -210,51 +359,260 @@ void acRawFileHandler::initHandler()
 // Name:        acRawFileHandler::loadFromFile
 // Description: Loads raw data from file into the raw file handler
 // Arguments:   rawDataFile - The raw data file to load
+//              mapFile - true to read the raw data in place from a mapping
+//              of the file, false to read the whole file into memory.
+//              Files which cannot be mapped are read into memory.
 // Return Val:  bool - Success / Failure
 // Author:      Eran Zinman
 // Date:        16/1/2008
 // ---------------------------------------------------------------------------
-bool acRawFileHandler::loadFromFile(const osFilePath& rawDataFile)
+bool acRawFileHandler::loadFromFile(const osFilePath& rawDataFile, bool mapFile)
 {
     bool retVal = false;
 
+    // Release the previously loaded raw data
+    releaseRawData();
+
     // Load the raw data from file
     if (rawDataFile.isRegularFile())
     {
-        // Load Raw data file
-        oaRawFileSeralizer rawFileSeralizer;
-        bool rc = rawFileSeralizer.loadFromFile(rawDataFile);
-        GT_IF_WITH_ASSERT(rc)
+        bool isDataLoaded = false;
+
+        if (mapFile)
         {
-            // Set pointer to the new memory. *Take ownership* over releasing the memory from oaRawFileSeralizer
-            _rawDataSize = rawFileSeralizer.getRawDataSize();
-            _pRawData = (gtUByte*)rawFileSeralizer.getRawDataPointer(true /* Take Ownership */);
-            GT_IF_WITH_ASSERT(_pRawData != NULL)
-            {
-                // Get raw data dimensions
-                rawFileSeralizer.getRawDataDimensions(_width, _height);
+            isDataLoaded = mapRawDataFile(rawDataFile);
+        }
 
-                // Get raw data data type
-                rawFileSeralizer.getRawDataFormat(_texelDataFormat, _componentDataType);
+        if (!isDataLoaded)
+        {
+            // Load Raw data file
+            oaRawFileSeralizer rawFileSeralizer;
+            bool rc = rawFileSeralizer.loadFromFile(rawDataFile);
+            GT_IF_WITH_ASSERT(rc)
+            {
+                // Set pointer to the new memory. *Take ownership* over releasing the memory from oaRawFileSeralizer
+                _rawDataSize = rawFileSeralizer.getRawDataSize();
+                _pRawData = (gtUByte*)rawFileSeralizer.getRawDataPointer(true /* Take Ownership */);
+                GT_IF_WITH_ASSERT(_pRawData != NULL)
+                {
+                    // Get raw data dimensions
+                    rawFileSeralizer.getRawDataDimensions(_width, _height);
 
-                // Get amount of pages in raw data
-                _amountOfPages = rawFileSeralizer.getAmountOfPages();
+                    // Get raw data data type
+                    rawFileSeralizer.getRawDataFormat(_texelDataFormat, _componentDataType);
 
-                // Initializes the raw file hander
-                initHandler();
+                    // Get amount of pages in raw data
+                    _amountOfPages = rawFileSeralizer.getAmountOfPages();
 
-                // If data was loaded successfully
-                if (_isLoadedSuccesfully)
-                {
-                    retVal = true;
+                    isDataLoaded = true;
                 }
             }
         }
+
+        if (isDataLoaded)
+        {
+            // Initializes the raw file hander
+            initHandler();
+
+            // If data was loaded successfully
+            if (_isLoadedSuccesfully)
+            {
+                // Read the active page ahead (when the file is mapped):
+                adviseMappedData(_activePageRawDataOffset, (gtSizeType)_rawDataPixelSize * _width * _height, AC_MAPPED_DATA_WILL_NEED);
+
+                retVal = true;
+            }
+        }
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::mapRawDataFile
+// Description: Maps a raw data file read-only, and reads the raw data
+//              dimensions, format and amount of pages from its header.
+//              The raw data points into the mapping, so only the pages
+//              which are accessed are read from the file.
+// Arguments:   rawDataFile - The raw data file to map
+// Return Val:  bool - Success / Failure (the file could not be mapped, or its
+//              header does not describe exactly the raw data that follows it,
+//              see verifyMappedFileHeader)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::mapRawDataFile(const osFilePath& rawDataFile)
+{
+    bool retVal = false;
+
+    QFile* pFile = new QFile(acGTStringToQString(rawDataFile.asString()));
+
+    qint64 headerSize = AC_RAW_DATA_FILE_HEADER_FIELDS * sizeof(qint32);
+    qint32 header[AC_RAW_DATA_FILE_HEADER_FIELDS];
+
+    // Only the header is read, to check that the file can be mapped:
+    if (pFile->open(QIODevice::ReadOnly) && (pFile->size() > headerSize) && (pFile->read((char*)header, headerSize) == headerSize))
+    {
+        quint64 dataSize = (quint64)(pFile->size() - headerSize);
+
+        if (verifyMappedFileHeader(header, dataSize))
+        {
+            // The whole file is mapped, but the OS only reads the pages which are accessed:
+            uchar* pMappedData = pFile->map(0, pFile->size());
+
+            if (pMappedData != NULL)
+            {
+                _pMappedFile = pFile;
+                _pRawData = (gtUByte*)(pMappedData + headerSize);
+                _rawDataSize = (gtSizeType)dataSize;
+                _width = header[0];
+                _height = header[1];
+                _texelDataFormat = (oaTexelDataFormat)header[2];
+                _componentDataType = (oaDataType)header[3];
+                _amountOfPages = header[4];
+
+                retVal = true;
+            }
+        }
+    }
+
+    if (!retVal)
+    {
+        // Closing the file releases the mapping:
+        delete pFile;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::verifyMappedFileHeader
+// Description: Checks that a raw data file header describes exactly the raw
+//              data that follows it: positive dimensions and amount of pages,
+//              a known texel format and data type, and a raw data size which
+//              matches them. Only the header fields are checked, the raw data
+//              is not read. Files which fail the check are loaded through the
+//              raw file serializer.
+// Arguments:   header - The header fields (width, height, texel format, data
+//              type and amount of pages)
+//              dataSize - The size of the file following the header
+// Return Val:  bool - true iff the file can be mapped
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::verifyMappedFileHeader(const qint32* header, quint64 dataSize)
+{
+    bool retVal = false;
+
+    int width = header[0];
+    int height = header[1];
+    oaTexelDataFormat texelDataFormat = (oaTexelDataFormat)header[2];
+    oaDataType componentDataType = (oaDataType)header[3];
+    int amountOfPages = header[4];
+
+    if ((width > 0) && (height > 0) && (amountOfPages > 0) && (texelDataFormat != OA_TEXEL_FORMAT_UNKNOWN) && (oaSizeOfDataType(componentDataType) > 0))
+    {
+        int pixelSize = oaCalculatePixelUnitByteSize(texelDataFormat, componentDataType);
+        quint64 rowSize = (quint64)pixelSize * width;
+
+        // Compare by division, the product of the dimensions could overflow for a corrupted header:
+        retVal = (pixelSize > 0) && ((dataSize % rowSize) == 0) && (((dataSize / rowSize) % height) == 0) && ((dataSize / rowSize / height) == (quint64)amountOfPages);
     }
 
     return retVal;
 }
 
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::releaseRawData
+// Description: Releases the raw data - frees the raw data memory, or unmaps
+//              the raw data file.
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::releaseRawData()
+{
+    // The prefetch jobs read the raw data:
+    cancelPrefetch();
+    clearPageCaches();
+
+    if (_pMappedFile != NULL)
+    {
+        // The raw data points into the file mapping, which is released with the file:
+        delete _pMappedFile;
+        _pMappedFile = NULL;
+    }
+    else if (_pRawData != NULL)
+    {
+        free(_pRawData);
+    }
+
+    _pRawData = NULL;
+    _rawDataSize = 0;
+    _isLoadedSuccesfully = false;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::adviseMappedData
+// Description: Tells the OS how a range of the raw data is about to be
+//              accessed, so that it can read it ahead or reclaim its memory.
+//              Does nothing when the raw data is held in memory.
+// Arguments:   offset - The offset of the range in the raw data
+//              size - The size of the range
+//              advice - The expected access
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::adviseMappedData(gtSizeType offset, gtSizeType size, MappedDataAdvice advice)
+{
+#if AMDT_BUILD_TARGET == AMDT_LINUX_OS
+
+    if ((_pMappedFile != NULL) && (size > 0) && (offset < _rawDataSize))
+    {
+        if (size > _rawDataSize - offset)
+        {
+            size = _rawDataSize - offset;
+        }
+
+        // The hints apply to whole memory pages:
+        static const quintptr memoryPageSize = (quintptr)sysconf(_SC_PAGESIZE);
+        quintptr rangeStart = (quintptr)(_pRawData + offset);
+        quintptr rangeEnd = rangeStart + size;
+        rangeStart -= rangeStart % memoryPageSize;
+
+        int linuxAdvice = MADV_NORMAL;
+
+        switch (advice)
+        {
+            case AC_MAPPED_DATA_WILL_NEED:
+                linuxAdvice = MADV_WILLNEED;
+                break;
+
+            case AC_MAPPED_DATA_SEQUENTIAL:
+                linuxAdvice = MADV_SEQUENTIAL;
+                break;
+
+            case AC_MAPPED_DATA_DONT_NEED:
+                // The mapping is read-only, so the memory pages are read again from the file if accessed:
+                linuxAdvice = MADV_DONTNEED;
+                break;
+
+            default:
+                GT_ASSERT(false);
+                break;
+        }
+
+        int rc = madvise((void*)rangeStart, (size_t)(rangeEnd - rangeStart), linuxAdvice);
+        GT_ASSERT(rc == 0);
+    }
+
+#else
+    // The mapping reads the pages on access, there are no hints to pass:
+    GT_UNREFERENCED_PARAMETER(offset);
+    GT_UNREFERENCED_PARAMETER(size);
+    GT_UNREFERENCED_PARAMETER(advice);
+#endif
+}
+
 // ---------------------------------------------------------------------------
 // Name:        acRawFileHandler::createPixelValueDataParameter
 // Description: Generates an OpenGL parameter which will be used to retrieve
@@ -380,63 +738,93 @@ QImage* acRawFileHandler::convertToQImage()
     // If raw data file was loaded successfully
     if (_isLoadedSuccesfully)
     {
-        // Allocate a memory buffer that will hold the pixels in raw format:
+        // The QImage pixels are 32 bits:
         int bytesPerPixel = 4;
 
         // make sure 1G limit is not reached:
         if (_width * _height * bytesPerPixel < AC_CONVERT_IMAGE_LIMIT)
         {
-            uchar* pImageBuffer = new uchar[_width * _height * bytesPerPixel];
-
-
             // Add the offset to get current page:
             gtUByte* pSrcRawData = (gtUByte*)(_pRawData + _activePageRawDataOffset);
 
-            int qimagePixelSize = 4 * sizeof(uchar);
             GT_IF_WITH_ASSERT(pSrcRawData != NULL)
             {
-                // Calculate the line and pixel sizes:
-                int qimageLineSize = qimagePixelSize * _width;
+                // Use the image cached when the page was displayed or prefetched:
+                bool canCache = canCachePageImages();
+                PageImageKey key;
+                getPageImageKey(_activePage, key);
+                QImage cachedImage;
 
-                // Fill the free image bitmap with the raw data converted image:
-                for (int y = 0; y < _height; y++)
+                if (canCache && findCachedPageImage(key, &cachedImage))
+                {
+                    // The images share the pixels until one of them is modified:
+                    pRetVal = new QImage(cachedImage);
+                }
+                else
                 {
-                    // Get the current line index:
-                    int lineIndex = m_yFlipImage ? _height - (y + 1) : y;
+                    // The page is converted from start to end (each row band is):
+                    adviseMappedData(_activePageRawDataOffset, (gtSizeType)_rawDataPixelSize * _width * _height, AC_MAPPED_DATA_SEQUENTIAL);
 
-                    for (int x = 0; x < _width; x++)
+                    // Allocate the required bitmap, the rows are converted directly into it:
+                    pRetVal = new QImage(_width, _height, QImage::Format_ARGB32);
+
+                    GT_IF_WITH_ASSERT(!pRetVal->isNull())
                     {
-                        // Before calculating the pixel value, check if the pixel should be filtered:
-                        bool shouldPixelBeDisplayed = true;
-                        bool rcCheckFilter = checkPixelFilter(y, x, shouldPixelBeDisplayed);
-                        GT_ASSERT(rcCheckFilter);
+                        // Select the conversion kernel once for the whole image:
+                        TexelKernel kernel;
+                        selectTexelKernel(kernel);
+
+                        // Check which pixels should be filtered before converting them (the filter handlers are not thread safe):
+                        QBitArray displayedPixels;
+                        kernel._pDisplayedPixels = calculatePixelFilterMask(displayedPixels) ? &displayedPixels : NULL;
+
+                        // Get the filtered pixel color:
+                        GLubyte notInScopePixelValue[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL] = {0, 0, 0, 0xff};
+                        notInScopePixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.red();
+                        notInScopePixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.green();
+                        notInScopePixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.blue();
+                        memcpy(&kernel._notInScopePixel, notInScopePixelValue, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+
+                        // Get the image lines (before the rows are converted on other threads):
+                        uchar* pImageBits = pRetVal->bits();
+                        int imageLineSize = pRetVal->bytesPerLine();
 
-                        int currentPixelOffset = lineIndex * qimageLineSize + x * qimagePixelSize;
-                        uchar* pPixelAddress = pImageBuffer + currentPixelOffset;
+                        int amountOfRowBands = calculateRowBandsCount();
 
-                        // If values are normalized, fill normalized values, else fill with default multiplier
-                        if (_valuesNormazlied)
+                        if (amountOfRowBands == 1)
                         {
-                            // Fill normalized pixel value according to the raw data type
-                            calculateNormalizedPixelValue(pSrcRawData, pPixelAddress, shouldPixelBeDisplayed);
+                            convertTexelRows(kernel, 0, _height, _activePageRawDataOffset, _pPixelValueDataParameter, pImageBits, imageLineSize);
                         }
                         else
                         {
-                            // Fill pixel value according to the raw data type:
-                            calculateQImagePixelValue(pSrcRawData, pPixelAddress, shouldPixelBeDisplayed);
+                            // Convert the row bands in parallel:
+                            QThreadPool threadPool;
+
+                            for (int i = 0; i < amountOfRowBands; i++)
+                            {
+                                int firstRow = (int)((qint64)_height * i / amountOfRowBands);
+                                int endRow = (int)((qint64)_height * (i + 1) / amountOfRowBands);
+                                threadPool.start(new ConversionJob(this, kernel, firstRow, endRow, _activePageRawDataOffset, pImageBits, imageLineSize));
+                            }
+
+                            threadPool.waitForDone();
                         }
+                    }
+                    else
+                    {
+                        delete pRetVal;
+                        pRetVal = NULL;
+                    }
 
-                        // Advance to the next source pixel position:
-                        pSrcRawData += _rawDataPixelSize;
+                    if (canCache && (pRetVal != NULL))
+                    {
+                        cachePageImage(key, *pRetVal);
                     }
                 }
 
-                // Make sure width and height are in valid range before trying to create the qimage or it might crash the application:
-                if (_width * _height * bytesPerPixel < AC_CONVERT_IMAGE_LIMIT)
+                if (canCache)
                 {
-                    // Allocate the required bitmap:
-                    pRetVal = new QImage(pImageBuffer, _width, _height, _width * 4, QImage::Format_ARGB32);
-
+                    prefetchNeighborPages();
                 }
             }
         }
@@ -473,50 +861,80 @@ bool acRawFileHandler::findMinMaxValuesFromRawData(bool shouldNegativeValuesBeNo
         // Sanity check
         GT_IF_WITH_ASSERT(_pPixelValueDataParameter != NULL)
         {
-            // Get pointer to the raw data (with the active page offset):
-            gtUByte* pRawDataSrc = (gtUByte*)(_pRawData + _activePageRawDataOffset);
-            GT_IF_WITH_ASSERT(pRawDataSrc != NULL)
-            {
-                // Get initial lowest and highest values from the first pixel in array
-                _pPixelValueDataParameter->readValueFromPointer(pRawDataSrc);
+            // Use the values found when the page was normalized before:
+            QHash<int, PageMinMaxValues>::const_iterator iter = _pageMinMaxValues.find(_activePage);
+            bool isCached = (iter != _pageMinMaxValues.end()) && (iter->_texelDataFormat == _texelDataFormat) && (iter->_componentDataType == _componentDataType) &&
+                            (iter->_shouldNegativeValuesBeNormalized == shouldNegativeValuesBeNormalized);
 
-                _minValueParameter = _pPixelValueDataParameter->valueAsDouble();
-                _maxValueParameter = _minValueParameter;
+            if (isCached)
+            {
+                _minValueParameter = iter->_minValue;
+                _maxValueParameter = iter->_maxValue;
 
-                // Fill the free image bitmap with the converted raw data image:
-                for (int y = 0; y < _height; y++)
+                retVal = true;
+            }
+            else
+            {
+                // Get pointer to the raw data (with the active page offset):
+                gtUByte* pRawDataSrc = (gtUByte*)(_pRawData + _activePageRawDataOffset);
+                GT_IF_WITH_ASSERT(pRawDataSrc != NULL)
                 {
-                    for (int x = 0; x < _width; x++)
+                    // The page is scanned from start to end (each row band is):
+                    adviseMappedData(_activePageRawDataOffset, (gtSizeType)_rawDataPixelSize * _width * _height, AC_MAPPED_DATA_SEQUENTIAL);
+
+                    // Get initial lowest and highest values from the first pixel in array
+                    _pPixelValueDataParameter->readValueFromPointer(pRawDataSrc);
+
+                    _minValueParameter = _pPixelValueDataParameter->valueAsDouble();
+                    _maxValueParameter = _minValueParameter;
+
+                    int amountOfRowBands = calculateRowBandsCount();
+
+                    if (amountOfRowBands == 1)
+                    {
+                        findRowsMinMaxValues(0, _height, _pPixelValueDataParameter, shouldNegativeValuesBeNormalized, _minValueParameter, _maxValueParameter);
+                    }
+                    else
                     {
-                        // Get the current pixel value
-                        _pPixelValueDataParameter->readValueFromPointer(pRawDataSrc);
+                        // Scan the row bands in parallel, each starting from the first pixel value:
+                        QVector<double> bandMinValues(amountOfRowBands, _minValueParameter);
+                        QVector<double> bandMaxValues(amountOfRowBands, _maxValueParameter);
+                        QThreadPool threadPool;
+
+                        for (int i = 0; i < amountOfRowBands; i++)
+                        {
+                            int firstRow = (int)((qint64)_height * i / amountOfRowBands);
+                            int endRow = (int)((qint64)_height * (i + 1) / amountOfRowBands);
+                            threadPool.start(new MinMaxJob(this, firstRow, endRow, shouldNegativeValuesBeNormalized, bandMinValues[i], bandMaxValues[i]));
+                        }
 
-                        // Get value as double
-                        double curValue = _pPixelValueDataParameter->valueAsDouble();
+                        threadPool.waitForDone();
 
-                        // Check if we found a new maximum or minimum
-                        if (curValue < _minValueParameter)
+                        // Reduce the bands values, the same way the values of a band are (so NaN values are ignored):
+                        for (int i = 0; i < amountOfRowBands; i++)
                         {
-                            if (!shouldNegativeValuesBeNormalized)
+                            if (bandMinValues[i] < _minValueParameter)
                             {
-                                _minValueParameter = curValue;
+                                _minValueParameter = bandMinValues[i];
                             }
-                            else if (curValue >= 0)
+
+                            if (bandMaxValues[i] > _maxValueParameter)
                             {
-                                _minValueParameter = curValue;
+                                _maxValueParameter = bandMaxValues[i];
                             }
                         }
-                        else if (curValue > _maxValueParameter)
-                        {
-                            _maxValueParameter = curValue;
-                        }
-
-                        // Advance to the next source pixel:
-                        pRawDataSrc += _rawDataPixelSize;
                     }
-                }
 
-                retVal = true;
+                    retVal = true;
+
+                    // Keep the values, for when the page is normalized again:
+                    PageMinMaxValues& pageMinMaxValues = _pageMinMaxValues[_activePage];
+                    pageMinMaxValues._texelDataFormat = _texelDataFormat;
+                    pageMinMaxValues._componentDataType = _componentDataType;
+                    pageMinMaxValues._shouldNegativeValuesBeNormalized = shouldNegativeValuesBeNormalized;
+                    pageMinMaxValues._minValue = _minValueParameter;
+                    pageMinMaxValues._maxValue = _maxValueParameter;
+                }
             }
         }
     }
@@ -525,71 +943,424 @@ bool acRawFileHandler::findMinMaxValuesFromRawData(bool shouldNegativeValuesBeNo
 }
 
 // ---------------------------------------------------------------------------
-// Name:        acRawFileHandler::getValueMultiplier
-// Description: Return the value multiplier (if values are normalized)
-// Arguments:   valueMultiplier - Output value multiplier
-// Return Val:  bool - Success / Failure
+// Name:        acRawFileHandler::findRowsMinMaxValues
+// Description: Finds the lowest and highest values in a band of rows of the
+//              active page
+// Arguments:   firstRow, endRow - The rows range [firstRow, endRow)
+//              pParameter - The parameter used for reading the values
+//              shouldNegativeValuesBeNormalized - tells how to handle negative value
+//              minValue, maxValue - Input initial values, output lowest and
+//              highest values
 // Author:      Eran Zinman
-// Date:        7/1/2008
+// Date:        13/8/2007
 // ---------------------------------------------------------------------------
-bool acRawFileHandler::getValueMultiplier(double& valueMultiplier)
+void acRawFileHandler::findRowsMinMaxValues(int firstRow, int endRow, apPixelValueParameter* pParameter, bool shouldNegativeValuesBeNormalized, double& minValue, double& maxValue)
 {
-    bool retVal = false;
+    gtUByte* pRawDataSrc = (gtUByte*)(_pRawData + _activePageRawDataOffset) + (gtSizeType)firstRow * _width * _rawDataPixelSize;
 
-    if (_valuesNormazlied)
+    for (int y = firstRow; y < endRow; y++)
     {
-        // Return the value multiplier
-        valueMultiplier = _valueMultiplier;
+        for (int x = 0; x < _width; x++)
+        {
+            // Get the current pixel value
+            pParameter->readValueFromPointer(pRawDataSrc);
 
-        retVal = true;
-    }
+            // Get value as double
+            double curValue = pParameter->valueAsDouble();
 
-    return retVal;
+            // Check if we found a new maximum or minimum
+            if (curValue < minValue)
+            {
+                if (!shouldNegativeValuesBeNormalized)
+                {
+                    minValue = curValue;
+                }
+                else if (curValue >= 0)
+                {
+                    minValue = curValue;
+                }
+            }
+            else if (curValue > maxValue)
+            {
+                maxValue = curValue;
+            }
+
+            // Advance to the next source pixel:
+            pRawDataSrc += _rawDataPixelSize;
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
-// Name:        acRawFileHandler::calculateValueMultiplier
-// Description: Calculates the value multiplier according to the minimum and
-//              maximum values of the raw data
-// Arguments:   minValue, maxValue - Raw data minimum and maximum values
-// Author:      Eran Zinman
-// Date:        30/12/2007
+// Name:        acRawFileHandler::calculateRowBandsCount
+// Description: Calculates the amount of row bands the active page is split
+//              into, when it is processed in parallel
+// Return Val:  int - The amount of row bands (1 if the page is too small to be
+//              worth splitting)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
 // ---------------------------------------------------------------------------
-void acRawFileHandler::calculateValueMultiplier(double minValue, double maxValue)
+int acRawFileHandler::calculateRowBandsCount() const
 {
-    // Calculate the amount of possible values between minimum and maximum values
-    double amountOfValues = maxValue - minValue;
+    // A few bands per thread, so that the threads finish together:
+    qint64 maxAmountOfBands = qMax(QThread::idealThreadCount(), 1) * AC_RAW_DATA_ROW_BANDS_PER_THREAD;
+    qint64 amountOfBands = ((qint64)_width * _height) / AC_RAW_DATA_MIN_PIXELS_PER_ROW_BAND;
 
-    // These are the amount of values we need to normalize our values to
-    double mapToValue = (double)255.0f;
+    int retVal = (int)qBound((qint64)1, amountOfBands, qMin(maxAmountOfBands, (qint64)qMax(_height, 1)));
 
-    // When data type is not float (regular numbers) we add one extra to the amount of possible values.
-    // For example: If minValue is 5 and maxValue is 9 we got 9 - 5 + 1 = 5 Possible values
-    if ((OA_FLOAT != _componentDataType) && (OA_DOUBLE != _componentDataType))
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::setPageCacheBudget
+// Description: Sets the memory budget of the converted pages cache
+// Arguments:   pageCacheBudget - The budget, in bytes (0 disables the cache
+//              and the pages prefetching)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::setPageCacheBudget(gtSizeType pageCacheBudget)
+{
+    if (pageCacheBudget == 0)
     {
-        amountOfValues++;
-        mapToValue = (double)256.0f;
+        cancelPrefetch();
     }
 
-    // Recalculate the value multiplier according to the new min and max values
-    _valueMultiplier = mapToValue / amountOfValues;
-
-    // Flag that the raw data is normalized
-    _valuesNormazlied = true;
+    QMutexLocker locker(&_pageCacheMutex);
+    _pageCacheBudget = pageCacheBudget;
+    trimPageImagesCache(_pageCacheBudget);
 }
 
 // ---------------------------------------------------------------------------
-// Name:        acRawFileHandler::setMinMaxValues
-// Description: Manually sets the minimum and maximum values for the raw data
-//              (for example - using the double slider component)
-// Arguments:   minValue, maxValue - Raw data minimum and maximum values
-// Return Val:  bool - Success / Failure
-// Author:      Eran Zinman
-// Date:        16/11/2007
+// Name:        acRawFileHandler::setPagePrefetchEnabled
+// Description: Enables / disables the prefetching of the pages next to the
+//              active page. Should be disabled while all the pages are
+//              converted one after the other (the prefetched pages would be
+//              converted twice).
+// Arguments:   isEnabled - Should the pages be prefetched
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
 // ---------------------------------------------------------------------------
-bool acRawFileHandler::setMinMaxValues(double minValue, double maxValue)
+void acRawFileHandler::setPagePrefetchEnabled(bool isEnabled)
 {
-    bool retVal = false;
+    if (!isEnabled)
+    {
+        dropPrefetch();
+    }
+
+    _isPagePrefetchEnabled = isEnabled;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::canCachePageImages
+// Description: Checks if the converted pages can be cached and prefetched.
+//              Only images of multiple pages textures are cached, and not
+//              when filters are applied, since the state of the filter
+//              handlers is not part of the cached images key (and the filter
+//              handlers cannot be used by the prefetch jobs).
+// Return Val:  bool - true if the pages can be cached
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::canCachePageImages() const
+{
+    bool retVal = (_pageCacheBudget > 0) && (_amountOfPages > 1) && !oaIsBufferTexelFormat(_texelDataFormat) && !hasFilterRawFileHandlers();
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::getPageImageKey
+// Description: Gets the key of a page image converted in the current state
+// Arguments:   page - The (real) page index
+//              key - Output key
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::getPageImageKey(int page, PageImageKey& key) const
+{
+    key._page = page;
+    key._texelDataFormat = _texelDataFormat;
+    key._componentDataType = _componentDataType;
+    key._valuesNormalized = _valuesNormazlied;
+    key._minValue = _minValueParameter;
+    key._maxValue = _maxValueParameter;
+    key._valueMultiplier = _valueMultiplier;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::findCachedPageImage
+// Description: Looks up a page image in the converted pages cache. Images
+//              converted in another state (format, normalization values) are
+//              ignored.
+// Arguments:   key - The page image key
+//              pImage - Output image, or NULL to only check if the image is
+//              cached (without marking it as recently used)
+// Return Val:  bool - true if the image is cached
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::findCachedPageImage(const PageImageKey& key, QImage* pImage)
+{
+    bool retVal = false;
+
+    QMutexLocker locker(&_pageCacheMutex);
+
+    QHash<int, PageImage>::const_iterator iter = _pageImages.find(key._page);
+
+    if (iter != _pageImages.end())
+    {
+        const PageImageKey& cachedKey = iter->_key;
+        retVal = (cachedKey._texelDataFormat == key._texelDataFormat) && (cachedKey._componentDataType == key._componentDataType) &&
+                 (cachedKey._valuesNormalized == key._valuesNormalized) && (cachedKey._minValue == key._minValue) &&
+                 (cachedKey._maxValue == key._maxValue) && (cachedKey._valueMultiplier == key._valueMultiplier);
+
+        if (retVal && (pImage != NULL))
+        {
+            *pImage = iter->_image;
+
+            // Mark the page as the most recently used:
+            if (_pageImagesOrder.last() != key._page)
+            {
+                _pageImagesOrder.removeOne(key._page);
+                _pageImagesOrder.append(key._page);
+            }
+        }
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::cachePageImage
+// Description: Adds a page image to the converted pages cache (replacing the
+//              image of the page converted in another state), and removes the
+//              least recently used images which do not fit the budget
+// Arguments:   key - The page image key
+//              image - The page image (its pixels are shared, not copied)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::cachePageImage(const PageImageKey& key, const QImage& image)
+{
+    QMutexLocker locker(&_pageCacheMutex);
+
+    gtSizeType imageSize = (gtSizeType)image.bytesPerLine() * image.height();
+
+    if (imageSize <= _pageCacheBudget)
+    {
+        QHash<int, PageImage>::iterator iter = _pageImages.find(key._page);
+
+        if (iter != _pageImages.end())
+        {
+            _pageCacheSize -= (gtSizeType)iter->_image.bytesPerLine() * iter->_image.height();
+            _pageImagesOrder.removeOne(key._page);
+        }
+
+        // Make room for the new image:
+        trimPageImagesCache(_pageCacheBudget - imageSize);
+
+        PageImage& pageImage = _pageImages[key._page];
+        pageImage._key = key;
+        pageImage._image = image;
+
+        _pageImagesOrder.append(key._page);
+        _pageCacheSize += imageSize;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::trimPageImagesCache
+// Description: Removes the least recently used page images until the cache
+//              fits a size. The cache mutex must be locked by the caller.
+// Arguments:   pageCacheBudget - The size the cache should fit, in bytes
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::trimPageImagesCache(gtSizeType pageCacheBudget)
+{
+    while ((_pageCacheSize > pageCacheBudget) && !_pageImagesOrder.isEmpty())
+    {
+        QHash<int, PageImage>::iterator iter = _pageImages.find(_pageImagesOrder.takeFirst());
+        GT_IF_WITH_ASSERT(iter != _pageImages.end())
+        {
+            _pageCacheSize -= (gtSizeType)iter->_image.bytesPerLine() * iter->_image.height();
+            _pageImages.erase(iter);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::prefetchNeighborPages
+// Description: Queues the conversion of the pages following the active page
+//              in the direction the pages are switched in, replacing the
+//              queued conversions of the previously active page.
+//              Normalized pages are not prefetched: each page is normalized
+//              to its own lowest and highest values, which are only known
+//              once the page is active (see findMinMaxValuesFromRawData). So
+//              the prefetch jobs never read the normalization values, and
+//              changing them does not wait for the jobs.
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::prefetchNeighborPages()
+{
+    // The jobs queued for the previously active page are not needed anymore:
+    _prefetchThreadPool.clear();
+
+    if (!_isPagePrefetchEnabled || _valuesNormazlied)
+    {
+        return;
+    }
+
+    TexelKernel kernel;
+    bool isKernelSelected = false;
+
+    for (int i = 1; i <= AC_RAW_DATA_PREFETCHED_PAGES; i++)
+    {
+        int externalPage = activePage() + (i * _scrubDirection);
+
+        if ((externalPage < 0) || (externalPage >= amountOfExternalPages()))
+        {
+            break;
+        }
+
+        PageImageKey key;
+        getPageImageKey((externalPage * m_pageStride) + m_pageOffset, key);
+
+        if (!findCachedPageImage(key, NULL))
+        {
+            // The kernel is selected on this thread, since its lookup tables are built through the pixel value parameter:
+            if (!isKernelSelected)
+            {
+                selectTexelKernel(kernel);
+                isKernelSelected = true;
+            }
+
+            _prefetchThreadPool.start(new PrefetchJob(this, kernel, key, _prefetchGeneration.loadAcquire()));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::dropPrefetch
+// Description: Drops the queued prefetch jobs, without waiting for the
+//              running one. Used when the prefetched images are not needed
+//              anymore, but the state the jobs read is not changed.
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::dropPrefetch()
+{
+    _prefetchGeneration.fetchAndAddOrdered(1);
+    _prefetchThreadPool.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::cancelPrefetch
+// Description: Drops the queued prefetch jobs and waits for the running one.
+//              Must be called before changing the state the prefetch jobs
+//              read (the raw data, its format and size).
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::cancelPrefetch()
+{
+    dropPrefetch();
+    _prefetchThreadPool.waitForDone();
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::clearPageCaches
+// Description: Clears the converted pages and the pages lowest and highest
+//              values caches
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::clearPageCaches()
+{
+    QMutexLocker locker(&_pageCacheMutex);
+    _pageImages.clear();
+    _pageImagesOrder.clear();
+    _pageCacheSize = 0;
+
+    _pageMinMaxValues.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::getValueMultiplier
+// Description: Return the value multiplier (if values are normalized)
+// Arguments:   valueMultiplier - Output value multiplier
+// Return Val:  bool - Success / Failure
+// Author:      Eran Zinman
+// Date:        7/1/2008
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::getValueMultiplier(double& valueMultiplier)
+{
+    bool retVal = false;
+
+    if (_valuesNormazlied)
+    {
+        // Return the value multiplier
+        valueMultiplier = _valueMultiplier;
+
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::calculateValueMultiplier
+// Description: Calculates the value multiplier according to the minimum and
+//              maximum values of the raw data
+// Arguments:   minValue, maxValue - Raw data minimum and maximum values
+// Author:      Eran Zinman
+// Date:        30/12/2007
+// ---------------------------------------------------------------------------
+void acRawFileHandler::calculateValueMultiplier(double minValue, double maxValue)
+{
+    // Calculate the amount of possible values between minimum and maximum values
+    double amountOfValues = maxValue - minValue;
+
+    // These are the amount of values we need to normalize our values to
+    double mapToValue = (double)255.0f;
+
+    // When data type is not float (regular numbers) we add one extra to the amount of possible values.
+    // For example: If minValue is 5 and maxValue is 9 we got 9 - 5 + 1 = 5 Possible values
+    if ((OA_FLOAT != _componentDataType) && (OA_DOUBLE != _componentDataType))
+    {
+        amountOfValues++;
+        mapToValue = (double)256.0f;
+    }
+
+    // Recalculate the value multiplier according to the new min and max values
+    double valueMultiplier = mapToValue / amountOfValues;
+
+    // The normalized pages are not prefetched (the prefetch jobs do not read the value multiplier):
+    if (!_valuesNormazlied)
+    {
+        dropPrefetch();
+    }
+
+    _valueMultiplier = valueMultiplier;
+
+    // Flag that the raw data is normalized
+    _valuesNormazlied = true;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::setMinMaxValues
+// Description: Manually sets the minimum and maximum values for the raw data
+//              (for example - using the double slider component)
+// Arguments:   minValue, maxValue - Raw data minimum and maximum values
+// Return Val:  bool - Success / Failure
+// Author:      Eran Zinman
+// Date:        16/11/2007
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::setMinMaxValues(double minValue, double maxValue)
+{
+    bool retVal = false;
 
     // Do we have reasonable values?
     GT_IF_WITH_ASSERT(maxValue >= minValue)
@@ -739,7 +1510,7 @@ bool acRawFileHandler::getRawDataComponentValue(int x, int y, int componentIndex
                     if (rc2)
                     {
                         // Go to raw data pixel position
-                        unsigned long pageOffset = _activePageRawDataOffset + (y * _width + x) * _rawDataPixelSize;
+                        gtSizeType pageOffset = _activePageRawDataOffset + ((gtSizeType)y * _width + x) * _rawDataPixelSize;
                         gtUByte* pDataOffset = (gtUByte*)(_pRawData + pageOffset);
 
                         // Get raw data component value
@@ -762,6 +1533,44 @@ bool acRawFileHandler::getRawDataComponentValue(int x, int y, int componentIndex
     return retVal;
 }
 
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::readRawDataComponentValue
+// Description: Reads a raw data component value of the currently active page
+//              into a parameter owned by the caller. Unlike
+//              getRawDataComponentValue, the filters are not checked and the
+//              handler is not modified, so the values can be read on several
+//              threads, each with its own parameter.
+// Arguments:   x,y - (x, y) position in the raw data
+//              componentIndex - Index of the desired component (0..amount-1)
+//              pParameter - The parameter the value is read into
+// Return Val:  bool  - Success / failure.
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::readRawDataComponentValue(int x, int y, int componentIndex, apPixelValueParameter* pParameter)
+{
+    bool retVal = false;
+
+    // Buffers are read through the static parameters, see getBufferRawDataComponentValue:
+    if (_isLoadedSuccesfully && (pParameter != NULL) && !oaIsBufferTexelFormat(_texelDataFormat))
+    {
+        // Components and (x, y) position range check:
+        bool rc1 = ((componentIndex >= 0) && (componentIndex < _amountOfPixelComponents));
+        bool rc2 = ((x >= 0) && (y >= 0) && (x < _width) && (y < _height));
+
+        if (rc1 && rc2)
+        {
+            // Go to raw data pixel position
+            gtSizeType pageOffset = _activePageRawDataOffset + ((gtSizeType)y * _width + x) * _rawDataPixelSize;
+            gtUByte* pDataOffset = (gtUByte*)(_pRawData + pageOffset);
+
+            retVal = readPixelChannelValue(pParameter, pDataOffset, componentIndex);
+        }
+    }
+
+    return retVal;
+}
+
 // ---------------------------------------------------------------------------
 // Name:        acRawFileHandler::getRawDataValue
 // Description: Retrieves a value from the raw data
@@ -942,163 +1751,642 @@ bool acRawFileHandler::getNormalizedPixelValue(apPixelValueParameter* pParameter
 }
 
 // ---------------------------------------------------------------------------
-// Name:        acRawFileHandler::calculateNormalizedPixelValue
-// Description: Fill normalized pixel value according to the raw data type
-// Arguments:   pSrcRawData - The raw data pixel offset
-//              pPixelData - The QImage destination pixel offset
+// Name:        acRawFileHandler::calculateNormalizedColor
+// Description: Fill the R, G, B values of a normalized pixel, according to
+//              the value position in the minimum and maximum values range
+// Arguments:   currentVal - The component value
+//              pPixelValue - The output pixel value (QImage byte order)
 // Author:      Eran Zinman
 // Date:        29/12/2007
 // ---------------------------------------------------------------------------
-void acRawFileHandler::calculateNormalizedPixelValue(gtUByte* pSrcRawData, uchar* pPixelData, bool shouldPixelBeDisplayed)
+void acRawFileHandler::calculateNormalizedColor(double currentVal, GLubyte* pPixelValue)
 {
-    // Pixel value that will be written into the image
-    GLubyte pixelValue[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL] = {0, 0, 0, 0xff};
+    calculateNormalizedColor(currentVal, _minValueParameter, _maxValueParameter, pPixelValue);
+}
 
-    if (!shouldPixelBeDisplayed)
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::calculateNormalizedColor
+// Description: Fill the R, G, B values of a normalized pixel, according to
+//              the value position in a minimum and maximum values range
+// Arguments:   currentVal - The component value
+//              minValue, maxValue - The normalization range
+//              pPixelValue - The output pixel value (QImage byte order)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::calculateNormalizedColor(double currentVal, double minValue, double maxValue, GLubyte* pPixelValue)
+{
+    // If we are above range show red
+    if (currentVal > maxValue)
     {
-        // Fill the pixel value with non available color:
-        pixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.red();
-        pixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.green();
-        pixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.blue();
+        // If we are above range, fill red channel
+        pPixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.red();
+        pPixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.green();
+        pPixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.blue();
+    }
+    else if (currentVal < minValue)
+    {
+        // If we are below range, fill green channel
+        pPixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.red();
+        pPixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.green();
+        pPixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.blue();
     }
     else
     {
-        // Get first component value:
-        apPixelValueParameter* pParameter = NULL;
-        bool rc = getPixelChannelValue(pSrcRawData, 0, pParameter);
-        GT_IF_WITH_ASSERT(rc)
+        // Reduce the min value from current value:
+        currentVal -= minValue;
+
+        if ((maxValue - minValue) > 0)
         {
-            // Get current, minimum and maximum values as double
-            double currentVal = pParameter->valueAsDouble();
+            currentVal /= maxValue - minValue;
+        }
+
+        // For these types - Fill the result into the R, G, B values:
+        pPixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.red();
+        pPixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.green();
+        pPixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.blue();
+    }
+}
 
-            // If we are above range show red
-            if (currentVal > _maxValueParameter)
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::selectTexelKernel
+// Description: Selects the kernel converting the texels of the current data
+//              type and format into QImage pixels. The component formats are
+//              resolved once here, instead of once per pixel:
+//              - Each component writes a set of pixel bytes, in order, on top
+//                of the default pixel (black, opaque).
+//              - 8 and 16 bits data types are converted through lookup tables,
+//                filled by reading every possible value through the pixel value
+//                parameter, so the pixels are the same as when each texel is
+//                read through it.
+//              - 4 x 8 bits texels which are not altered by the conversion are
+//                only reordered into the pixel bytes.
+//              - float, double and 32 bits integer components are read with
+//                typed loads. The normalized component is converted directly
+//                from its value, the other components are converted through
+//                the pixel value parameter (which owns their conversion to
+//                pixel values).
+// Arguments:   kernel - Output kernel
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::selectTexelKernel(TexelKernel& kernel)
+{
+    kernel._type = AC_TEXEL_KERNEL_GENERIC;
+    kernel._components.clear();
+    kernel._pDisplayedPixels = NULL;
+    kernel._notInScopePixel = 0;
+    kernel._minValue = _minValueParameter;
+    kernel._maxValue = _maxValueParameter;
+
+    GLubyte defaultPixelValue[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL] = {0, 0, 0, 0xff};
+    memcpy(&kernel._defaultPixel, defaultPixelValue, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+
+    // List the written components and the pixel bytes they write:
+    for (int i = 0; i < _amountOfPixelComponents; i++)
+    {
+        GLubyte pixelSpread[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL] = {0, 0, 0, 0};
+        bool isNormalizedValue = false;
+
+        if (_valuesNormazlied)
+        {
+            if (i == 0)
             {
-                // If we are above range, fill red channel
-                pixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.red();
-                pixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.green();
-                pixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = acQRAW_FILE_ABOVE_RANGE_COLOR.blue();
+                // The first component is converted to the normalized colors, into the R, G, B values:
+                memset(pixelSpread, 1, 3 * sizeof(GLubyte));
+                isNormalizedValue = true;
             }
-            else if (currentVal < _minValueParameter)
+            else if ((i == 1) && ((_texelDataFormat == OA_TEXEL_FORMAT_LUMINANCEALPHA) || (_texelDataFormat == OA_TEXEL_FORMAT_LUMINANCEALPHA_COMPRESSED)))
             {
-                // If we are below range, fill green channel
-                pixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.red();
-                pixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.green();
-                pixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = acQRAW_FILE_BELOW_RANGE_COLOR.blue();
+                // We got a special format which can be normalized (LUMINANCE_ALPHA)
+                pixelSpread[QT_BITMAP_ALPHA_CHANNEL_INDEX] = 1;
             }
-            else
+        }
+        else
+        {
+            // Fill the appropriate channel(s) with the pixel value
+            oaTexelDataFormat componentFormat = oaGetTexelFormatComponentType(_texelDataFormat, i);
+
+            switch (componentFormat)
             {
-                // Reduce the min value from current value:
-                currentVal -= _minValueParameter;
+                case OA_TEXEL_FORMAT_STENCIL:
+                case OA_TEXEL_FORMAT_DEPTH:
+                case OA_TEXEL_FORMAT_LUMINANCE:
+                case OA_TEXEL_FORMAT_COLORINDEX:
+                case OA_TEXEL_FORMAT_VARIABLE_VALUE:
+                {
+                    // For these types - Fill the result into the R, G, B values:
+                    memset(pixelSpread, 1, 3 * sizeof(GLubyte));
+                }
+                break;
 
-                if ((_maxValueParameter - _minValueParameter) > 0)
+                case OA_TEXEL_FORMAT_RED:
+                    pixelSpread[QT_BITMAP_RED_CHANNEL_INDEX] = 1;
+                    break;
+
+                case OA_TEXEL_FORMAT_GREEN:
+                    pixelSpread[QT_BITMAP_GREEN_CHANNEL_INDEX] = 1;
+                    break;
+
+                case OA_TEXEL_FORMAT_BLUE:
+                    pixelSpread[QT_BITMAP_BLUE_CHANNEL_INDEX] = 1;
+                    break;
+
+                case OA_TEXEL_FORMAT_ALPHA:
+                    pixelSpread[QT_BITMAP_ALPHA_CHANNEL_INDEX] = 1;
+                    break;
+
+                default:
+                    GT_ASSERT(false);
+                    break;
+            }
+        }
+
+        TexelComponent component;
+        component._componentIndex = i;
+        component._srcOffset = (_amountOfComponentsInDataType == 1) ? i * _dataTypeSize : 0;
+        component._isNormalizedValue = isNormalizedValue;
+        memcpy(&component._pixelSpread, pixelSpread, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+        component._pixelMask = component._pixelSpread * 0xff;
+
+        if (component._pixelMask != 0)
+        {
+            kernel._components.push_back(component);
+        }
+    }
+
+    // Tabulate the components if there are fewer possible values than pixels:
+    bool canUseLookupTables = (_dataTypeSize == 1) || ((_dataTypeSize == 2) && ((qint64)_width * _height >= (1 << 16)));
+
+    if (canUseLookupTables)
+    {
+        kernel._type = AC_TEXEL_KERNEL_LOOKUP;
+
+        for (QVector<TexelComponent>::iterator iter = kernel._components.begin(); iter != kernel._components.end(); ++iter)
+        {
+            if (!buildTexelLookupTable(*iter))
+            {
+                kernel._type = AC_TEXEL_KERNEL_GENERIC;
+                break;
+            }
+        }
+    }
+
+    // Read the float, double and 32 bits integer components with typed loads:
+    bool isTypedDataType = (_componentDataType == OA_FLOAT) || (_componentDataType == OA_DOUBLE) || (_componentDataType == OA_INT) || (_componentDataType == OA_UNSIGNED_INT);
+
+    if ((kernel._type == AC_TEXEL_KERNEL_GENERIC) && isTypedDataType && (_amountOfComponentsInDataType == 1))
+    {
+        kernel._type = AC_TEXEL_KERNEL_TYPED;
+    }
+
+    // Check if the texel bytes can be copied into the pixel bytes as they are:
+    if ((kernel._type == AC_TEXEL_KERNEL_LOOKUP) && (_dataTypeSize == 1) && (_amountOfComponentsInDataType == 1) && (kernel._components.count() == 4) && (_rawDataPixelSize == 4))
+    {
+        quint32 writtenBits = 0;
+        bool isSwizzle = true;
+
+        for (int i = 0; (i < 4) && isSwizzle; i++)
+        {
+            const TexelComponent& component = kernel._components[i];
+
+            // Each component should write a single pixel byte, not written by another component:
+            GLubyte pixelSpread[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL];
+            memcpy(pixelSpread, &component._pixelSpread, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+            int dstByte = -1;
+            int writtenBytes = 0;
+
+            for (int j = 0; j < AC_OUTPUT_IMAGE_BYTES_PER_PIXEL; j++)
+            {
+                if (pixelSpread[j] != 0)
                 {
-                    currentVal /= _maxValueParameter - _minValueParameter;
+                    dstByte = j;
+                    writtenBytes++;
                 }
+            }
 
-                // For these types - Fill the result into the R, G, B values:
-                pixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.red();
-                pixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.green();
-                pixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = currentVal * acQRAW_FILE_TOP_RANGE_COLOR.blue();
+            isSwizzle = (writtenBytes == 1) && ((writtenBits & component._pixelMask) == 0);
+            writtenBits |= component._pixelMask;
+
+            // The channel value should be the texel byte:
+            for (int value = 0; (value < 256) && isSwizzle; value++)
+            {
+                isSwizzle = (component._lookupTable[value] == value * component._pixelSpread);
             }
+
+            kernel._swizzleSrcByte[i] = component._srcOffset;
+            kernel._swizzleDstByte[i] = dstByte;
         }
 
-        // We got a special format which can be normalized (LUMINANCE_ALPHA)
-        if ((_texelDataFormat == OA_TEXEL_FORMAT_LUMINANCEALPHA) || (_texelDataFormat == OA_TEXEL_FORMAT_LUMINANCEALPHA_COMPRESSED))
+        if (isSwizzle)
         {
-            // Get alpha channel value
-            rc = getPixelChannelValue(pSrcRawData, 1, pParameter);
-            GT_IF_WITH_ASSERT(rc)
+            kernel._type = AC_TEXEL_KERNEL_SWIZZLE;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::buildTexelLookupTable
+// Description: Builds the lookup table of a texel component, by reading every
+//              possible value of the component data type through the pixel
+//              value parameter.
+// Arguments:   component - The component whose lookup table is built
+// Return Val:  bool - Success / Failure
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::buildTexelLookupTable(TexelComponent& component)
+{
+    bool retVal = false;
+
+    GT_IF_WITH_ASSERT((_pPixelValueDataParameter != NULL) && ((_dataTypeSize == 1) || (_dataTypeSize == 2)))
+    {
+        retVal = true;
+
+        // A texel holding the tabulated value:
+        QVector<gtUByte> texel(_rawDataPixelSize, 0);
+        int amountOfValues = 1 << (8 * _dataTypeSize);
+        component._lookupTable.resize(amountOfValues);
+
+        for (int value = 0; (value < amountOfValues) && retVal; value++)
+        {
+            if (_dataTypeSize == 1)
             {
-                // Convert channel value to pixel value
-                GLubyte channelValue = pParameter->asPixelValue();
+                texel[component._srcOffset] = (gtUByte)value;
+            }
+            else
+            {
+                quint16 shortValue = (quint16)value;
+                memcpy(texel.data() + component._srcOffset, &shortValue, sizeof(shortValue));
+            }
+
+            retVal = readPixelChannelValue(_pPixelValueDataParameter, texel.data(), component._componentIndex);
 
-                // Set alpha channel value
-                pixelValue[QT_BITMAP_ALPHA_CHANNEL_INDEX] = channelValue;
+            if (retVal)
+            {
+                component._lookupTable[value] = calculateTexelComponentBits(component, _pPixelValueDataParameter);
             }
         }
+
+        if (!retVal)
+        {
+            component._lookupTable.clear();
+        }
     }
 
-    // Write RGBA values:
-    memcpy(pPixelData, &pixelValue, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+    return retVal;
 }
 
 // ---------------------------------------------------------------------------
-// Name:        acRawFileHandler::calculateQImagePixelValue
-// Description: Calculate the raw data type and then fills pixel value
-//              according to the raw data type
-// Arguments:   pSrcRawData - The raw data pixel offset
-//              pPixelData - The QImage destination pixel offset
-// Author:      Eran Zinman
-// Date:        9/12/2007
+// Name:        acRawFileHandler::calculateTexelComponentBits
+// Description: Calculates the pixel bits written by a texel component
+// Arguments:   component - The texel component
+//              pParameter - The parameter holding the component value
+// Return Val:  quint32 - The pixel bits (only the component pixel mask bits are set)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
 // ---------------------------------------------------------------------------
-void acRawFileHandler::calculateQImagePixelValue(gtUByte* pSrcRawData, uchar* pPixelData, bool shouldPixelBeDisplayed)
+quint32 acRawFileHandler::calculateTexelComponentBits(const TexelComponent& component, apPixelValueParameter* pParameter)
 {
-    // Pixel value that will be written into the image
-    GLubyte pixelValue[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL] = {0, 0, 0, 0xff};
+    quint32 retVal = 0;
 
-    if (!shouldPixelBeDisplayed)
+    if (component._isNormalizedValue)
     {
-        // Fill the pixel value with non available color:
-        pixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.red();
-        pixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.green();
-        pixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = acQRAW_FILE_NOT_IN_SCOPE_COLOR.blue();
+        GLubyte pixelValue[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL] = {0, 0, 0, 0};
+        calculateNormalizedColor(pParameter->valueAsDouble(), pixelValue);
+        memcpy(&retVal, pixelValue, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+        retVal &= component._pixelMask;
     }
     else
     {
-        // Loop through the channels
-        for (int i = 0; i < _amountOfPixelComponents; i++)
+        // Convert channel value to pixel value
+        GLubyte channelValue = pParameter->asPixelValue();
+        retVal = channelValue * component._pixelSpread;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::convertTexelRows
+// Description: Converts a band of rows of a page into QImage lines, and
+//              fills the filtered pixels with the not in scope color
+// Arguments:   kernel - The conversion kernel (see selectTexelKernel)
+//              firstRow, endRow - The rows range [firstRow, endRow)
+//              pageRawDataOffset - The offset of the page in the raw data
+//              pParameter - The parameter used by the generic and typed kernels
+//              pImageBits - The QImage pixels
+//              imageLineSize - The size of a QImage line, in bytes
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::convertTexelRows(const TexelKernel& kernel, int firstRow, int endRow, gtSizeType pageRawDataOffset, apPixelValueParameter* pParameter, uchar* pImageBits, int imageLineSize)
+{
+    gtSizeType srcLineSize = (gtSizeType)_rawDataPixelSize * _width;
+    gtUByte* pSrcRawData = (gtUByte*)(_pRawData + pageRawDataOffset);
+
+    for (int y = firstRow; y < endRow; y++)
+    {
+        // Get the current line index:
+        int lineIndex = m_yFlipImage ? _height - (y + 1) : y;
+        quint32* pDstLine = (quint32*)(pImageBits + (gtSizeType)lineIndex * imageLineSize);
+
+        convertTexelRow(kernel, pSrcRawData + y * srcLineSize, pDstLine, _width, pParameter);
+
+        if (kernel._pDisplayedPixels != NULL)
         {
-            // Get component value
-            apPixelValueParameter* pParameter = NULL;
-            bool rc = getPixelChannelValue(pSrcRawData, i, pParameter);
-            GT_IF_WITH_ASSERT(rc)
+            int firstPixelIndex = y * _width;
+
+            for (int x = 0; x < _width; x++)
             {
-                // Convert channel value to pixel value
-                GLubyte channelValue = pParameter->asPixelValue();
+                if (!kernel._pDisplayedPixels->testBit(firstPixelIndex + x))
+                {
+                    pDstLine[x] = kernel._notInScopePixel;
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::convertTexelRow
+// Description: Converts a row of texels into QImage pixels
+// Arguments:   kernel - The conversion kernel (see selectTexelKernel)
+//              pSrcRow - The first texel of the row
+//              pDstRow - The first pixel of the row
+//              width - The amount of texels in the row
+//              pParameter - The parameter used by the generic and typed kernels
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+void acRawFileHandler::convertTexelRow(const TexelKernel& kernel, gtUByte* pSrcRow, quint32* pDstRow, int width, apPixelValueParameter* pParameter)
+{
+    int componentsCount = kernel._components.count();
+    const TexelComponent* pComponents = kernel._components.constData();
+
+    switch (kernel._type)
+    {
+        case AC_TEXEL_KERNEL_SWIZZLE:
+        {
+            int x = 0;
+
+#if AC_RAW_FILE_HANDLER_USE_SSE2
+            // Convert 4 texels at a time - each pixel byte is shifted out of its texel byte:
+            __m128i defaultBits = _mm_set1_epi32((int)(kernel._defaultPixel & ~(pComponents[0]._pixelMask | pComponents[1]._pixelMask | pComponents[2]._pixelMask | pComponents[3]._pixelMask)));
+            __m128i byteMask = _mm_set1_epi32(0xff);
+            __m128i srcShift[4];
+            __m128i dstShift[4];
+
+            for (int i = 0; i < 4; i++)
+            {
+                srcShift[i] = _mm_cvtsi32_si128(8 * kernel._swizzleSrcByte[i]);
+                dstShift[i] = _mm_cvtsi32_si128(8 * kernel._swizzleDstByte[i]);
+            }
+
+            for (; x + 4 <= width; x += 4)
+            {
+                __m128i texels = _mm_loadu_si128((const __m128i*)(pSrcRow + x * 4));
+                __m128i pixels = defaultBits;
+
+                for (int i = 0; i < 4; i++)
+                {
+                    __m128i channel = _mm_and_si128(_mm_srl_epi32(texels, srcShift[i]), byteMask);
+                    pixels = _mm_or_si128(pixels, _mm_sll_epi32(channel, dstShift[i]));
+                }
+
+                _mm_storeu_si128((__m128i*)(pDstRow + x), pixels);
+            }
+
+#endif
 
-                // Fill the appropriate channel(s) with the pixel value
-                oaTexelDataFormat componentFormat = oaGetTexelFormatComponentType(_texelDataFormat, i);
+            for (; x < width; x++)
+            {
+                GLubyte pixelValue[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL];
+                memcpy(pixelValue, &kernel._defaultPixel, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
 
-                switch (componentFormat)
+                for (int i = 0; i < 4; i++)
                 {
-                    case OA_TEXEL_FORMAT_STENCIL:
-                    case OA_TEXEL_FORMAT_DEPTH:
-                    case OA_TEXEL_FORMAT_LUMINANCE:
-                    case OA_TEXEL_FORMAT_COLORINDEX:
-                    case OA_TEXEL_FORMAT_VARIABLE_VALUE:
+                    pixelValue[kernel._swizzleDstByte[i]] = pSrcRow[x * 4 + kernel._swizzleSrcByte[i]];
+                }
+
+                memcpy(pDstRow + x, pixelValue, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+            }
+        }
+        break;
+
+        case AC_TEXEL_KERNEL_LOOKUP:
+        {
+            gtUByte* pSrcTexel = pSrcRow;
+
+            for (int x = 0; x < width; x++)
+            {
+                quint32 pixel = kernel._defaultPixel;
+
+                for (int i = 0; i < componentsCount; i++)
+                {
+                    const TexelComponent& component = pComponents[i];
+                    int value = 0;
+
+                    if (_dataTypeSize == 1)
                     {
-                        // For these types - Fill the result into the R, G, B values:
-                        memset(pixelValue, channelValue, 3 * sizeof(GLubyte));
+                        value = pSrcTexel[component._srcOffset];
                     }
-                    break;
+                    else
+                    {
+                        quint16 shortValue = 0;
+                        memcpy(&shortValue, pSrcTexel + component._srcOffset, sizeof(shortValue));
+                        value = shortValue;
+                    }
+
+                    pixel = (pixel & ~component._pixelMask) | component._lookupTable[value];
+                }
+
+                pDstRow[x] = pixel;
+
+                // Advance to the next source pixel position:
+                pSrcTexel += _rawDataPixelSize;
+            }
+        }
+        break;
 
-                    case OA_TEXEL_FORMAT_RED:
-                        pixelValue[QT_BITMAP_RED_CHANNEL_INDEX] = channelValue;
-                        break;
+        case AC_TEXEL_KERNEL_TYPED:
+        {
+            gtUByte* pSrcTexel = pSrcRow;
 
-                    case OA_TEXEL_FORMAT_GREEN:
-                        pixelValue[QT_BITMAP_GREEN_CHANNEL_INDEX] = channelValue;
-                        break;
+            for (int x = 0; x < width; x++)
+            {
+                quint32 pixel = kernel._defaultPixel;
 
-                    case OA_TEXEL_FORMAT_BLUE:
-                        pixelValue[QT_BITMAP_BLUE_CHANNEL_INDEX] = channelValue;
-                        break;
+                for (int i = 0; i < componentsCount; i++)
+                {
+                    const TexelComponent& component = pComponents[i];
+                    const gtUByte* pSrcValue = pSrcTexel + component._srcOffset;
 
-                    case OA_TEXEL_FORMAT_ALPHA:
-                        pixelValue[QT_BITMAP_ALPHA_CHANNEL_INDEX] = channelValue;
-                        break;
+                    if (component._isNormalizedValue)
+                    {
+                        // Read the value as the pixel value parameter holds it (as a double):
+                        double value = 0;
 
-                    default:
-                        GT_ASSERT(false);
-                        break;
+                        switch (_componentDataType)
+                        {
+                            case OA_FLOAT:
+                            {
+                                float floatValue = 0;
+                                memcpy(&floatValue, pSrcValue, sizeof(floatValue));
+                                value = floatValue;
+                            }
+                            break;
+
+                            case OA_DOUBLE:
+                                memcpy(&value, pSrcValue, sizeof(value));
+                                break;
+
+                            case OA_INT:
+                            {
+                                qint32 intValue = 0;
+                                memcpy(&intValue, pSrcValue, sizeof(intValue));
+                                value = intValue;
+                            }
+                            break;
+
+                            default:
+                            {
+                                quint32 uintValue = 0;
+                                memcpy(&uintValue, pSrcValue, sizeof(uintValue));
+                                value = uintValue;
+                            }
+                            break;
+                        }
+
+                        GLubyte pixelValue[AC_OUTPUT_IMAGE_BYTES_PER_PIXEL] = {0, 0, 0, 0};
+                        calculateNormalizedColor(value, kernel._minValue, kernel._maxValue, pixelValue);
+
+                        quint32 componentBits = 0;
+                        memcpy(&componentBits, pixelValue, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+                        pixel = (pixel & ~component._pixelMask) | (componentBits & component._pixelMask);
+                    }
+                    else
+                    {
+                        // The pixel value conversion is done by the parameter:
+                        bool rc = readPixelChannelValue(pParameter, pSrcTexel, component._componentIndex);
+                        GT_IF_WITH_ASSERT(rc)
+                        {
+                            pixel = (pixel & ~component._pixelMask) | calculateTexelComponentBits(component, pParameter);
+                        }
+                    }
+                }
+
+                pDstRow[x] = pixel;
+
+                // Advance to the next source pixel position:
+                pSrcTexel += _rawDataPixelSize;
+            }
+        }
+        break;
+
+        default:
+        {
+            gtUByte* pSrcTexel = pSrcRow;
+
+            for (int x = 0; x < width; x++)
+            {
+                quint32 pixel = kernel._defaultPixel;
+
+                for (int i = 0; i < componentsCount; i++)
+                {
+                    const TexelComponent& component = pComponents[i];
+
+                    // Get component value
+                    bool rc = readPixelChannelValue(pParameter, pSrcTexel, component._componentIndex);
+                    GT_IF_WITH_ASSERT(rc)
+                    {
+                        pixel = (pixel & ~component._pixelMask) | calculateTexelComponentBits(component, pParameter);
+                    }
                 }
+
+                pDstRow[x] = pixel;
+
+                // Advance to the next source pixel position:
+                pSrcTexel += _rawDataPixelSize;
             }
         }
+        break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::calculatePixelFilterMask
+// Description: Checks which pixels of the active page are displayed according
+//              to the filter raw file handlers, before the pixels are converted
+// Arguments:   displayedPixels - Output bit per pixel (row by row), set if the
+//              pixel is displayed
+// Return Val:  bool - true if the pixels are filtered, false if there are no
+//              filters (displayedPixels is not filled)
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::calculatePixelFilterMask(QBitArray& displayedPixels)
+{
+    bool retVal = hasFilterRawFileHandlers();
+
+    if (retVal)
+    {
+        displayedPixels.resize(_width * _height);
+
+        for (int y = 0; y < _height; y++)
+        {
+            for (int x = 0; x < _width; x++)
+            {
+                // Before calculating the pixel value, check if the pixel should be filtered:
+                bool shouldPixelBeDisplayed = true;
+                bool rcCheckFilter = checkPixelFilter(y, x, shouldPixelBeDisplayed);
+                GT_ASSERT(rcCheckFilter);
+
+                displayedPixels.setBit(y * _width + x, shouldPixelBeDisplayed);
+            }
+        }
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::hasFilterRawFileHandlers
+// Description: Checks if any filter raw file handler is set
+// Return Val:  bool - true if the pixels are filtered
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::hasFilterRawFileHandlers() const
+{
+    bool retVal = false;
+
+    for (int i = 0; i < AC_MAX_RAW_FILE_FILTER_HANDLERS; i++)
+    {
+        retVal = retVal || (_pFilterRawFileHandler[i] != NULL);
     }
 
-    // Write RGBA values:
-    memcpy(pPixelData, &pixelValue, AC_OUTPUT_IMAGE_BYTES_PER_PIXEL);
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::activePageRawData
+// Description: Returns the raw data of the currently active page, for reading
+//              the component values in place (see readPixelChannelValue)
+// Return Val:  const gtUByte* - The page raw data, or NULL for buffers
+// Author:      AMD Developer Tools Team
+// Date:        17/10/2026
+// ---------------------------------------------------------------------------
+const gtUByte* acRawFileHandler::activePageRawData() const
+{
+    const gtUByte* pRetVal = NULL;
+
+    if (_isLoadedSuccesfully && (_pRawData != NULL) && !oaIsBufferTexelFormat(_texelDataFormat))
+    {
+        pRetVal = (const gtUByte*)(_pRawData + _activePageRawDataOffset);
+    }
+
+    return pRetVal;
 }
 
 // ---------------------------------------------------------------------------
@@ -1119,39 +2407,57 @@ bool acRawFileHandler::getPixelChannelValue(gtUByte* pDataOffset, int componentI
     // Sanity check:
     if (_pPixelValueDataParameter)
     {
-        retVal = true;
+        retVal = readPixelChannelValue(_pPixelValueDataParameter, pDataOffset, componentIndex);
 
-        // On regular data types, just move offset to the current channel index
-        if (_amountOfComponentsInDataType == 1)
-        {
-            pDataOffset += componentIndex * _dataTypeSize;
-        }
+        // Return the GLDataParameter
+        pParameter = _pPixelValueDataParameter;
+    }
 
-        // Read data from raw data pointer into the apParameter
-        _pPixelValueDataParameter->readValueFromPointer((void*)pDataOffset);
+    return retVal;
+}
 
-        // If we got a few components in the data type, we need to take only the relevant channel bits
-        if (_amountOfComponentsInDataType > 1)
-        {
-            retVal = false;
+// ---------------------------------------------------------------------------
+// Name:        acRawFileHandler::readPixelChannelValue
+// Description: Reads the channel value (according to the channel index) from
+//              the current offset in the raw data pointer into a parameter
+// Arguments:   pParameter - The apParameter which will be read from the raw data
+//              pDataOffset - The raw data offset, pointing to the current pixel
+//              componentIndex - The index of the channel to retrieve it's value
+// Return Val:  bool - Success / Failure
+// Author:      Eran Zinman
+// Date:        9/12/2007
+// ---------------------------------------------------------------------------
+bool acRawFileHandler::readPixelChannelValue(apPixelValueParameter* pParameter, gtUByte* pDataOffset, int componentIndex)
+{
+    bool retVal = true;
+
+    // On regular data types, just move offset to the current channel index
+    if (_amountOfComponentsInDataType == 1)
+    {
+        pDataOffset += componentIndex * _dataTypeSize;
+    }
 
-            if (getDataTypeComponentValue(_componentDataType, componentIndex, _pPixelValueDataParameter))
+    // Read data from raw data pointer into the apParameter
+    pParameter->readValueFromPointer((void*)pDataOffset);
+
+    // If we got a few components in the data type, we need to take only the relevant channel bits
+    if (_amountOfComponentsInDataType > 1)
+    {
+        retVal = false;
+
+        if (getDataTypeComponentValue(_componentDataType, componentIndex, pParameter))
+        {
+            // Of many bytes enter into this bit mask
+            int amountOfComponentBits = oaAmountOfComponentBits(_componentDataType, componentIndex);
+            GT_IF_WITH_ASSERT(amountOfComponentBits != -1)
             {
-                // Of many bytes enter into this bit mask
-                int amountOfComponentBits = oaAmountOfComponentBits(_componentDataType, componentIndex);
-                GT_IF_WITH_ASSERT(amountOfComponentBits != -1)
-                {
-                    // Set the component value multiplier which is basically 256 / (2^amount of component bits)
-                    double valueMultiplier = (double)0xff / (double)(1 << amountOfComponentBits);
-                    _pPixelValueDataParameter->setValueMultiplier(valueMultiplier);
+                // Set the component value multiplier which is basically 256 / (2^amount of component bits)
+                double valueMultiplier = (double)0xff / (double)(1 << amountOfComponentBits);
+                pParameter->setValueMultiplier(valueMultiplier);
 
-                    retVal = true;
-                }
+                retVal = true;
             }
         }
-
-        // Return the GLDataParameter
-        pParameter = _pPixelValueDataParameter;
     }
 
     return retVal;
@@ -1178,8 +2484,22 @@ bool acRawFileHandler::setActivePage(int pageIndex)
         // Range check
         GT_IF_WITH_ASSERT((realPageIndex >= 0) && (realPageIndex < _amountOfPages))
         {
+            gtSizeType pageSize = (gtSizeType)_rawDataPixelSize * _width * _height;
+
+            // The previously active page of a mapped file is not displayed anymore:
+            if (realPageIndex != _activePage)
+            {
+                adviseMappedData(_activePageRawDataOffset, pageSize, AC_MAPPED_DATA_DONT_NEED);
+
+                // The next pages are prefetched in the direction the pages are switched in:
+                _scrubDirection = (realPageIndex > _activePage) ? 1 : -1;
+            }
+
             // Calculate the offset in the raw data
-            _activePageRawDataOffset = _rawDataPixelSize * _width * _height * realPageIndex;
+            _activePageRawDataOffset = pageSize * realPageIndex;
+
+            // Read the new page ahead:
+            adviseMappedData(_activePageRawDataOffset, pageSize, AC_MAPPED_DATA_WILL_NEED);
 
             // Save the currently active page
             _activePage = realPageIndex;
@@ -1305,6 +2625,9 @@ void acRawFileHandler::setBufferDataFormat(oaTexelDataFormat texelDataFormat)
 
     GT_IF_WITH_ASSERT(isNewFormatVBO && isCurrentFormatVBO)
     {
+        cancelPrefetch();
+        clearPageCaches();
+
         _texelDataFormat = texelDataFormat;
     }
 }
@@ -1325,6 +2648,10 @@ bool acRawFileHandler::setDataFormatAndAdaptSize(GLenum openGLDataFormat)
     bool rc1 = apGetPixelSizeInBitsByInternalFormat(openGLDataFormat, pixelSize);
     GT_IF_WITH_ASSERT(rc1)
     {
+        // The prefetch jobs read the format and size, and the cached pages were converted with the previous ones:
+        cancelPrefetch();
+        clearPageCaches();
+
         // Override the raw file handler with the texture buffer format:
         oaTexelDataFormat dataFormat = OA_TEXEL_FORMAT_UNKNOWN;
         bool rc2 = oaGLEnumToTexelDataFormat(openGLDataFormat, dataFormat);
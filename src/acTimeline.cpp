@@ -12,11 +12,14 @@
 #include <QPainter>
 #include <QBoxLayout>
 #include <QToolTip>
+#include <QCursor>
 #include <QDateTime>
 #include <QStyle>
 #include <QLabel>
 #include <QDialog>
+#include <QElapsedTimer>
 
+#include <algorithm>
 #include <limits>
 #include <cmath>
 
@@ -71,12 +74,34 @@ acTimeline::acTimeline(QWidget* parent, Qt::WindowFlags flags) : QWidget(parent,
     m_pSelectedBranch(nullptr),
     m_pSelectedItem(nullptr),
     m_lastSizeWhenCacheWasCleared(0, 0),
+    m_bTileCacheEnabled(false),
+    m_bPainting(false),
+    m_tileRenderer(this, "tilesRendered"),
+    m_bAsyncTileRendering(false),
+    m_bStreamingMode(false),
+    m_bFrameStatsEnabled(false),
+    m_bFrameStatsHUDVisible(false),
+    m_nFrameCount(0),
+    m_bRowLayoutInvalid(false),
+    m_bBatchedPainting(false),
+    m_bBranchTextIndexInvalid(true),
+    m_nCurrentSearchResult(-1),
+    m_rangeStatsCalculator(this, "rangeStatsFinished"),
+    m_bSelectionStatsEnabled(false),
+    m_toolTipBuilder(this, "toolTipBuilt"),
+    m_pToolTipItem(nullptr),
     m_shouldDisplayChildrenInParentBranch(false),
     m_pHScrollBar(nullptr),
     m_pVScrollBar(nullptr)
 {
     setMouseTracking(true);
 
+    m_labelCache.setFont(font());
+
+    m_toolTipTimer.setSingleShot(true);
+    m_toolTipTimer.setInterval(AC_TIMELINE_TOOLTIP_DEBOUNCE_MS);
+    connect(&m_toolTipTimer, SIGNAL(timeout()), this, SLOT(toolTipTimerFired()));
+
     m_pGrid = new(std::nothrow) acTimelineGrid(this);
     Q_ASSERT(m_pGrid != nullptr);
 
@@ -116,6 +141,11 @@ acTimeline::acTimeline(QWidget* parent, Qt::WindowFlags flags) : QWidget(parent,
 
 acTimeline::~acTimeline()
 {
+    // don't let the worker threads notify the timeline while it is destroyed
+    m_tileRenderer.cancel();
+    m_rangeStatsCalculator.cancel();
+    m_toolTipBuilder.cancel();
+
     clearBranches();
     clearMarkers();
 
@@ -130,6 +160,11 @@ acTimeline::~acTimeline()
 
 void acTimeline::clearBranches()
 {
+    // the statistics in progress read the items of the branches, and the tooltips refer to them
+    m_rangeStatsCalculator.cancelAndWait();
+    dropToolTipRequest();
+    m_toolTipBuilder.clearCache();
+
     for (QList<acTimelineBranch*>::iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
     {
         delete(*i);
@@ -137,6 +172,73 @@ void acTimeline::clearBranches()
     }
 
     m_subBranches.clear();
+    m_branchesById.clear();
+    m_rowLayout.clear();
+    resetRowIndex();
+
+    m_textIndex.clear();
+    m_compactTextIds.clear();
+    m_traceTextIds.clear();
+    m_itemTextIds.clear();
+    m_bBranchTextIndexInvalid = true;
+    m_searchResults.clear();
+    m_nCurrentSearchResult = -1;
+    m_pSelectedItem = nullptr;
+
+    // the tiles are keyed by branch
+    clearTileCache();
+}
+
+bool acTimeline::addTraceBranches(const acTimelineTraceFile& traceFile)
+{
+    if (!traceFile.isOpen())
+    {
+        return false;
+    }
+
+    // the branch table lists the parents before their sub branches, so the whole hierarchy is built before it is added to the timeline
+    QVector<acTimelineBranch*> branches;
+    branches.reserve(traceFile.branchCount());
+
+    for (int i = 0; i < traceFile.branchCount(); ++i)
+    {
+        acTimelineBranch* pBranch = new(std::nothrow) acTimelineBranch();
+        Q_ASSERT(pBranch != nullptr);
+
+        if (pBranch != nullptr)
+        {
+            pBranch->setText(traceFile.branchName(i));
+            pBranch->setTraceItems(traceFile.branchItems(i));
+
+            int parentIndex = traceFile.branchParent(i);
+            acTimelineBranch* pParent = (parentIndex >= 0) ? branches[parentIndex] : nullptr;
+
+            if (parentIndex >= 0 && pParent == nullptr)
+            {
+                // the parent could not be created
+                delete pBranch;
+                pBranch = nullptr;
+            }
+            else if (pParent != nullptr)
+            {
+                pParent->addSubBranch(pBranch);
+            }
+        }
+
+        branches.append(pBranch);
+    }
+
+    bool retVal = true;
+
+    for (int i = 0; i < traceFile.branchCount(); ++i)
+    {
+        if (traceFile.branchParent(i) < 0 && branches[i] != nullptr)
+        {
+            retVal = addBranch(branches[i]) && retVal;
+        }
+    }
+
+    return retVal;
 }
 
 bool acTimeline::addBranch(acTimelineBranch* branch)
@@ -166,10 +268,11 @@ bool acTimeline::addBranch(acTimelineBranch* branch)
     connectSlotsToBranchSignals(branch);
 
     m_subBranches.push_back(branch);
+    addBranchRows(branch);
+    m_bBranchTextIndexInvalid = true;
 
     recalcTitleWidth();
     updateScrollBars(QFlags<Qt::Orientation>(Qt::Vertical));
-    resetRowIndex();
     update();
 
     return true;
@@ -182,6 +285,8 @@ void acTimeline::connectSlotsToBranchSignals(acTimelineBranch* branch)
             this, SLOT(branchRangeChanged()));
     connect(branch, SIGNAL(branchAdded(acTimelineBranch*)),
             this, SLOT(branchAdded(acTimelineBranch*)));
+    connect(branch, SIGNAL(branchItemsAdded(int)),
+            this, SLOT(branchItemsAdded(int)));
     connect(branch, SIGNAL(branchTextChanged()),
             this, SLOT(branchTextChanged()));
     connect(branch, SIGNAL(branchFoldedChanged()),
@@ -256,6 +361,11 @@ void acTimeline::setStartTime(const quint64 newStartTime)
 
 void acTimeline::setFullRange(const quint64 newFullRange)
 {
+    if (m_bStreamingMode && growStreamingFullRange(newFullRange))
+    {
+        return;
+    }
+
     // TODO investigate why does setting the full range also affect the visible range (should do this only if visible range is now out full range)
     m_nFullRange = m_nVisibleRange = newFullRange;
 
@@ -271,27 +381,69 @@ void acTimeline::setFullRange(const quint64 newFullRange)
     updateGrid();
 }
 
-acTimelineBranch* acTimeline::getBranchFromY(int y) const
+bool acTimeline::growStreamingFullRange(const quint64 newFullRange)
 {
-    if (y >= timelineSectionTopSpace())
+    int localRowWidth = rowWidth();
+
+    if (newFullRange <= m_nFullRange || m_nFullRange == 0 || m_nVisibleRange == 0 || m_dZoomFactor <= 1.0 || localRowWidth <= 0)
     {
-        int adjustedY = y - timelineSectionTopSpace() + m_nVOffset;
-        int totalHeight = 0;
+        return false;
+    }
 
-        for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
-        {
-            if ((*i)->IsVisible() == true)
-            {
-                int branchHeight = (*i)->cumulativeHeight();
+    // keep the time per pixel, so that the visible items and the cached tiles stay where they are.  It is taken from the visible range,
+    // which does not change while streaming, so that rounding errors do not accumulate as the range keeps growing
+    quint64 newRenderWidth = (quint64)(newFullRange * (localRowWidth / (double)m_nVisibleRange) + 0.5);
 
-                if (totalHeight + branchHeight > adjustedY)
-                {
-                    return (*i)->getSubBranchFromY(adjustedY - totalHeight);
-                }
+    // half a pixel is added so that updateScrollBars, which truncates rowWidth() * m_dZoomFactor, gets the same render width back
+    double newZoomFactor = (newRenderWidth + 0.5) / localRowWidth;
 
-                totalHeight += branchHeight;
-            }
-        }
+    if (newZoomFactor > m_dMaxZoom)
+    {
+        return false;
+    }
+
+    bool wasShowingEnd = (quint64)(m_nOffset + localRowWidth) >= m_nRenderWidth;
+
+    m_nFullRange = newFullRange;
+    m_dInvRange = 1 / (double)m_nFullRange;
+    m_dZoomFactor = newZoomFactor;
+    m_nRenderWidth = newRenderWidth;
+
+    if (m_nRenderWidth > (quint64)std::numeric_limits<int>::max())
+    {
+        m_bScaleHScrollbar = true;
+        m_dHScrollbarScaleValue = (m_nRenderWidth / (double)std::numeric_limits<int>::max()) * 2.0;
+    }
+    else
+    {
+        m_bScaleHScrollbar = false;
+    }
+
+    // if the end of the timeline was visible, keep following it so that the streamed items scroll into view
+    qint64 oldOffset = m_nOffset;
+
+    if (wasShowingEnd)
+    {
+        setOffset(m_nRenderWidth - localRowWidth);
+    }
+
+    // setOffset updates the scroll bar and the grid when the offset changes.  Otherwise only their range changed
+    if (m_nOffset == oldOffset)
+    {
+        updateHorizontalScrollBar();
+        updateGrid();
+        update();
+    }
+
+    return true;
+}
+
+acTimelineBranch* acTimeline::getBranchFromY(int y) const
+{
+    if (y >= timelineSectionTopSpace())
+    {
+        int adjustedY = y - timelineSectionTopSpace() + m_nVOffset;
+        return rowLayout().branchAt(adjustedY);
     }
 
     return nullptr;
@@ -333,6 +485,230 @@ acTimelineBranch* acTimeline::getBranchFromText(const QString& branchText, bool
     return nullptr;
 }
 
+/// Lists a branch and all its sub branches, parents before their sub branches.
+/// \param pBranch the branch.
+/// \param visibleOnly true to skip the hidden branches (and their sub branches).
+/// \param[out] branches the list the branches are appended to.
+static void acListBranches(acTimelineBranch* pBranch, bool visibleOnly, QList<acTimelineBranch*>& branches)
+{
+    if (visibleOnly && !pBranch->IsVisible())
+    {
+        return;
+    }
+
+    branches.append(pBranch);
+
+    for (int i = 0; i < pBranch->subBranchCount(); ++i)
+    {
+        acListBranches(pBranch->getSubBranch(i), visibleOnly, branches);
+    }
+}
+
+QList<acTimelineBranch*> acTimeline::findBranches(const QString& text, acTimelineTextIndex::MatchType matchType, Qt::CaseSensitivity caseSensitivity) const
+{
+    ensureBranchTextIndex();
+
+    QVector<int> textIds;
+    m_branchTextIndex.findTextIds(text, matchType, caseSensitivity, textIds);
+
+    // several titles may match, so the positions of their branches are sorted to list the branches in order
+    QVector<int> positions;
+
+    for (QVector<int>::const_iterator i = textIds.begin(); i != textIds.end(); ++i)
+    {
+        positions += m_branchesByTextId[*i];
+    }
+
+    std::sort(positions.begin(), positions.end());
+
+    QList<acTimelineBranch*> retVal;
+
+    for (QVector<int>::const_iterator i = positions.begin(); i != positions.end(); ++i)
+    {
+        retVal.append(m_indexedBranches[*i]);
+    }
+
+    return retVal;
+}
+
+void acTimeline::ensureBranchTextIndex() const
+{
+    if (m_bBranchTextIndexInvalid)
+    {
+        m_branchTextIndex.clear();
+        m_indexedBranches.clear();
+        m_branchesByTextId.clear();
+
+        for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+        {
+            acListBranches(*i, false, m_indexedBranches);
+        }
+
+        for (int pos = 0; pos < m_indexedBranches.count(); ++pos)
+        {
+            int textId = m_branchTextIndex.addText(m_indexedBranches[pos]->text());
+
+            if (textId >= m_branchesByTextId.count())
+            {
+                m_branchesByTextId.resize(textId + 1);
+            }
+
+            m_branchesByTextId[textId].append(pos);
+        }
+
+        m_bBranchTextIndexInvalid = false;
+    }
+}
+
+int acTimeline::search(const QString& text, acTimelineTextIndex::MatchType matchType, Qt::CaseSensitivity caseSensitivity)
+{
+    m_searchResults.clear();
+    m_nCurrentSearchResult = -1;
+
+    QList<acTimelineBranch*> allBranches;
+
+    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    {
+        acListBranches(*i, false, allBranches);
+    }
+
+    // bring the text index up to date with the items added since the previous search
+    for (QList<acTimelineBranch*>::const_iterator i = allBranches.begin(); i != allBranches.end(); ++i)
+    {
+        (*i)->indexItemTexts(m_textIndex, m_itemTextIds[*i]);
+        (*i)->indexCompactTexts(m_textIndex, m_compactTextIds[*i]);
+
+        const acTimelineTraceFile* pTraceFile = (*i)->traceItems().file();
+
+        if (pTraceFile != nullptr && !m_traceTextIds.contains(pTraceFile->loadGeneration()))
+        {
+            // the string table of a trace file never changes, so it is indexed once per load
+            QVector<int>& traceTextIds = m_traceTextIds[pTraceFile->loadGeneration()];
+            traceTextIds.reserve(pTraceFile->stringCount());
+
+            for (quint32 stringId = 0; stringId < pTraceFile->stringCount(); ++stringId)
+            {
+                traceTextIds.append(m_textIndex.addText(pTraceFile->string(stringId)));
+            }
+        }
+    }
+
+    if (!text.isEmpty())
+    {
+        QVector<bool> textMatches;
+        m_textIndex.findTexts(text, matchType, caseSensitivity, textMatches);
+
+        for (QList<acTimelineBranch*>::const_iterator i = allBranches.begin(); i != allBranches.end(); ++i)
+        {
+            const acTimelineTraceFile* pTraceFile = (*i)->traceItems().file();
+            const QVector<int>* pTraceTextIds = (pTraceFile != nullptr) ? &m_traceTextIds[pTraceFile->loadGeneration()] : nullptr;
+
+            (*i)->findTextMatches(textMatches, m_itemTextIds[*i], m_compactTextIds[*i], pTraceTextIds, ACTIMELINE_MaxSearchResults, m_searchResults);
+        }
+
+        std::stable_sort(m_searchResults.begin(), m_searchResults.end(), [](const acTimelineSearchResult & left, const acTimelineSearchResult & right)
+        {
+            return left.m_nStartTime < right.m_nStartTime;
+        });
+
+        if (m_searchResults.count() > ACTIMELINE_MaxSearchResults)
+        {
+            m_searchResults.resize(ACTIMELINE_MaxSearchResults);
+        }
+    }
+
+    return m_searchResults.count();
+}
+
+acTimelineItem* acTimeline::searchResultItem(const acTimelineSearchResult& result) const
+{
+    acTimelineItem* retVal = nullptr;
+
+    GT_IF_WITH_ASSERT(result.m_pBranch != nullptr)
+    {
+        switch (result.m_kind)
+        {
+            case acTimelineSearchResult::SEARCH_RESULT_ITEM:
+                retVal = result.m_pBranch->getTimelineItem((int)result.m_nIndex);
+                break;
+
+            case acTimelineSearchResult::SEARCH_RESULT_COMPACT_ITEM:
+                retVal = result.m_pBranch->getCompactTimelineItem((int)result.m_nIndex);
+                break;
+
+            case acTimelineSearchResult::SEARCH_RESULT_TRACE_ITEM:
+                retVal = result.m_pBranch->getTraceTimelineItem(result.m_nIndex);
+                break;
+        }
+    }
+
+    return retVal;
+}
+
+acTimelineItem* acTimeline::showNextSearchResult(bool forward, bool shouldZoom)
+{
+    if (m_searchResults.isEmpty())
+    {
+        return nullptr;
+    }
+
+    int resultCount = m_searchResults.count();
+
+    if (m_nCurrentSearchResult < 0)
+    {
+        // start from the selected item, or from the visible time window
+        quint64 fromTime = (m_pSelectedItem != nullptr) ? m_pSelectedItem->startTime() : visibleStartTime();
+
+        QVector<acTimelineSearchResult>::const_iterator firstIt = std::lower_bound(m_searchResults.constBegin(), m_searchResults.constEnd(), fromTime,
+                                                                                   [](const acTimelineSearchResult & result, quint64 time)
+        {
+            return result.m_nStartTime < time;
+        });
+
+        int firstIndex = (int)(firstIt - m_searchResults.constBegin());
+
+        // when stepping forward from the selected item, the selected item itself is skipped
+        if (forward && m_pSelectedItem != nullptr && firstIndex < resultCount && searchResultItem(m_searchResults[firstIndex]) == m_pSelectedItem)
+        {
+            ++firstIndex;
+        }
+
+        m_nCurrentSearchResult = forward ? (firstIndex % resultCount) : ((firstIndex + resultCount - 1) % resultCount);
+    }
+    else
+    {
+        m_nCurrentSearchResult = (m_nCurrentSearchResult + (forward ? 1 : resultCount - 1)) % resultCount;
+    }
+
+    acTimelineItem* retVal = searchResultItem(m_searchResults[m_nCurrentSearchResult]);
+
+    if (retVal != nullptr)
+    {
+        if (shouldZoom)
+        {
+            ZoomToItem(retVal, true);
+        }
+        else
+        {
+            DisplayItemAtHorizontalCenter(retVal, true);
+        }
+    }
+
+    return retVal;
+}
+
+void acTimeline::computeRangeStats(quint64 rangeStart, quint64 rangeEnd, int topTextCount)
+{
+    QList<acTimelineBranch*> visibleBranches;
+
+    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    {
+        acListBranches(*i, true, visibleBranches);
+    }
+
+    m_rangeStatsCalculator.submit(rangeStart, rangeEnd, topTextCount, visibleBranches);
+}
+
 acTimelineItem* acTimeline::getTimelineItem(int x, int y) const
 {
     acTimelineBranch* branch = getBranchFromY(y);
@@ -520,8 +896,28 @@ void acTimeline::showBranch(acTimelineBranch* branch)
 
 int acTimeline::getXCoordOfTime(quint64 time) const
 {
-    int val = (int)((((double)(time - m_nStartTime) * invRange()) * m_nRenderWidth) - m_nOffset);
-    return val;
+    return timeTransform().timeToPixel(time);
+}
+
+quint64 acTimeline::getTimeOfXCoord(int x) const
+{
+    return timeTransform().xToTime(x);
+}
+
+acTimelineRowView acTimeline::rowView() const
+{
+    acTimelineRowView retVal;
+
+    retVal.m_timeTransform = timeTransform();
+    retVal.m_nVisibleStartTime = m_nVisibleStartTime;
+    retVal.m_nVisibleRange = m_nVisibleRange;
+    retVal.m_nLeft = m_nTitleWidth;
+    retVal.m_nWidth = rowWidth();
+    // the mask starts at the edge of the first visible tile, so that the items are masked as in the tiles (see drawBranchTiles)
+    retVal.m_nMaskLeft = m_nTitleWidth - (int)(m_nOffset % AC_TIMELINE_TILE_WIDTH);
+    retVal.m_bIsTiled = false;
+
+    return retVal;
 }
 
 double acTimeline::getFractionOfFullTimeline(double fractionOfVisiblePortion)
@@ -534,201 +930,605 @@ void acTimeline::SetGridLabelsPrecision(unsigned int precision)
 {
     if (m_pGrid != nullptr)
     {
-        m_pGrid->SetGridLabelsPrecision(precision);
+        m_pGrid->SetGridLabelsPrecision(precision);
+    }
+}
+
+void acTimeline::recalcTitleWidth()
+{
+    int originalWidth = ACTIMELINEGRID_DefaultGridLabelSpace;
+
+    if (m_pGrid != nullptr)
+    {
+        originalWidth = m_pGrid->gridLabelSpace();
+    }
+
+    m_nTitleWidth = originalWidth;
+    int branchTitleWidth;
+
+    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    {
+        branchTitleWidth = (*i)->titleWidth();
+
+        if (branchTitleWidth > m_nTitleWidth)
+        {
+            m_nTitleWidth = branchTitleWidth;
+        }
+    }
+
+    if (m_nTitleWidth > originalWidth)
+    {
+        m_nTitleWidth += m_nTitleSectionLeftSpace + m_nTitleSectionRightSpace + ACTIMELINE_TreeMarkSpace;
+
+        if (m_pGrid != nullptr)
+        {
+            m_pGrid->setGridLabelSpace(m_nTitleWidth);
+        }
+
+        if (m_pHScrollBar != nullptr)
+        {
+            m_pHScrollBar->setGeometry(m_nTitleWidth, m_pHScrollBar->y(), rowWidth(), m_pHScrollBar->height());
+        }
+    }
+
+    m_nRenderWidth = (quint64)(rowWidth() * m_dZoomFactor);
+}
+
+int acTimeline::rowWidth() const
+{
+    int rowWidth = width();
+    int nonRowSpace = m_nTitleWidth + m_nTimelineSectionRightSpace;
+
+    if (m_pVScrollBar != nullptr && m_pVScrollBar->isVisible())
+    {
+        nonRowSpace += m_pVScrollBar->width();
+    }
+
+    if (rowWidth > nonRowSpace)
+    {
+        rowWidth -= nonRowSpace;
+    }
+    else
+    {
+        rowWidth = 0;
+    }
+
+    return rowWidth;
+}
+
+int acTimeline::cumulativeBranchHeight()
+{
+    return rowLayout().totalHeight();
+}
+
+void acTimeline::updateRowLayout() const
+{
+    if (m_bRowLayoutInvalid)
+    {
+        m_bRowLayoutInvalid = false;
+        m_rowLayout.build(m_subBranches);
+    }
+}
+
+void acTimeline::updateBranchRow(const acTimelineBranch* branch)
+{
+    // an invalid layout reads the state of all the branches when it is rebuilt
+    if (!m_bRowLayoutInvalid)
+    {
+        m_rowLayout.updateRow(branch);
+    }
+}
+
+int acTimeline::registerBranch(acTimelineBranch* branch)
+{
+    m_branchesById.push_back(branch);
+    return m_branchesById.count() - 1;
+}
+
+int acTimeline::setBranchesVisibility(const QHash<int, bool>& visibility)
+{
+    int retVal = 0;
+    QVector<acTimelineBranch*> parents;
+
+    for (QHash<int, bool>::const_iterator i = visibility.begin(); i != visibility.end(); ++i)
+    {
+        acTimelineBranch* branch = branchById(i.key());
+
+        if (branch != nullptr && branch->IsVisible() != i.value())
+        {
+            // updates the row of the branch and the tiles of its parents
+            branch->setVisibility(i.value());
+            retVal++;
+
+            for (acTimelineBranch* parent = branch->parentBranch(); parent != nullptr; parent = parent->parentBranch())
+            {
+                parents.push_back(parent);
+            }
+        }
+    }
+
+    if (retVal > 0)
+    {
+        // the title width of a parent depends on the title width of its visible sub branches, so the deepest parents are updated first
+        std::sort(parents.begin(), parents.end(), [](const acTimelineBranch* a, const acTimelineBranch* b)
+        {
+            return (a->depth() != b->depth()) ? (a->depth() > b->depth()) : (a < b);
+        });
+        parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+
+        for (QVector<acTimelineBranch*>::iterator i = parents.begin(); i != parents.end(); ++i)
+        {
+            (*i)->recalcTitleWidth();
+        }
+
+        recalcTitleWidth();
+        updateScrollBars(QFlags<Qt::Orientation>(Qt::Vertical));
+        update();
+    }
+
+    return retVal;
+}
+
+bool acTimeline::event(QEvent* event)
+{
+    if (event->type() == QEvent::ToolTip)
+    {
+        if (m_showToolTip)
+        {
+            QHelpEvent* helpEvent = dynamic_cast<QHelpEvent*>(event);
+            acTimelineItem* item = getTimelineItem(helpEvent->x(), helpEvent->y());
+
+            if (item != NULL)
+            {
+                QString tooltipText;
+
+                if (m_toolTipBuilder.findCached(item, tooltipText))
+                {
+                    dropToolTipRequest();
+                    QToolTip::showText(helpEvent->globalPos(), tooltipText);
+                }
+                else if (item != m_pToolTipItem)
+                {
+                    // build the text once the mouse rests over the item, see toolTipTimerFired
+                    m_toolTipBuilder.cancel();
+                    m_pToolTipItem = item;
+                    m_toolTipPos = helpEvent->globalPos();
+                    m_toolTipTimer.start();
+                }
+            }
+            else
+            {
+                dropToolTipRequest();
+
+                if (m_bShowZoomHint)
+                {
+                    QToolTip::showText(helpEvent->globalPos(), tr("Use the mouse wheel or the plus/minus keys to zoom in and out"));
+                }
+                else
+                {
+                    QToolTip::hideText();
+                    event->ignore();
+                }
+            }
+        }
+
+        return true;
+    }
+
+    return QWidget::event(event);
+}
+
+void acTimeline::paintEvent(QPaintEvent* /* event */)
+{
+    QElapsedTimer paintTimer;
+
+    if (m_bFrameStatsEnabled)
+    {
+        paintTimer.start();
+    }
+
+    int rw = rowWidth();
+    int curHeight = height();
+    int topSpace = timelineSectionTopSpace();
+
+    int yOffset = topSpace - m_nVOffset;
+    QPainter painter(this);
+
+    int totalHeight = curHeight - topSpace;
+
+    if (m_pHScrollBar != NULL && m_pHScrollBar->isVisible())
+    {
+        totalHeight -= m_pHScrollBar->height();
+    }
+
+    painter.setClipRect(0, topSpace, width(), totalHeight);
+
+    m_bPainting = true;
+
+    if (m_bTileCacheEnabled && m_tileCache.setZoomLevel(m_nRenderWidth, m_nStartTime, m_nFullRange))
+    {
+        // the tiles being rasterized belong to the previous zoom level
+        m_tileRenderer.cancel();
+    }
+
+    // draw branches
+    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    {
+        if ((*i)->IsVisible() == true)
+        {
+            (*i)->draw(painter, yOffset);
+        }
+    }
+
+    // Tiles and aggregated bars do not include the selection frame and the hovered item outline, so they are painted on top
+    drawItemOverlays(painter);
+
+    m_bPainting = false;
+
+    // draw markers
+    for (QList<TimelineMarker*>::const_iterator i = m_markers.begin(); i != m_markers.end(); ++i)
+    {
+        TimelineMarker* marker = *i;
+
+        if (marker->m_nTimeStamp >= m_nVisibleStartTime && marker->m_nTimeStamp <= m_nVisibleStartTime + m_nVisibleRange)
+        {
+            QPen pen = painter.pen();
+            pen.setColor(marker->m_color);
+            painter.setPen(pen);
+            int xPos = m_nTitleWidth + getXCoordOfTime(marker->m_nTimeStamp);
+            painter.drawLine(QPoint(xPos, topSpace), QPoint(xPos, curHeight));
+        }
+    }
+
+    // draw pivot line
+    if (m_showToolTip)
+    {
+        if (m_dPivot >= 0 && rw > 0)
+        {
+            QPen pen = painter.pen();
+            pen.setColor(Qt::black);
+            painter.setPen(pen);
+            int xPos = m_nTitleWidth + (int)(rw * m_dPivot);
+            painter.drawLine(QPoint(xPos, topSpace), QPoint(xPos, curHeight));
+        }
+    }
+
+    // draw drag highlight rectangle
+    if (m_bStartDrag && m_bSelectDragging)
+    {
+        int mouseX = m_mouseLocation.x();
+        int localTitleWidth = m_nTitleWidth;
+
+        QRect dragAreaRect;
+
+        if (mouseX > m_nStartDragX)
+        {
+            dragAreaRect.setX(m_nStartDragX);
+            dragAreaRect.setWidth(mouseX - m_nStartDragX);
+        }
+        else if (mouseX < localTitleWidth)
+        {
+            dragAreaRect.setX(localTitleWidth);
+            dragAreaRect.setWidth(m_nStartDragX - localTitleWidth);
+        }
+        else
+        {
+            dragAreaRect.setX(mouseX);
+            dragAreaRect.setWidth(m_nStartDragX - mouseX);
+        }
+
+        dragAreaRect.setY(topSpace);
+        dragAreaRect.setHeight(height() - dragAreaRect.y());
+        QColor dragColor = palette().color(QPalette::Highlight);
+        dragColor.setAlpha(127);
+        painter.fillRect(dragAreaRect, dragColor);
+    }
+
+    if (m_bFrameStatsEnabled)
+    {
+        m_currentFrameStats.m_nFrameIndex = m_nFrameCount++;
+        m_currentFrameStats.m_nPaintNs = paintTimer.nsecsElapsed();
+        m_frameStatsHistory.append(m_currentFrameStats);
+
+        while (m_frameStatsHistory.count() > AC_TIMELINE_FRAME_STATS_HISTORY_SIZE)
+        {
+            m_frameStatsHistory.removeFirst();
+        }
+
+        m_currentFrameStats.reset();
+
+        // the HUD is not included in the paint time
+        if (m_bFrameStatsHUDVisible)
+        {
+            drawFrameStatsHUD(painter);
+        }
+    }
+}
+
+void acTimeline::setFrameStatsEnabled(const bool newFrameStatsEnabled)
+{
+    if (m_bFrameStatsEnabled != newFrameStatsEnabled)
+    {
+        m_bFrameStatsEnabled = newFrameStatsEnabled;
+
+        if (m_bFrameStatsEnabled)
+        {
+            clearFrameStats();
+        }
+
+        update();
+    }
+}
+
+void acTimeline::drawFrameStatsHUD(QPainter& painter)
+{
+    if (m_frameStatsHistory.isEmpty())
+    {
+        return;
+    }
+
+    QStringList lines = m_frameStatsHistory.last().toLines();
+    QFontMetrics fontMetrics = painter.fontMetrics();
+    int margin = 4;
+    int lineHeight = fontMetrics.height();
+    int boxWidth = 0;
+
+    for (QStringList::const_iterator i = lines.begin(); i != lines.end(); ++i)
+    {
+        boxWidth = qMax(boxWidth, fontMetrics.width(*i));
+    }
+
+    boxWidth += 2 * margin;
+    int boxHeight = lines.count() * lineHeight + 2 * margin;
+    int boxLeft = m_nTitleWidth + rowWidth() - boxWidth - margin;
+    int boxTop = timelineSectionTopSpace() + margin;
+
+    painter.save();
+    painter.fillRect(QRect(boxLeft, boxTop, boxWidth, boxHeight), QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+
+    int lineTop = boxTop + margin;
+
+    for (QStringList::const_iterator i = lines.begin(); i != lines.end(); ++i)
+    {
+        painter.drawText(QRect(boxLeft + margin, lineTop, boxWidth - 2 * margin, lineHeight), Qt::AlignLeft | Qt::AlignVCenter, *i);
+        lineTop += lineHeight;
+    }
+
+    painter.restore();
+}
+
+void acTimeline::setTileCacheEnabled(const bool newTileCacheEnabled)
+{
+    if (m_bTileCacheEnabled != newTileCacheEnabled)
+    {
+        m_bTileCacheEnabled = newTileCacheEnabled;
+        clearTileCache();
+
+        for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+        {
+            (*i)->clearDrawCache(true);
+        }
+
+        update();
+    }
+}
+
+void acTimeline::setAsyncTileRendering(const bool newAsyncTileRendering)
+{
+    if (m_bAsyncTileRendering != newAsyncTileRendering)
+    {
+        m_bAsyncTileRendering = newAsyncTileRendering;
+        m_tileRenderer.cancel();
+        m_tileCache.setKeepPreviewTiles(m_bAsyncTileRendering);
+        update();
+    }
+}
+
+void acTimeline::invalidateTiles(const acTimelineBranch* branch, quint64 startTime, quint64 endTime)
+{
+    if (m_nRenderWidth == 0 || m_nFullRange == 0)
+    {
+        invalidateTiles(branch);
+        return;
     }
+
+    // the pixels of the full render width covered by the time range, with a pixel of margin on each side for the aggregated bars,
+    // which start at the summary bucket containing an item
+    double pixelsPerTime = m_nRenderWidth / (double)m_nFullRange;
+    double firstPixel = (startTime > m_nStartTime) ? (startTime - m_nStartTime) * pixelsPerTime : 0;
+    double lastPixel = (endTime > m_nStartTime) ? (endTime - m_nStartTime) * pixelsPerTime : 0;
+
+    qint64 firstTileIndex = (qint64)std::floor((firstPixel - 1) / AC_TIMELINE_TILE_WIDTH);
+    qint64 lastTileIndex = (qint64)std::floor((lastPixel + 1) / AC_TIMELINE_TILE_WIDTH);
+
+    m_tileCache.invalidateTiles(branch, firstTileIndex, lastTileIndex);
+    m_tileRenderer.cancelTiles(branch, firstTileIndex, lastTileIndex);
 }
 
-void acTimeline::recalcTitleWidth()
+void acTimeline::drawBranchTiles(QPainter& painter, acTimelineBranch* branch, int branchTop, int branchHeight)
 {
-    int originalWidth = ACTIMELINEGRID_DefaultGridLabelSpace;
+    int localRowWidth = rowWidth();
 
-    if (m_pGrid != nullptr)
+    if (branch == nullptr || localRowWidth <= 0 || branchHeight <= 0)
     {
-        originalWidth = m_pGrid->gridLabelSpace();
+        return;
     }
 
-    m_nTitleWidth = originalWidth;
-    int branchTitleWidth;
-
-    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
-    {
-        branchTitleWidth = (*i)->titleWidth();
+    // tiles are aligned to the full render width, so the same tiles are reused while scrolling horizontally
+    qint64 firstTile = m_nOffset / AC_TIMELINE_TILE_WIDTH;
+    qint64 lastTile = (m_nOffset + localRowWidth - 1) / AC_TIMELINE_TILE_WIDTH;
 
-        if (branchTitleWidth > m_nTitleWidth)
-        {
-            m_nTitleWidth = branchTitleWidth;
-        }
-    }
+    painter.save();
+    painter.setClipRect(QRect(m_nTitleWidth, branchTop, localRowWidth, branchHeight), Qt::IntersectClip);
+    bool isTileCached = true;
 
-    if (m_nTitleWidth > originalWidth)
+    for (qint64 tileIndex = firstTile; tileIndex <= lastTile; ++tileIndex)
     {
-        m_nTitleWidth += m_nTitleSectionLeftSpace + m_nTitleSectionRightSpace + ACTIMELINE_TreeMarkSpace;
+        int tileX = m_nTitleWidth + (int)(tileIndex * AC_TIMELINE_TILE_WIDTH - m_nOffset);
+        const QImage* pTile = m_tileCache.tile(branch, tileIndex, branchHeight);
 
-        if (m_pGrid != nullptr)
+        if (pTile != nullptr)
         {
-            m_pGrid->setGridLabelSpace(m_nTitleWidth);
+            painter.drawImage(tileX, branchTop, *pTile);
         }
+        else if (m_bAsyncTileRendering)
+        {
+            if (!m_tileRenderer.isPending(branch, tileIndex, branchHeight))
+            {
+                m_tileRenderer.submit(branch, tileIndex, branchHeight, recordTile(branch, tileIndex, branchHeight), devicePixelRatio(), logicalDpiX());
+            }
 
-        if (m_pHScrollBar != nullptr)
+            // until the tile is rasterized, show the tiles of the previous zoom level
+            m_tileCache.drawPreview(painter, branch, tileIndex, branchHeight, QPoint(tileX, branchTop));
+        }
+        else
         {
-            m_pHScrollBar->setGeometry(m_nTitleWidth, m_pHScrollBar->y(), rowWidth(), m_pHScrollBar->height());
+            QImage newTile = renderTile(branch, tileIndex, branchHeight);
+            painter.drawImage(tileX, branchTop, newTile);
+            isTileCached = m_tileCache.insert(branch, tileIndex, branchHeight, newTile) && isTileCached;
         }
     }
 
-    m_nRenderWidth = (quint64)(rowWidth() * m_dZoomFactor);
-}
+    painter.restore();
 
-int acTimeline::rowWidth() const
-{
-    int rowWidth = width();
-    int nonRowSpace = m_nTitleWidth + m_nTimelineSectionRightSpace;
+    // The labels are not painted into the tiles, since the items of the next tile may paint over the labels of the items which cross
+    // the tile edge.  They are painted over the tiles, from the items of the whole visible row, as when the items are painted directly
+    acTimelineRowView labelsView = rowView();
+    labelsView.m_bIsTiled = true;
+    labelsView.m_bPaintBackgrounds = false;
+    branch->drawItems(painter, labelsView, branchTop, branchHeight);
 
-    if (m_pVScrollBar != nullptr && m_pVScrollBar->isVisible())
+    if (!isTileCached)
     {
-        nonRowSpace += m_pVScrollBar->width();
+        // the tiles were painted, but the cache cannot hold them, so every paint would render them again
+        tileCacheOverflowed();
     }
+}
 
-    if (rowWidth > nonRowSpace)
-    {
-        rowWidth -= nonRowSpace;
-    }
-    else
-    {
-        rowWidth = 0;
-    }
+void acTimeline::tileCacheOverflowed()
+{
+    // A single tile exceeds the tile cache budget.  Paint the items directly instead.  This is deferred, since the tiles may
+    // be inserted while painting
+    QMetaObject::invokeMethod(this, "disableTileCache", Qt::QueuedConnection);
+}
 
-    return rowWidth;
+void acTimeline::disableTileCache()
+{
+    setTileCacheEnabled(false);
 }
 
-int acTimeline::cumulativeBranchHeight()
+QImage acTimeline::renderTile(acTimelineBranch* branch, qint64 tileIndex, int branchHeight)
 {
-    int totalBranchHeight = 0;
+    QImage retVal = acTimelineTileRenderer::createTileImage(branchHeight, devicePixelRatio(), logicalDpiX());
 
-    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
     {
-        if ((*i)->IsVisible() == true)
-        {
-            totalBranchHeight += (*i)->cumulativeHeight();
-        }
+        QPainter tilePainter(&retVal);
+        paintTile(tilePainter, branch, tileIndex, branchHeight);
     }
 
-    return totalBranchHeight;
+    return retVal;
 }
 
-bool acTimeline::event(QEvent* event)
+QPicture acTimeline::recordTile(acTimelineBranch* branch, qint64 tileIndex, int branchHeight)
 {
-    if (event->type() == QEvent::ToolTip)
+    QPicture retVal;
+
     {
-        if (m_showToolTip)
-        {
-            QHelpEvent* helpEvent = dynamic_cast<QHelpEvent*>(event);
-            acTimelineItem* item = getTimelineItem(helpEvent->x(), helpEvent->y());
+        QPainter tilePainter(&retVal);
+        paintTile(tilePainter, branch, tileIndex, branchHeight);
+    }
 
-            if (item != NULL)
-            {
-                QToolTip::showText(helpEvent->globalPos(), item->tooltipText());
-            }
-            else if (m_bShowZoomHint)
-            {
-                QToolTip::showText(helpEvent->globalPos(), tr("Use the mouse wheel or the plus/minus keys to zoom in and out"));
-            }
-            else
-            {
-                QToolTip::hideText();
-                event->ignore();
-            }
-        }
+    return retVal;
+}
 
-        return true;
+void acTimeline::paintTile(QPainter& tilePainter, acTimelineBranch* branch, qint64 tileIndex, int branchHeight)
+{
+    acTimelineFrameStats* pStats = frameStats();
+
+    if (pStats != nullptr)
+    {
+        pStats->m_nTilesRendered++;
     }
 
-    return QWidget::event(event);
+    tilePainter.setFont(font());
+    tilePainter.setPen(palette().color(QPalette::Text));
+
+    // The items compute their geometry from the row view of the tile, so the view of the timeline is left alone
+    branch->drawItems(tilePainter, tileRowView(tileIndex), 0, branchHeight);
 }
 
-void acTimeline::paintEvent(QPaintEvent* /* event */)
+acTimelineRowView acTimeline::tileRowView(qint64 tileIndex) const
 {
-    int rw = rowWidth();
-    int curHeight = height();
-    int topSpace = timelineSectionTopSpace();
+    acTimelineRowView retVal;
 
-    int yOffset = topSpace - m_nVOffset;
-    QPainter painter(this);
+    retVal.m_timeTransform.set(m_nStartTime, m_nFullRange, m_nRenderWidth, tileIndex * AC_TIMELINE_TILE_WIDTH);
+    retVal.m_nVisibleStartTime = retVal.m_timeTransform.xToTime(0);
+    retVal.m_nVisibleRange = retVal.m_timeTransform.xToTime(AC_TIMELINE_TILE_WIDTH) - retVal.m_nVisibleStartTime;
+    retVal.m_nLeft = 0;
+    retVal.m_nWidth = AC_TIMELINE_TILE_WIDTH;
+    retVal.m_nMaskLeft = 0;
+    retVal.m_bIsTiled = true;
+    retVal.m_bPaintLabels = false;
 
-    int totalHeight = curHeight - topSpace;
+    return retVal;
+}
 
-    if (m_pHScrollBar != NULL && m_pHScrollBar->isVisible())
+void acTimeline::drawItemOverlays(QPainter& painter)
+{
+    if (m_pSelectedItem != nullptr)
     {
-        totalHeight -= m_pHScrollBar->height();
+        drawItemOverlay(painter, m_pSelectedItem);
     }
 
-    painter.setClipRect(0, topSpace, width(), totalHeight);
-
-    // draw branches
-    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    if (!m_bStartDrag && m_mouseLocation.x() >= m_nTitleWidth)
     {
-        if ((*i)->IsVisible() == true)
+        acTimelineItem* hoveredItem = getTimelineItem(m_mouseLocation.x(), m_mouseLocation.y());
+
+        if (hoveredItem != nullptr && hoveredItem != m_pSelectedItem)
         {
-            (*i)->draw(painter, yOffset);
+            drawItemOverlay(painter, hoveredItem);
         }
     }
+}
 
-    // draw markers
-    for (QList<TimelineMarker*>::const_iterator i = m_markers.begin(); i != m_markers.end(); ++i)
-    {
-        TimelineMarker* marker = *i;
+void acTimeline::drawItemOverlay(QPainter& painter, acTimelineItem* item)
+{
+    acTimelineBranch* rowBranch = item->parentBranch();
 
-        if (marker->m_nTimeStamp >= m_nVisibleStartTime && marker->m_nTimeStamp <= m_nVisibleStartTime + m_nVisibleRange)
-        {
-            QPen pen = painter.pen();
-            pen.setColor(marker->m_color);
-            painter.setPen(pen);
-            int xPos = m_nTitleWidth + getXCoordOfTime(marker->m_nTimeStamp);
-            painter.drawLine(QPoint(xPos, topSpace), QPoint(xPos, curHeight));
-        }
+    if (rowBranch == nullptr || !rowBranch->IsVisible())
+    {
+        return;
     }
 
-    // draw pivot line
-    if (m_showToolTip)
+    // When the items are painted one by one, the item already painted its own frame
+    if (!m_bTileCacheEnabled && !rowBranch->areItemRectsStale())
     {
-        if (m_dPivot >= 0 && rw > 0)
-        {
-            QPen pen = painter.pen();
-            pen.setColor(Qt::black);
-            painter.setPen(pen);
-            int xPos = m_nTitleWidth + (int)(rw * m_dPivot);
-            painter.drawLine(QPoint(xPos, topSpace), QPoint(xPos, curHeight));
-        }
+        return;
     }
 
-    // draw drag highlight rectangle
-    if (m_bStartDrag && m_bSelectDragging)
+    // the items of a folded branch are displayed on the row of its outermost folded parent
+    for (acTimelineBranch* pBranch = rowBranch->parentBranch(); pBranch != nullptr; pBranch = pBranch->parentBranch())
     {
-        int mouseX = m_mouseLocation.x();
-        int localTitleWidth = m_nTitleWidth;
-
-        QRect dragAreaRect;
-
-        if (mouseX > m_nStartDragX)
-        {
-            dragAreaRect.setX(m_nStartDragX);
-            dragAreaRect.setWidth(mouseX - m_nStartDragX);
-        }
-        else if (mouseX < localTitleWidth)
+        if (!pBranch->IsVisible())
         {
-            dragAreaRect.setX(localTitleWidth);
-            dragAreaRect.setWidth(m_nStartDragX - localTitleWidth);
+            return;
         }
-        else
+
+        if (pBranch->isFolded())
         {
-            dragAreaRect.setX(mouseX);
-            dragAreaRect.setWidth(m_nStartDragX - mouseX);
+            rowBranch = pBranch;
         }
+    }
 
-        dragAreaRect.setY(topSpace);
-        dragAreaRect.setHeight(height() - dragAreaRect.y());
-        QColor dragColor = palette().color(QPalette::Highlight);
-        dragColor.setAlpha(127);
-        painter.fillRect(dragAreaRect, dragColor);
+    int rowTop = rowBranch->top();
+
+    if (rowTop <= height() && rowTop + rowBranch->height() >= timelineSectionTopSpace())
+    {
+        painter.save();
+        painter.setClipRect(QRect(m_nTitleWidth, rowTop, rowWidth(), rowBranch->height()), Qt::IntersectClip);
+        item->drawOverlay(painter, rowTop, rowBranch->height());
+        painter.restore();
     }
 }
 
@@ -843,6 +1643,11 @@ void acTimeline::mouseMoveEvent(QMouseEvent* event)
     m_mouseLocation.setX(mouseX);
     m_mouseLocation.setY(mouseY);
 
+    if (m_pToolTipItem != nullptr && getTimelineItem(mouseX, mouseY) != m_pToolTipItem)
+    {
+        dropToolTipRequest();
+    }
+
     if (m_bStartDrag)
     {
         m_bSelectDragging = (event->modifiers() & Qt::ControlModifier) != 0;
@@ -941,6 +1746,8 @@ void acTimeline::mouseDoubleClickEvent(QMouseEvent* event)
 
 void acTimeline::leaveEvent(QEvent* /* event */)
 {
+    dropToolTipRequest();
+
     // clear the mouse location when the mouse leaves the control
     m_mouseLocation.setX(-1);
     m_mouseLocation.setY(-1);
@@ -1103,6 +1910,27 @@ void acTimeline::resizeEvent(QResizeEvent* pEvent)
     QWidget::resizeEvent(pEvent);
 }
 
+void acTimeline::changeEvent(QEvent* event)
+{
+    if (event != nullptr)
+    {
+        QEvent::Type eventType = event->type();
+
+        // the tiles are rendered with the widget font and faded when the widget is disabled
+        if (eventType == QEvent::EnabledChange || eventType == QEvent::FontChange || eventType == QEvent::PaletteChange)
+        {
+            clearTileCache();
+        }
+
+        if (eventType == QEvent::FontChange)
+        {
+            m_labelCache.setFont(font());
+        }
+    }
+
+    QWidget::changeEvent(event);
+}
+
 void acTimeline::setZoomFactor(const double newZoomFactor)
 {
     double localZoomFactor = newZoomFactor;
@@ -1129,6 +1957,10 @@ void acTimeline::setZoomFactor(const double newZoomFactor)
             m_bScaleHScrollbar = false;
         }
 
+        // the tiles being rasterized are stale now.  Cancel them right away rather than on the next paint, as the user may keep
+        // zooming (userZoom) faster than the timeline is painted
+        m_tileRenderer.cancel();
+
         double inverseZoomFactor = 1 / m_dZoomFactor;
 
         setOffset((qint64)((m_dZoomPivot - (m_dPivot * inverseZoomFactor)) * m_nRenderWidth));
@@ -1386,6 +2218,11 @@ void acTimeline::zoomToSelectedArea(int mouseUpX)
     double timelineFractionStart = getFractionOfFullTimeline(fractionStart);
     double timelineFractionEnd = getFractionOfFullTimeline(fractionEnd);
 
+    if (m_bSelectionStatsEnabled)
+    {
+        computeRangeStats(m_nStartTime + (quint64)(timelineFractionStart * m_nFullRange), m_nStartTime + (quint64)(timelineFractionEnd * m_nFullRange));
+    }
+
     // compute zoom factor
     double selectedRange = timelineFractionEnd - timelineFractionStart;
     double zoomFactor = 1.0f / selectedRange;
@@ -1519,7 +2356,15 @@ void acTimeline::branchRangeChanged()
     // Update Range
     if (branch->endTime() - m_nStartTime > m_nFullRange)
     {
-        setFullRange(branch->endTime() - m_nStartTime);
+        quint64 newFullRange = branch->endTime() - m_nStartTime;
+
+        // when the whole timeline is displayed, leave room for the items streamed in later (a zoomed in timeline keeps its time per pixel instead)
+        if (m_bStreamingMode && m_dZoomFactor <= 1.0)
+        {
+            newFullRange += newFullRange / ACTIMELINE_StreamingRangeHeadroomDivisor;
+        }
+
+        setFullRange(newFullRange);
         updateGrid();
     }
 
@@ -1537,19 +2382,149 @@ void acTimeline::branchRangeChanged()
 void acTimeline::branchAdded(acTimelineBranch* subBranch)
 {
     connectSlotsToBranchSignals(subBranch);
+    addBranchRows(subBranch);
+    m_bBranchTextIndexInvalid = true;
     updateScrollBars(QFlags<Qt::Orientation>(Qt::Vertical));
-    resetRowIndex();
     recalcTitleWidth();
     update();
 }
 
+void acTimeline::branchItemsAdded(int /* count */)
+{
+    // the branch already cleared its own draw cache and updated its range, so only the scroll bars and the view need updating (once per batch)
+    updateScrollBars(QFlags<Qt::Orientation>(Qt::Horizontal));
+    update();
+}
+
+void acTimeline::tilesRendered()
+{
+    QList<acTimelineTileRenderer::Result> results = m_tileRenderer.takeResults();
+    bool areTilesCached = true;
+
+    for (QList<acTimelineTileRenderer::Result>::const_iterator i = results.begin(); i != results.end(); ++i)
+    {
+        areTilesCached = m_tileCache.insert((*i).m_pBranch, (*i).m_nTileIndex, (*i).m_nHeight, (*i).m_image) && areTilesCached;
+    }
+
+    if (!areTilesCached)
+    {
+        // otherwise the next paint would submit the same tiles again, endlessly
+        tileCacheOverflowed();
+    }
+
+    if (!results.isEmpty())
+    {
+        update();
+    }
+}
+
+void acTimeline::rangeStatsFinished()
+{
+    quint64 rangeStart = 0;
+    quint64 rangeEnd = 0;
+    QVector<acTimelineBranchRangeStats> stats;
+
+    // the request may have been cancelled or replaced after the notification was posted
+    if (m_rangeStatsCalculator.takeResults(rangeStart, rangeEnd, stats))
+    {
+        emit rangeStatsComputed(rangeStart, rangeEnd, stats);
+    }
+}
+
+void acTimeline::toolTipTimerFired()
+{
+    QPoint mousePos = mapFromGlobal(QCursor::pos());
+
+    // the item may have been scrolled or zoomed away from the mouse while the timer was running
+    if (m_pToolTipItem == nullptr || getTimelineItem(mousePos.x(), mousePos.y()) != m_pToolTipItem)
+    {
+        dropToolTipRequest();
+        return;
+    }
+
+    QElapsedTimer tooltipTimer;
+
+    if (m_bFrameStatsEnabled)
+    {
+        tooltipTimer.start();
+    }
+
+    // the worker thread cannot read the item, so the times and text of the item are copied here and the worker builds the rows.
+    // Items with their own tooltip rows are read here, and the worker only formats them
+    if (m_pToolTipItem->hasDefaultToolTip())
+    {
+        acTimelineToolTipBuilder::ItemSnapshot snapshot;
+        snapshot.m_strText = m_pToolTipItem->text();
+        snapshot.m_nStartTime = m_pToolTipItem->startTime();
+        snapshot.m_nEndTime = m_pToolTipItem->endTime();
+        snapshot.m_nTimelineStartTime = startTime();
+
+        if (m_bFrameStatsEnabled)
+        {
+            m_currentFrameStats.m_nTooltipLayoutNs += tooltipTimer.nsecsElapsed();
+        }
+
+        m_toolTipBuilder.submit(m_pToolTipItem, snapshot);
+    }
+    else
+    {
+        acTimelineItemToolTip tooltip;
+        m_pToolTipItem->tooltipItems(tooltip);
+
+        acTimelineToolTipBuilder::Content content;
+        acTimelineToolTipBuilder::getContent(tooltip, content);
+
+        if (m_bFrameStatsEnabled)
+        {
+            m_currentFrameStats.m_nTooltipLayoutNs += tooltipTimer.nsecsElapsed();
+        }
+
+        m_toolTipBuilder.submit(m_pToolTipItem, content);
+    }
+}
+
+void acTimeline::toolTipBuilt()
+{
+    const acTimelineItem* pItem = nullptr;
+    QString tooltipText;
+
+    // the request may have been dropped after the notification was posted
+    if (m_toolTipBuilder.takeResult(pItem, tooltipText) && pItem == m_pToolTipItem)
+    {
+        QPoint mousePos = mapFromGlobal(QCursor::pos());
+
+        if (getTimelineItem(mousePos.x(), mousePos.y()) == m_pToolTipItem)
+        {
+            m_toolTipBuilder.cache(m_pToolTipItem, tooltipText);
+            QToolTip::showText(m_toolTipPos, tooltipText);
+        }
+
+        m_pToolTipItem = nullptr;
+    }
+}
+
+void acTimeline::dropToolTipRequest()
+{
+    m_toolTipTimer.stop();
+    m_toolTipBuilder.cancel();
+    m_pToolTipItem = nullptr;
+}
+
 void acTimeline::branchTextChanged()
 {
+    m_bBranchTextIndexInvalid = true;
     recalcTitleWidth();
 }
 
 void acTimeline::branchFoldedChanged()
 {
+    acTimelineBranch* branch = qobject_cast<acTimelineBranch*>(sender());
+
+    if (branch != nullptr)
+    {
+        updateBranchRow(branch);
+    }
+
     updateScrollBars(QFlags<Qt::Orientation>(Qt::Vertical));
 }
 
@@ -1587,11 +2562,16 @@ void acTimeline::vScrollBarValueChanged(int value)
 
 void acTimeline::resetRowIndex()
 {
-    unsigned int index = 0;
+    // the row indices are assigned when the rows are laid out again, on the next lookup
+    m_bRowLayoutInvalid = true;
+}
 
-    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+void acTimeline::addBranchRows(acTimelineBranch* branch)
+{
+    // branches are usually added after the existing ones, so their rows are appended instead of laying out all the rows again
+    if (!m_bRowLayoutInvalid && !m_rowLayout.appendBranch(branch))
     {
-        (*i)->resetRowIndex(index);
+        resetRowIndex();
     }
 }
 
@@ -1754,12 +2734,10 @@ int acTimeline::TimeToPixel(double timeValue, bool checkBounds)
 
     int drawingWidth = rowWidth();
 
-    // calculate drawing pixels
-    double drawingPixel = visibleRange() / (drawingWidth * 1.0);
-
     if (m_pGrid != nullptr)
     {
-        retPixel = (int)((timeValue - m_pGrid->visibleStartTime()) / drawingPixel);
+        // the grid times are relative to the start of the timeline
+        retPixel = acTimelineTimeTransform::clampToPixel(timeTransform().timeOffsetToX(timeValue));
 
         if (checkBounds)
         {
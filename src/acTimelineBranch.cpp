@@ -1,4 +1,4 @@
-//==================================================================================
+﻿//==================================================================================
 // Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
 //
 /// \author AMD Developer Tools Team
@@ -9,11 +9,15 @@
 #include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
 #include <QPainter>
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 
 #include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemBatch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineRangeStats.h>
 
 acTimelineBranch::acTimelineBranch() : QObject(),
     m_strText(""),
@@ -23,10 +27,10 @@ acTimelineBranch::acTimelineBranch() : QObject(),
     m_nEndTime(std::numeric_limits<quint64>::min()),
     m_bFolded(false),
     m_bSelected(false),
-    m_bSorted(true),
     m_nTitleWidth(0),
     m_nDepth(0),
     m_nRowIndex(0),
+    m_nId(-1),
     m_nTop(0),
     m_bHeightSet(false),
     m_nHeight(0),
@@ -34,6 +38,12 @@ acTimelineBranch::acTimelineBranch() : QObject(),
     m_bMaskEnabled(true),
     m_bVisible(true),
     m_pMask(new(std::nothrow) acTimelineMaskBuffer()),
+    m_bItemIndexInvalid(false),
+    m_bItemTextIndexInvalid(false),
+    m_bSummaryPyramidInvalid(true),
+    m_bItemRectsStale(false),
+    m_pCompactItemProxy(nullptr),
+    m_nTraceTextIndexGeneration(0),
     m_shouldDrawChildren(false)
 {
     Q_ASSERT(m_pMask != nullptr);
@@ -58,6 +68,25 @@ acTimelineBranch::~acTimelineBranch()
 
     m_timelineItems.clear();
 
+    // free the items created for compact items
+    for (QMap<int, acTimelineItem*>::iterator i = m_compactTimelineItems.begin(); i != m_compactTimelineItems.end(); ++i)
+    {
+        delete i.value();
+        i.value() = nullptr;
+    }
+
+    m_compactTimelineItems.clear();
+
+    for (QMap<qint64, acTimelineItem*>::iterator i = m_traceTimelineItems.begin(); i != m_traceTimelineItems.end(); ++i)
+    {
+        delete i.value();
+        i.value() = nullptr;
+    }
+
+    m_traceTimelineItems.clear();
+    delete m_pCompactItemProxy;
+    m_pCompactItemProxy = nullptr;
+
     // free all branches and clear the list
     for (QList<acTimelineBranch*>::iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
     {
@@ -83,6 +112,8 @@ void acTimelineBranch::setParentTimeline(acTimeline* newParentTimeline)
 
     if (m_pParentTimeline != nullptr)
     {
+        m_nId = m_pParentTimeline->registerBranch(this);
+
         if (!m_bHeightSet)
         {
             m_nHeight = m_pParentTimeline->defaultBranchHeight();
@@ -154,6 +185,17 @@ unsigned int acTimelineBranch::rowCount() const
     return totalCount;
 }
 
+unsigned int acTimelineBranch::rowIndex() const
+{
+    // the row indices are assigned when the parent timeline lays out its rows
+    if (m_pParentTimeline != nullptr)
+    {
+        m_pParentTimeline->updateRowLayout();
+    }
+
+    return m_nRowIndex;
+}
+
 void acTimelineBranch::resetRowIndex(unsigned int& rowIndex)
 {
     m_nRowIndex = rowIndex++;
@@ -183,10 +225,25 @@ void acTimelineBranch::setHeight(const int newHeight)
 {
     m_bHeightSet = true;
     m_nHeight = newHeight;
+
+    if (m_pParentTimeline != nullptr)
+    {
+        m_pParentTimeline->updateBranchRow(this);
+    }
 }
 
 int acTimelineBranch::cumulativeHeight() const
 {
+    if (m_pParentTimeline != nullptr)
+    {
+        const acTimelineRowLayout& rowLayout = m_pParentTimeline->rowLayout();
+
+        if (rowLayout.contains(this))
+        {
+            return rowLayout.subtreeHeight(this);
+        }
+    }
+
     if (!allParentsUnfolded())
     {
         return 0;
@@ -254,35 +311,8 @@ acTimelineItem* acTimelineBranch::getTimelineItem(const acTimelineBranch* branch
             }
         }
 
-        // Not found? search our own cached items
-        QList<acTimelineItem*> itemsToCheck;
-
-        if (branch->m_drawCache.count() > 0)
-        {
-            itemsToCheck = branch->m_drawCache;
-        }
-        else
-        {
-            itemsToCheck = branch->m_timelineItems;
-        }
-
-        acTimelineItem* retVal = nullptr;
-
-        // iterate backwards to get overlapped items correctly in a sorted branch
-        for (int i = itemsToCheck.size() - 1; i >= 0; --i)
-        {
-            retVal = itemsToCheck[i];
-
-            if (retVal->isVisible())
-            {
-                QRect rect = retVal->drawRectangle();
-
-                if (x >= rect.x() && x <= rect.x() + rect.width() && y >= rect.y() && y < rect.y() + rect.height())
-                {
-                    return retVal;
-                }
-            }
-        }
+        // Not found? search our own items
+        return branch->getOwnTimelineItem(x, y);
     }
 
     return nullptr;
@@ -297,11 +327,11 @@ void acTimelineBranch::recalcTitleWidth()
                         m_pParentTimeline->titleSectionLeftSpace() + m_pParentTimeline->titleSectionRightSpace() + // take into account the parent's left margin space
                         m_pParentTimeline->fontMetrics().width(m_strText);                                         // take into account this branch's text
 
+        // the sub branches update their own title width whenever it changes, so only their cached widths are needed here
         for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
         {
             if ((*i)->IsVisible() == true)
             {
-                (*i)->recalcTitleWidth();
                 int childWidth = (*i)->titleWidth();
 
                 if (childWidth > m_nTitleWidth)
@@ -317,6 +347,14 @@ void acTimelineBranch::recalcTitleWidth()
     }
 }
 
+void acTimelineBranch::growTitleWidth(const acTimelineBranch* subBranch)
+{
+    if (m_pParentTimeline != nullptr && subBranch != nullptr && subBranch->IsVisible() && subBranch->titleWidth() > m_nTitleWidth)
+    {
+        m_nTitleWidth = subBranch->titleWidth();
+    }
+}
+
 int acTimelineBranch::itemCount() const
 {
     return m_timelineItems.count();
@@ -341,267 +379,1227 @@ acTimelineItem* acTimelineBranch::getTimelineItem(const int x, const int y) cons
     }
     else
     {
-        acTimelineItem* retVal = nullptr;
+        return getOwnTimelineItem(x, y);
+    }
+}
+
+acTimelineItem* acTimelineBranch::getOwnTimelineItem(const int x, const int y) const
+{
+    if (m_pParentTimeline == nullptr)
+    {
+        return nullptr;
+    }
 
+    // Only look at the items overlapping the time under the mouse.  Items are at least one pixel wide (dots and lines are two pixels wide),
+    // so include a few pixels to the left of the mouse position to catch short items whose painted rectangle was widened
+    const static int hitTestPixelSlack = 3;
+    int timelineX = x - m_pParentTimeline->titleWidth();
+    quint64 rangeStart = m_pParentTimeline->getTimeOfXCoord(timelineX - hitTestPixelSlack);
+    quint64 rangeEnd = m_pParentTimeline->getTimeOfXCoord(timelineX + 1);
 
-        // Not found? search our own cached items
-        QList<acTimelineItem*> itemsToCheck;
+    acTimelineItem* retVal = nullptr;
+    int firstPos = 0;
+    int lastPos = 0;
 
-        if (m_drawCache.count() > 0)
-        {
-            itemsToCheck = m_drawCache;
-        }
-        else
+    if (m_bItemRectsStale)
+    {
+        // Items were painted as aggregated bars or from the tile cache, so their rectangles are stale.  Match by time instead, picking the latest item under the mouse
+        if (m_itemsRowRect.contains(x, y) && findItemsInRange(rangeStart, rangeEnd, firstPos, lastPos))
         {
-            itemsToCheck = m_timelineItems;
+            for (int pos = lastPos - 1; pos >= firstPos && retVal == nullptr; --pos)
+            {
+                if (m_itemIndex.endTime(pos) >= rangeStart)
+                {
+                    retVal = itemAtSortedPos(pos);
+                }
+            }
         }
-
-        // iterate backwards to get overlapped items correctly in a sorted branch
-        for (int i = itemsToCheck.size() - 1; i >= 0; --i)
+    }
+    else if (findItemsInRange(rangeStart, rangeEnd, firstPos, lastPos))
+    {
+        // iterate backwards to get overlapped items correctly (items are sorted by start time)
+        for (int pos = lastPos - 1; pos >= firstPos; --pos)
         {
-            retVal = itemsToCheck[i];
+            acTimelineItem* item = itemAtSortedPos(pos);
 
-            if (retVal->isVisible())
+            if (item->isVisible())
             {
-                QRect rect = retVal->drawRectangle();
+                QRect rect = item->drawRectangle();
 
                 if (x >= rect.x() && x <= rect.x() + rect.width() && y >= rect.y() && y < rect.y() + rect.height())
                 {
-                    return retVal;
+                    retVal = item;
+                    break;
                 }
             }
         }
-
-        return nullptr;
     }
-}
-
-int acTimelineBranch::indexOfItem(acTimelineItem* item) const
-{
-    return m_timelineItems.indexOf(item);
-}
 
-acTimelineBranch* acTimelineBranch::getSubBranchFromRowIndex(const unsigned int rowIndex) const
-{
-    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    // Compact items have no rectangles of their own, so they are always matched by time.  The latest item under the mouse wins
+    if (m_compactItems.count() > 0 && m_itemsRowRect.contains(x, y))
     {
-        if ((*i)->m_nRowIndex == rowIndex)
-        {
-            return *i;
-        }
+        m_compactItemIndex.build();
 
-        if ((*i)->m_nRowIndex < rowIndex && (*i)->m_nRowIndex + (*i)->rowCount() > rowIndex)
+        if (m_compactItemIndex.findOverlapping(rangeStart, rangeEnd, firstPos, lastPos))
         {
-            return (*i)->getSubBranchFromRowIndex(rowIndex);
+            for (int pos = lastPos - 1; pos >= firstPos; --pos)
+            {
+                if (m_compactItemIndex.endTime(pos) >= rangeStart)
+                {
+                    if (retVal == nullptr || m_compactItemIndex.startTime(pos) >= retVal->startTime())
+                    {
+                        retVal = getCompactTimelineItem(m_compactItemIndex.itemIndex(pos));
+                    }
+
+                    break;
+                }
+            }
         }
     }
 
-    return NULL;
-}
+    // Trace items are matched by time like compact items
+    qint64 traceFirstPos = 0;
+    qint64 traceLastPos = 0;
 
-acTimelineBranch* acTimelineBranch::getSubBranchFromText(const QString& branchText, bool partialMatch) const
-{
-    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    if (m_traceItems.count() > 0 && m_itemsRowRect.contains(x, y) && m_traceItems.findOverlapping(rangeStart, rangeEnd, traceFirstPos, traceLastPos))
     {
-        if ((*i)->IsVisible() == true)
+        for (qint64 pos = traceLastPos - 1; pos >= traceFirstPos; --pos)
         {
-            acTimelineBranch* branch = (*i);
-            QString thisBranchText = branch->text();
-
-            if (partialMatch)
-            {
-                if (thisBranchText.contains(branchText))
-                {
-                    return branch;
-                }
-            }
-            else
+            if (m_traceItems.endTime(pos) >= rangeStart)
             {
-                if (thisBranchText == branchText)
+                if (retVal == nullptr || m_traceItems.startTime(pos) >= retVal->startTime())
                 {
-                    return branch;
+                    retVal = getTraceTimelineItem(pos);
                 }
-            }
-
-            acTimelineBranch* subbranch = branch->getSubBranchFromText(branchText, partialMatch);
 
-            if (subbranch != nullptr)
-            {
-                return subbranch;
+                break;
             }
         }
     }
 
-    return nullptr;
+    return retVal;
 }
 
-acTimelineBranch* acTimelineBranch::getSubBranchFromY(const int y) const
+acTimelineItem* acTimelineBranch::getCompactTimelineItem(const int index) const
 {
-    int totalHeight = m_nHeight;
+    acTimelineItem* retVal = nullptr;
 
-    if (y < totalHeight)
+    if (index >= 0 && index < m_compactItems.count())
     {
-        return const_cast<acTimelineBranch*>(this);
-    }
+        retVal = m_compactTimelineItems.value(index, nullptr);
 
-    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
-    {
-        if ((*i)->IsVisible() == true)
+        if (retVal == nullptr)
         {
-            int branchHeight = (*i)->cumulativeHeight();
+            retVal = new(std::nothrow) acTimelineItem(0, 0);
+            Q_ASSERT(retVal != nullptr);
 
-            if (totalHeight + branchHeight > y)
+            if (retVal != nullptr)
             {
-                return (*i)->getSubBranchFromY(y - totalHeight);
+                retVal->setParentBranch(const_cast<acTimelineBranch*>(this));
+                retVal->setFromCompactItem(m_compactItems.item(index));
+                m_compactTimelineItems.insert(index, retVal);
             }
-
-            totalHeight += branchHeight;
         }
     }
 
-    return NULL;
+    return retVal;
 }
 
-bool acTimelineBranch::addTimelineItem(acTimelineItem* item)
+void acTimelineBranch::setTraceItems(const acTimelineTraceItems& traceItems)
 {
-    if (item == nullptr)
+    for (QMap<qint64, acTimelineItem*>::iterator i = m_traceTimelineItems.begin(); i != m_traceTimelineItems.end(); ++i)
     {
-        return false;
+        delete i.value();
+        i.value() = nullptr;
+    }
+
+    m_traceTimelineItems.clear();
+    m_traceItems = traceItems;
+    m_traceItemsByTextId.clear();
+    m_traceTextIdOffsets.clear();
+    m_nTraceTextIndexGeneration = 0;
+    invalidateTiles();
+
+    if (m_traceItems.count() > 0)
+    {
+        // the running maximum of the end times holds the end of the last item to end
+        extendRange(m_traceItems.startTime(0), m_traceItems.maxEndTime(m_traceItems.count() - 1));
     }
+}
+
+acTimelineItem* acTimelineBranch::getTraceTimelineItem(qint64 pos) const
+{
+    acTimelineItem* retVal = nullptr;
 
-    // when items are added, keep track if this branch remains sorted
-    if (m_bSorted && m_timelineItems.size() > 0)
+    if (pos >= 0 && pos < m_traceItems.count())
     {
-        quint64 lastItemStartTime = m_timelineItems.last()->startTime();
+        retVal = m_traceTimelineItems.value(pos, nullptr);
 
-        if (lastItemStartTime > 0 && item->startTime() < lastItemStartTime)
+        if (retVal == nullptr)
         {
-            m_bSorted = false;
+            retVal = new(std::nothrow) acTimelineItem(0, 0);
+            Q_ASSERT(retVal != nullptr);
+
+            if (retVal != nullptr)
+            {
+                retVal->setParentBranch(const_cast<acTimelineBranch*>(this));
+                retVal->setFromTraceItem(m_traceItems, pos);
+                m_traceTimelineItems.insert(pos, retVal);
+            }
         }
     }
 
-    item->setParentBranch(this);
-    m_timelineItems.push_back(item);
-
-    emit branchItemAdded(item);
+    return retVal;
+}
 
-    bool rangeChanged = false;
+void acTimelineBranch::getItemsInRange(quint64 rangeStart, quint64 rangeEnd, acTimelineRangeItems& items) const
+{
+    int firstPos = 0;
+    int lastPos = 0;
 
-    if (m_nStartTime > item->startTime() || (m_nStartTime == std::numeric_limits<quint64>::max()))
+    // the item index narrows the copy down to the items which may overlap the range
+    if (findItemsInRange(rangeStart, rangeEnd, firstPos, lastPos))
     {
-        m_nStartTime = item->startTime();
-        rangeChanged = true;
+        for (int pos = firstPos; pos < lastPos; ++pos)
+        {
+            if (m_itemIndex.endTime(pos) >= rangeStart)
+            {
+                acTimelineItem* item = itemAtSortedPos(pos);
+                items.m_startTimes.append(item->startTime());
+                items.m_endTimes.append(item->endTime());
+                items.m_texts.append(item->text());
+            }
+        }
     }
 
-    if (item->endTime() > m_nEndTime || (m_nEndTime == std::numeric_limits<quint64>::min()))
-    {
-        m_nEndTime = item->endTime();
-        rangeChanged = true;
-    }
+    // the compact item vectors are shared with the snapshot until the branch changes them
+    m_compactItemIndex.build();
+    items.m_compactItems = m_compactItems;
+    items.m_compactItemIndex = m_compactItemIndex;
+    items.m_traceItems = m_traceItems;
+}
 
-    if (rangeChanged)
+void acTimelineBranch::ensureItemIndex() const
+{
+    if (m_bItemIndexInvalid)
     {
-        emit branchRangeChanged();
+        m_itemIndex.clear();
+        m_itemIndex.reserve(m_timelineItems.count());
+
+        for (QList<acTimelineItem*>::const_iterator i = m_timelineItems.begin(); i != m_timelineItems.end(); ++i)
+        {
+            m_itemIndex.append((*i)->startTime(), (*i)->endTime());
+        }
+
+        m_bItemIndexInvalid = false;
     }
 
-    return true;
+    m_itemIndex.build();
 }
 
-bool acTimelineBranch::addSubBranch(acTimelineBranch* subBranch)
+void acTimelineBranch::ensureSummaryPyramid() const
 {
-    if (subBranch == nullptr)
+    if (m_bSummaryPyramidInvalid)
     {
-        return false;
-    }
+        ensureItemIndex();
+        m_compactItemIndex.build();
 
-    connect(subBranch, SIGNAL(branchRangeChanged()),
-            this, SLOT(subBranchRangeChanged()));
-    connect(subBranch, SIGNAL(branchAdded(acTimelineBranch*)),
-            this, SLOT(subBranchAdded(acTimelineBranch*)));
-    connect(subBranch, SIGNAL(branchTextChanged()),
-            this, SLOT(subBranchTextChanged()));
+        int count = m_itemIndex.count();
+        int compactCount = m_compactItemIndex.count();
+        quint64 endTime = m_nEndTime;
+        int bucketItemCount = count + compactCount;
 
-    subBranch->setParentTimeline(this->parentTimeline());
-    subBranch->setDepth(this->m_nDepth + 1);
+        // In streaming mode, leave room for the items streamed in later, so that they are summarized in place (see summarizeAddedItem)
+        // until the time range of the branch doubles.  The pyramid is then rebuilt a logarithmic number of times as the session grows
+        if (isStreaming() && m_nEndTime > m_nStartTime)
+        {
+            endTime = m_nEndTime + (m_nEndTime - m_nStartTime);
+            bucketItemCount *= 2;
+        }
 
-    bool rangeChanged = false;
+        m_summaryPyramid.begin(m_nStartTime, endTime, bucketItemCount);
 
-    if (m_nStartTime > subBranch->m_nStartTime)
-    {
-        m_nStartTime = subBranch->m_nStartTime;
-        rangeChanged = true;
-    }
+        // merge the items and the compact items in order of their start time
+        int pos = 0;
+        int compactPos = 0;
 
-    if (subBranch->m_nEndTime > m_nEndTime)
-    {
-        m_nEndTime = subBranch->m_nEndTime;
-        rangeChanged = true;
+        while (pos < count || compactPos < compactCount)
+        {
+            if (compactPos >= compactCount || (pos < count && m_itemIndex.startTime(pos) <= m_compactItemIndex.startTime(compactPos)))
+            {
+                m_summaryPyramid.addItem(m_itemIndex.startTime(pos), m_itemIndex.endTime(pos), itemAtSortedPos(pos)->backgroundColor().rgba());
+                ++pos;
+            }
+            else
+            {
+                m_summaryPyramid.addItem(m_compactItemIndex.startTime(compactPos), m_compactItemIndex.endTime(compactPos), m_compactItems.backgroundColor(m_compactItemIndex.itemIndex(compactPos)));
+                ++compactPos;
+            }
+        }
+
+        m_summaryPyramid.finish();
+        m_bSummaryPyramidInvalid = false;
     }
+}
 
-    if (rangeChanged)
+bool acTimelineBranch::drawAggregatedItems(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, int firstPos, int lastPos, int compactFirstPos, int compactLastPos, int alpha)
+{
+    int rowWidth = view.m_nWidth;
+    const acTimelineTimeTransform& timeTransform = view.m_timeTransform;
+
+    if (rowWidth <= 0 || (lastPos - firstPos) + (compactLastPos - compactFirstPos) == 0)
     {
-        emit branchRangeChanged();
+        return false;
     }
 
-    m_subBranches.push_back(subBranch);
+    ensureItemIndex();
+    m_compactItemIndex.build();
 
-    subBranch->m_pParentBranch = this;
+    if (m_itemIndex.count() + m_compactItemIndex.count() <= timeTransform.durationToWidth(m_nEndTime - m_nStartTime))
+    {
+        return false;
+    }
 
-    recalcTitleWidth();
+    quint64 visibleStartTime = view.m_nVisibleStartTime;
+    quint64 visibleEndTime = view.visibleEndTime();
+    double pixelDuration = timeTransform.timePerPixel();
 
-    emit branchAdded(subBranch);
+    ensureSummaryPyramid();
 
-    return true;
-}
+    if (m_summaryPyramid.meanDuration() >= pixelDuration)
+    {
+        return false;
+    }
 
-void acTimelineBranch::subBranchRangeChanged()
-{
-    bool rangeChanged = false;
+    int level = m_summaryPyramid.levelForResolution(pixelDuration);
 
-    acTimelineBranch* branch = qobject_cast<acTimelineBranch*>(sender());
+    if (level < 0)
+    {
+        return false;
+    }
 
-    if (m_nStartTime > branch->startTime())
+    if (!m_pParentTimeline->isEnabled())
     {
-        m_nStartTime = branch->startTime();
-        rangeChanged = true;
+        alpha = 32;
     }
 
-    if (branch->endTime() > m_nEndTime)
+    int titleWidth = view.m_nLeft;
+    int barTop = branchRowTop + 1;
+    int barHeight = branchHeight - 2;
+    quint64 bucketDuration = m_summaryPyramid.bucketDuration(level);
+    // start from the earliest visible item, which may start before the visible time window
+    quint64 firstStartTime = visibleStartTime;
+
+    if (firstPos < lastPos)
     {
-        m_nEndTime = branch->endTime();
-        rangeChanged = true;
+        firstStartTime = qMin(firstStartTime, m_itemIndex.startTime(firstPos));
     }
 
-    if (rangeChanged)
+    if (compactFirstPos < compactLastPos)
     {
-        emit branchRangeChanged();
+        firstStartTime = qMin(firstStartTime, m_compactItemIndex.startTime(compactFirstPos));
     }
-}
 
-void acTimelineBranch::subBranchAdded(acTimelineBranch* subBranch)
-{
-    emit branchAdded(subBranch);
-    recalcTitleWidth();
-}
+    int firstBucket = m_summaryPyramid.bucketIndex(level, firstStartTime);
+    int lastBucket = m_summaryPyramid.bucketIndex(level, visibleEndTime);
 
-void acTimelineBranch::subBranchTextChanged()
-{
-    emit branchTextChanged();
-    recalcTitleWidth();
-}
+    // Start from the first bucket of the pixel column of the first bucket, so that the column merges the same buckets whatever the
+    // painted area is (the buckets ending before the area are merged too, though only the buckets reaching it can be painted)
+    int firstColumnX = timeTransform.timeToColumn(m_summaryPyramid.startTime() + bucketDuration * firstBucket);
 
-void acTimelineBranch::zoomFactorOrOffsetChanged()
-{
-    clearDrawCache(false);
-}
+    while (firstBucket > 0 && timeTransform.timeToColumn(m_summaryPyramid.startTime() + bucketDuration * (firstBucket - 1)) == firstColumnX)
+    {
+        firstBucket--;
+    }
 
-void acTimelineBranch::draw(QPainter& painter, int& yOffset)
-{
-    m_nTop = yOffset;
-    yOffset += m_nHeight;
+    // Merge the buckets starting in the same pixel column into a single bar painted with the most dominant color
+    bool hasColumn = false;
+    int columnX = 0;
+    int columnRight = 0;
+    QRgb columnColor = 0;
+    quint64 columnColorDuration = 0;
+    acTimelineFrameStats* pStats = view.m_bPaintBackgrounds ? m_pParentTimeline->frameStats() : nullptr;
 
-    // Draw subbranches first, so that we can easily cull away branches whose parent is folded
-    if (!m_bFolded)
+    for (int i = firstBucket; i <= lastBucket + 1; ++i)
+    {
+        bool isLast = (i > lastBucket);
+        int x = 0;
+        int right = 0;
+        const acTimelineItemSummaryPyramid::Bucket* pBucket = nullptr;
+
+        if (!isLast)
+        {
+            pBucket = &m_summaryPyramid.bucket(level, i);
+
+            if (pBucket->m_count == 0)
+            {
+                continue;
+            }
+
+            // the bars are not trimmed to the painted area, so that they have the same geometry in all areas
+            x = titleWidth + timeTransform.timeToColumn(m_summaryPyramid.startTime() + bucketDuration * i);
+            right = titleWidth + timeTransform.timeToColumn(pBucket->m_maxEndTime);
+        }
+
+        if (hasColumn && x == columnX && !isLast)
+        {
+            columnRight = qMax(columnRight, right);
+
+            if (pBucket->m_dominantColorDuration > columnColorDuration)
+            {
+                columnColor = pBucket->m_dominantColor;
+                columnColorDuration = pBucket->m_dominantColorDuration;
+            }
+        }
+        else
+        {
+            int columnWidth = qMax(1, columnRight - columnX);
+
+            // the columns merged out of the painted area (before the first bucket reaching it, or after the last one) are skipped
+            int paintedLeft = qMax(columnX, titleWidth);
+            int paintedRight = qMin(columnX + columnWidth, titleWidth + rowWidth);
+
+            if (hasColumn && paintedLeft < paintedRight)
+            {
+                if (view.m_bPaintBackgrounds)
+                {
+                    QColor barColor = QColor::fromRgba(columnColor);
+
+                    if (alpha != 255)
+                    {
+                        barColor.setAlpha(alpha);
+                    }
+
+                    painter.fillRect(QRect(paintedLeft, barTop, paintedRight - paintedLeft, barHeight), barColor);
+                }
+
+                int maskIndex = columnX - view.m_nMaskLeft;
+
+                if (m_bMaskEnabled && maskIndex >= 0 && maskIndex < view.maskWidth())
+                {
+                    // Mark the column with the geometry of a full height item, so that the items painted later on the same row
+                    // (trace items, or the items of a folded branch) are masked as if the summarized items were painted one by one
+                    m_pMask->setMask(maskIndex, QRect(columnX, branchRowTop + 1, columnWidth, branchHeight));
+                }
+
+                if (pStats != nullptr)
+                {
+                    pStats->m_nAggregatedBars++;
+                }
+            }
+
+            if (!isLast)
+            {
+                hasColumn = true;
+                columnX = x;
+                columnRight = right;
+                columnColor = pBucket->m_dominantColor;
+                columnColorDuration = pBucket->m_dominantColorDuration;
+            }
+        }
+    }
+
+    return true;
+}
+
+void acTimelineBranch::drawCompactItems(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, int firstPos, int lastPos, bool drawFaded, bool shouldUpdateGeometry)
+{
+    acTimelineItemBatch* pBatch = m_pParentTimeline->itemBatch();
+
+    for (int pos = firstPos; pos < lastPos; ++pos)
+    {
+        int index = m_compactItemIndex.itemIndex(pos);
+        acTimelineItem* item = m_compactTimelineItems.value(index, nullptr);
+
+        if (item == nullptr)
+        {
+            // No timeline item was created for this compact item, so paint it through the shared proxy item
+            item = compactItemProxy();
+
+            if (item == nullptr)
+            {
+                return;
+            }
+
+            item->setFromCompactItem(m_compactItems.item(index));
+        }
+
+        drawItem(painter, pBatch, item, view, branchRowTop, branchHeight, drawFaded, shouldUpdateGeometry);
+    }
+}
+
+void acTimelineBranch::drawTraceItems(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawFaded, bool shouldUpdateGeometry)
+{
+    quint64 visibleStartTime = view.m_nVisibleStartTime;
+    quint64 visibleEndTime = view.visibleEndTime();
+    int rowWidth = view.m_nWidth;
+    qint64 firstPos = 0;
+    qint64 lastPos = 0;
+
+    if (m_traceItems.count() == 0 || rowWidth <= 0 || !m_traceItems.findOverlapping(visibleStartTime, visibleEndTime, firstPos, lastPos))
+    {
+        return;
+    }
+
+    acTimelineItemBatch* pBatch = m_pParentTimeline->itemBatch();
+    const acTimelineTimeTransform& timeTransform = view.m_timeTransform;
+    qint64 paintedPos = -1;
+    int x = 0;
+
+    // Visit the pixel columns, and paint one item covering each column (at most one item is read per pixel column).  The latest item
+    // starting before the end of the column is the one the items would show if they were all painted in order of their start time.
+    // A painted item covers the columns up to its end, and only the items starting and ending within those columns are skipped
+    while (x < rowWidth)
+    {
+        quint64 columnStartTime = timeTransform.xToTime(x);
+        qint64 nextPos = m_traceItems.lowerBound(timeTransform.xToTime(x + 1), firstPos, lastPos);
+        qint64 pos = nextPos - 1;
+
+        if (pos < firstPos || m_traceItems.maxEndTime(pos) < columnStartTime)
+        {
+            // no item covers the column, skip to the column of the next item
+            if (nextPos >= lastPos)
+            {
+                break;
+            }
+
+            x = qMax(x + 1, timeTransform.timeToPixel(m_traceItems.startTime(nextPos)));
+            continue;
+        }
+
+        if (m_traceItems.endTime(pos) < columnStartTime)
+        {
+            // the latest item ended before the column, so the first item reaching the column covers it
+            pos = m_traceItems.lowerBoundMaxEndTime(columnStartTime, firstPos, pos);
+        }
+
+        quint64 startTime = m_traceItems.startTime(pos);
+        quint64 endTime = qMax(m_traceItems.endTime(pos), startTime);
+
+        // an item ending within a column may be found again for the next column
+        if (pos != paintedPos)
+        {
+            acTimelineItem* item = m_traceTimelineItems.value(pos, nullptr);
+
+            if (item == nullptr)
+            {
+                item = compactItemProxy();
+
+                if (item == nullptr)
+                {
+                    return;
+                }
+
+                item->setFromTraceItem(m_traceItems, pos);
+            }
+
+            drawItem(painter, pBatch, item, view, branchRowTop, branchHeight, drawFaded, shouldUpdateGeometry);
+
+            paintedPos = pos;
+        }
+
+        x = qMax(x + 1, timeTransform.timeToPixel(qMin(endTime, visibleEndTime)));
+    }
+}
+
+acTimelineItem* acTimelineBranch::compactItemProxy()
+{
+    if (m_pCompactItemProxy == nullptr)
+    {
+        m_pCompactItemProxy = new(std::nothrow) acTimelineItem(0, 0);
+        Q_ASSERT(m_pCompactItemProxy != nullptr);
+
+        if (m_pCompactItemProxy != nullptr)
+        {
+            m_pCompactItemProxy->setParentBranch(this);
+        }
+    }
+
+    return m_pCompactItemProxy;
+}
+
+void acTimelineBranch::drawItem(QPainter& painter, acTimelineItemBatch* pBatch, acTimelineItem* item, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawFaded, bool shouldUpdateGeometry)
+{
+    if (!view.m_bPaintBackgrounds)
+    {
+        // Only the labels are painted: skip the items which are too narrow for one.  A narrower item never masks a wider one,
+        // so this does not change which items are masked
+        if (!shouldUpdateGeometry || !m_pParentTimeline->labelCache().isTextVisibleInWidth((int)view.m_timeTransform.durationToWidth(item->endTime() - item->startTime())))
+        {
+            return;
+        }
+
+        pBatch = nullptr;
+    }
+
+    // the batch copies the colors and geometry of the item, so the shared compact item proxy can be batched too
+    if (pBatch == nullptr || !item->drawBatched(*pBatch, view, branchRowTop, branchHeight, !drawFaded, shouldUpdateGeometry, drawFaded))
+    {
+        item->draw(painter, view, branchRowTop, branchHeight, !drawFaded, shouldUpdateGeometry, drawFaded);
+    }
+}
+
+bool acTimelineBranch::findItemsInRange(quint64 rangeStart, quint64 rangeEnd, int& firstPos, int& lastPos) const
+{
+    ensureItemIndex();
+    return m_itemIndex.findOverlapping(rangeStart, rangeEnd, firstPos, lastPos);
+}
+
+bool acTimelineBranch::findVisibleItems(const acTimelineRowView& view, int& firstPos, int& lastPos) const
+{
+    firstPos = 0;
+    lastPos = 0;
+    bool retVal = false;
+
+    if (m_pParentTimeline != nullptr)
+    {
+        retVal = findItemsInRange(view.m_nVisibleStartTime, view.visibleEndTime(), firstPos, lastPos);
+    }
+
+    return retVal;
+}
+
+bool acTimelineBranch::findVisibleCompactItems(const acTimelineRowView& view, int& firstPos, int& lastPos) const
+{
+    firstPos = 0;
+    lastPos = 0;
+    bool retVal = false;
+
+    if (m_pParentTimeline != nullptr && m_compactItems.count() > 0)
+    {
+        m_compactItemIndex.build();
+        retVal = m_compactItemIndex.findOverlapping(view.m_nVisibleStartTime, view.visibleEndTime(), firstPos, lastPos);
+    }
+
+    return retVal;
+}
+
+int acTimelineBranch::indexOfItem(acTimelineItem* item) const
+{
+    return m_timelineItems.indexOf(item);
+}
+
+acTimelineBranch* acTimelineBranch::getSubBranchFromRowIndex(const unsigned int rowIndex) const
+{
+    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    {
+        if ((*i)->m_nRowIndex == rowIndex)
+        {
+            return *i;
+        }
+
+        if ((*i)->m_nRowIndex < rowIndex && (*i)->m_nRowIndex + (*i)->rowCount() > rowIndex)
+        {
+            return (*i)->getSubBranchFromRowIndex(rowIndex);
+        }
+    }
+
+    return NULL;
+}
+
+acTimelineBranch* acTimelineBranch::getSubBranchFromText(const QString& branchText, bool partialMatch) const
+{
+    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    {
+        if ((*i)->IsVisible() == true)
+        {
+            acTimelineBranch* branch = (*i);
+            QString thisBranchText = branch->text();
+
+            if (partialMatch)
+            {
+                if (thisBranchText.contains(branchText))
+                {
+                    return branch;
+                }
+            }
+            else
+            {
+                if (thisBranchText == branchText)
+                {
+                    return branch;
+                }
+            }
+
+            acTimelineBranch* subbranch = branch->getSubBranchFromText(branchText, partialMatch);
+
+            if (subbranch != nullptr)
+            {
+                return subbranch;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void acTimelineBranch::indexCompactTexts(acTimelineTextIndex& textIndex, QVector<int>& textIds) const
+{
+    // compact item strings are only ever added to the store, so only the new ones are indexed
+    for (int stringId = textIds.count(); stringId < m_compactItems.stringCount(); ++stringId)
+    {
+        textIds.append(textIndex.addText(m_compactItems.string(stringId)));
+    }
+}
+
+void acTimelineBranch::indexItemTexts(acTimelineTextIndex& textIndex, QVector<int>& textIds) const
+{
+    ensureItemTextIndex();
+
+    // as with the compact items, only the texts added since the previous call are indexed
+    for (int stringId = textIds.count(); stringId < m_itemTexts.count(); ++stringId)
+    {
+        textIds.append(textIndex.addText(m_itemTexts[stringId]));
+    }
+}
+
+/// Appends the earliest of the matching items of a branch to the search results.
+/// \param matches the start time and the index of each matching item.
+/// \param maxResults the maximum number of items appended.
+/// \param result the result appended for each item, with its branch and item kind set.
+/// \param[out] results the list the items are appended to, in order of their start time.
+static void acAppendEarliestSearchResults(QVector<QPair<quint64, int> >& matches, int maxResults, acTimelineSearchResult& result, QVector<acTimelineSearchResult>& results)
+{
+    if (matches.count() > maxResults)
+    {
+        std::nth_element(matches.begin(), matches.begin() + maxResults, matches.end());
+        matches.resize(maxResults);
+    }
+
+    std::sort(matches.begin(), matches.end());
+
+    for (QVector<QPair<quint64, int> >::const_iterator i = matches.begin(); i != matches.end(); ++i)
+    {
+        result.m_nStartTime = (*i).first;
+        result.m_nIndex = (*i).second;
+        results.append(result);
+    }
+}
+
+void acTimelineBranch::findTextMatches(const QVector<bool>& textMatches, const QVector<int>& itemTextIds, const QVector<int>& compactTextIds,
+                                       const QVector<int>* pTraceTextIds, int maxResults, QVector<acTimelineSearchResult>& results) const
+{
+    acTimelineSearchResult result;
+    result.m_pBranch = const_cast<acTimelineBranch*>(this);
+
+    // only the items of the matching strings are read, and the earliest of them are kept when there are too many
+    if (!m_timelineItems.isEmpty())
+    {
+        ensureItemTextIndex();
+
+        QVector<QPair<quint64, int> > matches;
+        int stringCount = qMin(itemTextIds.count(), m_itemsByTextId.count());
+
+        for (int stringId = 0; stringId < stringCount; ++stringId)
+        {
+            if (textMatches.value(itemTextIds[stringId]))
+            {
+                const QVector<int>& indices = m_itemsByTextId[stringId];
+
+                for (QVector<int>::const_iterator i = indices.begin(); i != indices.end(); ++i)
+                {
+                    matches.append(qMakePair(m_timelineItems[*i]->startTime(), *i));
+                }
+            }
+        }
+
+        result.m_kind = acTimelineSearchResult::SEARCH_RESULT_ITEM;
+        acAppendEarliestSearchResults(matches, maxResults, result, results);
+    }
+
+    if (m_compactItems.count() > 0)
+    {
+        QVector<QPair<quint64, int> > matches;
+        int stringCount = qMin(compactTextIds.count(), m_compactItemsByTextId.count());
+
+        for (int stringId = 0; stringId < stringCount; ++stringId)
+        {
+            if (textMatches.value(compactTextIds[stringId]))
+            {
+                const QVector<int>& indices = m_compactItemsByTextId[stringId];
+
+                for (QVector<int>::const_iterator i = indices.begin(); i != indices.end(); ++i)
+                {
+                    matches.append(qMakePair(m_compactItems.startTime(*i), *i));
+                }
+            }
+        }
+
+        result.m_kind = acTimelineSearchResult::SEARCH_RESULT_COMPACT_ITEM;
+        acAppendEarliestSearchResults(matches, maxResults, result, results);
+    }
+
+    if (pTraceTextIds != nullptr && ensureTraceTextIndex())
+    {
+        result.m_kind = acTimelineSearchResult::SEARCH_RESULT_TRACE_ITEM;
+
+        // Merge the position lists of the matching strings, so that only the matching items are read from the mapping.
+        // Each cursor is the index of the next position of a list in m_traceItemsByTextId, and the end of that list
+        QVector<QPair<int, int> > cursors;
+        int stringCount = qMin(pTraceTextIds->count(), m_traceTextIdOffsets.count() - 1);
+
+        for (int stringId = 0; stringId < stringCount; ++stringId)
+        {
+            if (m_traceTextIdOffsets[stringId] < m_traceTextIdOffsets[stringId + 1] && textMatches.value((*pTraceTextIds)[stringId]))
+            {
+                cursors.append(qMakePair((int)m_traceTextIdOffsets[stringId], (int)m_traceTextIdOffsets[stringId + 1]));
+            }
+        }
+
+        // the cursor at the front of the heap points to the earliest position
+        const QVector<quint32>& positions = m_traceItemsByTextId;
+        auto isLater = [&positions](const QPair<int, int>& left, const QPair<int, int>& right)
+        {
+            return positions[left.first] > positions[right.first];
+        };
+
+        std::make_heap(cursors.begin(), cursors.end(), isLater);
+        int resultCount = 0;
+
+        while (!cursors.isEmpty() && resultCount < maxResults)
+        {
+            std::pop_heap(cursors.begin(), cursors.end(), isLater);
+            QPair<int, int>& cursor = cursors.last();
+            qint64 pos = positions[cursor.first];
+
+            result.m_nIndex = pos;
+            result.m_nStartTime = m_traceItems.startTime(pos);
+            results.append(result);
+            ++resultCount;
+
+            if (++cursor.first < cursor.second)
+            {
+                std::push_heap(cursors.begin(), cursors.end(), isLater);
+            }
+            else
+            {
+                cursors.removeLast();
+            }
+        }
+    }
+    else if (pTraceTextIds != nullptr)
+    {
+        result.m_kind = acTimelineSearchResult::SEARCH_RESULT_TRACE_ITEM;
+        int resultCount = 0;
+
+        for (qint64 pos = 0; pos < m_traceItems.count() && resultCount < maxResults; ++pos)
+        {
+            quint32 stringId = m_traceItems.textId(pos);
+
+            if ((int)stringId < pTraceTextIds->count() && textMatches.value((*pTraceTextIds)[stringId]))
+            {
+                result.m_nIndex = pos;
+                result.m_nStartTime = m_traceItems.startTime(pos);
+                results.append(result);
+                ++resultCount;
+            }
+        }
+    }
+}
+
+bool acTimelineBranch::ensureTraceTextIndex() const
+{
+    const acTimelineTraceFile* pTraceFile = m_traceItems.file();
+    qint64 count = m_traceItems.count();
+
+    // the positions are stored in 32 bits, and QVector is indexed with an int
+    if (pTraceFile == nullptr || count > std::numeric_limits<int>::max())
+    {
+        return false;
+    }
+
+    if (m_nTraceTextIndexGeneration != pTraceFile->loadGeneration())
+    {
+        // Counting sort of the positions by string id.  The string id column is read twice, once per trace
+        int stringCount = (int)qMin<quint32>(pTraceFile->stringCount(), std::numeric_limits<int>::max() - 1);
+        m_traceTextIdOffsets.fill(0, stringCount + 1);
+
+        for (qint64 pos = 0; pos < count; ++pos)
+        {
+            quint32 stringId = m_traceItems.textId(pos);
+
+            if (stringId < (quint32)stringCount)
+            {
+                m_traceTextIdOffsets[stringId + 1]++;
+            }
+        }
+
+        for (int stringId = 0; stringId < stringCount; ++stringId)
+        {
+            m_traceTextIdOffsets[stringId + 1] += m_traceTextIdOffsets[stringId];
+        }
+
+        QVector<quint32> nextOffsets = m_traceTextIdOffsets;
+        m_traceItemsByTextId.resize(m_traceTextIdOffsets[stringCount]);
+
+        for (qint64 pos = 0; pos < count; ++pos)
+        {
+            quint32 stringId = m_traceItems.textId(pos);
+
+            if (stringId < (quint32)stringCount)
+            {
+                m_traceItemsByTextId[nextOffsets[stringId]++] = (quint32)pos;
+            }
+        }
+
+        m_nTraceTextIndexGeneration = pTraceFile->loadGeneration();
+    }
+
+    return true;
+}
+
+void acTimelineBranch::indexItemText(int index) const
+{
+    QString text = m_timelineItems[index]->text();
+    QHash<QString, int>::const_iterator i = m_itemTextIds.find(text);
+    int stringId = 0;
+
+    if (i != m_itemTextIds.end())
+    {
+        stringId = i.value();
+    }
+    else
+    {
+        stringId = m_itemTexts.count();
+        m_itemTexts.append(text);
+        m_itemTextIds.insert(text, stringId);
+        m_itemsByTextId.append(QVector<int>());
+    }
+
+    m_itemsByTextId[stringId].append(index);
+}
+
+void acTimelineBranch::ensureItemTextIndex() const
+{
+    if (m_bItemTextIndexInvalid)
+    {
+        // The string ids are kept (the texts are only ever added), so that the text index ids of the strings stay valid
+        for (QVector<QVector<int> >::iterator i = m_itemsByTextId.begin(); i != m_itemsByTextId.end(); ++i)
+        {
+            (*i).clear();
+        }
+
+        for (int index = 0; index < m_timelineItems.count(); ++index)
+        {
+            indexItemText(index);
+        }
+
+        m_bItemTextIndexInvalid = false;
+    }
+}
+
+acTimelineBranch* acTimelineBranch::getSubBranchFromY(const int y) const
+{
+    int totalHeight = m_nHeight;
+
+    if (y < totalHeight)
+    {
+        return const_cast<acTimelineBranch*>(this);
+    }
+
+    for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+    {
+        if ((*i)->IsVisible() == true)
+        {
+            int branchHeight = (*i)->cumulativeHeight();
+
+            if (totalHeight + branchHeight > y)
+            {
+                return (*i)->getSubBranchFromY(y - totalHeight);
+            }
+
+            totalHeight += branchHeight;
+        }
+    }
+
+    return NULL;
+}
+
+bool acTimelineBranch::addTimelineItem(acTimelineItem* item)
+{
+    if (item == nullptr)
+    {
+        return false;
+    }
+
+    item->setParentBranch(this);
+    m_timelineItems.push_back(item);
+
+    if (!m_bItemTextIndexInvalid)
+    {
+        indexItemText(m_timelineItems.count() - 1);
+    }
+
+    // the index stays built (no sort needed) as long as items are added in order of their start time
+    if (!m_bItemIndexInvalid)
+    {
+        m_itemIndex.append(item->startTime(), item->endTime());
+    }
+
+    summarizeAddedItem(item->startTime(), item->endTime(), item->backgroundColor().rgba());
+    invalidateAddedRange(item->startTime(), item->endTime());
+
+    emit branchItemAdded(item);
+
+    extendRange(item->startTime(), item->endTime());
+
+    return true;
+}
+
+bool acTimelineBranch::addTimelineItems(const QList<acTimelineItem*>& items)
+{
+    QList<acTimelineItem*> newItems;
+    newItems.reserve(items.count());
+
+    quint64 batchStartTime = std::numeric_limits<quint64>::max();
+    quint64 batchEndTime = std::numeric_limits<quint64>::min();
+
+    for (QList<acTimelineItem*>::const_iterator i = items.begin(); i != items.end(); ++i)
+    {
+        acTimelineItem* item = *i;
+
+        if (item != nullptr)
+        {
+            batchStartTime = qMin(batchStartTime, item->startTime());
+            batchEndTime = qMax(batchEndTime, item->endTime());
+            newItems.push_back(item);
+        }
+    }
+
+    if (newItems.isEmpty())
+    {
+        return false;
+    }
+
+    // the items keep the order they were passed in.  Only the item index is sorted by start time, once, when it is next built
+    m_timelineItems.reserve(m_timelineItems.count() + newItems.count());
+
+    if (!m_bItemIndexInvalid)
+    {
+        m_itemIndex.reserve(m_itemIndex.count() + newItems.count());
+    }
+
+    for (QList<acTimelineItem*>::const_iterator i = newItems.begin(); i != newItems.end(); ++i)
+    {
+        (*i)->setParentBranch(this);
+        m_timelineItems.push_back(*i);
+
+        if (!m_bItemTextIndexInvalid)
+        {
+            indexItemText(m_timelineItems.count() - 1);
+        }
+
+        if (!m_bItemIndexInvalid)
+        {
+            m_itemIndex.append((*i)->startTime(), (*i)->endTime());
+        }
+
+        summarizeAddedItem((*i)->startTime(), (*i)->endTime(), (*i)->backgroundColor().rgba());
+    }
+
+    if (isStreaming())
+    {
+        invalidateAddedRange(batchStartTime, batchEndTime);
+    }
+    else
+    {
+        // the draw cache only holds the items painted before this batch was added
+        clearDrawCache(false);
+        invalidateTiles();
+    }
+
+    emit branchItemsAdded(newItems.count());
+
+    extendRange(batchStartTime, batchEndTime);
+
+    return true;
+}
+
+int acTimelineBranch::addCompactItem(quint64 startTime, quint64 endTime, const QColor& backgroundColor, const QString& text, quint8 flags)
+{
+    int retVal = m_compactItems.addItem(startTime, endTime, backgroundColor, text, flags);
+
+    // the search finds the compact items through the lists of the items of each string
+    quint32 stringId = m_compactItems.textId(retVal);
+
+    if ((int)stringId >= m_compactItemsByTextId.count())
+    {
+        m_compactItemsByTextId.resize(stringId + 1);
+    }
+
+    m_compactItemsByTextId[stringId].append(retVal);
+
+    // like the item index, the compact item index stays built as long as items are added in order of their start time
+    m_compactItemIndex.append(m_compactItems.startTime(retVal), m_compactItems.endTime(retVal));
+    summarizeAddedItem(m_compactItems.startTime(retVal), m_compactItems.endTime(retVal), m_compactItems.backgroundColor(retVal));
+    invalidateAddedRange(m_compactItems.startTime(retVal), m_compactItems.endTime(retVal));
+
+    extendRange(m_compactItems.startTime(retVal), m_compactItems.endTime(retVal));
+
+    return retVal;
+}
+
+bool acTimelineBranch::isStreaming() const
+{
+    return m_pParentTimeline != nullptr && m_pParentTimeline->isStreamingMode();
+}
+
+void acTimelineBranch::summarizeAddedItem(quint64 startTime, quint64 endTime, QRgb color)
+{
+    // In streaming mode, items added after the summarized items are summarized in place instead of rebuilding the pyramid from all the items
+    if (m_bSummaryPyramidInvalid || !isStreaming() || !m_summaryPyramid.appendItem(startTime, endTime, color))
+    {
+        m_bSummaryPyramidInvalid = true;
+    }
+}
+
+void acTimelineBranch::invalidateAddedRange(quint64 startTime, quint64 endTime)
+{
+    if (!isStreaming())
+    {
+        invalidateTiles();
+        return;
+    }
+
+    // Added items only change the pixels they cover, so only the tiles covering them are dropped (for this branch and the parent
+    // branches which may paint its items)
+    if (!m_pParentTimeline->isPainting())
+    {
+        for (acTimelineBranch* pBranch = this; pBranch != nullptr; pBranch = pBranch->m_pParentBranch)
+        {
+            m_pParentTimeline->invalidateTiles(pBranch, startTime, endTime);
+        }
+    }
+
+    // The draw cache lists the items painted within the visible time window, so it only changes if the added items are visible
+    quint64 visibleStartTime = m_pParentTimeline->visibleStartTime();
+
+    if (startTime <= visibleStartTime + m_pParentTimeline->visibleRange() && endTime >= visibleStartTime)
+    {
+        m_drawCache.clear();
+    }
+}
+
+void acTimelineBranch::extendRange(quint64 startTime, quint64 endTime)
+{
+    bool rangeChanged = false;
+
+    if (m_nStartTime > startTime || (m_nStartTime == std::numeric_limits<quint64>::max()))
+    {
+        m_nStartTime = startTime;
+        rangeChanged = true;
+    }
+
+    if (endTime > m_nEndTime || (m_nEndTime == std::numeric_limits<quint64>::min()))
+    {
+        m_nEndTime = endTime;
+        rangeChanged = true;
+    }
+
+    if (rangeChanged)
+    {
+        emit branchRangeChanged();
+    }
+}
+
+bool acTimelineBranch::addSubBranch(acTimelineBranch* subBranch)
+{
+    if (subBranch == nullptr)
+    {
+        return false;
+    }
+
+    connect(subBranch, SIGNAL(branchRangeChanged()),
+            this, SLOT(subBranchRangeChanged()));
+    connect(subBranch, SIGNAL(branchAdded(acTimelineBranch*)),
+            this, SLOT(subBranchAdded(acTimelineBranch*)));
+    connect(subBranch, SIGNAL(branchTextChanged()),
+            this, SLOT(subBranchTextChanged()));
+
+    subBranch->setParentTimeline(this->parentTimeline());
+    subBranch->setDepth(this->m_nDepth + 1);
+
+    bool rangeChanged = false;
+
+    if (m_nStartTime > subBranch->m_nStartTime)
+    {
+        m_nStartTime = subBranch->m_nStartTime;
+        rangeChanged = true;
+    }
+
+    if (subBranch->m_nEndTime > m_nEndTime)
+    {
+        m_nEndTime = subBranch->m_nEndTime;
+        rangeChanged = true;
+    }
+
+    if (rangeChanged)
+    {
+        emit branchRangeChanged();
+    }
+
+    m_subBranches.push_back(subBranch);
+
+    subBranch->m_pParentBranch = this;
+
+    growTitleWidth(subBranch);
+
+    emit branchAdded(subBranch);
+
+    return true;
+}
+
+void acTimelineBranch::subBranchRangeChanged()
+{
+    bool rangeChanged = false;
+
+    acTimelineBranch* branch = qobject_cast<acTimelineBranch*>(sender());
+
+    if (m_nStartTime > branch->startTime())
+    {
+        m_nStartTime = branch->startTime();
+        rangeChanged = true;
+    }
+
+    if (branch->endTime() > m_nEndTime)
+    {
+        m_nEndTime = branch->endTime();
+        rangeChanged = true;
+    }
+
+    if (rangeChanged)
+    {
+        emit branchRangeChanged();
+    }
+}
+
+void acTimelineBranch::subBranchAdded(acTimelineBranch* subBranch)
+{
+    emit branchAdded(subBranch);
+
+    // the title width of the sub branch which sent the signal already includes the added branch
+    growTitleWidth(qobject_cast<acTimelineBranch*>(sender()));
+}
+
+void acTimelineBranch::subBranchTextChanged()
+{
+    emit branchTextChanged();
+    recalcTitleWidth();
+}
+
+void acTimelineBranch::zoomFactorOrOffsetChanged()
+{
+    // Only the list of painted items depends on the offset.  Tiles are pre-rendered per zoom level, and the parent timeline drops them when the zoom level changes
+    m_drawCache.clear();
+}
+
+void acTimelineBranch::draw(QPainter& painter, int& yOffset)
+{
+    m_nTop = yOffset;
+    yOffset += m_nHeight;
+
+    // Draw subbranches first, so that we can easily cull away branches whose parent is folded
+    if (!m_bFolded)
     {
         // Draw sub branches
         for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
@@ -619,6 +1617,13 @@ void acTimelineBranch::draw(QPainter& painter, int& yOffset)
         return;
     }
 
+    acTimelineFrameStats* pStats = m_pParentTimeline->frameStats();
+
+    if (pStats != nullptr)
+    {
+        pStats->m_nBranchesVisited++;
+    }
+
     // Draw row background
     // dilute based on depth
     unsigned int intensity = 230 + (m_nDepth * 5);
@@ -716,55 +1721,143 @@ void acTimelineBranch::draw(QPainter& painter, int& yOffset)
         m_treeMarkRect.setHeight(0);
     }
 
-    if (m_bMaskEnabled)
+    // Draw items
+    m_itemsRowRect = QRect(m_pParentTimeline->titleWidth(), m_nTop, m_pParentTimeline->rowWidth(), m_nHeight);
+
+    if (m_pParentTimeline->isTileCacheEnabled())
+    {
+        // The items are painted from pre-rendered tiles, so their rectangles are not refreshed.  Hit testing matches them by time instead
+        m_pParentTimeline->drawBranchTiles(painter, this, m_nTop, m_nHeight);
+        markItemRectsStale(m_itemsRowRect, m_bFolded);
+    }
+    else
     {
-        m_pMask->resetMask(m_pParentTimeline->rowWidth());
+        drawItems(painter, m_pParentTimeline->rowView(), m_nTop, m_nHeight);
     }
 
-    // Draw items
-    QList<acTimelineItem*> itemsForDrawing;
-    bool usingCache = false;
+    painter.restore();
+}
 
-    if (m_drawCache.count() > 0)
+void acTimelineBranch::drawItems(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight)
+{
+    if (m_pParentTimeline == nullptr)
     {
-        itemsForDrawing = m_drawCache;
-        usingCache = true;
+        return;
     }
-    else
+
+    // When painting through tiles, the tiles are painted in any order and for any area, so the draw cache and the item rectangles
+    // state are left alone
+    bool isRenderingTile = view.m_bIsTiled;
+    acTimelineItemBatch* pBatch = m_pParentTimeline->itemBatch();
+
+    // The items out of the painted area are trimmed, but their frames (see acTimelineItem::ItemFrame) extend a little beyond it
+    painter.save();
+    painter.setClipRect(QRect(view.m_nLeft, branchRowTop, view.m_nWidth, branchHeight), Qt::IntersectClip);
+
+    if (m_bMaskEnabled)
     {
-        itemsForDrawing = m_timelineItems;
+        m_pMask->resetMask(view.maskWidth());
     }
 
-    for (QList<acTimelineItem*>::const_iterator i = itemsForDrawing.begin(); i != itemsForDrawing.end(); ++i)
+    // Compact items are not kept in the draw cache, since they are painted through a shared proxy item
+    int compactFirstPos = 0;
+    int compactLastPos = 0;
+    findVisibleCompactItems(view, compactFirstPos, compactLastPos);
+
+    if (m_drawCache.count() > 0 && !isRenderingTile)
     {
-        acTimelineItem* item = (*i);
+        m_bItemRectsStale = false;
 
-        if (m_bSorted && (item->startTime() > m_pParentTimeline->visibleStartTime() + m_pParentTimeline->visibleRange()))
+        for (QList<acTimelineItem*>::const_iterator i = m_drawCache.begin(); i != m_drawCache.end(); ++i)
         {
-            break;
+            drawItem(painter, pBatch, *i, view, branchRowTop, branchHeight, false, true);
         }
 
-        item->draw(painter, m_nTop, m_nHeight, true, true);
+        drawCompactItems(painter, view, branchRowTop, branchHeight, compactFirstPos, compactLastPos, false, true);
+    }
+    else
+    {
+        // Only visit the items overlapping the painted time window
+        int firstPos = 0;
+        int lastPos = 0;
+        findVisibleItems(view, firstPos, lastPos);
+
+        // When zoomed out far enough, paint one aggregated bar per pixel instead of the items themselves
+        bool drawnAggregated = drawAggregatedItems(painter, view, branchRowTop, branchHeight, firstPos, lastPos, compactFirstPos, compactLastPos, 255);
 
-        if (!usingCache && item->drawRectangle().width() > 0)
+        if (!isRenderingTile)
         {
-            m_drawCache.push_back(item);
+            m_bItemRectsStale = drawnAggregated;
+        }
+
+        if (!drawnAggregated)
+        {
+            for (int pos = firstPos; pos < lastPos; ++pos)
+            {
+                acTimelineItem* item = itemAtSortedPos(pos);
+
+                drawItem(painter, pBatch, item, view, branchRowTop, branchHeight, false, true);
+
+                if (!isRenderingTile && item->drawRectangle().width() > 0)
+                {
+                    m_drawCache.push_back(item);
+                }
+            }
+
+            drawCompactItems(painter, view, branchRowTop, branchHeight, compactFirstPos, compactLastPos, false, true);
         }
     }
 
+    // trace items are not summarized, they are thinned out to a pixel column each instead
+    drawTraceItems(painter, view, branchRowTop, branchHeight, false, true);
+
+    if (pBatch != nullptr)
+    {
+        pBatch->flush(painter);
+    }
+
     if (m_bFolded || m_shouldDrawChildren)
     {
         // Only update the child's geometry if it is painted once, in the parent branch
         bool shouldUpdateChildGeometry = m_bFolded;
 
         // Draw sub branches item on itself
-        DrawSubBranchItems(painter, m_nTop, m_nHeight, shouldUpdateChildGeometry);
+        DrawSubBranchItems(painter, view, branchRowTop, branchHeight, shouldUpdateChildGeometry);
+    }
+
+    // The labels are painted over all the items of the row (the items queue them while they are painted)
+    if (view.m_bPaintLabels)
+    {
+        int labelCount = m_pParentTimeline->labelCache().drawRowLabels(painter);
+        acTimelineFrameStats* pStats = m_pParentTimeline->frameStats();
+
+        if (pStats != nullptr)
+        {
+            pStats->m_nTextDraws += labelCount;
+        }
     }
 
     painter.restore();
 }
 
-void acTimelineBranch::DrawSubBranchItems(QPainter& painter, const int yOffset, const int branchHeight, bool shouldUpdateChildGeometry)
+void acTimelineBranch::markItemRectsStale(const QRect& itemsRowRect, bool includeSubBranches)
+{
+    m_itemsRowRect = itemsRowRect;
+    m_bItemRectsStale = true;
+
+    if (includeSubBranches)
+    {
+        for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
+        {
+            if ((*i)->IsVisible() == true)
+            {
+                (*i)->markItemRectsStale(itemsRowRect, true);
+            }
+        }
+    }
+}
+
+void acTimelineBranch::DrawSubBranchItems(QPainter& painter, const acTimelineRowView& view, const int yOffset, const int branchHeight, bool shouldUpdateChildGeometry)
 {
     if (m_pParentTimeline != nullptr)
     {
@@ -772,52 +1865,81 @@ void acTimelineBranch::DrawSubBranchItems(QPainter& painter, const int yOffset,
         {
             if ((*i)->IsVisible() == true)
             {
-                (*i)->DrawSubBranchItems(painter, yOffset, branchHeight, shouldUpdateChildGeometry);
+                (*i)->DrawSubBranchItems(painter, view, yOffset, branchHeight, shouldUpdateChildGeometry);
             }
         }
 
         if (m_bMaskEnabled)
         {
-            m_pMask->resetMask(m_pParentTimeline->rowWidth());
+            m_pMask->resetMask(view.maskWidth());
         }
 
         // Draw items
         QList<acTimelineItem*> itemsForDrawing;
         bool usingCache = false;
+        bool drawnAggregated = false;
+
+        // When painting through tiles, the draw cache and the item rectangles state are left alone (see drawItems).  The items are
+        // still painted with shouldUpdateChildGeometry, so that they are painted the same (with their labels) as when painted directly
+        bool isRenderingTile = view.m_bIsTiled;
+
+        if (shouldUpdateChildGeometry && !isRenderingTile)
+        {
+            m_itemsRowRect = QRect(view.m_nLeft, yOffset, view.m_nWidth, branchHeight);
+        }
 
-        if (m_drawCache.count() > 0)
+        int compactFirstPos = 0;
+        int compactLastPos = 0;
+        findVisibleCompactItems(view, compactFirstPos, compactLastPos);
+
+        if (m_drawCache.count() > 0 && !isRenderingTile)
         {
             itemsForDrawing = m_drawCache;
             usingCache = true;
         }
         else
         {
-            itemsForDrawing = m_timelineItems;
-        }
+            // Only visit the items overlapping the visible time window
+            int firstPos = 0;
+            int lastPos = 0;
+            findVisibleItems(view, firstPos, lastPos);
 
+            // When zoomed out far enough, paint one aggregated bar per pixel instead of the items themselves
+            drawnAggregated = drawAggregatedItems(painter, view, yOffset, branchHeight, firstPos, lastPos, compactFirstPos, compactLastPos, 50);
 
-        for (QList<acTimelineItem*>::const_iterator i = itemsForDrawing.begin(); i != itemsForDrawing.end(); ++i)
-        {
-            if (m_bSorted && ((*i)->startTime() > m_pParentTimeline->visibleStartTime() + m_pParentTimeline->visibleRange()))
+            if (shouldUpdateChildGeometry && !isRenderingTile)
             {
-                break;
+                m_bItemRectsStale = drawnAggregated;
             }
 
-            QColor origColor = (*i)->backgroundColor();
-            QColor newColor = origColor;
-
-            newColor.setAlpha(50);
+            for (int pos = firstPos; !drawnAggregated && pos < lastPos; ++pos)
+            {
+                itemsForDrawing.push_back(itemAtSortedPos(pos));
+            }
+        }
 
-            (*i)->setBackgroundColor(newColor);
+        acTimelineItemBatch* pBatch = m_pParentTimeline->itemBatch();
 
-            (*i)->draw(painter, yOffset, branchHeight, false, shouldUpdateChildGeometry);
+        for (QList<acTimelineItem*>::const_iterator i = itemsForDrawing.begin(); i != itemsForDrawing.end(); ++i)
+        {
+            drawItem(painter, pBatch, *i, view, yOffset, branchHeight, true, shouldUpdateChildGeometry);
 
-            if (!usingCache && (*i)->drawRectangle().width() > 0)
+            if (!usingCache && !isRenderingTile && (*i)->drawRectangle().width() > 0)
             {
                 m_drawCache.push_back(*i);
             }
+        }
+
+        if (!drawnAggregated)
+        {
+            drawCompactItems(painter, view, yOffset, branchHeight, compactFirstPos, compactLastPos, true, shouldUpdateChildGeometry);
+        }
+
+        drawTraceItems(painter, view, yOffset, branchHeight, true, shouldUpdateChildGeometry);
 
-            (*i)->setBackgroundColor(origColor);
+        if (pBatch != nullptr)
+        {
+            pBatch->flush(painter);
         }
     }
 }
@@ -826,6 +1948,11 @@ void acTimelineBranch::clearDrawCache(bool clearSubBranchCache)
 {
     m_drawCache.clear();
 
+    if (m_pParentTimeline != nullptr)
+    {
+        m_pParentTimeline->invalidateTiles(this);
+    }
+
     if (clearSubBranchCache)
     {
         for (QList<acTimelineBranch*>::const_iterator i = m_subBranches.begin(); i != m_subBranches.end(); ++i)
@@ -840,103 +1967,140 @@ void acTimelineBranch::clearDrawCache(bool clearSubBranchCache)
 
 acTimelineMaskBuffer::~acTimelineMaskBuffer()
 {
-    for (QMap<int, QMap<int, int*> >::iterator i = m_maskBuffer.begin(); i != m_maskBuffer.end(); ++i)
-    {
-        for (QMap<int, int*>::iterator j = i.value().begin(); j != i.value().end(); ++j)
-        {
-            delete[] j.value();
-            j.value() = nullptr;
-        }
-    }
+    m_maskRows.clear();
 }
 
-bool acTimelineMaskBuffer::setMask(int index, QRect rect)
+acTimelineMaskBuffer::MaskRow* acTimelineMaskBuffer::findRow(const QRect& rect, bool create)
 {
-    if (index < 0 || index > m_nBufferWidth)
-    {
-        return false;
-    }
-
-    int mask = rect.width() << 1;
-    mask |= 0x1;
     int rectHeight = rect.height();
     int rectTop = rect.top();
 
-    if (!m_maskBuffer.contains(rectHeight) || !m_maskBuffer[rectHeight].contains(rectTop))
+    // consecutive items are almost always in the same lane
+    if (m_nLastRow >= 0 && m_maskRows[m_nLastRow].m_nTop == rectTop && m_maskRows[m_nLastRow].m_nHeight == rectHeight)
     {
-        QMap<int, int*> offsetMap;
-        offsetMap[rectTop] = new(std::nothrow) int[m_nBufferWidth];
-        Q_ASSERT(offsetMap[rectTop] != nullptr);
+        return &m_maskRows[m_nLastRow];
+    }
 
-        if (offsetMap[rectTop] == nullptr)
+    for (int i = 0; i < m_maskRows.count(); ++i)
+    {
+        if (m_maskRows[i].m_nTop == rectTop && m_maskRows[i].m_nHeight == rectHeight)
         {
-            return false;
+            m_nLastRow = i;
+            return &m_maskRows[i];
         }
+    }
 
-        memset(offsetMap[rectTop], 0, m_nBufferWidth * sizeof(int));
-
-        m_maskBuffer[rectHeight] = offsetMap;
+    if (!create)
+    {
+        return nullptr;
     }
 
-    m_maskBuffer[rectHeight][rectTop][index] = mask;
-    return true;
+    MaskRow newRow;
+    newRow.m_nTop = rectTop;
+    newRow.m_nHeight = rectHeight;
+    newRow.m_widths.fill(0, m_nBufferWidth);
+    newRow.m_nDirtyStart = m_nBufferWidth;
+    newRow.m_nDirtyEnd = 0;
+    m_maskRows.push_back(newRow);
+
+    m_nLastRow = m_maskRows.count() - 1;
+    return &m_maskRows[m_nLastRow];
 }
 
-bool acTimelineMaskBuffer::checkMask(int index, QRect rect)
+bool acTimelineMaskBuffer::setMask(int index, QRect rect)
 {
-    if (index < 0 || index > m_nBufferWidth)
+    if (index < 0 || index >= m_nBufferWidth || rect.width() <= 0)
     {
         return false;
     }
 
-    int rectHeight = rect.height();
-    int rectTop = rect.top();
+    MaskRow* pRow = findRow(rect, true);
+    Q_ASSERT(pRow != nullptr);
+
+    pRow->m_widths[index] = rect.width();
+    pRow->m_nDirtyStart = qMin(pRow->m_nDirtyStart, index);
+    pRow->m_nDirtyEnd = qMax(pRow->m_nDirtyEnd, index + 1);
+
+    return true;
+}
 
-    if (!m_maskBuffer.contains(rectHeight) || !m_maskBuffer[rectHeight].contains(rectTop) || m_maskBuffer[rectHeight][rectTop] == nullptr)
+bool acTimelineMaskBuffer::checkMask(int index, QRect rect)
+{
+    if (index < 0 || index >= m_nBufferWidth)
     {
         return false;
     }
 
-    int mask = m_maskBuffer[rectHeight][rectTop][index];
-    bool isSet = (mask & 0x1) == 1;
+    const MaskRow* pRow = findRow(rect, false);
 
-    if (isSet)
+    if (pRow == nullptr)
     {
-        int setLen = mask >> 1;
-
-        if (setLen < rect.width())
-        {
-            isSet = false;
-        }
+        return false;
     }
 
-    return isSet;
+    // the mask is set if an item at least as wide was already painted starting at the same pixel
+    int setLen = pRow->m_widths[index];
+    return setLen > 0 && setLen >= rect.width();
 }
 
 void acTimelineMaskBuffer::resetMask(int rowWidth)
 {
+    bool widthChanged = false;
+
     if (m_nBufferWidth < rowWidth)
     {
         m_nBufferWidth = rowWidth;
+        widthChanged = true;
     }
 
-    for (QMap<int, QMap<int, int*> >::iterator i = m_maskBuffer.begin(); i != m_maskBuffer.end(); ++i)
+    // keep the rows allocated (the same lanes are used again in the next paint pass), and only clear the pixels which were set
+    for (QVector<MaskRow>::iterator i = m_maskRows.begin(); i != m_maskRows.end(); ++i)
     {
-        for (QMap<int, int*>::iterator j = i.value().begin(); j != i.value().end(); ++j)
+        if (i->m_nDirtyStart < i->m_nDirtyEnd)
         {
-            delete[] j.value();
-            j.value() = nullptr;
+            memset(i->m_widths.data() + i->m_nDirtyStart, 0, (i->m_nDirtyEnd - i->m_nDirtyStart) * sizeof(int));
         }
 
-        i.value().clear();
-    }
+        if (widthChanged)
+        {
+            i->m_widths.fill(0, m_nBufferWidth);
+        }
 
-    m_maskBuffer.clear();
+        i->m_nDirtyStart = m_nBufferWidth;
+        i->m_nDirtyEnd = 0;
+    }
 }
 
 void acTimelineBranch::setVisibility(bool isVisible)
 {
-    m_bVisible = isVisible;
+    if (m_bVisible != isVisible)
+    {
+        m_bVisible = isVisible;
+
+        if (m_pParentTimeline != nullptr)
+        {
+            m_pParentTimeline->updateBranchRow(this);
+        }
+
+        // a folded parent paints the items of its visible sub branches
+        if (m_pParentBranch != nullptr)
+        {
+            m_pParentBranch->invalidateTiles();
+        }
+    }
+}
+
+void acTimelineBranch::invalidateTiles()
+{
+    // Items are also painted on the rows of folded parents (and of parents drawing their children), so their tiles are invalidated too.
+    // Nothing is invalidated while the timeline paints, since painting temporarily changes item colors
+    if (m_pParentTimeline != nullptr && !m_pParentTimeline->isPainting())
+    {
+        for (acTimelineBranch* pBranch = this; pBranch != nullptr; pBranch = pBranch->m_pParentBranch)
+        {
+            m_pParentTimeline->invalidateTiles(pBranch);
+        }
+    }
 }
 bool acTimelineBranch::IsVisible()const
 {
@@ -281,6 +281,7 @@ void acTimelineFiltersDialog::UpdateCheckStatesFromTree()
     {
         m_CPUThreadCount = m_visibleCPUThreadCount = 0;
         m_isAllItemsChecked = true;
+        m_visibilityChanges.clear();
 
         int i = 0;
 
@@ -296,6 +297,17 @@ void acTimelineFiltersDialog::UpdateCheckStatesFromTree()
             Qt::CheckState state = (m_pSubBranches->count() == m_visibleCPUThreadCount ? Qt::Checked : ((0 != m_visibleCPUThreadCount) ? Qt::PartiallyChecked : Qt::Unchecked));
             m_isAllItemsChecked = (0 != state);
         }
+
+        // apply only the changed branches, so that the timeline does not lay out all its rows
+        if (!m_visibilityChanges.isEmpty() && !m_pSubBranches->isEmpty())
+        {
+            acTimeline* pTimeline = m_pSubBranches->first()->parentTimeline();
+
+            GT_IF_WITH_ASSERT(pTimeline != nullptr)
+            {
+                pTimeline->setBranchesVisibility(m_visibilityChanges);
+            }
+        }
     }
 }
 
@@ -314,14 +326,18 @@ void acTimelineFiltersDialog::UpdateCheckStateFromItem(QTreeWidgetItem* pItem, a
 
             m_CPUThreadCount++;
 
-            if (state != Qt::Unchecked)
+            bool isVisible = (state != Qt::Unchecked);
+
+            if (isVisible)
             {
                 m_visibleCPUThreadCount++;
             }
-            
-            pBranch->setVisibility(state != Qt::Unchecked);
-            m_threadNameVisibilityMap[pBranch->text()] = state != Qt::Unchecked;
 
+            if (pBranch->IsVisible() != isVisible)
+            {
+                m_visibilityChanges.insert(pBranch->id(), isVisible);
+                m_threadNameVisibilityMap[pBranch->text()] = isVisible;
+            }
         }
 
         int subBranchesCount = pBranch->subBranchCount();
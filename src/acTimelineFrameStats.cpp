@@ -0,0 +1,90 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineFrameStats.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Qt:
+#include <QFile>
+#include <QTextStream>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineFrameStats.h>
+
+void acTimelineFrameStats::reset()
+{
+    m_nFrameIndex = 0;
+    m_nBranchesVisited = 0;
+    m_nItemsConsidered = 0;
+    m_nItemsDrawn = 0;
+    m_nMaskRejects = 0;
+    m_nTextDraws = 0;
+    m_nAggregatedBars = 0;
+    m_nTilesRendered = 0;
+    m_nTooltipLayoutNs = 0;
+    m_nPaintNs = 0;
+}
+
+QString acTimelineFrameStats::csvHeader()
+{
+    return QString("frame,paint_ns,branches_visited,items_considered,items_drawn,mask_rejects,text_draws,aggregated_bars,tiles_rendered,tooltip_layout_ns");
+}
+
+QString acTimelineFrameStats::toCsv() const
+{
+    return QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10")
+           .arg(m_nFrameIndex)
+           .arg(m_nPaintNs)
+           .arg(m_nBranchesVisited)
+           .arg(m_nItemsConsidered)
+           .arg(m_nItemsDrawn)
+           .arg(m_nMaskRejects)
+           .arg(m_nTextDraws)
+           .arg(m_nAggregatedBars)
+           .arg(m_nTilesRendered)
+           .arg(m_nTooltipLayoutNs);
+}
+
+QStringList acTimelineFrameStats::toLines() const
+{
+    QStringList retVal;
+
+    retVal << QString("Frame %1: %2 ms").arg(m_nFrameIndex).arg(m_nPaintNs / 1e6, 0, 'f', 2);
+    retVal << QString("Branches visited: %1").arg(m_nBranchesVisited);
+    retVal << QString("Items considered: %1").arg(m_nItemsConsidered);
+    retVal << QString("Items drawn: %1").arg(m_nItemsDrawn);
+    retVal << QString("Mask rejects: %1").arg(m_nMaskRejects);
+    retVal << QString("Text draws: %1").arg(m_nTextDraws);
+    retVal << QString("Aggregated bars: %1").arg(m_nAggregatedBars);
+    retVal << QString("Tiles rendered: %1").arg(m_nTilesRendered);
+    retVal << QString("Tooltip layout: %1 ms").arg(m_nTooltipLayoutNs / 1e6, 0, 'f', 2);
+
+    return retVal;
+}
+
+bool acWriteTimelineFrameStatsCsv(const QList<acTimelineFrameStats>& frames, const QString& filePath)
+{
+    bool retVal = false;
+
+    QFile file(filePath);
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        QTextStream stream(&file);
+        stream << acTimelineFrameStats::csvHeader() << "\n";
+
+        for (QList<acTimelineFrameStats>::const_iterator i = frames.begin(); i != frames.end(); ++i)
+        {
+            stream << (*i).toCsv() << "\n";
+        }
+
+        stream.flush();
+        retVal = (stream.status() == QTextStream::Ok);
+        file.close();
+    }
+
+    return retVal;
+}
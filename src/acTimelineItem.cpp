@@ -15,6 +15,10 @@
 #include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemBatch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemStore.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineToolTipBuilder.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTraceFile.h>
 
 QMap<QRgb, QRgb> acTimelineItem::m_lightenedColorMap;
 
@@ -26,6 +30,7 @@ acTimelineItem::acTimelineItem(quint64 startTime, quint64 endTime) : QObject(),
     m_outlineColor(Qt::red),
     m_strText(""),
     m_nIndex(-1),
+    m_nCompactIndex(-1),
     m_nStartTime(startTime),
     m_nEndTime(endTime),
     m_dFractionalHeight(1.0f),
@@ -86,7 +91,7 @@ void acTimelineItem::DrawSelection(QPainter& painter)
                 painter.fillRect(m_rect.left(), m_rect.top(), 2, m_rect.height(), Qt::yellow);
             }
         }
-        else  if (IsHighlighted())
+        else if (IsHighlighted())
         {
             // draw item under the mouse with its outline color (skipped if the user is mouse dragging)
             pen.setColor(Qt::yellow);
@@ -113,6 +118,22 @@ void acTimelineItem::setBackgroundColor(const QColor& newColor)
 {
     m_backgroundColor = newColor;
     m_bLightenedBGColorCalculated = false;
+
+    if (m_pParentBranch != NULL)
+    {
+        m_pParentBranch->invalidateSummaryPyramid();
+    }
+}
+
+void acTimelineItem::setText(const QString newText)
+{
+    m_strText = newText;
+
+    // the parent branch finds its items by text when searching
+    if (m_pParentBranch != NULL)
+    {
+        m_pParentBranch->invalidateItemTextIndex();
+    }
 }
 
 QColor acTimelineItem::lightenedBackgroundColor()
@@ -140,6 +161,11 @@ void acTimelineItem::setStartTime(const quint64 newStartTime)
     {
         m_nStartTime = m_nEndTime;
     }
+
+    if (m_pParentBranch != NULL)
+    {
+        m_pParentBranch->invalidateItemIndex();
+    }
 }
 
 void acTimelineItem::setEndTime(const quint64 newEndTime)
@@ -150,6 +176,35 @@ void acTimelineItem::setEndTime(const quint64 newEndTime)
     {
         m_nEndTime = m_nStartTime;
     }
+
+    if (m_pParentBranch != NULL)
+    {
+        m_pParentBranch->invalidateItemIndex();
+    }
+}
+
+void acTimelineItem::setFromCompactItem(const acTimelineItemView& compactItem)
+{
+    // the times are set directly, since this must not invalidate the owning branch's item index
+    m_nCompactIndex = compactItem.index();
+    m_nStartTime = compactItem.startTime();
+    m_nEndTime = compactItem.endTime();
+    m_backgroundColor = compactItem.backgroundColor();
+    m_bLightenedBGColorCalculated = false;
+    m_strText = compactItem.text();
+    m_itemShape = (ItemGraphicShape)(compactItem.flags() & AC_TIMELINE_COMPACT_ITEM_SHAPE_MASK);
+}
+
+void acTimelineItem::setFromTraceItem(const acTimelineTraceItems& traceItems, qint64 pos)
+{
+    // as with compact items, the times are set directly
+    m_nCompactIndex = -1;
+    m_nStartTime = traceItems.startTime(pos);
+    m_nEndTime = traceItems.endTime(pos);
+    m_backgroundColor = QColor::fromRgba(traceItems.backgroundColor(pos));
+    m_bLightenedBGColorCalculated = false;
+    m_strText = traceItems.text(pos);
+    m_itemShape = (ItemGraphicShape)(traceItems.flags(pos) & AC_TIMELINE_COMPACT_ITEM_SHAPE_MASK);
 }
 
 int acTimelineItem::index()
@@ -196,33 +251,10 @@ QString acTimelineItem::tooltipText() const
     acTimelineItemToolTip tooltip;
     tooltipItems(tooltip);
 
-    QString retVal;
-    QString row1 = "%1: %2";
-    QString row2 = "%1";
+    acTimelineToolTipBuilder::Content content;
+    acTimelineToolTipBuilder::getContent(tooltip, content);
 
-    for (int i = 0; i < tooltip.count(); i++)
-    {
-        if (tooltip.getName(i).isEmpty())
-        {
-            retVal += row2.arg(tooltip.getValue(i));
-        }
-        else
-        {
-            retVal += row1.arg(tooltip.getName(i), tooltip.getValue(i));
-        }
-
-        if (i < tooltip.count() - 1)
-        {
-            retVal += "<br>";
-        }
-    }
-
-    if (!tooltip.additionalText().isEmpty())
-    {
-        retVal += "\n" + tooltip.additionalText();
-    }
-
-    return retVal;
+    return acTimelineToolTipBuilder::buildText(content);
 }
 
 QString acTimelineItem::getDurationString(quint64 duration)
@@ -273,17 +305,10 @@ void acTimelineItem::tooltipItems(acTimelineItemToolTip& tooltip) const
         }
     }
 
-    double fnum = (m_nStartTime - timelineStartTime) / 1e6; // convert to milliseconds
-    QString strNum = QString(tr("%1 millisecond")).arg(fnum, 0, 'f', 3);
-    tooltip.add(tr("Start Time"), strNum);
-
-    fnum = (m_nEndTime - timelineStartTime) / 1e6; // convert to milliseconds
-    strNum = QString(tr("%1 millisecond")).arg(fnum, 0, 'f', 3);
-    tooltip.add(tr("End Time"), strNum);
-
-    quint64 duration = m_nEndTime - m_nStartTime;
-    QString strDuration = QString(tr("%1 millisecond")).arg(NanosecToTimeString(duration, true, false));
-    tooltip.add(tr("Duration"), strDuration);
+    // the times are formatted when the tooltip text is built, which may be done by a worker thread
+    tooltip.addTime(tr("Start Time"), (double)(m_nStartTime - timelineStartTime));
+    tooltip.addTime(tr("End Time"), (double)(m_nEndTime - timelineStartTime));
+    tooltip.addDuration(tr("Duration"), m_nEndTime - m_nStartTime);
 }
 
 bool acTimelineItem::IsHighlighted() const
@@ -306,42 +331,58 @@ bool acTimelineItem::IsHighlighted() const
     return retVal;
 }
 
-void acTimelineItem::draw(QPainter& painter, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry)
+void acTimelineItem::draw(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry, bool drawFaded)
 {
     // Sanity check:
     GT_IF_WITH_ASSERT(m_pParentBranch != nullptr && m_pParentBranch->parentTimeline() != nullptr)
     {
         acTimeline* pTimeline = m_pParentBranch->parentTimeline();
+        acTimelineFrameStats* pStats = view.m_bPaintBackgrounds ? pTimeline->frameStats() : nullptr;
+
+        if (pStats != nullptr)
+        {
+            pStats->m_nItemsConsidered++;
+        }
 
         // Calculate the item geometry. The function also set m_bVisible, so we need to check is the item is visible after the calculation
-        bool roundLeftCorners = true;
-        bool roundRightCorners = true;
+        ItemFrame frame;
         QRect originalRect = m_rect;
-        CalculateItemRect(branchHeight, branchRowTop, roundLeftCorners, roundRightCorners);
+        CalculateItemRect(view, branchHeight, branchRowTop, frame);
 
         if (m_bVisible)
         {
             // Check if the parent branch mask
-            CheckParentBranchMask();
+            CheckParentBranchMask(view, frame);
 
             if (m_rect.isValid())
             {
                 m_bVisible = true;
 
-                // Draw the item background
-                DrawItemBackground(painter, roundLeftCorners, roundRightCorners, drawGradientBG);
-
-                // Draw the item selection frame is the item is selected
-                if (shouldUpdateGeometry)
+                if (view.m_bPaintBackgrounds)
                 {
-                    // Draw the selection frame only for the real item, not for the item shadow
-                    DrawSelection(painter);
+                    if (pStats != nullptr)
+                    {
+                        pStats->m_nItemsDrawn++;
+                    }
+
+                    // Draw the item background
+                    DrawItemBackground(painter, frame, drawGradientBG, drawFaded);
+
+                    // Draw the selection frame only for the real item, not for the item shadow.  Tiles are shared by all selection
+                    // and hover states, so the frame is not painted into tiles.  The timeline paints it on top of the tiles
+                    if (shouldUpdateGeometry && !view.m_bIsTiled)
+                    {
+                        DrawSelection(painter);
+                    }
 
-                    // Draw the item text
-                    DrawItemText(pTimeline, painter);
+                    painter.restore();
                 }
 
-                painter.restore();
+                // The label is painted after all the items of the row, since the next items (or the next tile) may paint over it
+                if (shouldUpdateGeometry && view.m_bPaintLabels && IsItemTextVisible(pTimeline))
+                {
+                    pTimeline->labelCache().addRowLabel(m_rect, m_foregroundColor, m_strText);
+                }
             }
             else
             {
@@ -356,89 +397,165 @@ void acTimelineItem::draw(QPainter& painter, const int branchRowTop, const int b
     }
 }
 
+bool acTimelineItem::drawBatched(acTimelineItemBatch& batch, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry, bool drawFaded)
+{
+    bool retVal = false;
+
+    if (isBatchable())
+    {
+        retVal = AddItemToBatch(batch, view, branchRowTop, branchHeight, drawGradientBG, shouldUpdateGeometry, drawFaded);
+    }
+
+    return retVal;
+}
 
-void acTimelineItem::DrawItemBackground(QPainter& painter, bool roundLeftCorners, bool roundRightCorners, bool drawGradientBG)
+bool acTimelineItem::AddItemToBatch(acTimelineItemBatch& batch, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry, bool drawFaded)
 {
     // Sanity check:
     GT_IF_WITH_ASSERT(m_pParentBranch != nullptr && m_pParentBranch->parentTimeline() != nullptr)
     {
         acTimeline* pTimeline = m_pParentBranch->parentTimeline();
-        QColor blockColor = m_backgroundColor;
-        QColor lightenedColor = lightenedBackgroundColor();
+        acTimelineFrameStats* pStats = pTimeline->frameStats();
 
-        if (!pTimeline->isEnabled())
+        if (pStats != nullptr)
         {
-            blockColor.setAlpha(32);
-            lightenedColor.setAlpha(32);
+            pStats->m_nItemsConsidered++;
         }
 
-        QPen pen = painter.pen();
-        painter.save();
-
-        int rectHeight = m_rect.height();
-        int rectWidth = m_rect.width();
+        // Same geometry and mask handling as draw.  The branch only batches the items when their backgrounds are painted
+        ItemFrame frame;
+        QRect originalRect = m_rect;
+        CalculateItemRect(view, branchHeight, branchRowTop, frame);
 
-        if (m_rect.width() == 1)
-        {
-            pen.setColor(blockColor);
-            painter.setPen(pen);
-            painter.drawLine(m_rect.topLeft(), m_rect.bottomLeft());
-        }
-        else if (rectHeight == 1)
-        {
-            pen.setColor(blockColor);
-            painter.setPen(pen);
-            painter.drawLine(m_rect.topLeft(), m_rect.topRight());
-        }
-        else
+        if (m_bVisible)
         {
-            // Clear the path
-            m_itemFramePath = QPainterPath();
+            CheckParentBranchMask(view, frame);
 
-            if (pTimeline->roundedRectangles() && rectHeight > 4 && rectWidth > 4)
+            if (m_rect.isValid())
             {
-                m_itemFramePath.addRoundedRect(m_rect, 4.0, 4.0);
+                m_bVisible = true;
+
+                if (pStats != nullptr)
+                {
+                    pStats->m_nItemsDrawn++;
+                }
+
+                QColor blockColor;
+                QColor lightenedColor;
+                GetItemBackgroundColors(pTimeline, drawFaded, blockColor, lightenedColor);
+
+                const QRect& frameRect = frame.m_frameRect;
 
-                if (!roundLeftCorners)
+                if (frameRect.width() == 1)
                 {
-                    // create a new path with a non-rounded left edge and union it with the rounded path
-                    // this causes square edges to be painted when a timeline item is partially scrolled off the left edge of the timeline
-                    QRect newRect(m_rect);
-                    newRect.setWidth(newRect.width() / 2);
+                    batch.addLine(QLine(frameRect.topLeft(), frameRect.bottomLeft()), blockColor);
+                }
+                else if (frameRect.height() == 1)
+                {
+                    batch.addLine(QLine(frameRect.topLeft(), frameRect.topRight()), blockColor);
+                }
+                else
+                {
+                    QColor gradientColor = (pTimeline->gradientPainting() && drawGradientBG) ? lightenedColor : blockColor;
 
-                    if (newRect.isValid())
+                    if (pTimeline->roundedRectangles() && frameRect.height() > 4 && frameRect.width() > 4)
+                    {
+                        BuildItemFramePath(pTimeline, frame);
+                        batch.addPath(GetItemGradientRect(frame), m_itemFramePath, blockColor, gradientColor);
+                    }
+                    else
                     {
-                        QPainterPath leftPath;
-                        leftPath.addRect(newRect);
-                        m_itemFramePath = m_itemFramePath.united(leftPath);
+                        batch.addRect(frameRect, GetItemGradientRect(frame), blockColor, gradientColor);
                     }
                 }
 
-                if (!roundRightCorners)
+                if (shouldUpdateGeometry)
                 {
-                    // create a new path with a non-rounded right edge and union it with the rounded path
-                    // this causes square edges to be painted when a timeline item is partially scrolled off the right edge of the timeline
-                    QRect newRect(m_rect);
-                    newRect.setX(newRect.x() + newRect.width() / 2);
+                    // The selection frame is only painted for the real item, not for the item shadow, and not into tiles (see draw)
+                    if (!view.m_bIsTiled && (IsSelected() || IsHighlighted()))
+                    {
+                        BuildItemFramePath(pTimeline, frame);
+                        batch.addSelection(this);
+                    }
 
-                    if (newRect.isValid())
+                    if (view.m_bPaintLabels && IsItemTextVisible(pTimeline))
                     {
-                        QPainterPath rightPath;
-                        rightPath.addRect(newRect);
-                        m_itemFramePath = m_itemFramePath.united(rightPath);
+                        pTimeline->labelCache().addRowLabel(m_rect, m_foregroundColor, m_strText);
                     }
                 }
             }
             else
             {
-                m_itemFramePath.addRect(m_rect);
+                m_bVisible = false;
             }
+        }
+
+        if (!shouldUpdateGeometry)
+        {
+            m_rect = originalRect;
+        }
+    }
+
+    return true;
+}
+
+void acTimelineItem::drawOverlay(QPainter& painter, const int branchRowTop, const int branchHeight)
+{
+    // Sanity check:
+    GT_IF_WITH_ASSERT(m_pParentBranch != nullptr && m_pParentBranch->parentTimeline() != nullptr)
+    {
+        acTimeline* pTimeline = m_pParentBranch->parentTimeline();
+
+        ItemFrame frame;
+        CalculateItemRect(pTimeline->rowView(), branchHeight, branchRowTop, frame);
+
+        if (m_bVisible && m_rect.isValid())
+        {
+            DrawItemBackground(painter, frame, true, false);
+            DrawSelection(painter);
+            DrawItemText(pTimeline, painter);
+            painter.restore();
+        }
+    }
+}
+
+void acTimelineItem::DrawItemBackground(QPainter& painter, const ItemFrame& frame, bool drawGradientBG, bool drawFaded)
+{
+    // Sanity check:
+    GT_IF_WITH_ASSERT(m_pParentBranch != nullptr && m_pParentBranch->parentTimeline() != nullptr)
+    {
+        acTimeline* pTimeline = m_pParentBranch->parentTimeline();
+        QColor blockColor;
+        QColor lightenedColor;
+        GetItemBackgroundColors(pTimeline, drawFaded, blockColor, lightenedColor);
+
+        QPen pen = painter.pen();
+        painter.save();
+
+        const QRect& frameRect = frame.m_frameRect;
+
+        if (frameRect.width() == 1)
+        {
+            pen.setColor(blockColor);
+            painter.setPen(pen);
+            painter.drawLine(frameRect.topLeft(), frameRect.bottomLeft());
+        }
+        else if (frameRect.height() == 1)
+        {
+            pen.setColor(blockColor);
+            painter.setPen(pen);
+            painter.drawLine(frameRect.topLeft(), frameRect.topRight());
+        }
+        else
+        {
+            BuildItemFramePath(pTimeline, frame);
 
             QBrush blockBrush;
 
             if (pTimeline->gradientPainting() && drawGradientBG)
             {
-                QLinearGradient gradient(m_rect.topLeft(), m_rect.bottomRight());
+                QRectF gradientRect = GetItemGradientRect(frame);
+                QLinearGradient gradient(gradientRect.topLeft(), gradientRect.bottomRight());
                 gradient.setColorAt(0.0, blockColor);
                 gradient.setColorAt(1.0, lightenedColor);
                 blockBrush = QBrush(gradient);
@@ -453,59 +570,150 @@ void acTimelineItem::DrawItemBackground(QPainter& painter, bool roundLeftCorners
     }
 }
 
+void acTimelineItem::BuildItemFramePath(acTimeline* pTimeline, const ItemFrame& frame)
+{
+    // Clear the path
+    m_itemFramePath = QPainterPath();
+
+    const QRect& frameRect = frame.m_frameRect;
+
+    if (pTimeline->roundedRectangles() && frameRect.height() > 4 && frameRect.width() > 4)
+    {
+        m_itemFramePath.addRoundedRect(frameRect, 4.0, 4.0);
+
+        if (!frame.m_bRoundLeftCorners)
+        {
+            // create a new path with a non-rounded left edge and union it with the rounded path
+            // this causes square edges to be painted when a timeline item is partially scrolled off the left edge of the timeline
+            QRect newRect(frameRect);
+            newRect.setWidth(newRect.width() / 2);
+
+            if (newRect.isValid())
+            {
+                QPainterPath leftPath;
+                leftPath.addRect(newRect);
+                m_itemFramePath = m_itemFramePath.united(leftPath);
+            }
+        }
+
+        if (!frame.m_bRoundRightCorners)
+        {
+            // create a new path with a non-rounded right edge and union it with the rounded path
+            // this causes square edges to be painted when a timeline item is partially scrolled off the right edge of the timeline
+            QRect newRect(frameRect);
+            newRect.setX(newRect.x() + newRect.width() / 2);
+
+            if (newRect.isValid())
+            {
+                QPainterPath rightPath;
+                rightPath.addRect(newRect);
+                m_itemFramePath = m_itemFramePath.united(rightPath);
+            }
+        }
+    }
+    else
+    {
+        m_itemFramePath.addRect(frameRect);
+    }
+}
+
+QRectF acTimelineItem::GetItemGradientRect(const ItemFrame& frame)
+{
+    // the gradient spans the whole item, from the top left to the bottom right pixel, wherever the item is trimmed
+    const QRect& frameRect = frame.m_frameRect;
+    return QRectF(QPointF(frame.m_nLeft, frameRect.top()), QPointF(frame.m_nLeft + frame.m_nWidth - 1, frameRect.bottom()));
+}
+
+void acTimelineItem::GetItemBackgroundColors(acTimeline* pTimeline, bool drawFaded, QColor& blockColor, QColor& lightenedColor)
+{
+    blockColor = m_backgroundColor;
+    lightenedColor = lightenedBackgroundColor();
+
+    if (drawFaded)
+    {
+        blockColor.setAlpha(AC_TIMELINE_FADED_ITEM_ALPHA);
+    }
+
+    if (!pTimeline->isEnabled())
+    {
+        blockColor.setAlpha(32);
+        lightenedColor.setAlpha(32);
+    }
+}
+
+bool acTimelineItem::IsItemTextVisible(acTimeline* pTimeline) const
+{
+    return pTimeline->labelCache().isTextVisible(m_rect);
+}
+
 void acTimelineItem::DrawItemText(acTimeline* pTimeline, QPainter& painter)
 {
     // Sanity check:
     GT_IF_WITH_ASSERT(pTimeline != nullptr)
     {
         QPen pen = painter.pen();
-        QFontMetrics fontMet = pTimeline->fontMetrics();
 
-        if (m_rect.width() > fontMet.averageCharWidth() && m_rect.height() >= fontMet.lineSpacing())
+        if (IsItemTextVisible(pTimeline))
         {
             pen.setColor(m_foregroundColor);
             painter.setPen(pen);
-            painter.drawText(m_rect, Qt::AlignCenter, m_strText);
+
+            // the label is laid out once and reused by later paints, rather than shaped on every paint
+            if (pTimeline->labelCache().drawLabel(painter, m_rect, m_strText))
+            {
+                acTimelineFrameStats* pStats = pTimeline->frameStats();
+
+                if (pStats != nullptr)
+                {
+                    pStats->m_nTextDraws++;
+                }
+            }
         }
     }
 }
 
-void acTimelineItem::CheckParentBranchMask()
+void acTimelineItem::CheckParentBranchMask(const acTimelineRowView& view, const ItemFrame& frame)
 {
     // Sanity check:
     GT_IF_WITH_ASSERT(m_pParentBranch != nullptr && m_pParentBranch->parentTimeline() != nullptr)
     {
         acTimeline* pTimeline = m_pParentBranch->parentTimeline();
-        int rowWidth = pTimeline->rowWidth();
-        int titleWidth = pTimeline->titleWidth();
+        int maskIndex = frame.m_nLeft - view.m_nMaskLeft;
 
-        // if (enable mask on the branch), check parent mask
-        if (m_pParentBranch->isMaskEnabled())
+        // if (enable mask on the branch), check parent mask.  The items starting out of the mask are neither masked nor masking
+        if (m_pParentBranch->isMaskEnabled() && maskIndex >= 0 && maskIndex < view.maskWidth())
         {
-            int maskIndex = m_rect.x() - titleWidth;
-            maskIndex = maskIndex > rowWidth - 1 ? rowWidth - 1 : maskIndex;
-            maskIndex = maskIndex < 0 ? 0 : maskIndex;
+            // the mask is indexed by the untrimmed start and width of the item, which do not depend on the painted area
+            QRect maskRect(frame.m_nLeft, m_rect.y(), frame.m_nWidth, m_rect.height());
+            bool isCrossingTileEdge = (maskIndex % AC_TIMELINE_TILE_WIDTH) + frame.m_nWidth > AC_TIMELINE_TILE_WIDTH;
 
-            if (m_pParentBranch->getMaskBuffer()->checkMask(maskIndex, m_rect))
+            if (!isCrossingTileEdge && m_pParentBranch->getMaskBuffer()->checkMask(maskIndex, maskRect))
             {
                 m_rect.setWidth(-1);
                 m_rect.setHeight(-1);
                 m_bVisible = false;
+
+                acTimelineFrameStats* pStats = view.m_bPaintBackgrounds ? pTimeline->frameStats() : nullptr;
+
+                if (pStats != nullptr)
+                {
+                    pStats->m_nMaskRejects++;
+                }
             }
             else
             {
-                m_pParentBranch->getMaskBuffer()->setMask(maskIndex, m_rect);
+                m_pParentBranch->getMaskBuffer()->setMask(maskIndex, maskRect);
             }
         }
     }
 }
 
-void acTimelineItem::CalculateItemRect(const int branchHeight, const int branchRowTop, bool& roundLeftCorners, bool& roundRightCorners)
+void acTimelineItem::CalculateItemRect(const acTimelineRowView& view, const int branchHeight, const int branchRowTop, ItemFrame& frame)
 {
     // Sanity check:
     GT_IF_WITH_ASSERT(m_pParentBranch != nullptr && m_pParentBranch->parentTimeline() != nullptr)
     {
-        acTimeline* pTimeline = m_pParentBranch->parentTimeline();
+        const acTimelineTimeTransform& timeTransform = view.m_timeTransform;
 
         int itemX = 0, itemY = 0, itemWidth = -1, itemHeight = -1;
         m_rect.setWidth(-1);
@@ -513,16 +721,16 @@ void acTimelineItem::CalculateItemRect(const int branchHeight, const int branchR
         m_bVisible = false;
 
         // Check visibility
-        if (m_nEndTime >= pTimeline->visibleStartTime() && (m_nStartTime <= (pTimeline->visibleStartTime() + pTimeline->visibleRange())))
+        if (m_nEndTime >= view.m_nVisibleStartTime && m_nStartTime <= view.visibleEndTime())
         {
             m_bVisible = true;
             // calculate width
-            double dblWidth = (m_nEndTime - m_nStartTime) * pTimeline->invRange() * pTimeline->renderWidth();
+            double dblWidth = timeTransform.durationToWidth(m_nEndTime - m_nStartTime);
             itemWidth = 1;
 
             if (dblWidth > 1)
             {
-                itemWidth = (int)dblWidth;
+                itemWidth = (int)qMin(dblWidth, (double)AC_TIMELINE_MAX_PIXEL_COORD);
             }
 
             // calculate top and height
@@ -547,8 +755,24 @@ void acTimelineItem::CalculateItemRect(const int branchHeight, const int branchR
                 }
             }
 
-            int titleWidth = pTimeline->titleWidth();
-            itemX = titleWidth + pTimeline->getXCoordOfTime(m_nStartTime);
+            // For items with the same start and end time, draw a point:
+            if (m_itemShape != AC_TIMELINE_RECTANGLE)
+            {
+                itemWidth = 2;
+
+                if (m_itemShape == AC_TIMELINE_DOT)
+                {
+                    itemHeight = 4;
+                    itemY = itemY + branchHeight - itemHeight;
+                }
+            }
+
+            int titleWidth = view.m_nLeft;
+            int rowRight = titleWidth + view.m_nWidth;
+            itemX = titleWidth + timeTransform.timeToColumn(m_nStartTime);
+
+            frame.m_nLeft = itemX;
+            frame.m_nWidth = itemWidth;
 
             if (itemX + itemWidth <= titleWidth)
             {
@@ -556,36 +780,24 @@ void acTimelineItem::CalculateItemRect(const int branchHeight, const int branchR
             }
             else
             {
-                roundLeftCorners = true;
-                roundRightCorners = true;
-
-                if (itemX < titleWidth && itemX + itemWidth > titleWidth)
+                // the frame is trimmed out of the area, so the item ends which are trimmed are not rounded, and are never painted
+                int frameLeft = qMax(itemX, titleWidth - AC_TIMELINE_ITEM_FRAME_MARGIN);
+                int frameRight = qMin(itemX + itemWidth, rowRight + AC_TIMELINE_ITEM_FRAME_MARGIN);
+                frame.m_bRoundLeftCorners = frameLeft == itemX;
+                frame.m_bRoundRightCorners = frameRight == itemX + itemWidth;
+                frame.m_frameRect = QRect(frameLeft, itemY, frameRight - frameLeft, itemHeight - 2);
+
+                if (itemX < titleWidth)
                 {
-                    // trim left -- don't use a rounded edge when painting the left edge
+                    // trim left
                     itemWidth = itemX + itemWidth - titleWidth;
                     itemX = titleWidth;
-                    roundLeftCorners = false;
-                }
-
-                int rowWidth = pTimeline->rowWidth();
-
-                if (itemX + itemWidth > titleWidth + rowWidth)
-                {
-                    // trim right -- don't use a rounded edge when painting the right edge
-                    itemWidth = titleWidth + rowWidth - itemX;
-                    roundRightCorners = false;
                 }
 
-                // For items with the same start and end time, draw a point:
-                if (m_itemShape != AC_TIMELINE_RECTANGLE)
+                if (itemX + itemWidth > rowRight)
                 {
-                    itemWidth = 2;
-
-                    if (m_itemShape == AC_TIMELINE_DOT)
-                    {
-                        itemHeight = 4;
-                        itemY = itemY + branchHeight - itemHeight;
-                    }
+                    // trim right
+                    itemWidth = rowRight - itemX;
                 }
             }
 
@@ -644,6 +856,34 @@ bool acTimelineItemToolTip::add(QString name, QString value)
     return false;
 }
 
+bool acTimelineItemToolTip::addTime(QString name, double time)
+{
+    ToolTipItem* newToolTipItem = new(std::nothrow) ToolTipItem(name, VALUE_MILLISECONDS, time);
+    Q_ASSERT(newToolTipItem != NULL);
+
+    if (newToolTipItem != NULL)
+    {
+        m_tooltipItems.push_back(newToolTipItem);
+        return true;
+    }
+
+    return false;
+}
+
+bool acTimelineItemToolTip::addDuration(QString name, quint64 duration)
+{
+    ToolTipItem* newToolTipItem = new(std::nothrow) ToolTipItem(name, VALUE_DURATION, (double)duration);
+    Q_ASSERT(newToolTipItem != NULL);
+
+    if (newToolTipItem != NULL)
+    {
+        m_tooltipItems.push_back(newToolTipItem);
+        return true;
+    }
+
+    return false;
+}
+
 bool acTimelineItemToolTip::remove(int index)
 {
     if (index >= 0 && index < m_tooltipItems.count())
@@ -671,12 +911,54 @@ QString acTimelineItemToolTip::getValue(int index) const
 {
     if (index >= 0 && index < m_tooltipItems.count())
     {
-        return m_tooltipItems[index]->m_strValue;
+        const ToolTipItem* item = m_tooltipItems[index];
+        return (item->m_format == VALUE_TEXT) ? item->m_strValue : formatNumber(item->m_format, item->m_dNumber);
     }
 
     return NULL;
 }
 
+acTimelineItemToolTip::ValueFormat acTimelineItemToolTip::getFormat(int index) const
+{
+    if (index >= 0 && index < m_tooltipItems.count())
+    {
+        return m_tooltipItems[index]->m_format;
+    }
+
+    return VALUE_TEXT;
+}
+
+double acTimelineItemToolTip::getNumber(int index) const
+{
+    if (index >= 0 && index < m_tooltipItems.count())
+    {
+        return m_tooltipItems[index]->m_dNumber;
+    }
+
+    return 0;
+}
+
+QString acTimelineItemToolTip::formatNumber(ValueFormat format, double number)
+{
+    QString retVal;
+
+    switch (format)
+    {
+        case VALUE_MILLISECONDS:
+            retVal = QString(acTimelineItem::tr("%1 millisecond")).arg(number / 1e6, 0, 'f', 3);
+            break;
+
+        case VALUE_DURATION:
+            retVal = QString(acTimelineItem::tr("%1 millisecond")).arg(NanosecToTimeString(number, true, false));
+            break;
+
+        default:
+            break;
+    }
+
+    return retVal;
+}
+
 void acTimelineItemToolTip::clear()
 {
     for (QList<ToolTipItem*>::iterator i = m_tooltipItems.begin(); i != m_tooltipItems.end(); ++i)
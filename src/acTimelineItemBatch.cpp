@@ -0,0 +1,166 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineItemBatch.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Qt:
+#include <QLinearGradient>
+#include <QPainter>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItem.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemBatch.h>
+
+acTimelineItemBatch::acTimelineItemBatch() : m_nUsedBuckets(0)
+{
+}
+
+void acTimelineItemBatch::addLine(const QLine& line, const QColor& color)
+{
+    bucket(color, color).m_lines.append(line);
+}
+
+void acTimelineItemBatch::addRect(const QRect& rect, const QRectF& gradientRect, const QColor& color, const QColor& gradientColor)
+{
+    Bucket& currentBucket = bucket(color, gradientColor);
+    currentBucket.m_rects.append(rect);
+
+    // solid rectangles are painted with a single drawRects call, so only the gradient rectangles are kept
+    if (gradientColor != color)
+    {
+        currentBucket.m_rectGradients.append(gradientRect);
+    }
+}
+
+void acTimelineItemBatch::addPath(const QRectF& gradientRect, const QPainterPath& path, const QColor& color, const QColor& gradientColor)
+{
+    Bucket& currentBucket = bucket(color, gradientColor);
+    currentBucket.m_pathGradients.append(gradientRect);
+    currentBucket.m_paths.append(path);
+}
+
+void acTimelineItemBatch::addSelection(acTimelineItem* pItem)
+{
+    m_selections.append(pItem);
+}
+
+acTimelineItemBatch::Bucket& acTimelineItemBatch::bucket(const QColor& color, const QColor& gradientColor)
+{
+    QPair<QRgb, QRgb> key(color.rgba(), gradientColor.rgba());
+    QHash<QPair<QRgb, QRgb>, int>::const_iterator i = m_bucketIndex.find(key);
+
+    if (i != m_bucketIndex.end())
+    {
+        return m_buckets[i.value()];
+    }
+
+    if (m_nUsedBuckets == m_buckets.count())
+    {
+        m_buckets.append(Bucket());
+    }
+
+    Bucket& newBucket = m_buckets[m_nUsedBuckets];
+    newBucket.m_color = color;
+    newBucket.m_gradientColor = gradientColor;
+    m_bucketIndex.insert(key, m_nUsedBuckets++);
+
+    return newBucket;
+}
+
+void acTimelineItemBatch::fillBackground(QPainter& painter, const Bucket& currentBucket, const QRectF& gradientRect, const QRect* pRect, const QPainterPath* pPath)
+{
+    QBrush brush;
+
+    if (currentBucket.m_gradientColor != currentBucket.m_color)
+    {
+        QLinearGradient gradient(gradientRect.topLeft(), gradientRect.bottomRight());
+        gradient.setColorAt(0.0, currentBucket.m_color);
+        gradient.setColorAt(1.0, currentBucket.m_gradientColor);
+        brush = QBrush(gradient);
+    }
+    else
+    {
+        brush = QBrush(currentBucket.m_color);
+    }
+
+    if (pRect != nullptr)
+    {
+        painter.fillRect(*pRect, brush);
+    }
+    else
+    {
+        painter.fillPath(*pPath, brush);
+    }
+}
+
+void acTimelineItemBatch::flush(QPainter& painter)
+{
+    if (isEmpty())
+    {
+        return;
+    }
+
+    painter.save();
+
+    // the lines and frames are painted with the current pen, only changing its color (as when painting the items one by one)
+    QPen originalPen = painter.pen();
+    QPen pen = originalPen;
+
+    for (int bucketIndex = 0; bucketIndex < m_nUsedBuckets; ++bucketIndex)
+    {
+        Bucket& currentBucket = m_buckets[bucketIndex];
+
+        if (!currentBucket.m_lines.isEmpty())
+        {
+            pen.setColor(currentBucket.m_color);
+            painter.setPen(pen);
+            painter.drawLines(currentBucket.m_lines);
+        }
+
+        if (!currentBucket.m_rects.isEmpty())
+        {
+            if (currentBucket.m_gradientColor == currentBucket.m_color)
+            {
+                painter.setPen(Qt::NoPen);
+                painter.setBrush(currentBucket.m_color);
+                painter.drawRects(currentBucket.m_rects);
+            }
+            else
+            {
+                for (int rectIndex = 0; rectIndex < currentBucket.m_rects.count(); ++rectIndex)
+                {
+                    fillBackground(painter, currentBucket, currentBucket.m_rectGradients[rectIndex], &currentBucket.m_rects[rectIndex], nullptr);
+                }
+            }
+        }
+
+        for (int pathIndex = 0; pathIndex < currentBucket.m_paths.count(); ++pathIndex)
+        {
+            fillBackground(painter, currentBucket, currentBucket.m_pathGradients[pathIndex], nullptr, &currentBucket.m_paths[pathIndex]);
+        }
+
+        // resize rather than clear, so that the storage is reused by the next batch
+        currentBucket.m_lines.resize(0);
+        currentBucket.m_rects.resize(0);
+        currentBucket.m_rectGradients.resize(0);
+        currentBucket.m_pathGradients.resize(0);
+        currentBucket.m_paths.resize(0);
+    }
+
+    painter.setPen(originalPen);
+
+    for (QList<acTimelineItem*>::const_iterator i = m_selections.begin(); i != m_selections.end(); ++i)
+    {
+        (*i)->DrawSelection(painter);
+    }
+
+    painter.restore();
+
+    m_nUsedBuckets = 0;
+    m_bucketIndex.clear();
+    m_selections.clear();
+}
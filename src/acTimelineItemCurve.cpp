@@ -6,6 +6,12 @@
 ///
 //==================================================================================
 
+#include <algorithm>
+#include <limits>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
 // Local:
 #include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
@@ -22,53 +28,102 @@ acTimelineItemCurve::acTimelineItemCurve() :
     //propagatable = false
 }
 
-void acTimelineItemCurve::draw(QPainter& painter, const int branchRowTop, const int branchHeight)
+void acTimelineItemCurve::draw(QPainter& painter, const acTimelineRowView& view, const int branchRowTop, const int branchHeight, bool drawGradientBG, bool shouldUpdateGeometry, bool drawFaded)
 {
+    GT_UNREFERENCED_PARAMETER(drawGradientBG);
 
-    acTimeline* timeline = m_pParentBranch->parentTimeline();
-    int titleWidth = timeline->titleWidth();
+    int titleWidth = view.m_nLeft;
+    const acTimelineTimeTransform& timeTransform = view.m_timeTransform;
 
+    if (shouldUpdateGeometry)
+    {
+        // the rectangle spans the samples, so that the curve is kept in the branch draw cache
+        ItemFrame frame;
+        CalculateItemRect(view, branchHeight, branchRowTop, frame);
+    }
+
+    // a curve has no label
+    if (!view.m_bPaintBackgrounds)
+    {
+        return;
+    }
 
-    m_pointBuffer.clear();
+    m_pointBuffer.resize(0);
 
+    int sampleCount = m_sampleTimes.count();
 
-    //if (m_pointBuffer.empty() || m_pointBuffer.count() != m_samplePairs.count())
+    if (sampleCount > 0)
     {
-        //for(QList<quint64>::const_iterator it = m_samplePairs.keys().constBegin(); it != m_samplePairs.keys().constEnd(); ++it)
-        for (QMap<quint64, float>::const_iterator it = m_samplePairs.constBegin(); it != m_samplePairs.constEnd(); ++it)
-            //quint64 key;
-            //foreach(key, m_samplePairs.keys())
+        quint64 visibleStartTime = view.m_nVisibleStartTime;
+        quint64 visibleEndTime = view.visibleEndTime();
+
+        // include the samples just outside of the visible range, so that the curve reaches the edges of the row
+        int firstSample = std::lower_bound(m_sampleTimes.constBegin(), m_sampleTimes.constEnd(), visibleStartTime) - m_sampleTimes.constBegin();
+        int endSample = std::upper_bound(m_sampleTimes.constBegin(), m_sampleTimes.constEnd(), visibleEndTime) - m_sampleTimes.constBegin();
+
+        if (firstSample > 0)
+        {
+            firstSample--;
+        }
+
+        if (endSample < sampleCount)
+        {
+            endSample++;
+        }
+
+        int sample = firstSample;
+
+        while (sample < endSample)
         {
-            //if (key >= timeline->visibleStartTime() && key <= timeline->visibleStartTime() + timeline->visibleRange())
+            int x = timeTransform.timeToPixel(m_sampleTimes[sample]);
+            int sampleEnd = columnEnd(timeTransform, sample, endSample, x);
+            int lastSample = sampleEnd - 1;
+            x += titleWidth;
+
+            appendPoint(QPoint(x, (int)(branchRowTop + (branchHeight * (m_sampleValues[sample] * m_dInvMaxValue)))));
+
+            if (lastSample - sample > 1)
             {
-                int x = timeline->getXCoordOfTime(it.key());
-                double val = it.value() * m_dInvMaxValue;
-                QPoint p = QPoint(x + titleWidth, (int)(branchRowTop + (branchHeight * val)));
-                m_pointBuffer.push_back(p);
+                float minValue;
+                float maxValue;
+                rangeMinMax(sample + 1, lastSample, minValue, maxValue);
+                appendPoint(QPoint(x, (int)(branchRowTop + (branchHeight * (minValue * m_dInvMaxValue)))));
+                appendPoint(QPoint(x, (int)(branchRowTop + (branchHeight * (maxValue * m_dInvMaxValue)))));
             }
+
+            if (lastSample > sample)
+            {
+                appendPoint(QPoint(x, (int)(branchRowTop + (branchHeight * (m_sampleValues[lastSample] * m_dInvMaxValue)))));
+            }
+
+            sample = sampleEnd;
         }
     }
 
     QPen pen = painter.pen();
     painter.save();
 
-    painter.setClipRect(QRect(titleWidth, branchRowTop, timeline->rowWidth(), branchHeight));
-    pen.setColor(backgroundColor());
+    painter.setClipRect(QRect(titleWidth, branchRowTop, view.m_nWidth, branchHeight));
+    QColor curveColor = backgroundColor();
+
+    if (drawFaded)
+    {
+        curveColor.setAlpha(AC_TIMELINE_FADED_ITEM_ALPHA);
+    }
+
+    pen.setColor(curveColor);
     painter.setPen(pen);
 
-    //painter.drawLines(m_pointBuffer);
-    QPoint point;
     QPainterPath path;
     bool first = true;
 
     if (m_bSolid)
     {
-        path.moveTo(timeline->getXCoordOfTime(m_nMinTime) + titleWidth, branchRowTop + branchHeight);
+        path.moveTo(timeTransform.timeToPixel(m_nMinTime) + titleWidth, branchRowTop + branchHeight);
         first = false;
     }
 
-    for (QVector<QPoint>::const_iterator it = m_pointBuffer.constBegin(); it != m_pointBuffer.end(); ++it)
-        //foreach(point, m_pointBuffer)
+    for (QVector<QPoint>::const_iterator it = m_pointBuffer.constBegin(); it != m_pointBuffer.constEnd(); ++it)
     {
         if (first)
         {
@@ -85,24 +140,42 @@ void acTimelineItemCurve::draw(QPainter& painter, const int branchRowTop, const
 
     if (m_bSolid)
     {
-        path.lineTo(timeline->getXCoordOfTime(m_nMaxTime) + titleWidth, branchRowTop + branchHeight);
-        path.lineTo(timeline->getXCoordOfTime(m_nMinTime) + titleWidth, branchRowTop + branchHeight);
-        painter.fillPath(path, QBrush(backgroundColor()));
+        path.lineTo(timeTransform.timeToPixel(m_nMaxTime) + titleWidth, branchRowTop + branchHeight);
+        path.lineTo(timeTransform.timeToPixel(m_nMinTime) + titleWidth, branchRowTop + branchHeight);
+        painter.fillPath(path, QBrush(curveColor));
     }
 
     painter.restore();
 }
 
+void acTimelineItemCurve::drawOverlay(QPainter& painter, const int branchRowTop, const int branchHeight)
+{
+    GT_UNREFERENCED_PARAMETER(painter);
+    GT_UNREFERENCED_PARAMETER(branchRowTop);
+    GT_UNREFERENCED_PARAMETER(branchHeight);
+}
+
 void acTimelineItemCurve::addTimestampValuePair(quint64 timeStamp, float value)
 {
+    bool isRangeExtended = false;
+
     if (timeStamp > m_nMaxTime)
     {
         m_nMaxTime = timeStamp;
+        isRangeExtended = true;
     }
 
     if (timeStamp < m_nMinTime)
     {
         m_nMinTime = timeStamp;
+        isRangeExtended = true;
+    }
+
+    if (isRangeExtended)
+    {
+        // the end time is set first, since the start time is clamped to it
+        setEndTime(m_nMaxTime);
+        setStartTime(m_nMinTime);
     }
 
     if (value > m_fMaxValue)
@@ -111,6 +184,152 @@ void acTimelineItemCurve::addTimestampValuePair(quint64 timeStamp, float value)
         m_dInvMaxValue = 1 / (double)m_fMaxValue;
     }
 
-    m_samplePairs[timeStamp] = value;
+    int changedSample = m_sampleTimes.count();
+
+    if (m_sampleTimes.isEmpty() || timeStamp > m_sampleTimes.last())
+    {
+        // samples usually arrive in order, so they are appended
+        m_sampleTimes.append(timeStamp);
+        m_sampleValues.append(value);
+    }
+    else
+    {
+        changedSample = std::lower_bound(m_sampleTimes.constBegin(), m_sampleTimes.constEnd(), timeStamp) - m_sampleTimes.constBegin();
+
+        if (m_sampleTimes[changedSample] == timeStamp)
+        {
+            m_sampleValues[changedSample] = value;
+        }
+        else
+        {
+            m_sampleTimes.insert(changedSample, timeStamp);
+            m_sampleValues.insert(changedSample, value);
+        }
+    }
+
+    updatePyramidTail(changedSample);
+}
+
+void acTimelineItemCurve::updatePyramidTail(int firstSample)
+{
+    int firstChanged = firstSample;
+    int lowerCount = m_sampleValues.count();
+    int level = 0;
+
+    while (lowerCount > 1)
+    {
+        int blockCount = (lowerCount + 1) / 2;
+
+        if (level == m_minLevels.count())
+        {
+            m_minLevels.append(QVector<float>());
+            m_maxLevels.append(QVector<float>());
+        }
+
+        QVector<float>& minLevel = m_minLevels[level];
+        QVector<float>& maxLevel = m_maxLevels[level];
+        minLevel.resize(blockCount);
+        maxLevel.resize(blockCount);
+
+        // the blocks of level 0 are made of samples, the blocks of the upper levels are made of two blocks of the level below
+        const float* pLowerMin = (level == 0) ? m_sampleValues.constData() : m_minLevels[level - 1].constData();
+        const float* pLowerMax = (level == 0) ? m_sampleValues.constData() : m_maxLevels[level - 1].constData();
+
+        firstChanged /= 2;
+
+        for (int block = firstChanged; block < blockCount; ++block)
+        {
+            int left = block * 2;
+            int right = qMin(left + 1, lowerCount - 1);
+            minLevel[block] = qMin(pLowerMin[left], pLowerMin[right]);
+            maxLevel[block] = qMax(pLowerMax[left], pLowerMax[right]);
+        }
+
+        lowerCount = blockCount;
+        level++;
+    }
+}
+
+void acTimelineItemCurve::rangeMinMax(int firstSample, int endSample, float& minValue, float& maxValue) const
+{
+    minValue = m_sampleValues[firstSample];
+    maxValue = minValue;
+
+    int sample = firstSample;
+
+    while (sample < endSample)
+    {
+        // use the largest block starting at the current sample which ends within the range
+        int level = -1;
+
+        while (level + 1 < m_minLevels.count())
+        {
+            int blockSize = 2 << (level + 1);
+
+            if ((sample & (blockSize - 1)) != 0 || sample + blockSize > endSample)
+            {
+                break;
+            }
+
+            level++;
+        }
+
+        if (level < 0)
+        {
+            minValue = qMin(minValue, m_sampleValues[sample]);
+            maxValue = qMax(maxValue, m_sampleValues[sample]);
+            sample++;
+        }
+        else
+        {
+            int block = sample >> (level + 1);
+            minValue = qMin(minValue, m_minLevels[level][block]);
+            maxValue = qMax(maxValue, m_maxLevels[level][block]);
+            sample += 2 << level;
+        }
+    }
+}
+
+int acTimelineItemCurve::columnEnd(const acTimelineTimeTransform& timeTransform, int firstSample, int endSample, int x) const
+{
+    // the X coordinate does not decrease with time, so the column is found with an exponential search followed by a binary search
+    int inColumn = firstSample;
+    int pastColumn = endSample;
+    int step = 1;
+
+    while (inColumn + step < endSample)
+    {
+        if (timeTransform.timeToPixel(m_sampleTimes[inColumn + step]) > x)
+        {
+            pastColumn = inColumn + step;
+            break;
+        }
+
+        inColumn += step;
+        step *= 2;
+    }
+
+    while (pastColumn - inColumn > 1)
+    {
+        int middle = (inColumn + pastColumn) / 2;
+
+        if (timeTransform.timeToPixel(m_sampleTimes[middle]) > x)
+        {
+            pastColumn = middle;
+        }
+        else
+        {
+            inColumn = middle;
+        }
+    }
+
+    return pastColumn;
 }
 
+void acTimelineItemCurve::appendPoint(const QPoint& point)
+{
+    if (m_pointBuffer.isEmpty() || m_pointBuffer.last() != point)
+    {
+        m_pointBuffer.append(point);
+    }
+}
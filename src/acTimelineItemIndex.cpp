@@ -0,0 +1,363 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineItemIndex.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <algorithm>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemIndex.h>
+
+void acTimelineItemIntervalIndex::clear()
+{
+    m_startTimes.clear();
+    m_endTimes.clear();
+    m_maxEndTimes.clear();
+    m_itemIndices.clear();
+    m_bBuilt = true;
+    m_bSorted = true;
+}
+
+void acTimelineItemIntervalIndex::reserve(int count)
+{
+    m_startTimes.reserve(count);
+    m_endTimes.reserve(count);
+    m_maxEndTimes.reserve(count);
+}
+
+void acTimelineItemIntervalIndex::append(quint64 startTime, quint64 endTime)
+{
+    if (m_bSorted && !m_startTimes.isEmpty() && startTime < m_startTimes.last())
+    {
+        m_bSorted = false;
+        m_bBuilt = false;
+    }
+
+    if (!m_itemIndices.isEmpty())
+    {
+        m_itemIndices.push_back(m_startTimes.count());
+    }
+
+    m_startTimes.push_back(startTime);
+    m_endTimes.push_back(endTime);
+
+    if (m_bBuilt)
+    {
+        // in-order append: extend the running maximum instead of rebuilding it
+        quint64 maxEndTime = m_maxEndTimes.isEmpty() ? endTime : std::max(m_maxEndTimes.last(), endTime);
+        m_maxEndTimes.push_back(maxEndTime);
+    }
+}
+
+void acTimelineItemIntervalIndex::build()
+{
+    if (m_bBuilt)
+    {
+        return;
+    }
+
+    int intervalCount = m_startTimes.count();
+
+    if (!m_bSorted)
+    {
+        // sort positions by start time.  A stable sort keeps items with equal start times in insertion order
+        QVector<int> sortedPositions(intervalCount);
+
+        for (int i = 0; i < intervalCount; ++i)
+        {
+            sortedPositions[i] = i;
+        }
+
+        const QVector<quint64>& startTimes = m_startTimes;
+        std::stable_sort(sortedPositions.begin(), sortedPositions.end(), [&startTimes](int a, int b) { return startTimes[a] < startTimes[b]; });
+
+        QVector<quint64> sortedStartTimes(intervalCount);
+        QVector<quint64> sortedEndTimes(intervalCount);
+        QVector<int> sortedItemIndices(intervalCount);
+
+        for (int i = 0; i < intervalCount; ++i)
+        {
+            int pos = sortedPositions[i];
+            sortedStartTimes[i] = m_startTimes[pos];
+            sortedEndTimes[i] = m_endTimes[pos];
+            sortedItemIndices[i] = itemIndex(pos);
+        }
+
+        m_startTimes.swap(sortedStartTimes);
+        m_endTimes.swap(sortedEndTimes);
+        m_itemIndices.swap(sortedItemIndices);
+        m_bSorted = true;
+    }
+
+    m_maxEndTimes.resize(intervalCount);
+    quint64 maxEndTime = 0;
+
+    for (int i = 0; i < intervalCount; ++i)
+    {
+        maxEndTime = std::max(maxEndTime, m_endTimes[i]);
+        m_maxEndTimes[i] = maxEndTime;
+    }
+
+    m_bBuilt = true;
+}
+
+bool acTimelineItemIntervalIndex::findOverlapping(quint64 rangeStart, quint64 rangeEnd, int& firstPos, int& lastPos) const
+{
+    firstPos = 0;
+    lastPos = 0;
+
+    Q_ASSERT(m_bBuilt);
+
+    if (m_bBuilt && !m_startTimes.isEmpty())
+    {
+        // intervals before firstPos all end before the window starts (the running maximum is non-decreasing)
+        firstPos = std::lower_bound(m_maxEndTimes.constBegin(), m_maxEndTimes.constEnd(), rangeStart) - m_maxEndTimes.constBegin();
+
+        // intervals at lastPos and after all start after the window ends
+        lastPos = std::upper_bound(m_startTimes.constBegin(), m_startTimes.constEnd(), rangeEnd) - m_startTimes.constBegin();
+    }
+
+    return firstPos < lastPos;
+}
+
+// The maximum number of buckets in the base level of a summary pyramid (the pyramid takes about twice this number of buckets)
+#define AC_TIMELINE_MAX_SUMMARY_BUCKETS (1 << 18)
+
+void acTimelineItemSummaryPyramid::clear()
+{
+    m_levels.clear();
+    m_currentColors.clear();
+    m_nStartTime = 0;
+    m_nBucketDuration = 1;
+    m_nItemCount = 0;
+    m_nTotalDuration = 0;
+    m_nLastStartTime = 0;
+    m_nCurrentBucket = -1;
+}
+
+void acTimelineItemSummaryPyramid::begin(quint64 startTime, quint64 endTime, int itemCount)
+{
+    clear();
+
+    // use about one bucket per item, rounded up to a power of two so that each upper level halves the bucket count
+    int baseBucketCount = 1;
+
+    while (baseBucketCount < itemCount && baseBucketCount < AC_TIMELINE_MAX_SUMMARY_BUCKETS)
+    {
+        baseBucketCount <<= 1;
+    }
+
+    quint64 range = (endTime > startTime) ? (endTime - startTime) : 1;
+    m_nStartTime = startTime;
+    m_nBucketDuration = (range + baseBucketCount - 1) / baseBucketCount;
+
+    if (m_nBucketDuration == 0)
+    {
+        m_nBucketDuration = 1;
+    }
+
+    Bucket emptyBucket = { 0, 0, 0, 0, 0, 0 };
+    m_levels.resize(1);
+    m_levels[0].fill(emptyBucket, baseBucketCount);
+}
+
+void acTimelineItemSummaryPyramid::addItem(quint64 startTime, quint64 endTime, QRgb color)
+{
+    if (m_levels.isEmpty())
+    {
+        return;
+    }
+
+    int index = bucketIndex(0, startTime);
+
+    if (index != m_nCurrentBucket)
+    {
+        flushCurrentBucket();
+        m_nCurrentBucket = index;
+    }
+
+    quint64 duration = (endTime > startTime) ? (endTime - startTime) : 0;
+    Bucket& bucket = m_levels[0][index];
+
+    if (bucket.m_count == 0 || duration < bucket.m_minDuration)
+    {
+        bucket.m_minDuration = duration;
+    }
+
+    if (duration > bucket.m_maxDuration)
+    {
+        bucket.m_maxDuration = duration;
+    }
+
+    if (endTime > bucket.m_maxEndTime)
+    {
+        bucket.m_maxEndTime = endTime;
+    }
+
+    bucket.m_count++;
+    m_nItemCount++;
+    m_nTotalDuration += duration;
+    m_nLastStartTime = startTime;
+
+    // accumulate the duration per color.  There are typically only a few distinct colors per bucket, so a linear search is fine.
+    // Zero-duration items still count, so that a bucket of instantaneous events gets a color
+    quint64 weight = duration + 1;
+    bool found = false;
+
+    for (int i = 0; i < m_currentColors.count(); ++i)
+    {
+        if (m_currentColors[i].first == color)
+        {
+            m_currentColors[i].second += weight;
+            found = true;
+            break;
+        }
+    }
+
+    if (!found)
+    {
+        m_currentColors.push_back(qMakePair(color, weight));
+    }
+}
+
+void acTimelineItemSummaryPyramid::updateCurrentBucketColor()
+{
+    if (m_nCurrentBucket >= 0 && !m_currentColors.isEmpty())
+    {
+        Bucket& bucket = m_levels[0][m_nCurrentBucket];
+        bucket.m_dominantColorDuration = 0;
+
+        for (int i = 0; i < m_currentColors.count(); ++i)
+        {
+            if (m_currentColors[i].second > bucket.m_dominantColorDuration)
+            {
+                bucket.m_dominantColor = m_currentColors[i].first;
+                bucket.m_dominantColorDuration = m_currentColors[i].second;
+            }
+        }
+    }
+}
+
+void acTimelineItemSummaryPyramid::flushCurrentBucket()
+{
+    updateCurrentBucketColor();
+
+    m_currentColors.clear();
+    m_nCurrentBucket = -1;
+}
+
+void acTimelineItemSummaryPyramid::mergeBuckets(const Bucket& left, const Bucket& right, Bucket& merged)
+{
+    // The dominant color of a merged bucket is the dominant color of the child whose dominant color covers more time,
+    // or the sum of both when the children agree (an approximation of the exact dominant color)
+    const Bucket& dominant = (right.m_dominantColorDuration > left.m_dominantColorDuration) ? right : left;
+    merged.m_count = left.m_count + right.m_count;
+    merged.m_dominantColor = dominant.m_dominantColor;
+    merged.m_dominantColorDuration = dominant.m_dominantColorDuration;
+
+    if (left.m_count > 0 && right.m_count > 0 && left.m_dominantColor == right.m_dominantColor)
+    {
+        merged.m_dominantColorDuration = left.m_dominantColorDuration + right.m_dominantColorDuration;
+    }
+
+    merged.m_maxDuration = std::max(left.m_maxDuration, right.m_maxDuration);
+    merged.m_maxEndTime = std::max(left.m_maxEndTime, right.m_maxEndTime);
+
+    if (left.m_count == 0)
+    {
+        merged.m_minDuration = right.m_minDuration;
+    }
+    else if (right.m_count == 0)
+    {
+        merged.m_minDuration = left.m_minDuration;
+    }
+    else
+    {
+        merged.m_minDuration = std::min(left.m_minDuration, right.m_minDuration);
+    }
+}
+
+void acTimelineItemSummaryPyramid::finish()
+{
+    // the colors of the last bucket are kept, so that appendItem can keep accumulating them
+    updateCurrentBucketColor();
+
+    if (m_levels.isEmpty())
+    {
+        return;
+    }
+
+    // each upper level merges pairs of buckets of the level below
+    while (m_levels.last().count() > 1)
+    {
+        const QVector<Bucket>& lowerLevel = m_levels.last();
+        int upperCount = lowerLevel.count() / 2;
+        QVector<Bucket> upperLevel(upperCount);
+
+        for (int i = 0; i < upperCount; ++i)
+        {
+            mergeBuckets(lowerLevel[i * 2], lowerLevel[i * 2 + 1], upperLevel[i]);
+        }
+
+        m_levels.push_back(upperLevel);
+    }
+}
+
+bool acTimelineItemSummaryPyramid::appendItem(quint64 startTime, quint64 endTime, QRgb color)
+{
+    // the item must start after the summarized items, within the time range covered by the base level
+    if (m_levels.isEmpty() || startTime < m_nStartTime || startTime < m_nLastStartTime ||
+        (startTime - m_nStartTime) / m_nBucketDuration >= (quint64)m_levels[0].count())
+    {
+        return false;
+    }
+
+    addItem(startTime, endTime, color);
+    updateCurrentBucketColor();
+
+    // only the buckets above the updated base bucket change
+    int index = m_nCurrentBucket;
+
+    for (int level = 1; level < m_levels.count(); ++level)
+    {
+        index >>= 1;
+        mergeBuckets(m_levels[level - 1][index * 2], m_levels[level - 1][index * 2 + 1], m_levels[level][index]);
+    }
+
+    return true;
+}
+
+int acTimelineItemSummaryPyramid::levelForResolution(double maxBucketDuration) const
+{
+    int retVal = -1;
+
+    for (int level = 0; level < m_levels.count(); ++level)
+    {
+        if ((double)bucketDuration(level) > maxBucketDuration)
+        {
+            break;
+        }
+
+        retVal = level;
+    }
+
+    return retVal;
+}
+
+int acTimelineItemSummaryPyramid::bucketIndex(int level, quint64 time) const
+{
+    int retVal = 0;
+
+    if (time > m_nStartTime)
+    {
+        quint64 index = (time - m_nStartTime) / bucketDuration(level);
+        int lastIndex = m_levels[level].count() - 1;
+        retVal = (index > (quint64)lastIndex) ? lastIndex : (int)index;
+    }
+
+    return retVal;
+}
@@ -0,0 +1,118 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineItemStore.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <limits>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemStore.h>
+
+bool acTimelineItemView::isValid() const
+{
+    return m_pStore != nullptr && m_nIndex >= 0 && m_nIndex < m_pStore->count();
+}
+
+quint64 acTimelineItemView::startTime() const
+{
+    return m_pStore->startTime(m_nIndex);
+}
+
+quint64 acTimelineItemView::endTime() const
+{
+    return m_pStore->endTime(m_nIndex);
+}
+
+QColor acTimelineItemView::backgroundColor() const
+{
+    return QColor::fromRgba(m_pStore->backgroundColor(m_nIndex));
+}
+
+const QString& acTimelineItemView::text() const
+{
+    return m_pStore->text(m_nIndex);
+}
+
+quint8 acTimelineItemView::flags() const
+{
+    return m_pStore->flags(m_nIndex);
+}
+
+void acTimelineItemStore::clear()
+{
+    m_startTimes.clear();
+    m_endTimes.clear();
+    m_paletteIndices.clear();
+    m_textIds.clear();
+    m_flags.clear();
+    m_palette.clear();
+    m_paletteLookup.clear();
+    m_strings.clear();
+    m_stringLookup.clear();
+}
+
+void acTimelineItemStore::reserve(int count)
+{
+    m_startTimes.reserve(count);
+    m_endTimes.reserve(count);
+    m_paletteIndices.reserve(count);
+    m_textIds.reserve(count);
+    m_flags.reserve(count);
+}
+
+int acTimelineItemStore::addItem(quint64 startTime, quint64 endTime, const QColor& backgroundColor, const QString& text, quint8 flags)
+{
+    int retVal = m_startTimes.count();
+
+    m_startTimes.push_back(startTime);
+    m_endTimes.push_back(endTime < startTime ? startTime : endTime);
+    m_paletteIndices.push_back(internColor(backgroundColor.rgba()));
+    m_textIds.push_back(internText(text));
+    m_flags.push_back(flags);
+
+    return retVal;
+}
+
+quint16 acTimelineItemStore::internColor(QRgb color)
+{
+    QHash<QRgb, quint16>::const_iterator it = m_paletteLookup.constFind(color);
+
+    if (it != m_paletteLookup.constEnd())
+    {
+        return it.value();
+    }
+
+    // the palette is limited to 16 bit indices. Traces use a handful of colors, so running out is not expected
+    Q_ASSERT(m_palette.count() <= std::numeric_limits<quint16>::max());
+
+    if (m_palette.count() > std::numeric_limits<quint16>::max())
+    {
+        return 0;
+    }
+
+    quint16 retVal = (quint16)m_palette.count();
+    m_palette.push_back(color);
+    m_paletteLookup.insert(color, retVal);
+
+    return retVal;
+}
+
+quint32 acTimelineItemStore::internText(const QString& text)
+{
+    QHash<QString, quint32>::const_iterator it = m_stringLookup.constFind(text);
+
+    if (it != m_stringLookup.constEnd())
+    {
+        return it.value();
+    }
+
+    quint32 retVal = (quint32)m_strings.count();
+    m_strings.push_back(text);
+    m_stringLookup.insert(text, retVal);
+
+    return retVal;
+}
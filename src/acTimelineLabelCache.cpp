@@ -0,0 +1,178 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineLabelCache.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Qt:
+#include <QFontMetrics>
+#include <QPainter>
+#include <QTransform>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineLabelCache.h>
+
+acTimelineLabelCache::acTimelineLabelCache() :
+    m_nAverageCharWidth(0),
+    m_nLineSpacing(0),
+    m_nCapacity(AC_TIMELINE_LABEL_CACHE_DEFAULT_CAPACITY)
+{
+    QFontMetrics fontMet(m_font);
+    m_nAverageCharWidth = fontMet.averageCharWidth();
+    m_nLineSpacing = fontMet.lineSpacing();
+}
+
+void acTimelineLabelCache::setFont(const QFont& font)
+{
+    if (font != m_font)
+    {
+        m_font = font;
+
+        QFontMetrics fontMet(m_font);
+        m_nAverageCharWidth = fontMet.averageCharWidth();
+        m_nLineSpacing = fontMet.lineSpacing();
+
+        clear();
+    }
+}
+
+void acTimelineLabelCache::clear()
+{
+    m_fullLabels.clear();
+    m_elidedLabels.clear();
+}
+
+bool acTimelineLabelCache::drawLabel(QPainter& painter, const QRect& rect, const QString& text)
+{
+    bool retVal = false;
+
+    const Label* pLabel = label(text, rect.width());
+
+    if (pLabel != nullptr)
+    {
+        QPointF topLeft(rect.x() + (rect.width() - pLabel->m_size.width()) / 2.0, rect.y() + (rect.height() - pLabel->m_size.height()) / 2.0);
+        painter.drawStaticText(topLeft, pLabel->m_staticText);
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+void acTimelineLabelCache::addRowLabel(const QRect& rect, const QColor& color, const QString& text)
+{
+    RowLabel newLabel;
+    newLabel.m_rect = rect;
+    newLabel.m_color = color.rgba();
+    newLabel.m_text = text;
+    m_rowLabels.append(newLabel);
+}
+
+int acTimelineLabelCache::drawRowLabels(QPainter& painter)
+{
+    int retVal = 0;
+
+    if (!m_rowLabels.isEmpty())
+    {
+        QPen originalPen = painter.pen();
+        QPen pen = originalPen;
+        QRgb textColor = 0;
+        bool isTextPenSet = false;
+
+        for (QVector<RowLabel>::const_iterator i = m_rowLabels.begin(); i != m_rowLabels.end(); ++i)
+        {
+            if (!isTextPenSet || (*i).m_color != textColor)
+            {
+                textColor = (*i).m_color;
+                isTextPenSet = true;
+                pen.setColor(QColor::fromRgba(textColor));
+                painter.setPen(pen);
+            }
+
+            if (drawLabel(painter, (*i).m_rect, (*i).m_text))
+            {
+                retVal++;
+            }
+        }
+
+        painter.setPen(originalPen);
+
+        // resize rather than clear, so that the storage is reused by the next row
+        m_rowLabels.resize(0);
+    }
+
+    return retVal;
+}
+
+void acTimelineLabelCache::layoutLabel(const QString& text, Label& label) const
+{
+    label.m_bEmpty = text.isEmpty();
+    label.m_staticText.setText(text);
+    label.m_staticText.setTextFormat(Qt::PlainText);
+    label.m_staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+    label.m_staticText.prepare(QTransform(), m_font);
+    label.m_size = label.m_staticText.size();
+}
+
+const acTimelineLabelCache::Label* acTimelineLabelCache::label(const QString& text, int availableWidth)
+{
+    QHash<QString, Label>::iterator fullIt = m_fullLabels.find(text);
+
+    if (fullIt == m_fullLabels.end())
+    {
+        if (m_fullLabels.count() >= m_nCapacity)
+        {
+            m_fullLabels.clear();
+        }
+
+        fullIt = m_fullLabels.insert(text, Label());
+        layoutLabel(text, fullIt.value());
+    }
+
+    const Label& fullLabel = fullIt.value();
+
+    if (fullLabel.m_bEmpty)
+    {
+        return nullptr;
+    }
+
+    if (fullLabel.m_size.width() <= availableWidth)
+    {
+        return &fullLabel;
+    }
+
+    // the label does not fit, use the label elided to the width bucket below the available width
+    int widthBucket = availableWidth / AC_TIMELINE_LABEL_WIDTH_BUCKET;
+
+    if (widthBucket <= 0)
+    {
+        return nullptr;
+    }
+
+    QPair<QString, int> key(text, widthBucket);
+    QHash<QPair<QString, int>, Label>::iterator elidedIt = m_elidedLabels.find(key);
+
+    if (elidedIt == m_elidedLabels.end())
+    {
+        if (m_elidedLabels.count() >= m_nCapacity)
+        {
+            m_elidedLabels.clear();
+        }
+
+        QFontMetrics fontMet(m_font);
+        QString elidedText = fontMet.elidedText(text, Qt::ElideRight, widthBucket * AC_TIMELINE_LABEL_WIDTH_BUCKET);
+
+        elidedIt = m_elidedLabels.insert(key, Label());
+        layoutLabel(elidedText, elidedIt.value());
+
+        // a lone ellipsis says nothing about the item, so it is not displayed
+        if (elidedText.length() <= 1)
+        {
+            elidedIt.value().m_bEmpty = true;
+        }
+    }
+
+    return elidedIt.value().m_bEmpty ? nullptr : &elidedIt.value();
+}
@@ -0,0 +1,337 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineRangeStats.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <algorithm>
+#include <limits>
+
+// Qt:
+#include <QHash>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QRunnable>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineRangeStats.h>
+
+/// Computes the statistics of a single branch
+class acTimelineRangeStatsCalculator::Job : public QRunnable
+{
+public:
+    Job(acTimelineRangeStatsCalculator* pCalculator, int branchIndex, quint64 rangeStart, quint64 rangeEnd, int topTextCount, int generation) :
+        m_pCalculator(pCalculator),
+        m_nBranchIndex(branchIndex),
+        m_nRangeStart(rangeStart),
+        m_nRangeEnd(rangeEnd),
+        m_nTopTextCount(topTextCount),
+        m_nGeneration(generation)
+    {
+    }
+
+    /// The snapshot of the items of the branch, filled on the GUI thread before the job is started.
+    acTimelineRangeItems& items() { return m_items; }
+
+    virtual void run()
+    {
+        // skip the jobs which were cancelled after they were queued
+        if (m_pCalculator->m_generation.loadAcquire() == m_nGeneration)
+        {
+            acTimelineBranchRangeStats stats;
+            computeStats(m_items, m_nRangeStart, m_nRangeEnd, m_nTopTextCount, stats);
+
+            m_pCalculator->addResult(m_nBranchIndex, stats, m_nGeneration);
+        }
+    }
+
+private:
+    acTimelineRangeStatsCalculator* m_pCalculator;
+    int                             m_nBranchIndex;
+    quint64                         m_nRangeStart;
+    quint64                         m_nRangeEnd;
+    int                             m_nTopTextCount;
+    int                             m_nGeneration;
+    acTimelineRangeItems            m_items;
+};
+
+/// Adds an item to the statistics of a branch and of its text.
+/// \param startTime the start time of the item.
+/// \param endTime the end time of the item.
+/// \param rangeStart the start of the time range.
+/// \param rangeEnd the end of the time range.
+/// \param[in,out] stats the statistics of the branch.
+/// \param[in,out] textStats the statistics of the text of the item.
+static void acAddRangeItem(quint64 startTime, quint64 endTime, quint64 rangeStart, quint64 rangeEnd, acTimelineBranchRangeStats& stats, acTimelineRangeTextStats& textStats)
+{
+    quint64 clippedStart = qMax(startTime, rangeStart);
+    quint64 clippedEnd = qMin(endTime, rangeEnd);
+    quint64 duration = (clippedEnd > clippedStart) ? clippedEnd - clippedStart : 0;
+
+    stats.m_nItemCount++;
+    stats.m_nTotalDuration += duration;
+    stats.m_nMinDuration = qMin(stats.m_nMinDuration, duration);
+    stats.m_nMaxDuration = qMax(stats.m_nMaxDuration, duration);
+
+    textStats.m_nItemCount++;
+    textStats.m_nTotalDuration += duration;
+}
+
+/// Merges the statistics of items with the same text.
+/// \param source the statistics to merge.
+/// \param[in,out] target the statistics to merge into.
+static void acMergeTextStats(const acTimelineRangeTextStats& source, acTimelineRangeTextStats& target)
+{
+    target.m_nItemCount += source.m_nItemCount;
+    target.m_nTotalDuration += source.m_nTotalDuration;
+}
+
+acTimelineRangeStatsCalculator::acTimelineRangeStatsCalculator(QObject* pReceiver, const char* finishedSlot) :
+    m_pReceiver(pReceiver),
+    m_finishedSlot(finishedSlot),
+    m_generation(0),
+    m_nRangeStart(0),
+    m_nRangeEnd(0),
+    m_nPendingCount(-1)
+{
+    // QThreadPool defaults to QThread::idealThreadCount() threads, which is the number of cores
+}
+
+acTimelineRangeStatsCalculator::~acTimelineRangeStatsCalculator()
+{
+    cancelAndWait();
+}
+
+void acTimelineRangeStatsCalculator::submit(quint64 rangeStart, quint64 rangeEnd, int topTextCount, const QList<acTimelineBranch*>& branches)
+{
+    cancel();
+
+    int generation = m_generation.loadAcquire();
+
+    {
+        QMutexLocker locker(&m_resultsMutex);
+        m_nRangeStart = rangeStart;
+        m_nRangeEnd = rangeEnd;
+        m_results.resize(branches.count());
+        m_nPendingCount = branches.count();
+
+        for (int i = 0; i < branches.count(); ++i)
+        {
+            m_results[i].m_pBranch = branches[i];
+        }
+    }
+
+    if (branches.isEmpty())
+    {
+        QMetaObject::invokeMethod(m_pReceiver, m_finishedSlot, Qt::QueuedConnection);
+        return;
+    }
+
+    for (int i = 0; i < branches.count(); ++i)
+    {
+        Job* pJob = new(std::nothrow) Job(this, i, rangeStart, rangeEnd, topTextCount, generation);
+        Q_ASSERT(pJob != nullptr);
+
+        if (pJob != nullptr)
+        {
+            // the snapshot is taken on the GUI thread, the statistics are computed on the worker thread
+            branches[i]->getItemsInRange(rangeStart, rangeEnd, pJob->items());
+
+            // the pool deletes the job when it is done
+            m_threadPool.start(pJob);
+        }
+        else
+        {
+            acTimelineBranchRangeStats emptyStats;
+            computeStats(acTimelineRangeItems(), rangeStart, rangeEnd, topTextCount, emptyStats);
+            addResult(i, emptyStats, generation);
+        }
+    }
+}
+
+void acTimelineRangeStatsCalculator::cancel()
+{
+    m_generation.fetchAndAddOrdered(1);
+    m_threadPool.clear();
+
+    QMutexLocker locker(&m_resultsMutex);
+    m_results.clear();
+    m_nPendingCount = -1;
+}
+
+void acTimelineRangeStatsCalculator::cancelAndWait()
+{
+    cancel();
+    m_threadPool.waitForDone();
+}
+
+bool acTimelineRangeStatsCalculator::takeResults(quint64& rangeStart, quint64& rangeEnd, QVector<acTimelineBranchRangeStats>& stats)
+{
+    QMutexLocker locker(&m_resultsMutex);
+
+    if (m_nPendingCount != 0)
+    {
+        return false;
+    }
+
+    rangeStart = m_nRangeStart;
+    rangeEnd = m_nRangeEnd;
+    stats.swap(m_results);
+    m_results.clear();
+    m_nPendingCount = -1;
+
+    return true;
+}
+
+void acTimelineRangeStatsCalculator::addResult(int branchIndex, const acTimelineBranchRangeStats& stats, int generation)
+{
+    QMutexLocker locker(&m_resultsMutex);
+
+    if (m_generation.loadAcquire() == generation && m_nPendingCount > 0)
+    {
+        acTimelineBranch* pBranch = m_results[branchIndex].m_pBranch;
+        m_results[branchIndex] = stats;
+        m_results[branchIndex].m_pBranch = pBranch;
+
+        // notify the receiver once, when the last branch of the request is done
+        if (--m_nPendingCount == 0)
+        {
+            QMetaObject::invokeMethod(m_pReceiver, m_finishedSlot, Qt::QueuedConnection);
+        }
+    }
+}
+
+void acTimelineRangeStatsCalculator::computeStats(const acTimelineRangeItems& items, quint64 rangeStart, quint64 rangeEnd, int topTextCount, acTimelineBranchRangeStats& stats)
+{
+    stats.m_pBranch = nullptr;
+    stats.m_nItemCount = 0;
+    stats.m_nTotalDuration = 0;
+    stats.m_nMinDuration = std::numeric_limits<quint64>::max();
+    stats.m_nMaxDuration = 0;
+    stats.m_topTexts.clear();
+
+    acTimelineRangeTextStats emptyTextStats;
+    emptyTextStats.m_nItemCount = 0;
+    emptyTextStats.m_nTotalDuration = 0;
+
+    QHash<QString, acTimelineRangeTextStats> textStats;
+
+    // the snapshot only holds the acTimelineItem objects overlapping the range
+    for (int i = 0; i < items.m_startTimes.count(); ++i)
+    {
+        QHash<QString, acTimelineRangeTextStats>::iterator textIt = textStats.find(items.m_texts[i]);
+
+        if (textIt == textStats.end())
+        {
+            textIt = textStats.insert(items.m_texts[i], emptyTextStats);
+            textIt.value().m_text = items.m_texts[i];
+        }
+
+        acAddRangeItem(items.m_startTimes[i], items.m_endTimes[i], rangeStart, rangeEnd, stats, textIt.value());
+    }
+
+    // the compact and trace items are grouped by string id, and their texts are only looked up for the distinct ids
+    int firstPos = 0;
+    int lastPos = 0;
+
+    if (items.m_compactItems.count() > 0 && items.m_compactItemIndex.findOverlapping(rangeStart, rangeEnd, firstPos, lastPos))
+    {
+        QHash<quint32, acTimelineRangeTextStats> compactTextStats;
+
+        for (int pos = firstPos; pos < lastPos; ++pos)
+        {
+            if (items.m_compactItemIndex.endTime(pos) >= rangeStart)
+            {
+                int index = items.m_compactItemIndex.itemIndex(pos);
+                QHash<quint32, acTimelineRangeTextStats>::iterator textIt = compactTextStats.find(items.m_compactItems.textId(index));
+
+                if (textIt == compactTextStats.end())
+                {
+                    textIt = compactTextStats.insert(items.m_compactItems.textId(index), emptyTextStats);
+                }
+
+                acAddRangeItem(items.m_compactItemIndex.startTime(pos), items.m_compactItemIndex.endTime(pos), rangeStart, rangeEnd, stats, textIt.value());
+            }
+        }
+
+        for (QHash<quint32, acTimelineRangeTextStats>::const_iterator i = compactTextStats.begin(); i != compactTextStats.end(); ++i)
+        {
+            const QString& text = items.m_compactItems.string(i.key());
+            QHash<QString, acTimelineRangeTextStats>::iterator textIt = textStats.find(text);
+
+            if (textIt == textStats.end())
+            {
+                textIt = textStats.insert(text, emptyTextStats);
+                textIt.value().m_text = text;
+            }
+
+            acMergeTextStats(i.value(), textIt.value());
+        }
+    }
+
+    qint64 traceFirstPos = 0;
+    qint64 traceLastPos = 0;
+
+    if (items.m_traceItems.file() != nullptr && items.m_traceItems.findOverlapping(rangeStart, rangeEnd, traceFirstPos, traceLastPos))
+    {
+        QHash<quint32, acTimelineRangeTextStats> traceTextStats;
+
+        for (qint64 pos = traceFirstPos; pos < traceLastPos; ++pos)
+        {
+            if (items.m_traceItems.endTime(pos) >= rangeStart)
+            {
+                QHash<quint32, acTimelineRangeTextStats>::iterator textIt = traceTextStats.find(items.m_traceItems.textId(pos));
+
+                if (textIt == traceTextStats.end())
+                {
+                    textIt = traceTextStats.insert(items.m_traceItems.textId(pos), emptyTextStats);
+                }
+
+                acAddRangeItem(items.m_traceItems.startTime(pos), items.m_traceItems.endTime(pos), rangeStart, rangeEnd, stats, textIt.value());
+            }
+        }
+
+        for (QHash<quint32, acTimelineRangeTextStats>::const_iterator i = traceTextStats.begin(); i != traceTextStats.end(); ++i)
+        {
+            // the decoded string cache of the trace file belongs to the GUI thread
+            QString text = items.m_traceItems.file()->decodeString(i.key());
+            QHash<QString, acTimelineRangeTextStats>::iterator textIt = textStats.find(text);
+
+            if (textIt == textStats.end())
+            {
+                textIt = textStats.insert(text, emptyTextStats);
+                textIt.value().m_text = text;
+            }
+
+            acMergeTextStats(i.value(), textIt.value());
+        }
+    }
+
+    if (stats.m_nItemCount == 0)
+    {
+        stats.m_nMinDuration = 0;
+    }
+
+    // only the longest texts are sorted
+    QVector<acTimelineRangeTextStats> allTextStats;
+    allTextStats.reserve(textStats.count());
+
+    for (QHash<QString, acTimelineRangeTextStats>::const_iterator i = textStats.begin(); i != textStats.end(); ++i)
+    {
+        allTextStats.append(i.value());
+    }
+
+    int topCount = qBound(0, topTextCount, allTextStats.count());
+
+    std::partial_sort(allTextStats.begin(), allTextStats.begin() + topCount, allTextStats.end(), [](const acTimelineRangeTextStats & left, const acTimelineRangeTextStats & right)
+    {
+        return (left.m_nTotalDuration != right.m_nTotalDuration) ? (left.m_nTotalDuration > right.m_nTotalDuration) : (left.m_text < right.m_text);
+    });
+
+    allTextStats.resize(topCount);
+    stats.m_topTexts = allTextStats;
+}
@@ -0,0 +1,296 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineRowLayout.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineRowLayout.h>
+
+acTimelineRowLayout::acTimelineRowLayout() : m_nCapacity(0)
+{
+}
+
+void acTimelineRowLayout::build(const QList<acTimelineBranch*>& branches)
+{
+    clear();
+
+    unsigned int rowIndex = 0;
+
+    for (QList<acTimelineBranch*>::const_iterator i = branches.begin(); i != branches.end(); ++i)
+    {
+        (*i)->resetRowIndex(rowIndex);
+    }
+
+    m_rows.reserve(rowIndex);
+    m_rowOfBranch.reserve(rowIndex);
+
+    for (QList<acTimelineBranch*>::const_iterator i = branches.begin(); i != branches.end(); ++i)
+    {
+        addRows(*i, -1);
+    }
+
+    buildTree();
+}
+
+bool acTimelineRowLayout::appendBranch(acTimelineBranch* pBranch)
+{
+    if (pBranch == nullptr || contains(pBranch))
+    {
+        // the timeline may be notified more than once about the same branch
+        return true;
+    }
+
+    int parentRow = -1;
+
+    if (pBranch->parentBranch() != nullptr)
+    {
+        parentRow = m_rowOfBranch.value(pBranch->parentBranch(), -1);
+
+        if (parentRow < 0 || m_rows[parentRow].m_nEnd != m_rows.count())
+        {
+            return false;
+        }
+
+        // the rows spanned by a cover must not change, so the parents must not be covering their sub branches
+        for (int row = parentRow; row >= 0; row = m_rows[row].m_nParentRow)
+        {
+            if (m_rows[row].m_bFolded || m_rows[row].m_bHidden)
+            {
+                return false;
+            }
+        }
+    }
+
+    int firstRow = m_rows.count();
+    unsigned int rowIndex = firstRow;
+    pBranch->resetRowIndex(rowIndex);
+    addRows(pBranch, parentRow);
+
+    for (int row = parentRow; row >= 0; row = m_rows[row].m_nParentRow)
+    {
+        m_rows[row].m_nEnd = m_rows.count();
+    }
+
+    if (m_rows.count() > m_nCapacity)
+    {
+        // doubling the capacity keeps the cost of appending rows one branch at a time linear
+        buildTree();
+    }
+    else
+    {
+        for (int row = firstRow; row < m_rows.count(); ++row)
+        {
+            updateRowState(row);
+        }
+    }
+
+    return true;
+}
+
+void acTimelineRowLayout::clear()
+{
+    m_rows.clear();
+    m_rowOfBranch.clear();
+    m_nCapacity = 0;
+    m_covers.clear();
+    m_sums.clear();
+}
+
+void acTimelineRowLayout::updateRow(const acTimelineBranch* pBranch)
+{
+    int row = m_rowOfBranch.value(pBranch, -1);
+
+    if (row >= 0)
+    {
+        updateRowState(row);
+    }
+}
+
+int acTimelineRowLayout::subtreeHeight(const acTimelineBranch* pBranch) const
+{
+    int retVal = 0;
+    int row = m_rowOfBranch.value(pBranch, -1);
+
+    if (row >= 0)
+    {
+        retVal = sum(1, 0, m_nCapacity, row, m_rows[row].m_nEnd);
+    }
+
+    return retVal;
+}
+
+acTimelineBranch* acTimelineRowLayout::branchAt(int y) const
+{
+    if (y < 0 || y >= totalHeight())
+    {
+        return nullptr;
+    }
+
+    // a node with a non zero height is not covered, so its height is the sum of the heights of its children
+    int node = 1;
+
+    while (node < m_nCapacity)
+    {
+        int leftChild = node * 2;
+
+        if (y < m_sums[leftChild])
+        {
+            node = leftChild;
+        }
+        else
+        {
+            y -= m_sums[leftChild];
+            node = leftChild + 1;
+        }
+    }
+
+    return m_rows[node - m_nCapacity].m_pBranch;
+}
+
+void acTimelineRowLayout::addRows(acTimelineBranch* pBranch, int parentRow)
+{
+    int row = m_rows.count();
+
+    Row newRow;
+    newRow.m_pBranch = pBranch;
+    newRow.m_nParentRow = parentRow;
+    newRow.m_nEnd = row + 1;
+    newRow.m_nHeight = 0;
+    newRow.m_bFolded = false;
+    newRow.m_bHidden = false;
+    m_rows.append(newRow);
+    m_rowOfBranch.insert(pBranch, row);
+
+    for (int i = 0; i < pBranch->subBranchCount(); ++i)
+    {
+        addRows(pBranch->getSubBranch(i), row);
+    }
+
+    m_rows[row].m_nEnd = m_rows.count();
+}
+
+void acTimelineRowLayout::buildTree()
+{
+    m_nCapacity = 1;
+
+    while (m_nCapacity < m_rows.count())
+    {
+        m_nCapacity *= 2;
+    }
+
+    m_covers.fill(0, m_nCapacity * 2);
+    m_sums.fill(0, m_nCapacity * 2);
+
+    for (int row = 0; row < m_rows.count(); ++row)
+    {
+        Row& currentRow = m_rows[row];
+        currentRow.m_nHeight = currentRow.m_pBranch->height();
+        currentRow.m_bFolded = false;
+        currentRow.m_bHidden = false;
+        m_sums[m_nCapacity + row] = currentRow.m_nHeight;
+    }
+
+    for (int node = m_nCapacity - 1; node >= 1; --node)
+    {
+        m_sums[node] = m_sums[node * 2] + m_sums[node * 2 + 1];
+    }
+
+    for (int row = 0; row < m_rows.count(); ++row)
+    {
+        updateRowState(row);
+    }
+}
+
+void acTimelineRowLayout::updateRowState(int row)
+{
+    Row& currentRow = m_rows[row];
+    const acTimelineBranch* pBranch = currentRow.m_pBranch;
+
+    if (pBranch->height() != currentRow.m_nHeight)
+    {
+        setRowHeight(row, pBranch->height());
+    }
+
+    // a folded branch displays its own row, but not the rows of its sub branches
+    if (pBranch->isFolded() != currentRow.m_bFolded)
+    {
+        currentRow.m_bFolded = pBranch->isFolded();
+        addCover(1, 0, m_nCapacity, row + 1, currentRow.m_nEnd, currentRow.m_bFolded ? 1 : -1);
+    }
+
+    if (pBranch->IsVisible() == currentRow.m_bHidden)
+    {
+        currentRow.m_bHidden = !pBranch->IsVisible();
+        addCover(1, 0, m_nCapacity, row, currentRow.m_nEnd, currentRow.m_bHidden ? 1 : -1);
+    }
+}
+
+void acTimelineRowLayout::setRowHeight(int row, int height)
+{
+    m_rows[row].m_nHeight = height;
+
+    for (int node = m_nCapacity + row; node >= 1; node /= 2)
+    {
+        updateSum(node);
+    }
+}
+
+void acTimelineRowLayout::addCover(int node, int nodeFirst, int nodeEnd, int first, int end, int delta)
+{
+    if (end <= nodeFirst || nodeEnd <= first)
+    {
+        return;
+    }
+
+    if (first <= nodeFirst && nodeEnd <= end)
+    {
+        m_covers[node] += delta;
+    }
+    else
+    {
+        int nodeMiddle = (nodeFirst + nodeEnd) / 2;
+        addCover(node * 2, nodeFirst, nodeMiddle, first, end, delta);
+        addCover(node * 2 + 1, nodeMiddle, nodeEnd, first, end, delta);
+    }
+
+    updateSum(node);
+}
+
+void acTimelineRowLayout::updateSum(int node)
+{
+    if (m_covers[node] > 0)
+    {
+        m_sums[node] = 0;
+    }
+    else if (node >= m_nCapacity)
+    {
+        int row = node - m_nCapacity;
+        m_sums[node] = (row < m_rows.count()) ? m_rows[row].m_nHeight : 0;
+    }
+    else
+    {
+        m_sums[node] = m_sums[node * 2] + m_sums[node * 2 + 1];
+    }
+}
+
+int acTimelineRowLayout::sum(int node, int nodeFirst, int nodeEnd, int first, int end) const
+{
+    if (end <= nodeFirst || nodeEnd <= first || m_covers[node] > 0)
+    {
+        return 0;
+    }
+
+    if (first <= nodeFirst && nodeEnd <= end)
+    {
+        return m_sums[node];
+    }
+
+    int nodeMiddle = (nodeFirst + nodeEnd) / 2;
+
+    return sum(node * 2, nodeFirst, nodeMiddle, first, end) + sum(node * 2 + 1, nodeMiddle, nodeEnd, first, end);
+}
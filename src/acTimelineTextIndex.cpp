@@ -0,0 +1,140 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTextIndex.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTextIndex.h>
+
+void acTimelineTextIndex::clear()
+{
+    m_texts.clear();
+    m_textIds.clear();
+    m_postings.clear();
+}
+
+int acTimelineTextIndex::addText(const QString& text)
+{
+    QHash<QString, int>::const_iterator i = m_textIds.find(text);
+
+    if (i != m_textIds.end())
+    {
+        return i.value();
+    }
+
+    int retVal = m_texts.count();
+    m_texts.append(text);
+    m_textIds.insert(text, retVal);
+
+    QString foldedText = text.toCaseFolded();
+
+    for (int pos = 0; pos + 3 <= foldedText.length(); ++pos)
+    {
+        QVector<int>& posting = m_postings[trigramKey(foldedText.constData() + pos)];
+
+        // a trigram may occur several times in the same text
+        if (posting.isEmpty() || posting.last() != retVal)
+        {
+            posting.append(retVal);
+        }
+    }
+
+    return retVal;
+}
+
+void acTimelineTextIndex::findTexts(const QString& query, MatchType matchType, Qt::CaseSensitivity caseSensitivity, QVector<bool>& matches) const
+{
+    QVector<int> textIds;
+    findTextIds(query, matchType, caseSensitivity, textIds);
+
+    matches.fill(false, m_texts.count());
+
+    for (QVector<int>::const_iterator i = textIds.begin(); i != textIds.end(); ++i)
+    {
+        matches[*i] = true;
+    }
+}
+
+void acTimelineTextIndex::findTextIds(const QString& query, MatchType matchType, Qt::CaseSensitivity caseSensitivity, QVector<int>& textIds) const
+{
+    textIds.clear();
+
+    if (matchType == MATCH_EXACT && caseSensitivity == Qt::CaseSensitive)
+    {
+        int textId = m_textIds.value(query, -1);
+
+        if (textId >= 0)
+        {
+            textIds.append(textId);
+        }
+
+        return;
+    }
+
+    // the texts matching the query contain all its trigrams, so only the texts containing its rarest trigram are compared
+    QString foldedQuery = query.toCaseFolded();
+    const QVector<int>* pCandidates = nullptr;
+
+    for (int pos = 0; pos + 3 <= foldedQuery.length(); ++pos)
+    {
+        QHash<quint64, QVector<int> >::const_iterator i = m_postings.find(trigramKey(foldedQuery.constData() + pos));
+
+        if (i == m_postings.end())
+        {
+            return;
+        }
+
+        if (pCandidates == nullptr || i.value().count() < pCandidates->count())
+        {
+            pCandidates = &i.value();
+        }
+    }
+
+    if (pCandidates != nullptr)
+    {
+        for (QVector<int>::const_iterator i = pCandidates->begin(); i != pCandidates->end(); ++i)
+        {
+            if (acTimelineTextIndex::matches(m_texts[*i], query, matchType, caseSensitivity))
+            {
+                textIds.append(*i);
+            }
+        }
+    }
+    else
+    {
+        // queries shorter than a trigram are compared with every text
+        for (int textId = 0; textId < m_texts.count(); ++textId)
+        {
+            if (acTimelineTextIndex::matches(m_texts[textId], query, matchType, caseSensitivity))
+            {
+                textIds.append(textId);
+            }
+        }
+    }
+}
+
+bool acTimelineTextIndex::matches(const QString& text, const QString& query, MatchType matchType, Qt::CaseSensitivity caseSensitivity)
+{
+    bool retVal = false;
+
+    switch (matchType)
+    {
+        case MATCH_SUBSTRING:
+            retVal = text.contains(query, caseSensitivity);
+            break;
+
+        case MATCH_PREFIX:
+            retVal = text.startsWith(query, caseSensitivity);
+            break;
+
+        case MATCH_EXACT:
+            retVal = (text.compare(query, caseSensitivity) == 0);
+            break;
+    }
+
+    return retVal;
+}
@@ -0,0 +1,287 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTileCache.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <cmath>
+
+// Qt:
+#include <QPainter>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTileCache.h>
+
+acTimelineTileCache::acTimelineTileCache() :
+    m_bKeepPreviewTiles(false),
+    m_nRenderWidth(0),
+    m_nStartTime(0),
+    m_nFullRange(0),
+    m_nBudget(AC_TIMELINE_TILE_CACHE_DEFAULT_BUDGET),
+    m_nUsedBytes(0)
+{
+    m_previewZoomLevel.m_nRenderWidth = 0;
+    m_previewZoomLevel.m_nStartTime = 0;
+    m_previewZoomLevel.m_nFullRange = 0;
+}
+
+void acTimelineTileCache::clear()
+{
+    m_tiles.clear();
+    m_previewTiles.clear();
+    m_tileUseList.clear();
+    m_nUsedBytes = 0;
+}
+
+bool acTimelineTileCache::setZoomLevel(quint64 renderWidth, quint64 startTime, quint64 fullRange)
+{
+    bool retVal = false;
+    bool isSameZoomLevel = (m_nRenderWidth == renderWidth && m_nStartTime == startTime && m_nFullRange == fullRange);
+
+    if (!isSameZoomLevel && m_nStartTime == startTime && m_nRenderWidth > 0 && renderWidth > 0 && m_nFullRange > 0)
+    {
+        // the tiles stay aligned as long as the time per pixel drifts by less than a pixel over the render width
+        double timePerPixel = m_nFullRange / (double)m_nRenderWidth;
+        double newTimePerPixel = fullRange / (double)renderWidth;
+        isSameZoomLevel = std::abs(newTimePerPixel - timePerPixel) * renderWidth < timePerPixel;
+    }
+
+    if (!isSameZoomLevel)
+    {
+        retVal = true;
+
+        // while zooming quickly, no tile of the intermediate zoom levels may have been rendered.  Keep the last rendered ones then
+        if (m_bKeepPreviewTiles && !m_tiles.isEmpty())
+        {
+            m_previewTiles = m_tiles;
+            m_previewZoomLevel.m_nRenderWidth = m_nRenderWidth;
+            m_previewZoomLevel.m_nStartTime = m_nStartTime;
+            m_previewZoomLevel.m_nFullRange = m_nFullRange;
+        }
+
+        m_tiles.clear();
+        m_tileUseList.clear();
+        m_nUsedBytes = 0;
+
+        m_nRenderWidth = renderWidth;
+        m_nStartTime = startTime;
+        m_nFullRange = fullRange;
+    }
+
+    return retVal;
+}
+
+void acTimelineTileCache::setKeepPreviewTiles(bool keepPreviewTiles)
+{
+    m_bKeepPreviewTiles = keepPreviewTiles;
+
+    if (!m_bKeepPreviewTiles)
+    {
+        m_previewTiles.clear();
+    }
+}
+
+bool acTimelineTileCache::drawPreview(QPainter& painter, const acTimelineBranch* pBranch, qint64 tileIndex, int height, const QPoint& tilePos) const
+{
+    bool retVal = false;
+    QHash<const acTimelineBranch*, BranchTiles>::const_iterator branchIt = m_previewTiles.find(pBranch);
+
+    if (branchIt == m_previewTiles.end() || m_nRenderWidth == 0 || m_nFullRange == 0 || m_previewZoomLevel.m_nFullRange == 0)
+    {
+        return retVal;
+    }
+
+    // map the pixel span of the tile to the pixel span of the previous zoom level, through the time it covers
+    double timePerPixel = m_nFullRange / (double)m_nRenderWidth;
+    double previewPixelsPerTime = m_previewZoomLevel.m_nRenderWidth / (double)m_previewZoomLevel.m_nFullRange;
+    double startTimeDelta = (double)m_nStartTime - (double)m_previewZoomLevel.m_nStartTime;
+
+    double previewStart = (startTimeDelta + (tileIndex * AC_TIMELINE_TILE_WIDTH) * timePerPixel) * previewPixelsPerTime;
+    double previewEnd = (startTimeDelta + ((tileIndex + 1) * AC_TIMELINE_TILE_WIDTH) * timePerPixel) * previewPixelsPerTime;
+    double previewPixelsPerPixel = (previewEnd - previewStart) / AC_TIMELINE_TILE_WIDTH;
+
+    if (previewPixelsPerPixel <= 0)
+    {
+        return retVal;
+    }
+
+    // when zooming out, a tile covers many preview tiles, so go over the preview tiles of the branch rather than over the covered range
+    for (BranchTiles::const_iterator i = branchIt.value().constBegin(); i != branchIt.value().constEnd(); ++i)
+    {
+        if (i.value().m_nHeight != height)
+        {
+            continue;
+        }
+
+        double previewTileStart = (double)i.key() * AC_TIMELINE_TILE_WIDTH;
+        double sourceStart = qMax(previewStart, previewTileStart);
+        double sourceEnd = qMin(previewEnd, previewTileStart + AC_TIMELINE_TILE_WIDTH);
+
+        if (sourceEnd > sourceStart)
+        {
+            const QImage& image = i.value().m_image;
+            double pixelRatio = image.devicePixelRatio();
+
+            QRectF targetRect(tilePos.x() + (sourceStart - previewStart) / previewPixelsPerPixel, tilePos.y(),
+                              (sourceEnd - sourceStart) / previewPixelsPerPixel, height);
+            QRectF sourceRect((sourceStart - previewTileStart) * pixelRatio, 0, (sourceEnd - sourceStart) * pixelRatio, image.height());
+
+            painter.drawImage(targetRect, image, sourceRect);
+            retVal = true;
+        }
+    }
+
+    return retVal;
+}
+
+void acTimelineTileCache::setBudget(qint64 budget)
+{
+    m_nBudget = budget;
+    evict();
+}
+
+const QImage* acTimelineTileCache::tile(const acTimelineBranch* pBranch, qint64 tileIndex, int height)
+{
+    const QImage* retVal = nullptr;
+    QHash<const acTimelineBranch*, BranchTiles>::iterator branchIt = m_tiles.find(pBranch);
+
+    if (branchIt != m_tiles.end())
+    {
+        BranchTiles::iterator tileIt = branchIt.value().find(tileIndex);
+
+        if (tileIt != branchIt.value().end() && tileIt.value().m_nHeight == height)
+        {
+            // move the tile to the front of the use list
+            TileKey key = *tileIt.value().m_usePos;
+            m_tileUseList.erase(tileIt.value().m_usePos);
+            tileIt.value().m_usePos = m_tileUseList.insert(m_tileUseList.begin(), key);
+            retVal = &tileIt.value().m_image;
+        }
+    }
+
+    return retVal;
+}
+
+bool acTimelineTileCache::insert(const acTimelineBranch* pBranch, qint64 tileIndex, int height, const QImage& image)
+{
+    // a tile larger than the whole budget would be dropped right away, after evicting all other tiles
+    if (image.byteCount() > m_nBudget)
+    {
+        invalidateTiles(pBranch, tileIndex, tileIndex);
+        return false;
+    }
+
+    BranchTiles& branchTiles = m_tiles[pBranch];
+    BranchTiles::iterator tileIt = branchTiles.find(tileIndex);
+
+    TileKey key;
+    key.m_pBranch = pBranch;
+    key.m_nTileIndex = tileIndex;
+
+    if (tileIt != branchTiles.end())
+    {
+        m_nUsedBytes -= tileIt.value().m_image.byteCount();
+        m_tileUseList.erase(tileIt.value().m_usePos);
+    }
+
+    Tile newTile;
+    newTile.m_image = image;
+    newTile.m_nHeight = height;
+    newTile.m_usePos = m_tileUseList.insert(m_tileUseList.begin(), key);
+    m_nUsedBytes += image.byteCount();
+    branchTiles.insert(tileIndex, newTile);
+
+    // the new tile is the most recently used one, and fits in the budget, so it is never dropped here
+    evict();
+
+    return true;
+}
+
+void acTimelineTileCache::invalidateBranch(const acTimelineBranch* pBranch)
+{
+    QHash<const acTimelineBranch*, BranchTiles>::iterator branchIt = m_tiles.find(pBranch);
+
+    if (branchIt != m_tiles.end())
+    {
+        BranchTiles::iterator i = branchIt.value().begin();
+
+        while (i != branchIt.value().end())
+        {
+            i = removeTile(branchIt, i);
+        }
+
+        m_tiles.erase(branchIt);
+    }
+
+    m_previewTiles.remove(pBranch);
+}
+
+void acTimelineTileCache::invalidateTiles(const acTimelineBranch* pBranch, qint64 firstTileIndex, qint64 lastTileIndex)
+{
+    QHash<const acTimelineBranch*, BranchTiles>::iterator branchIt = m_tiles.find(pBranch);
+
+    if (branchIt != m_tiles.end())
+    {
+        BranchTiles::iterator i = branchIt.value().begin();
+
+        while (i != branchIt.value().end())
+        {
+            if (i.key() >= firstTileIndex && i.key() <= lastTileIndex)
+            {
+                i = removeTile(branchIt, i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        if (branchIt.value().isEmpty())
+        {
+            m_tiles.erase(branchIt);
+        }
+    }
+}
+
+void acTimelineTileCache::evict()
+{
+    while (m_nUsedBytes > m_nBudget && !m_tileUseList.isEmpty())
+    {
+        const TileKey& key = m_tileUseList.last();
+        QHash<const acTimelineBranch*, BranchTiles>::iterator branchIt = m_tiles.find(key.m_pBranch);
+        Q_ASSERT(branchIt != m_tiles.end());
+
+        if (branchIt == m_tiles.end())
+        {
+            m_tileUseList.removeLast();
+            continue;
+        }
+
+        BranchTiles::iterator tileIt = branchIt.value().find(key.m_nTileIndex);
+        Q_ASSERT(tileIt != branchIt.value().end());
+
+        if (tileIt == branchIt.value().end())
+        {
+            m_tileUseList.removeLast();
+            continue;
+        }
+
+        removeTile(branchIt, tileIt);
+
+        if (branchIt.value().isEmpty())
+        {
+            m_tiles.erase(branchIt);
+        }
+    }
+}
+
+acTimelineTileCache::BranchTiles::iterator acTimelineTileCache::removeTile(QHash<const acTimelineBranch*, BranchTiles>::iterator branchIt, BranchTiles::iterator tileIt)
+{
+    m_nUsedBytes -= tileIt.value().m_image.byteCount();
+    m_tileUseList.erase(tileIt.value().m_usePos);
+
+    return branchIt.value().erase(tileIt);
+}
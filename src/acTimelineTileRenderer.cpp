@@ -0,0 +1,196 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTileRenderer.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <limits>
+
+// Qt:
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QRunnable>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTileCache.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTileRenderer.h>
+
+/// Rasterizes the recorded paint commands of a single tile
+class acTimelineTileRenderer::Job : public QRunnable
+{
+public:
+    Job(acTimelineTileRenderer* pRenderer, const Result& result, const QPicture& picture, int pixelRatio, int logicalDpi, int generation) :
+        m_pRenderer(pRenderer),
+        m_result(result),
+        m_picture(picture),
+        m_nPixelRatio(pixelRatio),
+        m_nLogicalDpi(logicalDpi),
+        m_nGeneration(generation)
+    {
+    }
+
+    virtual void run()
+    {
+        // skip the jobs which were cancelled after they were queued
+        if (m_pRenderer->m_generation.loadAcquire() == m_nGeneration)
+        {
+            m_result.m_image = createTileImage(m_result.m_nHeight, m_nPixelRatio, m_nLogicalDpi);
+
+            {
+                QPainter painter(&m_result.m_image);
+                painter.drawPicture(0, 0, m_picture);
+            }
+
+            m_pRenderer->addResult(m_result, m_nGeneration);
+        }
+    }
+
+private:
+    acTimelineTileRenderer* m_pRenderer;
+    Result                  m_result;
+    QPicture                m_picture;
+    int                     m_nPixelRatio;
+    int                     m_nLogicalDpi;
+    int                     m_nGeneration;
+};
+
+acTimelineTileRenderer::acTimelineTileRenderer(QObject* pReceiver, const char* finishedSlot) :
+    m_pReceiver(pReceiver),
+    m_finishedSlot(finishedSlot),
+    m_generation(0),
+    m_nNextSerial(0),
+    m_bNotifyPosted(false)
+{
+    // QThreadPool defaults to QThread::idealThreadCount() threads, which is the number of cores
+}
+
+acTimelineTileRenderer::~acTimelineTileRenderer()
+{
+    cancel();
+    m_threadPool.waitForDone();
+}
+
+QImage acTimelineTileRenderer::createTileImage(int height, int pixelRatio, int logicalDpi)
+{
+    QImage retVal(AC_TIMELINE_TILE_WIDTH * pixelRatio, height * pixelRatio, QImage::Format_ARGB32_Premultiplied);
+    retVal.setDevicePixelRatio(pixelRatio);
+
+    // use the DPI of the widget, so that text is rendered with the same size as when painting the widget directly
+    int dotsPerMeter = qRound(logicalDpi / 0.0254);
+    retVal.setDotsPerMeterX(dotsPerMeter);
+    retVal.setDotsPerMeterY(dotsPerMeter);
+
+    retVal.fill(Qt::transparent);
+
+    return retVal;
+}
+
+void acTimelineTileRenderer::submit(const acTimelineBranch* pBranch, qint64 tileIndex, int height, const QPicture& picture, int pixelRatio, int logicalDpi)
+{
+    PendingTile pendingTile;
+    pendingTile.m_nHeight = height;
+    pendingTile.m_nSerial = m_nNextSerial++;
+    m_pending.insert(TileKey(pBranch, tileIndex), pendingTile);
+
+    Result result;
+    result.m_pBranch = pBranch;
+    result.m_nTileIndex = tileIndex;
+    result.m_nHeight = height;
+    result.m_nSerial = pendingTile.m_nSerial;
+
+    Job* pJob = new(std::nothrow) Job(this, result, picture, pixelRatio, logicalDpi, m_generation.loadAcquire());
+    Q_ASSERT(pJob != nullptr);
+
+    if (pJob != nullptr)
+    {
+        // the pool deletes the job when it is done
+        m_threadPool.start(pJob);
+    }
+}
+
+bool acTimelineTileRenderer::isPending(const acTimelineBranch* pBranch, qint64 tileIndex, int height) const
+{
+    QHash<TileKey, PendingTile>::const_iterator i = m_pending.find(TileKey(pBranch, tileIndex));
+
+    return i != m_pending.end() && i.value().m_nHeight == height;
+}
+
+void acTimelineTileRenderer::cancel()
+{
+    m_generation.fetchAndAddOrdered(1);
+    m_threadPool.clear();
+    m_pending.clear();
+
+    QMutexLocker locker(&m_resultsMutex);
+    m_results.clear();
+}
+
+void acTimelineTileRenderer::cancelBranch(const acTimelineBranch* pBranch)
+{
+    cancelTiles(pBranch, std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max());
+}
+
+void acTimelineTileRenderer::cancelTiles(const acTimelineBranch* pBranch, qint64 firstTileIndex, qint64 lastTileIndex)
+{
+    QHash<TileKey, PendingTile>::iterator i = m_pending.begin();
+
+    while (i != m_pending.end())
+    {
+        if (i.key().first == pBranch && i.key().second >= firstTileIndex && i.key().second <= lastTileIndex)
+        {
+            i = m_pending.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+QList<acTimelineTileRenderer::Result> acTimelineTileRenderer::takeResults()
+{
+    QList<Result> results;
+
+    {
+        QMutexLocker locker(&m_resultsMutex);
+        results.swap(m_results);
+        m_bNotifyPosted = false;
+    }
+
+    QList<Result> retVal;
+
+    for (QList<Result>::const_iterator i = results.begin(); i != results.end(); ++i)
+    {
+        // drop the tiles which were cancelled or submitted again after the job was queued
+        QHash<TileKey, PendingTile>::iterator pendingIt = m_pending.find(TileKey((*i).m_pBranch, (*i).m_nTileIndex));
+
+        if (pendingIt != m_pending.end() && pendingIt.value().m_nSerial == (*i).m_nSerial)
+        {
+            m_pending.erase(pendingIt);
+            retVal.append(*i);
+        }
+    }
+
+    return retVal;
+}
+
+void acTimelineTileRenderer::addResult(const Result& result, int generation)
+{
+    QMutexLocker locker(&m_resultsMutex);
+
+    if (m_generation.loadAcquire() == generation)
+    {
+        m_results.append(result);
+
+        // notify the receiver once for all the tiles finished until it collects them
+        if (!m_bNotifyPosted)
+        {
+            m_bNotifyPosted = true;
+            QMetaObject::invokeMethod(m_pReceiver, m_finishedSlot, Qt::QueuedConnection);
+        }
+    }
+}
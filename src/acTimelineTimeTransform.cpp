@@ -0,0 +1,81 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTimeTransform.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <cmath>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTimeTransform.h>
+
+acTimelineTimeTransform::acTimelineTimeTransform() :
+    m_nStartTime(0),
+    m_nFullRange(0),
+    m_nRenderWidth(0),
+    m_nOffset(0),
+    m_nOriginTime(0),
+    m_dOriginX(0),
+    m_dPixelsPerTime(0),
+    m_dTimePerPixel(0)
+{
+}
+
+void acTimelineTimeTransform::set(quint64 startTime, quint64 fullRange, quint64 renderWidth, qint64 offset)
+{
+    m_nStartTime = startTime;
+    m_nFullRange = fullRange;
+    m_nRenderWidth = renderWidth;
+    m_nOffset = offset;
+
+    m_dPixelsPerTime = (fullRange > 0) ? (double)renderWidth / fullRange : 0;
+    m_dTimePerPixel = (renderWidth > 0) ? (double)fullRange / renderWidth : 0;
+
+    m_nOriginTime = startTime;
+    m_dOriginX = -(double)offset;
+
+    if (fullRange > 0 && renderWidth > 0 && offset > 0)
+    {
+        // Anchor the transform on the time unit containing X = 0, i.e. the largest q with q * renderWidth <= offset * fullRange.
+        // The estimate of q from doubles is within a unit or two of it, so the remainder is small, and computing it with wrapping
+        // 64 bit arithmetic gives it exactly even though the products themselves overflow
+        quint64 q = (quint64)((double)offset * fullRange / renderWidth);
+        qint64 remainder = (qint64)((quint64)offset * fullRange - q * renderWidth);
+
+        while (remainder < 0)
+        {
+            --q;
+            remainder += (qint64)renderWidth;
+        }
+
+        while ((quint64)remainder >= renderWidth)
+        {
+            ++q;
+            remainder -= (qint64)renderWidth;
+        }
+
+        // X(origin) = (q * renderWidth - offset * fullRange) / fullRange
+        m_nOriginTime = startTime + q;
+        m_dOriginX = -(double)remainder / fullRange;
+    }
+}
+
+quint64 acTimelineTimeTransform::xToTime(int x) const
+{
+    quint64 retVal = m_nStartTime;
+    double timeOffset = std::floor((x - m_dOriginX) * m_dTimePerPixel);
+
+    if (timeOffset >= 0)
+    {
+        retVal = m_nOriginTime + (quint64)timeOffset;
+    }
+    else if ((quint64)(-timeOffset) < m_nOriginTime - m_nStartTime)
+    {
+        retVal = m_nOriginTime - (quint64)(-timeOffset);
+    }
+
+    return retVal;
+}
@@ -0,0 +1,286 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineToolTipBuilder.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+// Qt:
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QRunnable>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineToolTipBuilder.h>
+
+/// Builds the text of a single tooltip, from its content or from the snapshot of its item
+class acTimelineToolTipBuilder::Job : public QRunnable
+{
+public:
+    Job(acTimelineToolTipBuilder* pBuilder, const acTimelineItem* pItem, const Content& content) :
+        m_pBuilder(pBuilder),
+        m_pItem(pItem),
+        m_content(content),
+        m_bHasSnapshot(false),
+        m_nGeneration(0)
+    {
+    }
+
+    Job(acTimelineToolTipBuilder* pBuilder, const acTimelineItem* pItem, const ItemSnapshot& snapshot) :
+        m_pBuilder(pBuilder),
+        m_pItem(pItem),
+        m_snapshot(snapshot),
+        m_bHasSnapshot(true),
+        m_nGeneration(0)
+    {
+    }
+
+    void setGeneration(int generation) { m_nGeneration = generation; }
+
+    virtual void run()
+    {
+        // skip the requests which were dropped after they were queued
+        if (m_pBuilder->m_generation.loadAcquire() == m_nGeneration)
+        {
+            if (m_bHasSnapshot)
+            {
+                getContent(m_snapshot, m_content);
+            }
+
+            m_pBuilder->setResult(m_pItem, buildText(m_content), m_nGeneration);
+        }
+    }
+
+private:
+    acTimelineToolTipBuilder* m_pBuilder;
+    const acTimelineItem*     m_pItem;
+    Content                   m_content;
+    ItemSnapshot              m_snapshot;
+    bool                      m_bHasSnapshot;
+    int                       m_nGeneration;
+};
+
+acTimelineToolTipBuilder::acTimelineToolTipBuilder(QObject* pReceiver, const char* finishedSlot) :
+    m_pReceiver(pReceiver),
+    m_finishedSlot(finishedSlot),
+    m_generation(0),
+    m_bHasResult(false),
+    m_pResultItem(nullptr)
+{
+    // a single tooltip is shown at a time, so a single thread builds them
+    m_threadPool.setMaxThreadCount(1);
+}
+
+acTimelineToolTipBuilder::~acTimelineToolTipBuilder()
+{
+    cancel();
+    m_threadPool.waitForDone();
+}
+
+void acTimelineToolTipBuilder::getContent(const acTimelineItemToolTip& tooltip, Content& content)
+{
+    content.m_rows.resize(tooltip.count());
+
+    for (int i = 0; i < tooltip.count(); i++)
+    {
+        Row& row = content.m_rows[i];
+        row.m_strName = tooltip.getName(i);
+        row.m_format = tooltip.getFormat(i);
+        row.m_dNumber = tooltip.getNumber(i);
+
+        // the time values are formatted by buildText
+        if (row.m_format == acTimelineItemToolTip::VALUE_TEXT)
+        {
+            row.m_strValue = tooltip.getValue(i);
+        }
+    }
+
+    content.m_strAdditionalText = tooltip.additionalText();
+}
+
+void acTimelineToolTipBuilder::getContent(const ItemSnapshot& snapshot, Content& content)
+{
+    // the same rows as acTimelineItem::tooltipItems, translated in the context of the item (translating is thread safe)
+    content.m_rows.resize(4);
+    content.m_strAdditionalText.clear();
+
+    Row& nameRow = content.m_rows[0];
+    nameRow.m_strName = acTimelineItem::tr("Name");
+    nameRow.m_strValue = snapshot.m_strText;
+    nameRow.m_format = acTimelineItemToolTip::VALUE_TEXT;
+    nameRow.m_dNumber = 0;
+
+    Row& startRow = content.m_rows[1];
+    startRow.m_strName = acTimelineItem::tr("Start Time");
+    startRow.m_format = acTimelineItemToolTip::VALUE_MILLISECONDS;
+    startRow.m_dNumber = (double)(snapshot.m_nStartTime - snapshot.m_nTimelineStartTime);
+
+    Row& endRow = content.m_rows[2];
+    endRow.m_strName = acTimelineItem::tr("End Time");
+    endRow.m_format = acTimelineItemToolTip::VALUE_MILLISECONDS;
+    endRow.m_dNumber = (double)(snapshot.m_nEndTime - snapshot.m_nTimelineStartTime);
+
+    Row& durationRow = content.m_rows[3];
+    durationRow.m_strName = acTimelineItem::tr("Duration");
+    durationRow.m_format = acTimelineItemToolTip::VALUE_DURATION;
+    durationRow.m_dNumber = (double)(snapshot.m_nEndTime - snapshot.m_nStartTime);
+}
+
+QString acTimelineToolTipBuilder::buildText(const Content& content)
+{
+    QString retVal;
+    QString row1 = "%1: %2";
+    QString row2 = "%1";
+
+    for (int i = 0; i < content.m_rows.count(); i++)
+    {
+        const Row& row = content.m_rows[i];
+        QString value = (row.m_format == acTimelineItemToolTip::VALUE_TEXT) ? row.m_strValue : acTimelineItemToolTip::formatNumber(row.m_format, row.m_dNumber);
+
+        if (row.m_strName.isEmpty())
+        {
+            retVal += row2.arg(value);
+        }
+        else
+        {
+            retVal += row1.arg(row.m_strName, value);
+        }
+
+        if (i < content.m_rows.count() - 1)
+        {
+            retVal += "<br>";
+        }
+    }
+
+    if (!content.m_strAdditionalText.isEmpty())
+    {
+        retVal += "\n" + content.m_strAdditionalText;
+    }
+
+    return retVal;
+}
+
+void acTimelineToolTipBuilder::submit(const acTimelineItem* pItem, const Content& content)
+{
+    start(new(std::nothrow) Job(this, pItem, content));
+}
+
+void acTimelineToolTipBuilder::submit(const acTimelineItem* pItem, const ItemSnapshot& snapshot)
+{
+    start(new(std::nothrow) Job(this, pItem, snapshot));
+}
+
+void acTimelineToolTipBuilder::start(Job* pJob)
+{
+    cancel();
+
+    Q_ASSERT(pJob != nullptr);
+
+    if (pJob != nullptr)
+    {
+        pJob->setGeneration(m_generation.loadAcquire());
+
+        // the pool deletes the job when it is done
+        m_threadPool.start(pJob);
+    }
+}
+
+void acTimelineToolTipBuilder::cancel()
+{
+    m_generation.fetchAndAddOrdered(1);
+    m_threadPool.clear();
+
+    QMutexLocker locker(&m_resultMutex);
+    m_bHasResult = false;
+    m_pResultItem = nullptr;
+    m_strResultText.clear();
+}
+
+bool acTimelineToolTipBuilder::takeResult(const acTimelineItem*& pItem, QString& text)
+{
+    QMutexLocker locker(&m_resultMutex);
+
+    if (!m_bHasResult)
+    {
+        return false;
+    }
+
+    pItem = m_pResultItem;
+    text = m_strResultText;
+
+    m_bHasResult = false;
+    m_pResultItem = nullptr;
+    m_strResultText.clear();
+
+    return true;
+}
+
+void acTimelineToolTipBuilder::setResult(const acTimelineItem* pItem, const QString& text, int generation)
+{
+    QMutexLocker locker(&m_resultMutex);
+
+    if (m_generation.loadAcquire() == generation)
+    {
+        m_bHasResult = true;
+        m_pResultItem = pItem;
+        m_strResultText = text;
+
+        QMetaObject::invokeMethod(m_pReceiver, m_finishedSlot, Qt::QueuedConnection);
+    }
+}
+
+bool acTimelineToolTipBuilder::findCached(const acTimelineItem* pItem, QString& text)
+{
+    QHash<const acTimelineItem*, CacheEntry>::const_iterator i = m_cache.find(pItem);
+
+    if (i == m_cache.end())
+    {
+        return false;
+    }
+
+    const CacheEntry& entry = i.value();
+
+    if (entry.m_nStartTime != pItem->startTime() || entry.m_nEndTime != pItem->endTime() || entry.m_strItemText != pItem->text())
+    {
+        return false;
+    }
+
+    text = entry.m_strText;
+
+    // keep the order of the cache from the least recently to the most recently used item
+    if (m_cacheOrder.last() != pItem)
+    {
+        m_cacheOrder.removeOne(pItem);
+        m_cacheOrder.append(pItem);
+    }
+
+    return true;
+}
+
+void acTimelineToolTipBuilder::cache(const acTimelineItem* pItem, const QString& text)
+{
+    if (m_cache.contains(pItem))
+    {
+        m_cacheOrder.removeOne(pItem);
+    }
+    else if (m_cache.count() >= AC_TIMELINE_TOOLTIP_CACHE_CAPACITY)
+    {
+        m_cache.remove(m_cacheOrder.takeFirst());
+    }
+
+    CacheEntry& entry = m_cache[pItem];
+    entry.m_strText = text;
+    entry.m_nStartTime = pItem->startTime();
+    entry.m_nEndTime = pItem->endTime();
+    entry.m_strItemText = pItem->text();
+
+    m_cacheOrder.append(pItem);
+}
+
+void acTimelineToolTipBuilder::clearCache()
+{
+    m_cache.clear();
+    m_cacheOrder.clear();
+}
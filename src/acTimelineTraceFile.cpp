@@ -0,0 +1,462 @@
+//==================================================================================
+// Copyright (c) 2011 - 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file acTimelineTraceFile.cpp
+///
+//==================================================================================
+
+#include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// Qt:
+#include <QSysInfo>
+
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineBranch.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineItemStore.h>
+#include <AMDTApplicationComponents/Include/Timeline/acTimelineTraceFile.h>
+
+// The magic number at the start of a trace file
+#define AC_TIMELINE_TRACE_MAGIC "ACTRACE1"
+
+// The version of the trace file format
+#define AC_TIMELINE_TRACE_VERSION 1
+
+/// The header of a trace file.
+struct acTimelineTraceHeader
+{
+    char    m_magic[8];             ///< AC_TIMELINE_TRACE_MAGIC (not null terminated).
+    quint32 m_version;              ///< AC_TIMELINE_TRACE_VERSION.
+    quint32 m_branchCount;          ///< The number of branches.
+    quint32 m_paletteCount;         ///< The number of colors in the palette.
+    quint32 m_stringCount;          ///< The number of strings in the string table.
+    quint64 m_paletteOffset;        ///< The offset of the palette.
+    quint64 m_stringOffsetsOffset;  ///< The offset of the string offsets.
+    quint64 m_stringDataOffset;     ///< The offset of the string data.
+    quint64 m_branchTableOffset;    ///< The offset of the branch table.
+    quint64 m_reserved;             ///< Reserved, 0.
+};
+
+/// A branch of the branch table of a trace file.
+struct acTimelineTraceBranchRecord
+{
+    quint32 m_nameId;               ///< The string id of the name of the branch.
+    qint32  m_parentIndex;          ///< The index of the parent branch (-1 for top level branches).
+    quint64 m_itemCount;            ///< The number of items.
+    quint64 m_startTimesOffset;     ///< The offset of the start times.
+    quint64 m_endTimesOffset;       ///< The offset of the end times.
+    quint64 m_maxEndTimesOffset;    ///< The offset of the running maximum of the end times.
+    quint64 m_paletteIndicesOffset; ///< The offset of the palette indices.
+    quint64 m_textIdsOffset;        ///< The offset of the string ids.
+    quint64 m_flagsOffset;          ///< The offset of the flags.
+};
+
+quint64 acTimelineTraceFile::m_nLastLoadGeneration = 0;
+
+QRgb acTimelineTraceItems::backgroundColor(qint64 pos) const
+{
+    return m_pFile->paletteColor(m_pPaletteIndices[pos]);
+}
+
+QString acTimelineTraceItems::text(qint64 pos) const
+{
+    return m_pFile->string(m_pTextIds[pos]);
+}
+
+bool acTimelineTraceItems::findOverlapping(quint64 rangeStart, quint64 rangeEnd, qint64& firstPos, qint64& lastPos) const
+{
+    // same search as acTimelineItemIntervalIndex::findOverlapping, on the mapped columns
+    firstPos = std::lower_bound(m_pMaxEndTimes, m_pMaxEndTimes + m_nCount, rangeStart) - m_pMaxEndTimes;
+    lastPos = std::upper_bound(m_pStartTimes, m_pStartTimes + m_nCount, rangeEnd) - m_pStartTimes;
+
+    return firstPos < lastPos;
+}
+
+qint64 acTimelineTraceItems::lowerBound(quint64 time, qint64 firstPos, qint64 lastPos) const
+{
+    return std::lower_bound(m_pStartTimes + firstPos, m_pStartTimes + lastPos, time) - m_pStartTimes;
+}
+
+qint64 acTimelineTraceItems::lowerBoundMaxEndTime(quint64 time, qint64 firstPos, qint64 lastPos) const
+{
+    return std::lower_bound(m_pMaxEndTimes + firstPos, m_pMaxEndTimes + lastPos, time) - m_pMaxEndTimes;
+}
+
+acTimelineTraceFile::acTimelineTraceFile() :
+    m_pData(nullptr),
+    m_nSize(0),
+    m_pStringOffsets(nullptr),
+    m_pStringData(nullptr),
+    m_nStringCount(0),
+    m_nLoadGeneration(0)
+{
+}
+
+acTimelineTraceFile::~acTimelineTraceFile()
+{
+    close();
+}
+
+bool acTimelineTraceFile::open(const QString& filePath)
+{
+    close();
+
+    // trace files are only opened from the UI thread
+    m_nLoadGeneration = ++m_nLastLoadGeneration;
+
+    // the columns are read in place, so the byte order of the file must be the byte order of the machine
+    if (QSysInfo::ByteOrder != QSysInfo::LittleEndian)
+    {
+        return false;
+    }
+
+    m_file.setFileName(filePath);
+
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    m_nSize = m_file.size();
+
+    // the whole file is mapped, but the OS only reads the pages which are accessed
+    if (m_nSize >= (qint64)sizeof(acTimelineTraceHeader))
+    {
+        m_pData = m_file.map(0, m_nSize);
+    }
+
+    bool retVal = false;
+    const acTimelineTraceHeader* pHeader = reinterpret_cast<const acTimelineTraceHeader*>(m_pData);
+
+    if (pHeader != nullptr && memcmp(pHeader->m_magic, AC_TIMELINE_TRACE_MAGIC, sizeof(pHeader->m_magic)) == 0 && pHeader->m_version == AC_TIMELINE_TRACE_VERSION)
+    {
+        const QRgb* pPalette = reinterpret_cast<const QRgb*>(mappedArray(pHeader->m_paletteOffset, pHeader->m_paletteCount, sizeof(QRgb)));
+        m_pStringOffsets = reinterpret_cast<const quint64*>(mappedArray(pHeader->m_stringOffsetsOffset, (quint64)pHeader->m_stringCount + 1, sizeof(quint64)));
+        const acTimelineTraceBranchRecord* pBranchTable = reinterpret_cast<const acTimelineTraceBranchRecord*>(mappedArray(pHeader->m_branchTableOffset, pHeader->m_branchCount, sizeof(acTimelineTraceBranchRecord)));
+
+        retVal = (pPalette != nullptr || pHeader->m_paletteCount == 0) && m_pStringOffsets != nullptr && (pBranchTable != nullptr || pHeader->m_branchCount == 0);
+
+        if (retVal)
+        {
+            // only the end of the string data is checked here, the offsets of each string are checked when it is decoded
+            m_nStringCount = pHeader->m_stringCount;
+            m_pStringData = reinterpret_cast<const char*>(mappedArray(pHeader->m_stringDataOffset, m_pStringOffsets[m_nStringCount], 1));
+            retVal = (m_pStringData != nullptr);
+        }
+
+        if (retVal)
+        {
+            m_palette.reserve(pHeader->m_paletteCount);
+
+            for (quint32 i = 0; i < pHeader->m_paletteCount; ++i)
+            {
+                m_palette.append(pPalette[i]);
+            }
+
+            m_branches.reserve(pHeader->m_branchCount);
+            m_branchNames.reserve(pHeader->m_branchCount);
+            m_branchParents.reserve(pHeader->m_branchCount);
+        }
+
+        for (quint32 i = 0; retVal && i < pHeader->m_branchCount; ++i)
+        {
+            const acTimelineTraceBranchRecord& record = pBranchTable[i];
+            acTimelineTraceItems items;
+            items.m_pFile = this;
+            items.m_nCount = (qint64)record.m_itemCount;
+            items.m_pStartTimes = reinterpret_cast<const quint64*>(mappedArray(record.m_startTimesOffset, record.m_itemCount, sizeof(quint64)));
+            items.m_pEndTimes = reinterpret_cast<const quint64*>(mappedArray(record.m_endTimesOffset, record.m_itemCount, sizeof(quint64)));
+            items.m_pMaxEndTimes = reinterpret_cast<const quint64*>(mappedArray(record.m_maxEndTimesOffset, record.m_itemCount, sizeof(quint64)));
+            items.m_pPaletteIndices = reinterpret_cast<const quint16*>(mappedArray(record.m_paletteIndicesOffset, record.m_itemCount, sizeof(quint16)));
+            items.m_pTextIds = reinterpret_cast<const quint32*>(mappedArray(record.m_textIdsOffset, record.m_itemCount, sizeof(quint32)));
+            items.m_pFlags = mappedArray(record.m_flagsOffset, record.m_itemCount, sizeof(quint8));
+
+            // a parent must come before its sub branches
+            retVal = (record.m_itemCount == 0 || (items.m_pStartTimes != nullptr && items.m_pEndTimes != nullptr && items.m_pMaxEndTimes != nullptr &&
+                                                  items.m_pPaletteIndices != nullptr && items.m_pTextIds != nullptr && items.m_pFlags != nullptr)) &&
+                     record.m_parentIndex >= -1 && record.m_parentIndex < (qint32)i;
+
+            m_branches.append(items);
+            m_branchNames.append(record.m_nameId);
+            m_branchParents.append(record.m_parentIndex);
+        }
+    }
+
+    if (!retVal)
+    {
+        close();
+    }
+
+    return retVal;
+}
+
+void acTimelineTraceFile::close()
+{
+    if (m_pData != nullptr)
+    {
+        m_file.unmap(m_pData);
+        m_pData = nullptr;
+    }
+
+    m_file.close();
+    m_nSize = 0;
+    m_palette.clear();
+    m_pStringOffsets = nullptr;
+    m_pStringData = nullptr;
+    m_nStringCount = 0;
+    m_branchNames.clear();
+    m_branchParents.clear();
+    m_branches.clear();
+    m_decodedStrings.clear();
+}
+
+QString acTimelineTraceFile::branchName(int branchIndex) const
+{
+    return string(m_branchNames[branchIndex]);
+}
+
+int acTimelineTraceFile::branchParent(int branchIndex) const
+{
+    return m_branchParents[branchIndex];
+}
+
+QString acTimelineTraceFile::decodeString(quint32 stringId) const
+{
+    QString retVal;
+
+    if (stringId < m_nStringCount)
+    {
+        quint64 startOffset = m_pStringOffsets[stringId];
+        quint64 endOffset = m_pStringOffsets[stringId + 1];
+
+        if (startOffset <= endOffset && endOffset <= m_pStringOffsets[m_nStringCount])
+        {
+            retVal = QString::fromUtf8(m_pStringData + startOffset, (int)(endOffset - startOffset));
+        }
+    }
+
+    return retVal;
+}
+
+QString acTimelineTraceFile::string(quint32 stringId) const
+{
+    QHash<quint32, QString>::const_iterator i = m_decodedStrings.find(stringId);
+
+    if (i != m_decodedStrings.end())
+    {
+        return i.value();
+    }
+
+    QString retVal;
+
+    if (stringId < m_nStringCount)
+    {
+        retVal = decodeString(stringId);
+
+        // item names are usually repeated, so the cache refills with the names in use
+        if (m_decodedStrings.count() >= AC_TIMELINE_TRACE_TEXT_CACHE_CAPACITY)
+        {
+            m_decodedStrings.clear();
+        }
+
+        m_decodedStrings.insert(stringId, retVal);
+    }
+
+    return retVal;
+}
+
+const uchar* acTimelineTraceFile::mappedArray(quint64 offset, quint64 count, quint64 elementSize) const
+{
+    const uchar* retVal = nullptr;
+    quint64 fileSize = (quint64)m_nSize;
+
+    // the columns are read in place, so they must be aligned to their element size
+    if (m_pData != nullptr && offset <= fileSize && (offset % elementSize) == 0 && count <= (fileSize - offset) / elementSize)
+    {
+        retVal = m_pData + offset;
+    }
+
+    return retVal;
+}
+
+// Writes a block at the end of a trace file, padded to 8 bytes, and returns its offset (or 0 if the write failed)
+static quint64 acWriteTraceBlock(QFile& file, const void* pData, qint64 size)
+{
+    static const char padding[8] = { 0 };
+    quint64 retVal = (quint64)file.pos();
+
+    if ((size > 0 && file.write(reinterpret_cast<const char*>(pData), size) != size) || file.write(padding, (8 - size % 8) % 8) < 0)
+    {
+        retVal = 0;
+    }
+
+    return retVal;
+}
+
+// Appends the specified branch and all its sub branches (in pre-order) to a list of branches, with the index of their parent
+static void acListTraceBranches(acTimelineBranch* pBranch, qint32 parentIndex, QList<acTimelineBranch*>& allBranches, QVector<qint32>& parents)
+{
+    qint32 branchIndex = allBranches.count();
+    allBranches.append(pBranch);
+    parents.append(parentIndex);
+
+    for (int i = 0; i < pBranch->subBranchCount(); ++i)
+    {
+        acListTraceBranches(pBranch->getSubBranch(i), branchIndex, allBranches, parents);
+    }
+}
+
+bool acTimelineTraceFile::write(const QString& filePath, const QList<acTimelineBranch*>& branches)
+{
+    // list the branches in pre-order, with the index of their parent
+    QList<acTimelineBranch*> allBranches;
+    QVector<qint32> parents;
+
+    for (QList<acTimelineBranch*>::const_iterator i = branches.begin(); i != branches.end(); ++i)
+    {
+        acListTraceBranches(*i, -1, allBranches, parents);
+    }
+
+    // intern the colors and texts of all the branches
+    QVector<QRgb> palette;
+    QHash<QRgb, quint16> paletteLookup;
+    QVector<QString> strings;
+    QHash<QString, quint32> stringLookup;
+    QVector<quint32> branchNames;
+
+    for (QList<acTimelineBranch*>::const_iterator i = allBranches.begin(); i != allBranches.end(); ++i)
+    {
+        const acTimelineItemStore& store = (*i)->compactItems();
+
+        for (int index = -1; index < store.count(); ++index)
+        {
+            // index -1 stands for the name of the branch
+            const QString& text = (index < 0) ? (*i)->text() : store.text(index);
+
+            if (!stringLookup.contains(text))
+            {
+                stringLookup.insert(text, strings.count());
+                strings.append(text);
+            }
+
+            if (index < 0)
+            {
+                branchNames.append(stringLookup.value(text));
+            }
+            else if (!paletteLookup.contains(store.backgroundColor(index)))
+            {
+                if (palette.count() > std::numeric_limits<quint16>::max())
+                {
+                    return false;
+                }
+
+                paletteLookup.insert(store.backgroundColor(index), palette.count());
+                palette.append(store.backgroundColor(index));
+            }
+        }
+    }
+
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    acTimelineTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.m_magic, AC_TIMELINE_TRACE_MAGIC, sizeof(header.m_magic));
+    header.m_version = AC_TIMELINE_TRACE_VERSION;
+    header.m_branchCount = allBranches.count();
+    header.m_paletteCount = palette.count();
+    header.m_stringCount = strings.count();
+
+    // the header and the branch table are written again once the offsets are known
+    bool retVal = (file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header));
+
+    header.m_paletteOffset = acWriteTraceBlock(file, palette.constData(), palette.count() * sizeof(QRgb));
+
+    QVector<quint64> stringOffsets;
+    QByteArray stringData;
+    stringOffsets.reserve(strings.count() + 1);
+
+    for (QVector<QString>::const_iterator i = strings.begin(); i != strings.end(); ++i)
+    {
+        stringOffsets.append(stringData.size());
+        stringData.append((*i).toUtf8());
+    }
+
+    stringOffsets.append(stringData.size());
+    header.m_stringOffsetsOffset = acWriteTraceBlock(file, stringOffsets.constData(), stringOffsets.count() * sizeof(quint64));
+    header.m_stringDataOffset = acWriteTraceBlock(file, stringData.constData(), stringData.size());
+
+    QVector<acTimelineTraceBranchRecord> branchTable(allBranches.count());
+    memset(branchTable.data(), 0, branchTable.count() * sizeof(acTimelineTraceBranchRecord));
+    header.m_branchTableOffset = acWriteTraceBlock(file, branchTable.constData(), branchTable.count() * sizeof(acTimelineTraceBranchRecord));
+
+    for (int branchIndex = 0; retVal && branchIndex < allBranches.count(); ++branchIndex)
+    {
+        const acTimelineItemStore& store = allBranches[branchIndex]->compactItems();
+        int count = store.count();
+
+        // the items are sorted by start time (keeping the order of items starting at the same time)
+        QVector<int> order(count);
+
+        for (int index = 0; index < count; ++index)
+        {
+            order[index] = index;
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&store](int left, int right) { return store.startTime(left) < store.startTime(right); });
+
+        QVector<quint64> startTimes(count);
+        QVector<quint64> endTimes(count);
+        QVector<quint64> maxEndTimes(count);
+        QVector<quint16> paletteIndices(count);
+        QVector<quint32> textIds(count);
+        QVector<quint8> flags(count);
+        quint64 maxEndTime = 0;
+
+        for (int pos = 0; pos < count; ++pos)
+        {
+            int index = order[pos];
+            startTimes[pos] = store.startTime(index);
+            endTimes[pos] = store.endTime(index);
+            maxEndTime = qMax(maxEndTime, endTimes[pos]);
+            maxEndTimes[pos] = maxEndTime;
+            paletteIndices[pos] = paletteLookup.value(store.backgroundColor(index));
+            textIds[pos] = stringLookup.value(store.text(index));
+            flags[pos] = store.flags(index);
+        }
+
+        acTimelineTraceBranchRecord& record = branchTable[branchIndex];
+        record.m_nameId = branchNames[branchIndex];
+        record.m_parentIndex = parents[branchIndex];
+        record.m_itemCount = count;
+        record.m_startTimesOffset = acWriteTraceBlock(file, startTimes.constData(), count * sizeof(quint64));
+        record.m_endTimesOffset = acWriteTraceBlock(file, endTimes.constData(), count * sizeof(quint64));
+        record.m_maxEndTimesOffset = acWriteTraceBlock(file, maxEndTimes.constData(), count * sizeof(quint64));
+        record.m_paletteIndicesOffset = acWriteTraceBlock(file, paletteIndices.constData(), count * sizeof(quint16));
+        record.m_textIdsOffset = acWriteTraceBlock(file, textIds.constData(), count * sizeof(quint32));
+        record.m_flagsOffset = acWriteTraceBlock(file, flags.constData(), count * sizeof(quint8));
+
+        retVal = (record.m_startTimesOffset != 0 && record.m_endTimesOffset != 0 && record.m_maxEndTimesOffset != 0 &&
+                  record.m_paletteIndicesOffset != 0 && record.m_textIdsOffset != 0 && record.m_flagsOffset != 0);
+    }
+
+    retVal = retVal && header.m_paletteOffset != 0 && header.m_stringOffsetsOffset != 0 && header.m_stringDataOffset != 0 && header.m_branchTableOffset != 0;
+
+    if (retVal)
+    {
+        retVal = file.seek(0) && file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header) &&
+                 file.seek(header.m_branchTableOffset) &&
+                 file.write(reinterpret_cast<const char*>(branchTable.constData()), branchTable.count() * sizeof(acTimelineTraceBranchRecord)) == (qint64)(branchTable.count() * sizeof(acTimelineTraceBranchRecord));
+    }
+
+    file.close();
+
+    return retVal;
+}